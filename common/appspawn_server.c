@@ -150,7 +150,7 @@ static void NwebSpawnCloneChildProcess(AppSpawnContent *content, AppSpawnClient
 #ifndef APPSPAWN_TEST
     AppSpawningCtx *property = (AppSpawningCtx *)client;
     uint32_t len = 0;
-    char *processType = (char *)(GetAppSpawnMsgExtInfo(property->message, MSG_EXT_NAME_PROCESS_TYPE, &len));
+    char *processType = (char *)(GetAppSpawnMsgKnownExtInfo(property->message, EXT_TLV_ID_PROCESS_TYPE, &len));
     APPSPAWN_CHECK(processType != NULL, return, "Invalid processType data");
 
     if (strcmp(processType, "gpu") == 0) {
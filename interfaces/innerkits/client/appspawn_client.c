@@ -17,6 +17,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <pthread.h>
 #include <string.h>
 #include <unistd.h>
@@ -51,6 +52,7 @@ static int g_hybridSpawnListenFd = 0;
 static bool g_hybridSpawnListenStart = false;
 
 APPSPAWN_STATIC void SpawnListen(AppSpawnReqMsgMgr *reqMgr, const char *processName);
+static void DestroyAsyncClient(AppSpawnReqMsgMgr *reqMgr);
 
 static int InitClientInstance(AppSpawnClientType type)
 {
@@ -75,6 +77,7 @@ static int InitClientInstance(AppSpawnClientType type)
     }
     clientInstance->maxRetryCount = MAX_RETRY_SEND_COUNT;
     clientInstance->socketId = -1;
+    clientInstance->asyncClient = NULL;
     pthread_mutex_init(&clientInstance->mutex, NULL);
     // init recvBlock
     OH_ListInit(&clientInstance->recvBlock.node);
@@ -447,6 +450,7 @@ int AppSpawnClientDestroy(AppSpawnClientHandle handle)
         g_clientInstance[reqMgr->type] = NULL;
     }
     pthread_mutex_unlock(&g_mutex);
+    DestroyAsyncClient(reqMgr);
     pthread_mutex_destroy(&reqMgr->mutex);
     if (reqMgr->socketId >= 0) {
         CloseClientSocket(reqMgr->socketId);
@@ -551,6 +555,277 @@ int AppSpawnClientSendMsg(AppSpawnClientHandle handle, AppSpawnReqMsgHandle reqH
     return ret;
 }
 
+static uint64_t GetMonotonicMs(void)
+{
+    struct timespec now = {0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;  // 1000 ms per s, 1000000 ns per ms
+}
+
+static AppSpawnAsyncClient *GetAsyncClient(AppSpawnReqMsgMgr *reqMgr)
+{
+    pthread_mutex_lock(&g_mutex);
+    if (reqMgr->asyncClient == NULL) {
+        AppSpawnAsyncClient *client = (AppSpawnAsyncClient *)calloc(1, sizeof(AppSpawnAsyncClient));
+        if (client != NULL) {
+            pthread_mutex_init(&client->mutex, NULL);
+            client->socketId = -1;
+            client->msgNextId = 1;
+            OH_ListInit(&client->pendingQueue);
+            OH_ListInit(&client->doneQueue);
+            reqMgr->asyncClient = client;
+        }
+    }
+    pthread_mutex_unlock(&g_mutex);
+    return reqMgr->asyncClient;
+}
+
+static void CompleteAsyncReq(AppSpawnAsyncClient *client, AppSpawnAsyncReq *req, int result)
+{
+    OH_ListRemove(&req->node);
+    OH_ListInit(&req->node);
+    if (result != 0) {
+        req->result.result = result;
+    }
+    OH_ListAddTail(&client->doneQueue, &req->node);
+}
+
+// responses of the requests in flight are lost with the connection
+static void CloseAsyncSocket(AppSpawnAsyncClient *client, int result)
+{
+    APPSPAWN_LOGW("Close async socket %{public}d with %{public}u request", client->socketId, client->pendingCount);
+    CloseClientSocket(client->socketId);
+    client->socketId = -1;
+    client->recvLen = 0;
+    while (!ListEmpty(client->pendingQueue)) {
+        CompleteAsyncReq(client, ListEntry(client->pendingQueue.next, AppSpawnAsyncReq, node), result);
+    }
+}
+
+static int AsyncClientSend(AppSpawnReqMsgMgr *reqMgr, AppSpawnAsyncClient *client, AppSpawnReqMsgNode *reqNode)
+{
+    uint32_t retryCount = 1;
+    while (retryCount <= reqMgr->maxRetryCount) {
+        if (client->socketId < 0) {
+            client->socketId = CreateClientSocket(reqMgr->type, reqMgr->timeout);
+        }
+        if (client->socketId < 0) {
+            usleep(RETRY_TIME);
+            retryCount++;
+            continue;
+        }
+        reqNode->msg->msgId = client->msgNextId++;
+        APPSPAWN_ONLY_EXPER(client->msgNextId == 0, client->msgNextId = 1);
+        int ret = HandleMsgSend(reqMgr, client->socketId, reqNode);
+        if (ret == 0) {
+            return 0;
+        }
+        CloseAsyncSocket(client, APPSPAWN_SYSTEM_ERROR);
+        retryCount++;
+    }
+    return APPSPAWN_TIMEOUT;
+}
+
+int AppSpawnClientSubmitMsg(AppSpawnClientHandle handle, AppSpawnReqMsgHandle reqHandle,
+    AppSpawnClientCallback callback, void *context)
+{
+    AppSpawnReqMsgMgr *reqMgr = (AppSpawnReqMsgMgr *)handle;
+    APPSPAWN_CHECK(reqMgr != NULL && callback != NULL, AppSpawnReqMsgFree(reqHandle);
+        return APPSPAWN_ARG_INVALID, "Invalid reqMgr or callback");
+    AppSpawnReqMsgNode *reqNode = (AppSpawnReqMsgNode *)reqHandle;
+    APPSPAWN_CHECK(reqNode != NULL && reqNode->msg != NULL, AppSpawnReqMsgFree(reqHandle);
+        return APPSPAWN_ARG_INVALID, "Invalid msgReq");
+    AppSpawnAsyncClient *client = GetAsyncClient(reqMgr);
+    APPSPAWN_CHECK(client != NULL, AppSpawnReqMsgFree(reqHandle);
+        return APPSPAWN_SYSTEM_ERROR, "Failed to create async client");
+    AppSpawnAsyncReq *req = (AppSpawnAsyncReq *)calloc(1, sizeof(AppSpawnAsyncReq));
+    APPSPAWN_CHECK(req != NULL, AppSpawnReqMsgFree(reqHandle);
+        return APPSPAWN_SYSTEM_ERROR, "Failed to alloc async request");
+    OH_ListInit(&req->node);
+    req->reqId = reqNode->reqId;
+    req->callback = callback;
+    req->context = context;
+    uint32_t timeout = (reqNode->isColdRun && reqMgr->timeout < ASAN_TIMEOUT) ? ASAN_TIMEOUT : reqMgr->timeout;
+
+    pthread_mutex_lock(&reqMgr->mutex);
+    SendSpawnListenMsg(reqMgr, reqNode);
+    pthread_mutex_unlock(&reqMgr->mutex);
+
+    pthread_mutex_lock(&client->mutex);
+    int ret = AsyncClientSend(reqMgr, client, reqNode);
+    if (ret == 0) {
+        req->msgId = reqNode->msg->msgId;
+        req->deadline = GetMonotonicMs() + (uint64_t)timeout * 1000;  // 1000 ms per s
+        OH_ListAddTail(&client->pendingQueue, &req->node);
+        client->pendingCount++;
+    }
+    pthread_mutex_unlock(&client->mutex);
+    APPSPAWN_DUMPI("AppSpawnClientSubmitMsg reqId:%{public}u msgId:%{public}u %{public}s ret:%{public}d",
+        reqNode->reqId, reqNode->msg->msgId, reqNode->msg->processName, ret);
+    APPSPAWN_ONLY_EXPER(ret != 0, free(req));
+    AppSpawnReqMsgFree(reqHandle);
+    return ret;
+}
+
+static int AsyncReqCompareMsgId(ListNode *node, void *data)
+{
+    AppSpawnAsyncReq *req = ListEntry(node, AppSpawnAsyncReq, node);
+    return req->msgId == *(uint32_t *)data ? 0 : 1;
+}
+
+static void HandleAsyncResponses(AppSpawnAsyncClient *client)
+{
+    uint32_t offset = 0;
+    while (client->recvLen - offset >= sizeof(AppSpawnResponseMsg)) {
+        AppSpawnResponseMsg *msg = (AppSpawnResponseMsg *)(client->recvBuffer + offset);
+        offset += sizeof(AppSpawnResponseMsg);
+        ListNode *node = OH_ListFind(&client->pendingQueue, &msg->msgHdr.msgId, AsyncReqCompareMsgId);
+        APPSPAWN_CHECK(node != NULL, continue, "No request for response msgId %{public}u, maybe timeout",
+            msg->msgHdr.msgId);
+        AppSpawnAsyncReq *req = ListEntry(node, AppSpawnAsyncReq, node);
+        (void)memcpy_s(&req->result, sizeof(req->result), &msg->result, sizeof(msg->result));
+        CompleteAsyncReq(client, req, 0);
+    }
+    if (offset > 0 && client->recvLen > offset) {
+        (void)memmove_s(client->recvBuffer, sizeof(client->recvBuffer),
+            client->recvBuffer + offset, client->recvLen - offset);
+    }
+    client->recvLen -= offset;
+}
+
+static void RecvAsyncResponses(AppSpawnAsyncClient *client)
+{
+    while (client->socketId >= 0) {
+        ssize_t rLen = TEMP_FAILURE_RETRY(recv(client->socketId, client->recvBuffer + client->recvLen,
+            sizeof(client->recvBuffer) - client->recvLen, MSG_DONTWAIT));
+        if (rLen < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        APPSPAWN_CHECK(rLen > 0, CloseAsyncSocket(client, APPSPAWN_SYSTEM_ERROR);
+            return, "Async socket closed rLen %{public}zd errno: %{public}d", rLen, errno);
+        client->recvLen += (uint32_t)rLen;
+        HandleAsyncResponses(client);
+    }
+}
+
+static void ExpireAsyncRequests(AppSpawnAsyncClient *client)
+{
+    uint64_t now = GetMonotonicMs();
+    ListNode *node = client->pendingQueue.next;
+    while (node != &client->pendingQueue) {
+        ListNode *next = node->next;
+        AppSpawnAsyncReq *req = ListEntry(node, AppSpawnAsyncReq, node);
+        if (req->deadline <= now) {
+            APPSPAWN_LOGE("Async request timeout reqId: %{public}u msgId: %{public}u", req->reqId, req->msgId);
+            CompleteAsyncReq(client, req, APPSPAWN_TIMEOUT);
+        }
+        node = next;
+    }
+}
+
+// time to wait for the first response or the nearest request timeout
+static int GetAsyncWaitTime(const AppSpawnAsyncClient *client, int timeoutMs)
+{
+    if (!ListEmpty(client->doneQueue) || ListEmpty(client->pendingQueue) || timeoutMs == 0) {
+        return 0;
+    }
+    uint64_t deadline = UINT64_MAX;
+    ListNode *node = client->pendingQueue.next;
+    while (node != &client->pendingQueue) {
+        AppSpawnAsyncReq *req = ListEntry(node, AppSpawnAsyncReq, node);
+        deadline = req->deadline < deadline ? req->deadline : deadline;
+        node = node->next;
+    }
+    uint64_t now = GetMonotonicMs();
+    uint64_t wait = deadline > now ? deadline - now : 0;
+    if (timeoutMs > 0 && (uint64_t)timeoutMs < wait) {
+        wait = (uint64_t)timeoutMs;
+    }
+    return (int)wait;
+}
+
+static int RunAsyncCallbacks(ListNode *done)
+{
+    int count = 0;
+    while (!ListEmpty(*done)) {
+        AppSpawnAsyncReq *req = ListEntry(done->next, AppSpawnAsyncReq, node);
+        OH_ListRemove(&req->node);
+        APPSPAWN_DUMPI("Async request end reqId:%{public}u msgId:%{public}u result:0x%{public}x pid:%{public}d",
+            req->reqId, req->msgId, req->result.result, req->result.pid);
+        req->callback(&req->result, req->context);
+        free(req);
+        count++;
+    }
+    return count;
+}
+
+static void TakeAsyncDoneQueue(AppSpawnAsyncClient *client, ListNode *done)
+{
+    while (!ListEmpty(client->doneQueue)) {
+        ListNode *node = client->doneQueue.next;
+        OH_ListRemove(node);
+        OH_ListInit(node);
+        OH_ListAddTail(done, node);
+        client->pendingCount--;
+    }
+}
+
+int AppSpawnClientProcessEvents(AppSpawnClientHandle handle, int timeoutMs)
+{
+    AppSpawnReqMsgMgr *reqMgr = (AppSpawnReqMsgMgr *)handle;
+    APPSPAWN_CHECK(reqMgr != NULL, return APPSPAWN_ARG_INVALID, "Invalid reqMgr");
+    AppSpawnAsyncClient *client = reqMgr->asyncClient;
+    APPSPAWN_CHECK_ONLY_EXPER(client != NULL, return 0);
+
+    pthread_mutex_lock(&client->mutex);
+    int socketId = client->socketId;
+    int waitMs = GetAsyncWaitTime(client, timeoutMs);
+    pthread_mutex_unlock(&client->mutex);
+    if (socketId >= 0 && waitMs > 0) {  // wait without lock, submit is not blocked
+        struct pollfd pfd = {socketId, POLLIN, 0};
+        (void)TEMP_FAILURE_RETRY(poll(&pfd, 1, waitMs));
+    }
+
+    ListNode done;
+    OH_ListInit(&done);
+    pthread_mutex_lock(&client->mutex);
+    RecvAsyncResponses(client);
+    ExpireAsyncRequests(client);
+    TakeAsyncDoneQueue(client, &done);
+    int remain = (int)client->pendingCount;
+    pthread_mutex_unlock(&client->mutex);
+    (void)RunAsyncCallbacks(&done);
+    return remain;
+}
+
+int AppSpawnClientGetEventFd(AppSpawnClientHandle handle)
+{
+    AppSpawnReqMsgMgr *reqMgr = (AppSpawnReqMsgMgr *)handle;
+    APPSPAWN_CHECK(reqMgr != NULL, return -1, "Invalid reqMgr");
+    AppSpawnAsyncClient *client = reqMgr->asyncClient;
+    APPSPAWN_CHECK_ONLY_EXPER(client != NULL, return -1);
+    pthread_mutex_lock(&client->mutex);
+    int socketId = client->socketId;
+    pthread_mutex_unlock(&client->mutex);
+    return socketId;
+}
+
+static void DestroyAsyncClient(AppSpawnReqMsgMgr *reqMgr)
+{
+    AppSpawnAsyncClient *client = reqMgr->asyncClient;
+    APPSPAWN_CHECK_ONLY_EXPER(client != NULL, return);
+    reqMgr->asyncClient = NULL;
+    ListNode done;
+    OH_ListInit(&done);
+    pthread_mutex_lock(&client->mutex);
+    CloseAsyncSocket(client, APPSPAWN_SYSTEM_ERROR);
+    TakeAsyncDoneQueue(client, &done);
+    pthread_mutex_unlock(&client->mutex);
+    (void)RunAsyncCallbacks(&done);
+    pthread_mutex_destroy(&client->mutex);
+    free(client);
+}
+
 int AppSpawnClientSendUserLockStatus(uint32_t userId, bool isLocked, uint32_t timeoutSec)
 {
     char lockstatus[USER_LOCK_STATUS_SIZE] = {0};
@@ -71,6 +71,31 @@ typedef struct {
     uint8_t buffer[0];
 } AppSpawnMsgBlock;
 
+#define ASYNC_RECV_RESPONSE_COUNT 8
+
+// 异步请求，发送后等待响应
+typedef struct {
+    struct ListNode node;
+    uint32_t msgId;
+    uint32_t reqId;
+    uint64_t deadline;  // CLOCK_MONOTONIC ms
+    AppSpawnClientCallback callback;
+    void *context;
+    AppSpawnResult result;
+} AppSpawnAsyncReq;
+
+// 异步连接，与同步请求的连接分开，多个请求同时在途
+typedef struct {
+    pthread_mutex_t mutex;
+    int socketId;
+    uint32_t msgNextId;
+    uint32_t pendingCount;         // 未执行回调的请求，包括 doneQueue
+    struct ListNode pendingQueue;  // AppSpawnAsyncReq，按提交顺序
+    struct ListNode doneQueue;     // 已完成，在 AppSpawnClientProcessEvents 中执行回调
+    uint32_t recvLen;
+    uint8_t recvBuffer[sizeof(AppSpawnResponseMsg) * ASYNC_RECV_RESPONSE_COUNT];
+} AppSpawnAsyncClient;
+
 typedef struct TagAppSpawnReqMsgMgr {
     AppSpawnClientType type;
     uint32_t maxRetryCount;
@@ -78,6 +103,7 @@ typedef struct TagAppSpawnReqMsgMgr {
     uint32_t msgNextId;
     int socketId;
     pthread_mutex_t mutex;
+    AppSpawnAsyncClient *asyncClient;  // 首次 AppSpawnClientSubmitMsg 时创建
     AppSpawnMsgBlock recvBlock;  // 消息接收缓存
 } AppSpawnReqMsgMgr;
 
@@ -102,6 +102,49 @@ int AppSpawnClientDestroy(AppSpawnClientHandle handle);
  */
 int AppSpawnClientSendMsg(AppSpawnClientHandle handle, AppSpawnReqMsgHandle reqHandle, AppSpawnResult *result);
 
+/**
+ * @brief 异步请求完成回调，在调用 AppSpawnClientProcessEvents 的线程中执行，可以在回调中继续提交请求
+ *
+ * @param result result from appspawn service, result->result is APPSPAWN_TIMEOUT when the request timed out
+ * @param context context passed to AppSpawnClientSubmitMsg
+ */
+typedef void (*AppSpawnClientCallback)(const AppSpawnResult *result, void *context);
+
+/**
+ * @brief submit client request without waiting for the response
+ *
+ * 异步请求使用独立的连接，多个请求可以同时发送，响应按 msgId 匹配到对应请求，超时按请求计算。
+ * 无论成功与否，reqHandle 都会被释放；返回0时 callback 保证被调用一次。
+ *
+ * @param handle handle for client
+ * @param reqHandle handle for request
+ * @param callback completion callback
+ * @param context context for callback
+ * @return if succeed return 0,else return other value
+ */
+int AppSpawnClientSubmitMsg(AppSpawnClientHandle handle, AppSpawnReqMsgHandle reqHandle,
+    AppSpawnClientCallback callback, void *context);
+
+/**
+ * @brief receive responses of submitted requests and run their callbacks
+ *
+ * @param handle handle for client
+ * @param timeoutMs max time to wait for a response in ms, 0 not wait, -1 wait until one request completes
+ * @return count of requests still in flight, or negative value on error
+ */
+int AppSpawnClientProcessEvents(AppSpawnClientHandle handle, int timeoutMs);
+
+/**
+ * @brief fd of the asynchronous connection, readable when responses arrive
+ *
+ * 可以加入调用者自己的 poll/epoll，可读时调用 AppSpawnClientProcessEvents(handle, 0)；
+ * 请求超时也在 AppSpawnClientProcessEvents 中处理，有请求未完成时需要周期性调用。
+ *
+ * @param handle handle for client
+ * @return fd, -1 if no request has been submitted
+ */
+int AppSpawnClientGetEventFd(AppSpawnClientHandle handle);
+
 /**
  * @brief send client user lock status request
  *
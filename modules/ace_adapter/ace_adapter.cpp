@@ -392,7 +392,7 @@ APPSPAWN_STATIC int RunChildThread(const AppSpawnMgr *content, const AppSpawning
 APPSPAWN_STATIC int RunChildByRenderCmd(const AppSpawnMgr *content, const AppSpawningCtx *property)
 {
     uint32_t len = 0;
-    char *renderCmd = reinterpret_cast<char *>(GetAppPropertyExt(property, MSG_EXT_NAME_RENDER_CMD, &len));
+    char *renderCmd = reinterpret_cast<char *>(GetAppPropertyKnownExt(property, EXT_TLV_ID_RENDER_CMD, &len));
     if (renderCmd == nullptr || !IsDeveloperModeOn(property)) {
         APPSPAWN_LOGE("Denied launching a native process: not in developer mode");
         return -1;
@@ -56,7 +56,7 @@ static bool IsInRenderProcess(const AppSpawningCtx *property)
         return isRender;
     }
     firstIn = false;
-    char *processType = (char *)GetAppPropertyExt(property, MSG_EXT_NAME_PROCESS_TYPE, NULL);
+    char *processType = (char *)GetAppPropertyKnownExt(property, EXT_TLV_ID_PROCESS_TYPE, NULL);
     if (processType == NULL) {
         APPSPAWN_LOGE("GetAppPropertyExt ProcessType is null");
         return false;
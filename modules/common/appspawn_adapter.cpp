@@ -108,7 +108,7 @@ void SetHapDomainInfo(const AppSpawnMgr *content, const AppSpawningCtx *property
     if (CheckAppMsgFlagsSet(property, APP_FLAGS_ISOLATED_SELINUX_LABEL)) {
         uint32_t len = 0;
         char *extensionTypeChar =
-            reinterpret_cast<char *>(GetAppPropertyExt(property, MSG_EXT_NAME_EXTENSION_TYPE, &len));
+            reinterpret_cast<char *>(GetAppPropertyKnownExt(property, EXT_TLV_ID_EXTENSION_TYPE, &len));
         std::string extensionType = (extensionTypeChar != nullptr) ? std::string(extensionTypeChar) : "";
         hapDomainInfo->extensionType = extensionType;
     }
@@ -170,8 +170,8 @@ int SetUidGidFilter(const AppSpawnMgr *content)
 static const char *TryGetAllowPtracePolicy(const AppSpawningCtx *property)
 {
     uint32_t kernelPermissionSize = 0;
-    char *kernelPermissionInfo = (char *)GetAppSpawnMsgExtInfo(
-        property->message, MSG_EXT_NAME_JIT_PERMISSIONS, &kernelPermissionSize);
+    char *kernelPermissionInfo = (char *)GetAppSpawnMsgKnownExtInfo(
+        property->message, EXT_TLV_ID_JIT_PERMISSIONS, &kernelPermissionSize);
     if (kernelPermissionSize > 0 && kernelPermissionInfo != NULL &&
         strstr(kernelPermissionInfo, "ohos.permission.kernel.ALLOW_PTRACE") != NULL) {
         APPSPAWN_LOGI("SetSeccompFilter: ALLOW_PTRACE matched, "
@@ -202,7 +202,7 @@ int SetSeccompFilter(const AppSpawnMgr *content, const AppSpawningCtx *property)
     if (IsNWebSpawnMode(content)) {
         uint32_t len = 0;
         char *processTypeChar =
-            reinterpret_cast<char *>(GetAppPropertyExt(property, MSG_EXT_NAME_PROCESS_TYPE, &len));
+            reinterpret_cast<char *>(GetAppPropertyKnownExt(property, EXT_TLV_ID_PROCESS_TYPE, &len));
         std::string processType = (processTypeChar != NULL) ? std::string(processTypeChar) : "";
         if (processType == "render") {
             return 0;
@@ -312,7 +312,7 @@ uint32_t GetHostId(const AppSpawningCtx *property)
 {
     uint32_t hostId = 0; // The value of 0 is invalid. Its purpose is to initialize.
     const char *userId =
-        (const char *)(GetAppSpawnMsgExtInfo(property->message, MSG_EXT_NAME_PARENT_UID, nullptr));
+        (const char *)(GetAppSpawnMsgKnownExtInfo(property->message, EXT_TLV_ID_PARENT_UID, nullptr));
     if (userId == nullptr) {
         APPSPAWN_LOGE("AppSpawn get hostId failed, userId is null");
         return hostId;
@@ -333,7 +333,7 @@ void CheckSpecialSpawnMode(const AppSpawnMgr *content, const AppSpawningCtx *pro
         hapDomainInfo->uid = GetHostId(property);
         uint32_t len = 0;
         char *processTypeChar =
-            reinterpret_cast<char *>(GetAppPropertyExt(property, MSG_EXT_NAME_PROCESS_TYPE, &len));
+            reinterpret_cast<char *>(GetAppPropertyKnownExt(property, EXT_TLV_ID_PROCESS_TYPE, &len));
         std::string processType = (processTypeChar != nullptr) ? std::string(processTypeChar) : "";
         if (processType == "render") {
             hapDomainInfo->hapFlags |= SELINUX_HAP_ISOLATED_RENDER;
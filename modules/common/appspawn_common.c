@@ -249,7 +249,7 @@ static void ClearEnvironment(const AppSpawnMgr *content, const AppSpawningCtx *p
 #ifdef CODE_SIGNATURE_ENABLE
 static char *GetProvisionType(const AppSpawningCtx *property, uint32_t *len)
 {
-    char *provisionType = GetAppPropertyExt(property, MSG_EXT_NAME_PROVISION_TYPE, len);
+    char *provisionType = GetAppPropertyKnownExt(property, EXT_TLV_ID_PROVISION_TYPE, len);
     if (provisionType == NULL) {
         APPSPAWN_LOGE("get provision type failed, defaut is %{public}s", PROVISION_TYPE_DEBUG);
         return PROVISION_TYPE_DEBUG;
@@ -285,10 +285,10 @@ APPSPAWN_STATIC int SetXpmConfig(const AppSpawnMgr *content, const AppSpawningCt
         &len, XPM_DISTRIBUTION_STR_NONE, "app distribution type");
     AppSpawnMsgOwnerId *ownerInfo = (AppSpawnMsgOwnerId *)GetAppProperty(property, TLV_OWNER_INFO);
     const char *ownerId = ownerInfo ? ownerInfo->ownerId : NULL;
-    char *apiTargetVersionStr = GetAppPropertyExt(property, MSG_EXT_NAME_API_TARGET_VERSION, &len);
+    char *apiTargetVersionStr = GetAppPropertyKnownExt(property, EXT_TLV_ID_API_TARGET_VERSION, &len);
     int jitfortEnable = IsJitFortModeOn(property) ? 1 : 0;
     int idType = PROCESS_OWNERID_APP;
-    uint32_t *xpmIdType = (uint32_t *)GetAppPropertyExt(property, MSG_EXT_NAME_XPM_ID_TYPE, &len);
+    uint32_t *xpmIdType = (uint32_t *)GetAppPropertyKnownExt(property, EXT_TLV_ID_XPM_ID_TYPE, &len);
     if (xpmIdType != NULL && len == sizeof(uint32_t)) {
         // Use idType from MSG_EXT_NAME_XPM_ID_TYPE ext TLV (set by SPM)
         idType = (int)*xpmIdType;
@@ -351,7 +351,7 @@ APPSPAWN_STATIC int SetUidGid(const AppSpawnMgr *content, const AppSpawningCtx *
     ret = setresuid(dacInfo->uid, dacInfo->uid, dacInfo->uid);
     APPSPAWN_CHECK(ret == 0, return errno, "setuid(%{public}u) failed: %{public}d", dacInfo->uid, errno);
 
-    char *userIdStr = (char *)GetAppSpawnMsgExtInfo(property->message, MSG_EXT_NAME_USERID, NULL);
+    char *userIdStr = (char *)GetAppSpawnMsgKnownExtInfo(property->message, EXT_TLV_ID_USERID, NULL);
     if (userIdStr != NULL) {
         APPSPAWN_LOGV("Set userId to %{public}s for process %{public}s", userIdStr, GetProcessName(property));
         ret = SetUserId(userIdStr);
@@ -97,7 +97,7 @@ APPSPAWN_STATIC int EnableEncapsForProc(int encapsFileFd)
 APPSPAWN_STATIC uint32_t SpawnGetMaxPids(AppSpawningCtx *property)
 {
     uint32_t len = 0;
-    char *pidMaxStr = GetAppPropertyExt(property, MSG_EXT_NAME_MAX_CHILD_PROCCESS_MAX, &len);
+    char *pidMaxStr = GetAppPropertyKnownExt(property, EXT_TLV_ID_MAX_CHILD_PROCESS, &len);
     APPSPAWN_CHECK_ONLY_EXPER(pidMaxStr != NULL, return 0);
     uint32_t maxNum = 0;
     // string convert to value
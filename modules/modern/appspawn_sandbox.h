@@ -128,6 +128,35 @@ typedef struct {
     char **decPath;         // dec放行目录数组
 } DecPolicyPaths;
 
+typedef enum {
+    SANDBOX_PATH_TOKEN_LITERAL,  // 常量片段，直接拷贝
+    SANDBOX_PATH_TOKEN_VAR,      // 加载时已解析的变量，直接调用handler
+    SANDBOX_PATH_TOKEN_PARAM,    // <param:xxx>
+    SANDBOX_PATH_TOKEN_UNKNOWN,  // 加载时未注册的变量，孵化时按名字查找
+} SandboxPathTokenType;
+
+#define SANDBOX_PATH_TPL_DEP_VAR 0x1       // 含值可能带变量的变量(deps、外部或未知)，name group需要二次替换
+#define SANDBOX_PATH_TPL_PACKAGE_NAME 0x2  // 含<variablePackageName>
+#define SANDBOX_PATH_TPL_PARAM 0x4         // 含<param:xxx>，值随系统参数变化
+
+typedef struct {
+    uint32_t type;
+    uint32_t len;
+    const char *text;  // 常量片段或变量名，PARAM为"<param:xxx"
+    ReplaceVarHandler replaceVar;
+} SandboxPathToken;
+
+/**
+ * @brief 路径预编译模板
+ * 加载配置时将source/target拆分为常量片段和变量，孵化时按顺序拷贝常量并直接调用变量handler
+ */
+typedef struct TagSandboxPathTemplate {
+    uint32_t flags;
+    uint32_t generation;  // 编译时的变量表版本，ClearVariable后模板失效，回退到字符串替换
+    uint32_t tokenCount;
+    SandboxPathToken tokens[0];
+} SandboxPathTemplate;
+
 typedef struct TagPathMountNode {
     SandboxMountNode sandboxNode;
     char *source;                   // source 目录，一般是全局的fs 目录
@@ -139,6 +168,8 @@ typedef struct TagPathMountNode {
     uint32_t checkErrorFlag : 1;
     uint32_t category;
     char *appAplName;
+    SandboxPathTemplate *sourceTpl; // source 预编译模板，NULL时按字符串替换
+    SandboxPathTemplate *targetTpl; // target 预编译模板
     PathDemandInfo demandInfo[0];
     DecPolicyPaths decPolicyPaths;
 } PathMountNode;
@@ -177,14 +208,63 @@ typedef struct TagSandboxGroupNode {
     uint32_t destType;
     PathMountNode *depNode;
     uint32_t depMode;
-    uint32_t depMounted : 1; // 是否执行了挂载
+    uint32_t depStatic : 1; // mount-paths-deps不含变量，加载后即为最终路径，孵化时不再展开
 } SandboxNameGroupNode;
 
+/**
+ * @brief name group依赖路径在本次孵化中的展开结果，保存在context中，不修改共享的配置节点
+ */
+typedef struct TagSandboxDepPath {
+    const SandboxNameGroupNode *groupNode;
+    char *source;
+    char *target;
+    uint32_t owned : 1;    // source/target为本次孵化分配；depStatic时指向配置中的路径
+    uint32_t mounted : 1;  // 是否执行了挂载
+} SandboxDepPath;
+
 typedef struct TagPermissionNode {
     SandboxSection section;
     int32_t permissionIndex;
 } SandboxPermissionNode;
 
+typedef enum {
+    SANDBOX_PLAN_ITEM_MOUNT,   // 父进程已解析source/target并完成source检查，子进程直接挂载
+    SANDBOX_PLAN_ITEM_NODE,    // symlink、含param/deps变量或检查失败的节点，子进程按配置实时处理
+    SANDBOX_PLAN_ITEM_GROUPS,  // section下的name group，依赖本次孵化的deps挂载状态，子进程实时处理
+} SandboxPlanItemType;
+
+typedef struct {
+    uint32_t type;
+    uint32_t operation;
+    const SandboxSection *section;
+    const SandboxMountNode *node;
+    char *source;  // 仅SANDBOX_PLAN_ITEM_MOUNT有效
+    char *target;
+} SandboxMountPlanItem;
+
+/**
+ * @brief 按应用缓存的已解析挂载计划
+ * 父进程孵化前按bundle、消息flags、权限位等查找或生成，fork后子进程按数组顺序执行
+ */
+typedef struct TagSandboxMountPlan {
+    struct ListNode node;  // LRU，最近使用的在表头
+    uint32_t keyHash;
+    uint32_t keyLen;
+    uint8_t *key;
+    uint32_t unlocked : 1;  // 生成时用户的解锁状态，状态变化后重新生成
+    uint32_t appVarCount;  // items[0, appVarCount)为app-variable，在expand配置之前挂载
+    uint32_t itemCount;
+    uint32_t capacity;
+    SandboxMountPlanItem *items;
+} SandboxMountPlan;
+
+// 按permission/flag索引排列的section，索引i的section为sections[start[i]]到sections[start[i + 1] - 1]
+typedef struct {
+    uint32_t indexCount;
+    uint32_t *start;  // indexCount + 1项
+    SandboxSection **sections;
+} SandboxSectionTable;
+
 typedef struct TagAppSpawnSandboxCfg {
     AppSpawnExtData extData;
     SandboxQueue requiredQueue;
@@ -202,6 +282,11 @@ typedef struct TagAppSpawnSandboxCfg {
     uint32_t pidNamespaceSupport : 1;
     uint32_t mounted : 1;
     char *rootPath;
+    struct ListNode mountPlans;  // SandboxMountPlan
+    uint32_t mountPlanCount;
+    const SandboxMountPlan *spawnPlan;  // 本次孵化使用的计划，父进程fork前设置
+    SandboxSectionTable permissionTable;  // 预加载时按permissionIndex生成
+    SandboxSectionTable spawnFlagsTable;  // 预加载时按flagIndex生成，同一flag保持队列顺序
 } AppSpawnSandboxCfg;
 
 enum {
@@ -217,6 +302,8 @@ typedef struct TagSandboxBuffer {
     char *buffer;
 } SandboxBuffer;
 
+typedef struct TagSandboxDirCache SandboxDirCache;
+
 typedef struct TagSandboxContext {
     SandboxBuffer buffer[MAX_BUFFER];
     const char *bundleName;
@@ -229,6 +316,12 @@ typedef struct TagSandboxContext {
     uint32_t nwebspawn : 1;
     uint32_t sandboxNsFlags;
     char *rootPath;
+    SandboxMountPlan *buildPlan;  // 非NULL时只解析配置并记录到计划，不执行挂载
+    const SandboxMountPlan *mountPlan;
+    SandboxDirCache *dirCache;  // 子进程unshare后打开，沙盒内目录相对根目录fd创建
+    SandboxDepPath *depPaths;   // 已展开的name group依赖路径
+    uint32_t depPathCount;
+    uint32_t depPathCapacity;
 } SandboxContext;
 
 typedef struct {
@@ -267,6 +360,34 @@ __attribute__((always_inline)) inline uint32_t GetSectionType(const SandboxSecti
     return section != NULL ? section->sandboxNode.type : SANDBOX_TAG_INVALID;
 }
 
+/**
+ * @brief 按消息中置位的permission/flag分发section
+ *
+ * type为TLV_PERMISSION或TLV_MSG_FLAGS，只遍历置位的索引；未生成索引表时回退为遍历队列
+ */
+typedef int (*SandboxSectionHandler)(SandboxSection *section, void *data);
+int BuildSandboxSectionTables(AppSpawnSandboxCfg *sandbox);
+void ClearSandboxSectionTables(AppSpawnSandboxCfg *sandbox);
+int ForEachSandboxSectionSet(const AppSpawnSandboxCfg *sandbox, const AppSpawnMsgNode *message,
+    uint32_t type, SandboxSectionHandler handler, void *data);
+
+// 返回start及之后第一个置位的索引，不存在时返回limit
+__attribute__((always_inline)) inline uint32_t GetNextMsgFlagIndex(
+    const AppSpawnMsgFlags *msgFlags, uint32_t start, uint32_t limit)
+{
+    const uint32_t bits = 32;  // 32 bit in flags word
+    uint32_t block = start / bits;
+    uint32_t mask = ~0U << (start % bits);
+    for (; msgFlags != NULL && block < msgFlags->count && block * bits < limit; block++, mask = ~0U) {
+        uint32_t word = msgFlags->flags[block] & mask;
+        if (word != 0) {
+            uint32_t index = block * bits + (uint32_t)__builtin_ctz(word);
+            return index < limit ? index : limit;
+        }
+    }
+    return limit;
+}
+
 /**
  * @brief SandboxMountNode op
  *
@@ -293,6 +414,8 @@ int MountSandboxConfigs(AppSpawnSandboxCfg *sandbox, const AppSpawningCtx *prope
 int StagedMountSystemConst(AppSpawnSandboxCfg *sandbox, const AppSpawningCtx *property, int nwebspawn);
 int StagedMountPreUnShare(const SandboxContext *context, AppSpawnSandboxCfg *sandbox);
 int StagedMountPostUnshare(const SandboxContext *context, const AppSpawnSandboxCfg *sandbox);
+int BuildSandboxMountPlan(SandboxContext *context, const AppSpawnSandboxCfg *sandbox, SandboxMountPlan *plan);
+int MountSandboxPlanItems(const SandboxContext *context, const SandboxMountPlan *plan, uint32_t start, uint32_t end);
 // 在子进程退出时，由父进程发起unmount操作
 int UnmountDepPaths(const AppSpawnSandboxCfg *sandbox, uid_t uid);
 int UnmountSandboxConfigs(const AppSpawnSandboxCfg *sandbox, uid_t uid, const char *name);
@@ -314,12 +437,17 @@ typedef struct TagVarExtraData {
     union {
         PathMountNode *depNode;
     } data;
+    const SandboxDepPath *depPath;  // 非NULL时deps变量取本次孵化展开的路径，否则取depNode中的配置
 } VarExtraData;
 
 void ClearVariable(void);
 void AddDefaultVariable(void);
 const char *GetSandboxRealVar(const SandboxContext *context, uint32_t bufferType, const char *source,
                               const char *prefix, const VarExtraData *extraData);
+SandboxPathTemplate *CompileSandboxPathTemplate(const char *path);
+// tpl为NULL或已失效时，按source字符串替换
+const char *GetSandboxRealPath(const SandboxContext *context, uint32_t bufferType, const SandboxPathTemplate *tpl,
+                               const char *source, const char *prefix, const VarExtraData *extraData);
 
 /**
  * @brief expand config
@@ -365,6 +493,32 @@ __attribute__((always_inline)) inline bool CheckSandboxCtxPermissionFlagSet(
 SandboxContext *GetSandboxContext(void);
 void DeleteSandboxContext(SandboxContext **context);
 
+/**
+ * @brief Sandbox mount plan cache op
+ *
+ */
+#define SANDBOX_MOUNT_PLAN_MAX 32  // 每种沙盒配置缓存的计划上限，超出时淘汰最久未使用的
+void PrepareSandboxMountPlan(AppSpawnSandboxCfg *sandbox, const AppSpawningCtx *property, int nwebspawn);
+// 子进程获取父进程为本次孵化准备的计划，不匹配时返回NULL，按配置实时挂载
+const SandboxMountPlan *GetSpawnMountPlan(const AppSpawnSandboxCfg *sandbox,
+    const AppSpawningCtx *property, const SandboxContext *context);
+void ClearSandboxMountPlans(AppSpawnSandboxCfg *sandbox);
+// 拷贝item，MOUNT类型的source/target由计划持有
+int AddSandboxMountPlanItem(SandboxMountPlan *plan, const SandboxMountPlanItem *item);
+
+/**
+ * @brief Sandbox dir cache op
+ * 单次孵化内记录沙盒根目录下已确认存在的目录，目录创建使用mkdirat/openat相对根目录fd
+ */
+int OpenSandboxDirCache(SandboxContext *context);
+void CloseSandboxDirCache(SandboxContext *context);
+// 丢弃全部记录，用于未经过缓存的挂载之后
+void ResetSandboxDirCache(const SandboxContext *context);
+// path上发生mount/umount后，其下的目录可能被覆盖，丢弃相关记录
+void InvalidateSandboxDirCache(const SandboxContext *context, const char *path);
+// 确保挂载目的路径存在，isFile时创建空文件；缓存不可用或不在沙盒根目录下时返回false，由调用者按绝对路径创建
+bool CreateSandboxTargetPath(const SandboxContext *context, const char *path, bool isFile);
+
 /**
  * @brief defineMount Arg Template and operation
  *
@@ -413,6 +567,13 @@ typedef struct TagMountArg {
 
 int SandboxMountPath(const MountArg *arg);
 
+/**
+ * @brief 子进程构建沙盒期间的挂载统计，stat 为 NULL 时停止统计；父进程中的挂载不统计
+ */
+void SetSandboxMountStat(SandboxMountStat *stat);
+uint64_t SandboxStatTimeBegin(void);  // 未统计时返回0，不读时钟
+void SandboxStatTimeEnd(SandboxStatOp op, uint64_t begin);
+
 __attribute__((always_inline)) inline int IsPathEmpty(const char *path)
 {
     if (path == NULL || path[0] == '\0') {
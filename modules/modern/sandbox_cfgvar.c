@@ -20,7 +20,11 @@
 #include "parameter.h"
 #include "securec.h"
 
+#define SANDBOX_VAR_NAME_MAX 128
+#define SANDBOX_PARAM_VAR_PREFIX "<param:"
+
 struct ListNode g_sandboxVarList = {&g_sandboxVarList, &g_sandboxVarList};
+static uint32_t g_sandboxVarGeneration = 0;
 
 static int VarPackageNameIndexReplace(const SandboxContext *context,
     const char *buffer, uint32_t bufferLen, uint32_t *realLen, const VarExtraData *extraData)
@@ -74,7 +78,7 @@ static int VarCurrentHostUserIdReplace(const SandboxContext *context,
     int uid = 0;
     int len = 0;
     char *hostUid =
-        (char *)GetAppSpawnMsgExtInfo(context->message, MSG_EXT_NAME_PARENT_UID, NULL);
+        (char *)GetAppSpawnMsgKnownExtInfo(context->message, EXT_TLV_ID_PARENT_UID, NULL);
     if (hostUid != NULL) {
         uid = atoi(hostUid);
         len = sprintf_s((char *)buffer, bufferLen, "%d", uid / UID_BASE);
@@ -134,12 +138,23 @@ static int ReplaceVariableByParameter(const char *varData, SandboxBuffer *sandbo
     return 0;
 }
 
+static inline const char *GetDepSource(const VarExtraData *extraData)
+{
+    return extraData->depPath != NULL ? extraData->depPath->source : extraData->data.depNode->source;
+}
+
+static inline const char *GetDepTarget(const VarExtraData *extraData)
+{
+    return extraData->depPath != NULL ? extraData->depPath->target : extraData->data.depNode->target;
+}
+
 APPSPAWN_STATIC int ReplaceVariableForDepSandboxPath(const SandboxContext *context,
     const char *buffer, uint32_t bufferLen, uint32_t *realLen, const VarExtraData *extraData)
 {
     APPSPAWN_CHECK(extraData != NULL && extraData->data.depNode != NULL, return -1, "Invalid extra data ");
-    uint32_t len = strlen(extraData->data.depNode->target);
-    int ret = memcpy_s((char *)buffer, bufferLen, extraData->data.depNode->target, len);
+    const char *target = GetDepTarget(extraData);
+    uint32_t len = strlen(target);
+    int ret = memcpy_s((char *)buffer, bufferLen, target, len);
     APPSPAWN_CHECK(ret == 0, return -1, "Failed to copy real data");
     *realLen = len;
     return 0;
@@ -149,8 +164,9 @@ APPSPAWN_STATIC int ReplaceVariableForDepSrcPath(const SandboxContext *context,
     const char *buffer, uint32_t bufferLen, uint32_t *realLen, const VarExtraData *extraData)
 {
     APPSPAWN_CHECK(extraData != NULL && extraData->data.depNode != NULL, return -1, "Invalid extra data ");
-    uint32_t len = strlen(extraData->data.depNode->source);
-    int ret = memcpy_s((char *)buffer, bufferLen, extraData->data.depNode->source, len);
+    const char *source = GetDepSource(extraData);
+    uint32_t len = strlen(source);
+    int ret = memcpy_s((char *)buffer, bufferLen, source, len);
     APPSPAWN_CHECK(ret == 0, return -1, "Failed to copy real data");
     *realLen = len;
     return 0;
@@ -160,11 +176,11 @@ APPSPAWN_STATIC int ReplaceVariableForDepPath(const SandboxContext *context,
     const char *buffer, uint32_t bufferLen, uint32_t *realLen, const VarExtraData *extraData)
 {
     APPSPAWN_CHECK(extraData != NULL && extraData->data.depNode != NULL, return -1, "Invalid extra data ");
-    char *path = extraData->data.depNode->source;
+    const char *path = GetDepSource(extraData);
     if (CHECK_FLAGS_BY_INDEX(extraData->operation, MOUNT_PATH_OP_REPLACE_BY_SANDBOX)) {
-        path = extraData->data.depNode->target;
+        path = GetDepTarget(extraData);
     } else if (CHECK_FLAGS_BY_INDEX(extraData->operation, MOUNT_PATH_OP_REPLACE_BY_SRC) && IsPathEmpty(path)) {
-        path = extraData->data.depNode->target;
+        path = GetDepTarget(extraData);
     }
     APPSPAWN_CHECK(path != NULL, return -1, "Invalid path %{public}x ", extraData->operation);
     uint32_t len = strlen(path);
@@ -191,7 +207,7 @@ static int ReplaceVariableForpackageName(const SandboxContext *context,
             bundleInfo->bundleIndex > 0) ? SANDBOX_PACKAGENAME_CLONE : 0;
         flags |= CheckAppSpawnMsgFlag(context->message, TLV_MSG_FLAGS, APP_FLAGS_EXTENSION_SANDBOX)
             ? SANDBOX_PACKAGENAME_EXTENSION : 0;
-        extension = (char *)GetAppSpawnMsgExtInfo(context->message, MSG_EXT_NAME_APP_EXTENSION, NULL);
+        extension = (char *)GetAppSpawnMsgKnownExtInfo(context->message, EXT_TLV_ID_APP_EXTENSION, NULL);
     }
 
     int32_t len = 0;
@@ -214,7 +230,7 @@ static int ReplaceVariableForpackageName(const SandboxContext *context,
             break;
         }
         case SANDBOX_PACKAGENAME_ATOMIC_SERVICE: {      // 4 +auid-<accountId>+packageName
-            char *accountId = (char *)GetAppSpawnMsgExtInfo(context->message, MSG_EXT_NAME_ACCOUNT_ID, NULL);
+            char *accountId = (char *)GetAppSpawnMsgKnownExtInfo(context->message, EXT_TLV_ID_ACCOUNT_ID, NULL);
             APPSPAWN_CHECK(accountId != NULL, return -1, "Invalid accountId data");
             len = sprintf_s((char *)buffer, bufferLen, "+auid-%s+%s", accountId, bundleInfo->bundleName);
             break;
@@ -231,7 +247,7 @@ static int ReplaceVariableForpackageName(const SandboxContext *context,
 static int ReplaceVariable(const SandboxContext *context,
     const char *varStart, SandboxBuffer *sandboxBuffer, uint32_t *varLen, const VarExtraData *extraData)
 {
-    char varName[128] = {0};  // 128 max len for var
+    char varName[SANDBOX_VAR_NAME_MAX] = {0};
     int ret = GetVariableName(varName, sizeof(varName), varStart, varLen);
     APPSPAWN_CHECK(ret == 0, return -1, "Failed to get variable name");
 
@@ -287,6 +303,27 @@ static int HandleVariableReplace(const SandboxContext *context,
     return 0;
 }
 
+// For the depNode scenario, if there are variables in the deps path, a secondary replacement is required
+static int ReplaceDepPathVariable(const SandboxContext *context,
+    SandboxBuffer *sandboxBuffer, const VarExtraData *extraData)
+{
+    if (extraData == NULL || extraData->sandboxTag != SANDBOX_TAG_NAME_GROUP || extraData->data.depNode == NULL) {
+        return 0;
+    }
+    if (strstr(sandboxBuffer->buffer, "<") == NULL) {
+        return 0;
+    }
+    SandboxBuffer *tmpBuffer = &((SandboxContext *)context)->buffer[BUFFER_FOR_TMP];
+    int ret = HandleVariableReplace(context, tmpBuffer, sandboxBuffer->buffer, extraData);
+    APPSPAWN_CHECK(ret == 0, tmpBuffer->current = 0;
+        return -1, "Failed to replace source %{public}s ", sandboxBuffer->buffer);
+    tmpBuffer->buffer[tmpBuffer->current] = '\0';
+    tmpBuffer->current = 0;
+    ret = strcpy_s(sandboxBuffer->buffer, sandboxBuffer->bufferLen, tmpBuffer->buffer);
+    APPSPAWN_CHECK(ret == 0, return -1, "Failed to copy source %{public}s ", sandboxBuffer->buffer);
+    return 0;
+}
+
 const char *GetSandboxRealVar(const SandboxContext *context, uint32_t bufferType, const char *source,
                               const char *prefix, const VarExtraData *extraData)
 {
@@ -298,7 +335,8 @@ const char *GetSandboxRealVar(const SandboxContext *context, uint32_t bufferType
     int ret = 0;
     if (!IsPathEmpty(prefix)) {  // copy prefix data
         ret = HandleVariableReplace(context, sandboxBuffer, prefix, extraData);
-        APPSPAWN_CHECK(ret == 0, return NULL, "Failed to replace source %{public}s ", prefix);
+        APPSPAWN_CHECK(ret == 0, sandboxBuffer->current = 0;
+            return NULL, "Failed to replace source %{public}s ", prefix);
 
         if (tmp != NULL && sandboxBuffer->buffer[sandboxBuffer->current - 1] == '/' && *tmp == '/') {
             tmp = source + 1;
@@ -306,23 +344,189 @@ const char *GetSandboxRealVar(const SandboxContext *context, uint32_t bufferType
     }
     if (!IsPathEmpty(tmp)) {  // copy source data
         ret = HandleVariableReplace(context, sandboxBuffer, tmp, extraData);
-        APPSPAWN_CHECK(ret == 0, return NULL, "Failed to replace source %{public}s ", source);
+        APPSPAWN_CHECK(ret == 0, sandboxBuffer->current = 0;
+            return NULL, "Failed to replace source %{public}s ", source);
     }
     sandboxBuffer->buffer[sandboxBuffer->current] = '\0';
     // restore buffer
     sandboxBuffer->current = 0;
 
-    // For the depNode scenario, if there are variables in the deps path, a secondary replacement is required
-    if (extraData != NULL && extraData->sandboxTag == SANDBOX_TAG_NAME_GROUP && extraData->data.depNode != NULL) {
-        if (strstr(sandboxBuffer->buffer, "<") != NULL) {
-            SandboxBuffer *tmpBuffer = &((SandboxContext *)context)->buffer[BUFFER_FOR_TMP];
-            ret = HandleVariableReplace(context, tmpBuffer, sandboxBuffer->buffer, extraData);
-            APPSPAWN_CHECK(ret == 0, return NULL, "Failed to replace source %{public}s ", sandboxBuffer->buffer);
-            tmpBuffer->buffer[tmpBuffer->current] = '\0';
-            ret = strcpy_s(sandboxBuffer->buffer, sandboxBuffer->bufferLen, tmpBuffer->buffer);
-            APPSPAWN_CHECK(ret == 0, return NULL, "Failed to copy source %{public}s ", sandboxBuffer->buffer);
+    ret = ReplaceDepPathVariable(context, sandboxBuffer, extraData);
+    APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return NULL);
+    return sandboxBuffer->buffer;
+}
+
+// built-in handlers whose value never contains variables, others (deps path, external) may need a second pass
+static bool IsRealValueHandler(ReplaceVarHandler handler)
+{
+    return handler == VarPackageNameReplace || handler == VarCurrentUseIdReplace ||
+        handler == VarCurrentHostUserIdReplace || handler == VarPackageNameIndexReplace ||
+        handler == VarArkWebPackageNameReplace || handler == ReplaceVariableForpackageName;
+}
+
+static int AddPathToken(SandboxPathTemplate *tpl, uint32_t type, const char *text, uint32_t len)
+{
+    if (len == 0) {
+        return 0;
+    }
+    SandboxPathToken *token = &tpl->tokens[tpl->tokenCount++];
+    token->type = type;
+    token->text = text;
+    token->len = len;
+    token->replaceVar = NULL;
+    if (type != SANDBOX_PATH_TOKEN_UNKNOWN) {
+        return 0;
+    }
+
+    char varName[SANDBOX_VAR_NAME_MAX] = {0};
+    int ret = memcpy_s(varName, sizeof(varName) - 1, text, len);
+    APPSPAWN_CHECK(ret == 0, return -1, "Variable name too long %{public}u", len);
+    tpl->flags |= (strcmp(varName, "<variablePackageName>") == 0) ? SANDBOX_PATH_TPL_PACKAGE_NAME : 0;
+    AppSandboxVarNode *node = GetAppSandboxVarNode(varName);
+    if (node != NULL) {
+        token->type = SANDBOX_PATH_TOKEN_VAR;
+        token->text = node->name;
+        token->replaceVar = node->replaceVar;
+        tpl->flags |= IsRealValueHandler(node->replaceVar) ? 0 : SANDBOX_PATH_TPL_DEP_VAR;
+    } else if (strncmp(varName, SANDBOX_PARAM_VAR_PREFIX, sizeof(SANDBOX_PARAM_VAR_PREFIX) - 1) == 0) {
+        token->type = SANDBOX_PATH_TOKEN_PARAM;
+        tpl->flags |= SANDBOX_PATH_TPL_PARAM;
+        ((char *)text)[len - 1] = '\0';  // erase last >, the copy is owned by the template
+        token->len = len - 1;
+    } else if (strcmp(varName, "<lib>") == 0) {
+        token->type = SANDBOX_PATH_TOKEN_LITERAL;
+        token->text = APPSPAWN_LIB_NAME;
+        token->len = strlen(APPSPAWN_LIB_NAME);
+    } else {
+        // registered later or never, resolve by name at spawn time; its value may contain variables too
+        tpl->flags |= SANDBOX_PATH_TPL_DEP_VAR;
+    }
+    return 0;
+}
+
+SandboxPathTemplate *CompileSandboxPathTemplate(const char *path)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(path != NULL, return NULL);
+    size_t pathLen = strlen(path);
+    uint32_t maxCount = 1;
+    for (size_t i = 0; i < pathLen; i++) {
+        maxCount += (path[i] == '<') ? 2 : 0;  // 2 one literal before and the variable
+    }
+    size_t tokenSize = sizeof(SandboxPathToken) * maxCount;
+    SandboxPathTemplate *tpl = (SandboxPathTemplate *)calloc(1, sizeof(SandboxPathTemplate) + tokenSize + pathLen + 1);
+    APPSPAWN_CHECK(tpl != NULL, return NULL, "Failed to alloc template for %{public}s", path);
+    char *data = (char *)tpl + sizeof(SandboxPathTemplate) + tokenSize;
+    int ret = memcpy_s(data, pathLen + 1, path, pathLen + 1);
+    APPSPAWN_CHECK(ret == 0, free(tpl);
+        return NULL, "Failed to copy path %{public}s", path);
+    tpl->generation = g_sandboxVarGeneration;
+
+    size_t start = 0;
+    size_t i = 0;
+    while (i < pathLen) {
+        if (data[i] != '<') {
+            i++;
+            continue;
+        }
+        const char *end = strchr(data + i, '>');
+        uint32_t varLen = (end != NULL) ? (uint32_t)(end - (data + i) + 1) : 0;
+        // invalid variable, leave it to the string path which reports the error at spawn time
+        if (varLen == 0 || varLen >= SANDBOX_VAR_NAME_MAX) {
+            APPSPAWN_LOGW("Invalid variable in path %{public}s", path);
+            free(tpl);
+            return NULL;
+        }
+        ret = AddPathToken(tpl, SANDBOX_PATH_TOKEN_LITERAL, data + start, (uint32_t)(i - start));
+        ret |= AddPathToken(tpl, SANDBOX_PATH_TOKEN_UNKNOWN, data + i, varLen);
+        APPSPAWN_CHECK(ret == 0, free(tpl);
+            return NULL, "Failed to compile path %{public}s", path);
+        i += varLen;
+        start = i;
+    }
+    (void)AddPathToken(tpl, SANDBOX_PATH_TOKEN_LITERAL, data + start, (uint32_t)(pathLen - start));
+    return tpl;
+}
+
+static int CopyPathData(SandboxBuffer *sandboxBuffer, const char *data, uint32_t len)
+{
+    APPSPAWN_CHECK(len < (sandboxBuffer->bufferLen - sandboxBuffer->current),
+        return -1, "Path too long %{public}u", sandboxBuffer->current + len);
+    int ret = memcpy_s(sandboxBuffer->buffer + sandboxBuffer->current,
+        sandboxBuffer->bufferLen - sandboxBuffer->current, data, len);
+    APPSPAWN_CHECK(ret == 0, return -1, "Failed to copy real data");
+    sandboxBuffer->current += len;
+    return 0;
+}
+
+static int ExpandPathToken(const SandboxContext *context, SandboxBuffer *sandboxBuffer,
+    const SandboxPathToken *token, uint32_t skip, const VarExtraData *extraData)
+{
+    uint32_t valueLen = 0;
+    int ret = 0;
+    switch (token->type) {
+        case SANDBOX_PATH_TOKEN_LITERAL:
+            return CopyPathData(sandboxBuffer, token->text + skip, token->len - skip);
+        case SANDBOX_PATH_TOKEN_VAR:
+            ret = token->replaceVar(context, sandboxBuffer->buffer + sandboxBuffer->current,
+                sandboxBuffer->bufferLen - sandboxBuffer->current - 1, &valueLen, extraData);
+            APPSPAWN_CHECK(ret == 0 && valueLen < (sandboxBuffer->bufferLen - sandboxBuffer->current),
+                return -1, "Failed to fill real data");
+            sandboxBuffer->current += valueLen;
+            return 0;
+        case SANDBOX_PATH_TOKEN_PARAM:
+            return ReplaceVariableByParameter(token->text, sandboxBuffer);
+        default:
+            return ReplaceVariable(context, token->text, sandboxBuffer, &valueLen, extraData);
+    }
+}
+
+static int CopyPathPrefix(const SandboxContext *context,
+    SandboxBuffer *sandboxBuffer, const char *prefix, const VarExtraData *extraData, bool *hasVar)
+{
+    size_t len = strlen(prefix);
+    if (memchr(prefix, '<', len) != NULL) {
+        *hasVar = true;
+        return HandleVariableReplace(context, sandboxBuffer, prefix, extraData);
+    }
+    return CopyPathData(sandboxBuffer, prefix, (uint32_t)len);
+}
+
+const char *GetSandboxRealPath(const SandboxContext *context, uint32_t bufferType, const SandboxPathTemplate *tpl,
+                               const char *source, const char *prefix, const VarExtraData *extraData)
+{
+    if (tpl == NULL || tpl->generation != g_sandboxVarGeneration) {
+        return GetSandboxRealVar(context, bufferType, source, prefix, extraData);
+    }
+    APPSPAWN_CHECK_ONLY_EXPER(context != NULL, return NULL);
+    APPSPAWN_CHECK(bufferType < ARRAY_LENGTH(context->buffer), return NULL, "Invalid index for buffer");
+    SandboxBuffer *sandboxBuffer = &((SandboxContext *)context)->buffer[bufferType];
+    APPSPAWN_CHECK_ONLY_EXPER(sandboxBuffer->buffer != NULL, return NULL);
+    bool depVar = (tpl->flags & SANDBOX_PATH_TPL_DEP_VAR) != 0;
+    uint32_t skip = 0;
+    int ret = 0;
+    if (!IsPathEmpty(prefix)) {  // copy prefix data
+        ret = CopyPathPrefix(context, sandboxBuffer, prefix, extraData, &depVar);
+        APPSPAWN_CHECK(ret == 0, sandboxBuffer->current = 0;
+            return NULL, "Failed to replace source %{public}s ", prefix);
+        const SandboxPathToken *first = &tpl->tokens[0];
+        if (tpl->tokenCount > 0 && first->type == SANDBOX_PATH_TOKEN_LITERAL && first->text[0] == '/' &&
+            sandboxBuffer->current > 0 && sandboxBuffer->buffer[sandboxBuffer->current - 1] == '/') {
+            skip = 1;
         }
     }
+    for (uint32_t i = 0; i < tpl->tokenCount; i++) {
+        ret = ExpandPathToken(context, sandboxBuffer, &tpl->tokens[i], (i == 0) ? skip : 0, extraData);
+        APPSPAWN_CHECK(ret == 0, sandboxBuffer->current = 0;
+            return NULL, "Failed to replace source %{public}s ", source);
+    }
+    sandboxBuffer->buffer[sandboxBuffer->current] = '\0';
+    // restore buffer
+    sandboxBuffer->current = 0;
+
+    if (depVar) {
+        ret = ReplaceDepPathVariable(context, sandboxBuffer, extraData);
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return NULL);
+    }
     return sandboxBuffer->buffer;
 }
 
@@ -371,4 +575,5 @@ void AddDefaultVariable(void)
 void ClearVariable(void)
 {
     OH_ListRemoveAll(&g_sandboxVarList, NULL);
+    g_sandboxVarGeneration++;
 }
@@ -186,6 +186,11 @@ static void PreAppSpawnHookExec(const HOOK_INFO *hookInfo, void *executionContex
     APPSPAWN_LOGV("Hook stage: %{public}d prio: %{public}d start", hookInfo->stage, hookInfo->prio);
 }
 
+static inline bool IsChildTimingStage(int stage)
+{
+    return stage >= CHILD_TIMING_STAGE_BEGIN && stage < CHILD_TIMING_STAGE_BEGIN + CHILD_TIMING_STAGE_COUNT;
+}
+
 static void PostAppSpawnHookExec(const HOOK_INFO *hookInfo, void *executionContext, int executionRetVal)
 {
     AppSpawnHookArg *arg = (AppSpawnHookArg *)executionContext;
@@ -193,6 +198,14 @@ static void PostAppSpawnHookExec(const HOOK_INFO *hookInfo, void *executionConte
     uint64_t diff = DiffTime(&arg->tmStart, &arg->tmEnd);
     APPSPAWN_LOGV("Hook stage: %{public}d prio: %{public}d end time %{public}" PRId64 " us result: %{public}d",
         hookInfo->stage, hookInfo->prio, diff, executionRetVal);
+    APPSPAWN_CHECK_ONLY_EXPER(IsChildTimingStage(hookInfo->stage), return);
+    AppSpawnChildTiming *timing = &((AppSpawningCtx *)arg->client)->childTiming;
+    APPSPAWN_CHECK_ONLY_EXPER(timing->hookCount < CHILD_TIMING_HOOK_MAX, return);
+    AppSpawnHookCost *cost = &timing->hooks[timing->hookCount++];
+    cost->stage = hookInfo->stage;
+    cost->prio = hookInfo->prio;
+    cost->costUs = (uint32_t)diff;
+    cost->result = executionRetVal;
 }
 
 int AppSpawnHookExecute(AppSpawnHookStage stage, uint32_t flags, AppSpawnContent *content, AppSpawnClient *client)
@@ -208,8 +221,16 @@ int AppSpawnHookExecute(AppSpawnHookStage stage, uint32_t flags, AppSpawnContent
     options.flags = (int)flags;  // TRAVERSE_STOP_WHEN_ERROR : 0;
     options.preHook = PreAppSpawnHookExec;
     options.postHook = PostAppSpawnHookExec;
+    struct timespec stageStart = {0};
+    clock_gettime(CLOCK_MONOTONIC, &stageStart);
     int ret = HookMgrExecute(GetAppSpawnHookMgr(), stage, (void *)(&forkArg), &options);
     ret = (ret == ERR_NO_HOOK_STAGE) ? 0 : ret;
+    if (IsChildTimingStage(stage)) {
+        struct timespec stageEnd = {0};
+        clock_gettime(CLOCK_MONOTONIC, &stageEnd);
+        AppSpawnChildTiming *timing = &((AppSpawningCtx *)client)->childTiming;
+        timing->stageCostUs[stage - CHILD_TIMING_STAGE_BEGIN] = (uint32_t)DiffTime(&stageStart, &stageEnd);
+    }
     if (ret != 0) {
         APPSPAWN_LOGE("Execute hook [%{public}d] result %{public}d", stage, ret);
     }
@@ -311,7 +311,7 @@ APPSPAWN_STATIC int DupNwebRenderFdsBeforeRunHook(AppSpawnMgr *content, AppSpawn
     }
 
     uint32_t len = 0;
-    char *renderCmd = reinterpret_cast<char *>(GetAppPropertyExt(property, MSG_EXT_NAME_RENDER_CMD, &len));
+    char *renderCmd = reinterpret_cast<char *>(GetAppPropertyKnownExt(property, EXT_TLV_ID_RENDER_CMD, &len));
     if (renderCmd != nullptr && len > 0) {
         std::string renderStr(renderCmd);
         auto version = UpdateAppWebEngineVersion(renderStr);
@@ -22,6 +22,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <sys/mount.h>
@@ -44,6 +45,8 @@
 #define DIR_MODE     0711
 #define LOCK_STATUS_PARAM_SIZE     64
 #define LOCK_STATUS_SIZE     16
+#define DEP_PATH_INIT_CAPACITY 8
+#define NSEC_PER_SEC 1000000000ULL
 
 APPSPAWN_STATIC bool CheckDirRecursive(const char *path)
 {
@@ -69,6 +72,82 @@ APPSPAWN_STATIC bool CheckDirRecursive(const char *path)
     return true;
 }
 
+static SandboxMountStat *g_mountStat = NULL;  // 子进程单线程使用
+
+void SetSandboxMountStat(SandboxMountStat *stat)
+{
+    g_mountStat = stat;
+}
+
+uint64_t SandboxStatTimeBegin(void)
+{
+    struct timespec ts = {0};
+    if (g_mountStat == NULL || clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        return 0;
+    }
+    return (uint64_t)ts.tv_sec * NSEC_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
+void SandboxStatTimeEnd(SandboxStatOp op, uint64_t begin)
+{
+    uint64_t end = SandboxStatTimeBegin();
+    if (begin == 0 || end < begin || op >= SANDBOX_STAT_OP_MAX) {
+        return;
+    }
+    g_mountStat->opCount[op]++;
+    g_mountStat->opCostNs[op] += end - begin;
+}
+
+static uint32_t GetSandboxStatSection(const SandboxSection *section)
+{
+    switch (GetSectionType(section)) {
+        case SANDBOX_TAG_SYSTEM_CONST:
+            return SANDBOX_STAT_SECTION_SYSTEM_CONST;
+        case SANDBOX_TAG_APP_VARIABLE:
+            return SANDBOX_STAT_SECTION_APP_VARIABLE;
+        case SANDBOX_TAG_APP_CONST:
+            return SANDBOX_STAT_SECTION_APP_CONST;
+        case SANDBOX_TAG_PACKAGE_NAME:
+            return SANDBOX_STAT_SECTION_PACKAGE_NAME;
+        case SANDBOX_TAG_SPAWN_FLAGS:
+            return SANDBOX_STAT_SECTION_SPAWN_FLAGS;
+        case SANDBOX_TAG_PERMISSION:
+            return SANDBOX_STAT_SECTION_PERMISSION;
+        case SANDBOX_TAG_NAME_GROUP:
+            return SANDBOX_STAT_SECTION_NAME_GROUP;
+        default:
+            return SANDBOX_STAT_SECTION_OTHER;
+    }
+}
+
+static void CountSandboxMount(SandboxMountCount *count, int result, bool skipped)
+{
+    if (skipped) {
+        count->skipped++;
+        return;
+    }
+    count->attempted++;
+    if (result == 0) {
+        count->succeeded++;
+    } else {
+        count->failed++;
+    }
+}
+
+_Static_assert(SANDBOX_STAT_CATEGORY_MAX >= MOUNT_TMP_MAX, "SANDBOX_STAT_CATEGORY_MAX less than MOUNT_TMP_MAX");
+
+// category 为 MOUNT_TMP_MAX 时只按 section 统计（如符号链接）
+static void CountSandboxSectionMount(const SandboxSection *section, uint32_t category, int result, bool skipped)
+{
+    if (g_mountStat == NULL) {
+        return;
+    }
+    CountSandboxMount(&g_mountStat->section[GetSandboxStatSection(section)], result, skipped);
+    if (category < SANDBOX_STAT_CATEGORY_MAX) {
+        CountSandboxMount(&g_mountStat->category[category], result, skipped);
+    }
+}
+
 int SandboxMountPath(const MountArg *arg)
 {
     APPSPAWN_CHECK(arg != NULL && arg->originPath != NULL && arg->destinationPath != NULL,
@@ -78,8 +157,10 @@ int SandboxMountPath(const MountArg *arg)
         arg->fsType, arg->mountSharedFlag == MS_SHARED ? "MS_SHARED" : "MS_SLAVE",
         (uint32_t)arg->mountFlags, arg->options, arg->originPath, arg->destinationPath);
 
+    uint64_t begin = SandboxStatTimeBegin();
     int ret = mount(arg->originPath, arg->destinationPath, arg->fsType, arg->mountFlags, arg->options);
     if (ret != 0) {
+        SandboxStatTimeEnd(SANDBOX_STAT_OP_MOUNT, begin);
         APPSPAWN_LOGW("errno is: %{public}d, bind mount %{public}s => %{public}s",
             errno, arg->originPath, arg->destinationPath);
         if (strstr(arg->originPath, "/data/app/el1/") != NULL || strstr(arg->originPath, "/data/app/el2/") != NULL) {
@@ -88,6 +169,7 @@ int SandboxMountPath(const MountArg *arg)
         return errno;
     }
     ret = mount(NULL, arg->destinationPath, NULL, arg->mountSharedFlag, NULL);
+    SandboxStatTimeEnd(SANDBOX_STAT_OP_MOUNT, begin);
     if (ret != 0) {
         APPSPAWN_LOGW("errno is: %{public}d, bind mount %{public}s => %{public}s",
             errno, arg->originPath, arg->destinationPath);
@@ -151,11 +233,27 @@ SandboxContext *GetSandboxContext(void)
     return g_sandboxContext;
 }
 
+static void ClearSandboxDepPaths(SandboxContext *context)
+{
+    for (uint32_t i = 0; i < context->depPathCount; i++) {
+        if (context->depPaths[i].owned) {
+            free(context->depPaths[i].source);
+            free(context->depPaths[i].target);
+        }
+    }
+    free(context->depPaths);
+    context->depPaths = NULL;
+    context->depPathCount = 0;
+    context->depPathCapacity = 0;
+}
+
 void DeleteSandboxContext(SandboxContext **context)
 {
     if (context == NULL || *context == NULL) {
         return;
     }
+    CloseSandboxDirCache(*context);
+    ClearSandboxDepPaths(*context);
     if ((*context)->rootPath) {
         free((*context)->rootPath);
         (*context)->rootPath = NULL;
@@ -176,7 +274,7 @@ static bool NeedNetworkIsolated(SandboxContext *context, const AppSpawningCtx *p
 
     if (CheckSandboxCtxMsgFlagSet(context, APP_FLAGS_ISOLATED_NETWORK)) {
         uint32_t len = 0;
-        char *extensionType = GetAppPropertyExt(property, MSG_EXT_NAME_EXTENSION_TYPE, &len);
+        char *extensionType = GetAppPropertyKnownExt(property, EXT_TLV_ID_EXTENSION_TYPE, &len);
         if (extensionType == NULL || extensionType[0] == '\0' || !developerMode) {
             return true;
         }
@@ -235,6 +333,16 @@ int InitSandboxContext(SandboxContext *context, const AppSpawnSandboxCfg *sandbo
     return 0;
 }
 
+static SandboxDepPath *GetSandboxDepPath(const SandboxContext *context, const SandboxNameGroupNode *groupNode)
+{
+    for (uint32_t i = 0; i < context->depPathCount; i++) {
+        if (context->depPaths[i].groupNode == groupNode) {
+            return &context->depPaths[i];
+        }
+    }
+    return NULL;
+}
+
 static VarExtraData *GetVarExtraData(const SandboxContext *context, const SandboxSection *section)
 {
     static VarExtraData extraData;
@@ -243,6 +351,7 @@ static VarExtraData *GetVarExtraData(const SandboxContext *context, const Sandbo
     if (GetSectionType(section) == SANDBOX_TAG_NAME_GROUP) {
         SandboxNameGroupNode *groupNode = (SandboxNameGroupNode *)section;
         extraData.data.depNode = groupNode->depNode;
+        extraData.depPath = GetSandboxDepPath(context, groupNode);
     }
     return &extraData;
 }
@@ -305,7 +414,9 @@ static int32_t SandboxMountFusePath(const SandboxContext *context, const MountAr
         "No tlv %{public}d in msg %{public}s", TLV_DAC_INFO, context->bundleName);
 
     // umount fuse path, make sure that sandbox path is not a mount point
+    uint64_t begin = SandboxStatTimeBegin();
     umount2(args->destinationPath, MNT_DETACH);
+    SandboxStatTimeEnd(SANDBOX_STAT_OP_UMOUNT, begin);
 
     int fd = open("/dev/fuse", O_RDWR);
     APPSPAWN_CHECK(fd != -1, return -EINVAL,
@@ -325,7 +436,9 @@ static int32_t SandboxMountFusePath(const SandboxContext *context, const MountAr
         (uint32_t)args->mountFlags, options, args->originPath, args->destinationPath);
 
     // To make sure destinationPath exist
+    begin = SandboxStatTimeBegin();
     CreateSandboxDir(args->destinationPath, FILE_MODE);
+    SandboxStatTimeEnd(SANDBOX_STAT_OP_MKDIR, begin);
     MountArg mountArg = {args->originPath, args->destinationPath, args->fsType, args->mountFlags, options, MS_SHARED};
     ret = SandboxMountPath(&mountArg);
     if (ret != 0) {
@@ -381,11 +494,14 @@ APPSPAWN_STATIC void CreateDemandSrc(const SandboxContext *context, const PathMo
     }
 }
 
-APPSPAWN_STATIC const char *GetRealSrcPath(const SandboxContext *context, const char *source, VarExtraData *extraData)
+APPSPAWN_STATIC const char *GetRealSrcPath(const SandboxContext *context,
+    const PathMountNode *sandboxNode, VarExtraData *extraData)
 {
-    bool hasPackageName = strstr(source, "<variablePackageName>") != NULL;
+    const SandboxPathTemplate *tpl = sandboxNode->sourceTpl;
+    bool hasPackageName = (tpl != NULL) ? (tpl->flags & SANDBOX_PATH_TPL_PACKAGE_NAME) != 0 :
+        strstr(sandboxNode->source, "<variablePackageName>") != NULL;
     extraData->variablePackageName = (char *)context->bundleName;
-    const char *originPath = GetSandboxRealVar(context, BUFFER_FOR_SOURCE, source, NULL, extraData);
+    const char *originPath = GetSandboxRealPath(context, BUFFER_FOR_SOURCE, tpl, sandboxNode->source, NULL, extraData);
     if (originPath == NULL) {
         return NULL;
     }
@@ -529,54 +645,59 @@ static int SetDecPolicyWithDir(const SandboxContext *context)
     return 0;
 }
 
-static int DoSandboxPathNodeMount(const SandboxContext *context,
-    const SandboxSection *section, const PathMountNode *sandboxNode, uint32_t operation)
+static const char *GetSandboxPathNodeTarget(const SandboxContext *context,
+    const PathMountNode *sandboxNode, uint32_t operation, const VarExtraData *extraData)
 {
-    if (CheckSandboxMountNode(context, section, sandboxNode, operation) == 0) {
-        return 0;
-    }
-
-    MountArg args = {};
-    uint32_t category = GetMountArgs(context, sandboxNode, operation, &args);
-    VarExtraData *extraData = GetVarExtraData(context, section);
-    args.originPath = GetRealSrcPath(context, sandboxNode->source, extraData);
-    // dest
-    extraData->operation = operation;  // only destinationPath
     // 对name group的节点，需要对目的沙盒进行特殊处理，不能带root-dir
     if (CHECK_FLAGS_BY_INDEX(operation, SANDBOX_TAG_NAME_GROUP) &&
         CHECK_FLAGS_BY_INDEX(operation, MOUNT_PATH_OP_ONLY_SANDBOX)) {
-        args.destinationPath = GetSandboxRealVar(context, BUFFER_FOR_TARGET, sandboxNode->target, NULL, extraData);
-    } else {
-        args.destinationPath = GetSandboxRealVar(context,
-            BUFFER_FOR_TARGET, sandboxNode->target, context->rootPath, extraData);
+        return GetSandboxRealPath(context, BUFFER_FOR_TARGET,
+            sandboxNode->targetTpl, sandboxNode->target, NULL, extraData);
     }
-    APPSPAWN_CHECK(args.originPath != NULL && args.destinationPath != NULL,
-        return APPSPAWN_ARG_INVALID, "Invalid path %{public}s %{public}s", args.originPath, args.destinationPath);
+    return GetSandboxRealPath(context, BUFFER_FOR_TARGET,
+        sandboxNode->targetTpl, sandboxNode->target, context->rootPath, extraData);
+}
 
-    if (sandboxNode->sandboxNode.type == SANDBOX_TAG_MOUNT_FILE) {
-        CheckAndCreateSandboxFile(args.destinationPath);
-    } else {
-        if (access(args.destinationPath, F_OK) != 0) {
+static int DoSandboxResolvedPathMount(const SandboxContext *context, const SandboxSection *section,
+    const PathMountNode *sandboxNode, uint32_t operation, const char *source, const char *target)
+{
+    MountArg args = {};
+    uint32_t category = GetMountArgs(context, sandboxNode, operation, &args);
+    args.originPath = source;
+    args.destinationPath = target;
+    bool isFile = sandboxNode->sandboxNode.type == SANDBOX_TAG_MOUNT_FILE;
+    uint64_t begin = SandboxStatTimeBegin();
+    if (!CreateSandboxTargetPath(context, args.destinationPath, isFile)) {
+        if (isFile) {
+            CheckAndCreateSandboxFile(args.destinationPath);
+        } else if (access(args.destinationPath, F_OK) != 0) {
             CreateSandboxDir(args.destinationPath, FILE_MODE);
         }
     }
+    SandboxStatTimeEnd(SANDBOX_STAT_OP_MKDIR, begin);
 
     CreateDemandSrc(context, sandboxNode, &args);
 
     int ret = 0;
     if (CHECK_FLAGS_BY_INDEX(operation, MOUNT_PATH_OP_UNMOUNT)) {  // unmount this deps
         APPSPAWN_LOGI("umount2 %{public}s", args.destinationPath);
+        begin = SandboxStatTimeBegin();
         ret = umount2(args.destinationPath, MNT_DETACH);
+        SandboxStatTimeEnd(SANDBOX_STAT_OP_UMOUNT, begin);
         APPSPAWN_CHECK_ONLY_LOG(ret == 0, "Failed to umount %{public}s errno %{public}d", args.destinationPath, errno);
     }
 
     ret = DoSandboxMountByCategory(context, sandboxNode, &args, operation);
+    CountSandboxSectionMount(section, category, ret, false);
+    InvalidateSandboxDirCache(context, args.destinationPath);
     if (ret != 0 && sandboxNode->checkErrorFlag) {
         APPSPAWN_LOGE("Failed to mount config, section: %{public}s result: %{public}d category: %{public}d",
             section->name, ret, category);
         return ret;
     }
 
+    VarExtraData *extraData = GetVarExtraData(context, section);
+    extraData->operation = operation;
     ret = SetDecPolicyWithCond(context, sandboxNode, extraData);
     if (ret != 0) {
         APPSPAWN_LOGE("Failed to set dec policy with conditional: %{public}d", ret);
@@ -584,6 +705,24 @@ static int DoSandboxPathNodeMount(const SandboxContext *context,
     return ret;
 }
 
+static int DoSandboxPathNodeMount(const SandboxContext *context,
+    const SandboxSection *section, const PathMountNode *sandboxNode, uint32_t operation)
+{
+    if (CheckSandboxMountNode(context, section, sandboxNode, operation) == 0) {
+        CountSandboxSectionMount(section, sandboxNode->category, 0, true);
+        return 0;
+    }
+
+    VarExtraData *extraData = GetVarExtraData(context, section);
+    const char *source = GetRealSrcPath(context, sandboxNode, extraData);
+    // dest
+    extraData->operation = operation;  // only destinationPath
+    const char *target = GetSandboxPathNodeTarget(context, sandboxNode, operation, extraData);
+    APPSPAWN_CHECK(source != NULL && target != NULL,
+        return APPSPAWN_ARG_INVALID, "Invalid path %{public}s %{public}s", source, target);
+    return DoSandboxResolvedPathMount(context, section, sandboxNode, operation, source, target);
+}
+
 static int DoSandboxPathSymLink(const SandboxContext *context,
     const SandboxSection *section, const SymbolLinkNode *sandboxNode)
 {
@@ -597,7 +736,12 @@ static int DoSandboxPathSymLink(const SandboxContext *context,
     const char *linkName = GetSandboxRealVar(context, BUFFER_FOR_TARGET,
         sandboxNode->linkName, context->rootPath, NULL);
     APPSPAWN_LOGV("symlink from %{public}s to %{public}s", target, linkName);
+    uint64_t begin = SandboxStatTimeBegin();
     int ret = symlink(target, linkName);
+    int err = errno;
+    SandboxStatTimeEnd(SANDBOX_STAT_OP_SYMLINK, begin);
+    errno = err;
+    CountSandboxSectionMount(section, MOUNT_TMP_MAX, ret == 0 ? 0 : err, ret != 0 && err == EEXIST);
     if (ret && errno != EEXIST) {
         if (sandboxNode->checkErrorFlag) {
             APPSPAWN_LOGE("symlink failed, errno: %{public}d link info %{public}s %{public}s",
@@ -610,26 +754,29 @@ static int DoSandboxPathSymLink(const SandboxContext *context,
     return 0;
 }
 
+static int DoSandboxMountNode(const SandboxContext *context,
+    const SandboxSection *section, const SandboxMountNode *sandboxNode, uint32_t operation)
+{
+    switch (sandboxNode->type) {
+        case SANDBOX_TAG_MOUNT_PATH:
+        case SANDBOX_TAG_MOUNT_FILE:
+            return DoSandboxPathNodeMount(context, section, (PathMountNode *)sandboxNode, operation);
+        case SANDBOX_TAG_SYMLINK:
+            if (!CHECK_FLAGS_BY_INDEX(operation, MOUNT_PATH_OP_SYMLINK)) {
+                return 0;
+            }
+            return DoSandboxPathSymLink(context, section, (SymbolLinkNode *)sandboxNode);
+        default:
+            return 0;
+    }
+}
+
 static int DoSandboxNodeMount(const SandboxContext *context, const SandboxSection *section, uint32_t operation)
 {
     ListNode *node = section->front.next;
     while (node != &section->front) {
-        int ret = 0;
         SandboxMountNode *sandboxNode = (SandboxMountNode *)ListEntry(node, SandboxMountNode, node);
-        switch (sandboxNode->type) {
-            case SANDBOX_TAG_MOUNT_PATH:
-            case SANDBOX_TAG_MOUNT_FILE:
-                ret = DoSandboxPathNodeMount(context, section, (PathMountNode *)sandboxNode, operation);
-                break;
-            case SANDBOX_TAG_SYMLINK:
-                if (!CHECK_FLAGS_BY_INDEX(operation, MOUNT_PATH_OP_SYMLINK)) {
-                    break;
-                }
-                ret = DoSandboxPathSymLink(context, section, (SymbolLinkNode *)sandboxNode);
-                break;
-            default:
-                break;
-        }
+        int ret = DoSandboxMountNode(context, section, sandboxNode, operation);
         if (ret != 0) {
             return ret;
         }
@@ -638,35 +785,62 @@ static int DoSandboxNodeMount(const SandboxContext *context, const SandboxSectio
     return 0;
 }
 
-static int UpdateMountPathDepsPath(const SandboxContext *context, SandboxNameGroupNode *groupNode)
+static SandboxDepPath *AddSandboxDepPath(SandboxContext *context, const SandboxNameGroupNode *groupNode)
+{
+    if (context->depPathCount >= context->depPathCapacity) {
+        uint32_t capacity = context->depPathCapacity == 0 ? DEP_PATH_INIT_CAPACITY : context->depPathCapacity * 2;
+        SandboxDepPath *depPaths = (SandboxDepPath *)realloc(context->depPaths, capacity * sizeof(SandboxDepPath));
+        APPSPAWN_CHECK(depPaths != NULL, return NULL, "Failed to alloc dep paths %{public}u", capacity);
+        context->depPaths = depPaths;
+        context->depPathCapacity = capacity;
+    }
+    SandboxDepPath *depPath = &context->depPaths[context->depPathCount++];
+    (void)memset_s(depPath, sizeof(SandboxDepPath), 0, sizeof(SandboxDepPath));
+    depPath->groupNode = groupNode;
+    return depPath;
+}
+
+// 展开结果保存在context中，同一孵化内重复引用的name group只展开一次
+static SandboxDepPath *ResolveSandboxDepPath(const SandboxContext *context, const SandboxNameGroupNode *groupNode)
 {
+    SandboxDepPath *depPath = GetSandboxDepPath(context, groupNode);
+    APPSPAWN_CHECK_ONLY_EXPER(depPath == NULL, return depPath);
+
     PathMountNode *depNode = groupNode->depNode;
-    const char *srcPath = GetSandboxRealVar(context, BUFFER_FOR_SOURCE, depNode->source, NULL, NULL);
-    const char *sandboxPath = GetSandboxRealVar(context, BUFFER_FOR_TARGET, depNode->target, NULL, NULL);
-    if (srcPath == NULL || sandboxPath == NULL) {
-        APPSPAWN_LOGE("Failed to get real path %{public}s ", groupNode->section.name);
-        return APPSPAWN_SANDBOX_MOUNT_FAIL;
-    }
-    free(depNode->source);
-    depNode->source = strdup(srcPath);
-    free(depNode->target);
-    depNode->target = strdup(sandboxPath);
-    if (depNode->source == NULL || depNode->target == NULL) {
-        APPSPAWN_LOGE("Failed to get real path %{public}s ", groupNode->section.name);
-        if (depNode->source) {
-            free(depNode->source);
-            depNode->source = NULL;
+    char *source = depNode->source;
+    char *target = depNode->target;
+    if (!groupNode->depStatic) {
+        const char *srcPath = GetSandboxRealPath(context, BUFFER_FOR_SOURCE,
+            depNode->sourceTpl, depNode->source, NULL, NULL);
+        const char *sandboxPath = GetSandboxRealPath(context, BUFFER_FOR_TARGET,
+            depNode->targetTpl, depNode->target, NULL, NULL);
+        APPSPAWN_CHECK(srcPath != NULL && sandboxPath != NULL, return NULL,
+            "Failed to get real path %{public}s ", groupNode->section.name);
+        source = strdup(srcPath);
+        target = strdup(sandboxPath);
+        if (source == NULL || target == NULL) {
+            APPSPAWN_LOGE("Failed to get real path %{public}s ", groupNode->section.name);
+            free(source);
+            free(target);
+            return NULL;
         }
-        if (depNode->target) {
-            free(depNode->target);
-            depNode->target = NULL;
+    }
+    depPath = AddSandboxDepPath((SandboxContext *)context, groupNode);
+    if (depPath == NULL) {
+        if (!groupNode->depStatic) {
+            free(source);
+            free(target);
         }
-        return APPSPAWN_SANDBOX_MOUNT_FAIL;
+        return NULL;
     }
-    return 0;
+    depPath->source = source;
+    depPath->target = target;
+    depPath->owned = !groupNode->depStatic;
+    return depPath;
 }
 
-static bool CheckAndCreateDepPath(const SandboxContext *context, const SandboxNameGroupNode *groupNode)
+static bool CheckAndCreateDepPath(const SandboxContext *context,
+    const SandboxNameGroupNode *groupNode, const SandboxDepPath *depPath)
 {
     PathMountNode *mountNode = (PathMountNode *)GetFirstSandboxMountNode(&groupNode->section);
     if (mountNode == NULL) {
@@ -675,7 +849,8 @@ static bool CheckAndCreateDepPath(const SandboxContext *context, const SandboxNa
 
     // 这里可能需要替换deps的数据
     VarExtraData *extraData = GetVarExtraData(context, &groupNode->section);
-    const char *srcPath = GetSandboxRealVar(context, BUFFER_FOR_SOURCE, mountNode->source, NULL, extraData);
+    const char *srcPath = GetSandboxRealPath(context, BUFFER_FOR_SOURCE,
+        mountNode->sourceTpl, mountNode->source, NULL, extraData);
     if (srcPath == NULL) {
         return false;
     }
@@ -684,35 +859,81 @@ static bool CheckAndCreateDepPath(const SandboxContext *context, const SandboxNa
         return true;
     }
     // 不存在，则创建并挂载
-    APPSPAWN_LOGV("Mount depended source: %{public}s", groupNode->depNode->source);
-    CreateSandboxDir(groupNode->depNode->source, FILE_MODE);
+    APPSPAWN_LOGV("Mount depended source: %{public}s", depPath->source);
+    CreateSandboxDir(depPath->source, FILE_MODE);
     return false;
 }
 
-int MountSandboxConfig(const SandboxContext *context, const AppSpawnSandboxCfg *sandbox,
-                       const SandboxSection *section, uint32_t op)
+static bool IsPlanStablePath(const SandboxPathTemplate *tpl)
 {
-    uint32_t operation = (op != MOUNT_PATH_OP_NONE) ? op : 0;
-    SetMountPathOperation(&operation, section->sandboxNode.type);
-    // if sandbox switch is off, don't do symlink work again
-    if (context->sandboxSwitch && sandbox->topSandboxSwitch) {
-        SetMountPathOperation(&operation, MOUNT_PATH_OP_SYMLINK);
+    return tpl != NULL && (tpl->flags & (SANDBOX_PATH_TPL_DEP_VAR | SANDBOX_PATH_TPL_PARAM)) == 0;
+}
+
+static int AddSandboxPathNodePlan(const SandboxContext *context,
+    const SandboxSection *section, const PathMountNode *sandboxNode, uint32_t operation)
+{
+    SandboxMountPlanItem item = {SANDBOX_PLAN_ITEM_NODE, operation, section, &sandboxNode->sandboxNode, NULL, NULL};
+    /**
+     * 以下节点留给子进程实时处理：
+     *   1.含param或deps变量，值随系统参数或deps挂载变化;
+     *   2.原子化服务的<variablePackageName>源目录，每次孵化都需要检查创建;
+     *   3.source检查不通过，目录可能稍后才创建;
+     * 已解析的节点在子进程执行时仍会重新检查source。
+     */
+    bool atomicPackage = (sandboxNode->sourceTpl != NULL) &&
+        (sandboxNode->sourceTpl->flags & SANDBOX_PATH_TPL_PACKAGE_NAME) != 0 &&
+        CheckSandboxCtxMsgFlagSet(context, APP_FLAGS_ATOMIC_SERVICE);
+    if (IsPlanStablePath(sandboxNode->sourceTpl) && IsPlanStablePath(sandboxNode->targetTpl) && !atomicPackage &&
+        CheckSandboxMountNode(context, section, sandboxNode, operation) != 0) {
+        VarExtraData *extraData = GetVarExtraData(context, section);
+        const char *source = GetRealSrcPath(context, sandboxNode, extraData);
+        extraData->operation = operation;
+        const char *target = GetSandboxPathNodeTarget(context, sandboxNode, operation, extraData);
+        if (source != NULL && target != NULL) {
+            item.type = SANDBOX_PLAN_ITEM_MOUNT;
+            item.source = (char *)source;
+            item.target = (char *)target;
+        }
     }
+    return AddSandboxMountPlanItem(context->buildPlan, &item);
+}
 
-    int ret = DoSandboxNodeMount(context, section, operation);
-    APPSPAWN_CHECK(ret == 0, return ret,
-        "Mount sandbox config fail result: %{public}d, app: %{public}s", ret, context->bundleName);
+static int AddSandboxSectionPlan(const SandboxContext *context, const SandboxSection *section, uint32_t operation)
+{
+    int ret = 0;
+    ListNode *node = section->front.next;
+    while (node != &section->front && ret == 0) {
+        SandboxMountNode *sandboxNode = (SandboxMountNode *)ListEntry(node, SandboxMountNode, node);
+        if (sandboxNode->type == SANDBOX_TAG_MOUNT_PATH || sandboxNode->type == SANDBOX_TAG_MOUNT_FILE) {
+            ret = AddSandboxPathNodePlan(context, section, (PathMountNode *)sandboxNode, operation);
+        } else if (sandboxNode->type == SANDBOX_TAG_SYMLINK) {
+            SandboxMountPlanItem item = {SANDBOX_PLAN_ITEM_NODE, operation, section, sandboxNode, NULL, NULL};
+            ret = AddSandboxMountPlanItem(context->buildPlan, &item);
+        }
+        node = node->next;
+    }
+    if (ret == 0 && section->nameGroups != NULL) {
+        SandboxMountPlanItem item = {SANDBOX_PLAN_ITEM_GROUPS, operation, section, NULL, NULL, NULL};
+        ret = AddSandboxMountPlanItem(context->buildPlan, &item);
+    }
+    return ret;
+}
 
+static int MountSandboxNameGroups(const SandboxContext *context, const SandboxSection *section, uint32_t op)
+{
     if (section->nameGroups == NULL) {
         return 0;
     }
 
+    int ret = 0;
+    uint32_t operation = op;
     for (uint32_t i = 0; i < section->number; i++) {
         if (section->nameGroups[i] == NULL) {
             continue;
         }
         SandboxNameGroupNode *groupNode = (SandboxNameGroupNode *)section->nameGroups[i];
-        if (groupNode->depMounted != 1) {
+        const SandboxDepPath *depPath = GetSandboxDepPath(context, groupNode);
+        if (depPath == NULL || !depPath->mounted) {
             SetMountPathOperation(&operation, MOUNT_PATH_OP_REPLACE_BY_SANDBOX);
         }
         SetMountPathOperation(&operation, SANDBOX_TAG_NAME_GROUP);
@@ -723,6 +944,56 @@ int MountSandboxConfig(const SandboxContext *context, const AppSpawnSandboxCfg *
     return 0;
 }
 
+int MountSandboxConfig(const SandboxContext *context, const AppSpawnSandboxCfg *sandbox,
+                       const SandboxSection *section, uint32_t op)
+{
+    uint32_t operation = (op != MOUNT_PATH_OP_NONE) ? op : 0;
+    SetMountPathOperation(&operation, section->sandboxNode.type);
+    // if sandbox switch is off, don't do symlink work again
+    if (context->sandboxSwitch && sandbox->topSandboxSwitch) {
+        SetMountPathOperation(&operation, MOUNT_PATH_OP_SYMLINK);
+    }
+    if (context->buildPlan != NULL) {
+        return AddSandboxSectionPlan(context, section, operation);
+    }
+
+    int ret = DoSandboxNodeMount(context, section, operation);
+    APPSPAWN_CHECK(ret == 0, return ret,
+        "Mount sandbox config fail result: %{public}d, app: %{public}s", ret, context->bundleName);
+    return MountSandboxNameGroups(context, section, operation);
+}
+
+static int DoSandboxPlanMount(const SandboxContext *context, const SandboxMountPlanItem *item)
+{
+    // source可能在生成计划后被删除，孵化时重新检查
+    const PathMountNode *sandboxNode = (const PathMountNode *)item->node;
+    if (CheckSandboxMountNode(context, item->section, sandboxNode, item->operation) == 0) {
+        CountSandboxSectionMount(item->section, sandboxNode->category, 0, true);
+        return 0;
+    }
+    return DoSandboxResolvedPathMount(context, item->section, sandboxNode, item->operation,
+        item->source, item->target);
+}
+
+int MountSandboxPlanItems(const SandboxContext *context, const SandboxMountPlan *plan, uint32_t start, uint32_t end)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(context != NULL && plan != NULL, return APPSPAWN_ARG_INVALID);
+    for (uint32_t i = start; i < end && i < plan->itemCount; i++) {
+        const SandboxMountPlanItem *item = &plan->items[i];
+        int ret = 0;
+        if (item->type == SANDBOX_PLAN_ITEM_MOUNT) {
+            ret = DoSandboxPlanMount(context, item);
+        } else if (item->type == SANDBOX_PLAN_ITEM_NODE) {
+            ret = DoSandboxMountNode(context, item->section, item->node, item->operation);
+        } else {
+            ret = MountSandboxNameGroups(context, item->section, item->operation);
+        }
+        APPSPAWN_CHECK(ret == 0, return ret, "Mount plan section %{public}s fail result: %{public}d, app: %{public}s",
+            item->section->name, ret, context->bundleName);
+    }
+    return 0;
+}
+
 static int SetExpandSandboxConfig(const SandboxContext *context, const AppSpawnSandboxCfg *sandbox)
 {
     int ret = ProcessExpandAppSandboxConfig(context, sandbox, "HspList");
@@ -761,44 +1032,31 @@ static int SetSandboxPackageNameConfig(const SandboxContext *context, const AppS
     return 0;
 }
 
-static int SetSandboxSpawnFlagsConfig(const SandboxContext *context, const AppSpawnSandboxCfg *sandbox)
+typedef struct {
+    const SandboxContext *context;
+    const AppSpawnSandboxCfg *sandbox;
+    uint32_t operation;
+} SectionMountData;
+
+static int MountSandboxSectionSet(SandboxSection *section, void *data)
 {
-    ListNode *node = sandbox->spawnFlagsQueue.front.next;
-    while (node != &sandbox->spawnFlagsQueue.front) {
-        SandboxFlagsNode *sandboxNode = (SandboxFlagsNode *)ListEntry(node, SandboxMountNode, node);
-        // match flags point
-        if (sandboxNode->flagIndex == 0 || !CheckSandboxCtxMsgFlagSet(context, sandboxNode->flagIndex)) {
-            node = node->next;
-            continue;
-        }
+    SectionMountData *mountData = (SectionMountData *)data;
+    APPSPAWN_LOGV("Mount section %{public}s", section->name);
+    return MountSandboxConfig(mountData->context, mountData->sandbox, section, mountData->operation);
+}
 
-        int ret = MountSandboxConfig(context, sandbox, &sandboxNode->section, MOUNT_PATH_OP_NONE);
-        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
-        node = node->next;
-    }
-    return 0;
+static int SetSandboxSpawnFlagsConfig(const SandboxContext *context, const AppSpawnSandboxCfg *sandbox)
+{
+    SectionMountData data = {context, sandbox, MOUNT_PATH_OP_NONE};
+    return ForEachSandboxSectionSet(sandbox, context->message, TLV_MSG_FLAGS, MountSandboxSectionSet, &data);
 }
 
 static int SetSandboxPermissionConfig(const SandboxContext *context, const AppSpawnSandboxCfg *sandbox)
 {
     APPSPAWN_LOGV("Set permission config");
-    ListNode *node = sandbox->permissionQueue.front.next;
-    while (node != &sandbox->permissionQueue.front) {
-        SandboxPermissionNode *permissionNode = (SandboxPermissionNode *)ListEntry(node, SandboxMountNode, node);
-        if (!CheckSandboxCtxPermissionFlagSet(context, permissionNode->permissionIndex)) {
-            node = node->next;
-            continue;
-        }
-
-        APPSPAWN_LOGV("SetSandboxPermissionConfig permission %{public}d %{public}s",
-            permissionNode->permissionIndex, permissionNode->section.name);
-        uint32_t operation = 0;
-        SetMountPathOperation(&operation, MOUNT_PATH_OP_REPLACE_BY_SANDBOX);
-        int ret = MountSandboxConfig(context, sandbox, &permissionNode->section, operation);
-        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
-        node = node->next;
-    }
-    return 0;
+    SectionMountData data = {context, sandbox, 0};
+    SetMountPathOperation(&data.operation, MOUNT_PATH_OP_REPLACE_BY_SANDBOX);
+    return ForEachSandboxSectionSet(sandbox, context->message, TLV_PERMISSION, MountSandboxSectionSet, &data);
 }
 
 static int SetOverlayAppSandboxConfig(const SandboxContext *context, const AppSpawnSandboxCfg *sandbox)
@@ -1040,12 +1298,12 @@ int StagedMountSystemConst(AppSpawnSandboxCfg *sandbox, const AppSpawningCtx *pr
     return ret;
 }
 
-static int MountDepGroups(const SandboxContext *context, SandboxNameGroupNode *groupNode)
+static int MountDepGroups(const SandboxContext *context, const SandboxNameGroupNode *groupNode)
 {
      /**
      * 在unshare前处理mount-paths-deps 处理逻辑
      *   1.判断是否有mount-paths-deps节点，没有直接返回;
-     *   2.填充json文件中路径的变量值;
+     *   2.填充json文件中路径的变量值，结果保存在context中，配置中不含变量时加载后即为最终路径;
      *   3.校验deps-mode的值是否是not-exists
      *          是not-exist则判断mount-paths.src-path是否存在，若不存在则创建并挂载mount-paths-deps中的目录
      *                                                       若存在则不挂载mount-paths-deps中的目录
@@ -1058,16 +1316,17 @@ static int MountDepGroups(const SandboxContext *context, SandboxNameGroupNode *g
         return 0;
     }
 
-    ret = UpdateMountPathDepsPath(context, groupNode);
-    APPSPAWN_CHECK(ret == 0, return ret, "Failed to update deps path name groups %{public}s", groupNode->section.name);
+    SandboxDepPath *depPath = ResolveSandboxDepPath(context, groupNode);
+    APPSPAWN_CHECK(depPath != NULL, return APPSPAWN_SANDBOX_MOUNT_FAIL,
+        "Failed to update deps path name groups %{public}s", groupNode->section.name);
 
-    if (groupNode->depMode == MOUNT_MODE_NOT_EXIST && CheckAndCreateDepPath(context, groupNode)) {
+    if (groupNode->depMode == MOUNT_MODE_NOT_EXIST && CheckAndCreateDepPath(context, groupNode, depPath)) {
         return 0;
     }
 
     uint32_t operation = 0;
     SetMountPathOperation(&operation, MOUNT_PATH_OP_UNMOUNT);
-    groupNode->depMounted = 1;
+    depPath->mounted = 1;
     ret = DoSandboxPathNodeMount(context, &groupNode->section, groupNode->depNode, operation);
     if (ret != 0) {
         APPSPAWN_LOGE("Mount deps root fail %{public}s", groupNode->section.name);
@@ -1113,34 +1372,27 @@ static int SetAppVariableDepGroups(const SandboxContext *context, AppSpawnSandbo
     return ret;
 }
 
-static int SetSpawnFlagsDepGroups(const SandboxContext *context, AppSpawnSandboxCfg *sandbox)
+static int MountSectionDepGroups(SandboxSection *section, void *data)
 {
-    ListNode *node = sandbox->spawnFlagsQueue.front.next;
-    int ret = 0;
-    while (node != &sandbox->spawnFlagsQueue.front) {
-        SandboxFlagsNode *sandboxNode = (SandboxFlagsNode *)ListEntry(node, SandboxMountNode, node);
-        // match flags point
-        if (sandboxNode->flagIndex == 0 || !CheckSandboxCtxMsgFlagSet(context, sandboxNode->flagIndex)) {
-            node = node->next;
-            continue;
-        }
-
-        if (sandboxNode->section.nameGroups == NULL) {
-            node = node->next;
+    const SandboxContext *context = (const SandboxContext *)data;
+    if (section->nameGroups == NULL) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < section->number; i++) {
+        if (section->nameGroups[i] == NULL) {
             continue;
         }
-
-        for (uint32_t i = 0; i < sandboxNode->section.number; i++) {
-            if (sandboxNode->section.nameGroups[i] == NULL) {
-                continue;
-            }
-            SandboxNameGroupNode *groupNode = (SandboxNameGroupNode *)sandboxNode->section.nameGroups[i];
-            ret = MountDepGroups(context, groupNode);
-            APPSPAWN_CHECK(ret == 0, return ret, "Failed to mount deps groups");
-        }
-        node = node->next;
+        SandboxNameGroupNode *groupNode = (SandboxNameGroupNode *)section->nameGroups[i];
+        int ret = MountDepGroups(context, groupNode);
+        APPSPAWN_CHECK(ret == 0, return ret, "Failed to mount deps groups");
     }
-    return ret;
+    return 0;
+}
+
+static int SetSpawnFlagsDepGroups(const SandboxContext *context, AppSpawnSandboxCfg *sandbox)
+{
+    return ForEachSandboxSectionSet(sandbox, context->message, TLV_MSG_FLAGS,
+        MountSectionDepGroups, (void *)context);
 }
 
 static int SetPackageNameDepGroups(const SandboxContext *context, AppSpawnSandboxCfg *sandbox)
@@ -1165,32 +1417,8 @@ static int SetPackageNameDepGroups(const SandboxContext *context, AppSpawnSandbo
 
 static int SetPermissionDepGroups(const SandboxContext *context, AppSpawnSandboxCfg *sandbox)
 {
-    ListNode *node = sandbox->permissionQueue.front.next;
-    int ret = 0;
-    while (node != &sandbox->permissionQueue.front) {
-        SandboxPermissionNode *permissionNode = (SandboxPermissionNode *)ListEntry(node, SandboxMountNode, node);
-        // match flags point
-        if (!CheckSandboxCtxPermissionFlagSet(context, permissionNode->permissionIndex)) {
-            node = node->next;
-            continue;
-        }
-
-        if (permissionNode->section.nameGroups == NULL) {
-            node = node->next;
-            continue;
-        }
-
-        for (uint32_t i = 0; i < permissionNode->section.number; i++) {
-            if (permissionNode->section.nameGroups[i] == NULL) {
-                continue;
-            }
-            SandboxNameGroupNode *groupNode = (SandboxNameGroupNode *)permissionNode->section.nameGroups[i];
-            ret = MountDepGroups(context, groupNode);
-            APPSPAWN_CHECK(ret == 0, return ret, "Failed to mount deps groups");
-        }
-        node = node->next;
-    }
-    return ret;
+    return ForEachSandboxSectionSet(sandbox, context->message, TLV_PERMISSION,
+        MountSectionDepGroups, (void *)context);
 }
 
 // The execution of the preunshare phase depends on the mounted mount point
@@ -1260,12 +1488,19 @@ int StagedMountPostUnshare(const SandboxContext *context, const AppSpawnSandboxC
     APPSPAWN_CHECK(sandbox != NULL && context != NULL, return -1, "Invalid sandbox or context");
     APPSPAWN_LOGV("Set sandbox config after unshare ");
 
-    int ret = SetAppVariableConfig(context, sandbox);
+    const SandboxMountPlan *plan = context->mountPlan;
+    int ret = (plan != NULL) ? MountSandboxPlanItems(context, plan, 0, plan->appVarCount) :
+        SetAppVariableConfig(context, sandbox);
     APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
     if (!context->nwebspawn) {
         ret = SetExpandSandboxConfig(context, sandbox);
+        // expand配置的挂载不经过目录缓存
+        ResetSandboxDirCache(context);
         APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
     }
+    if (plan != NULL) {
+        return MountSandboxPlanItems(context, plan, plan->appVarCount, plan->itemCount);
+    }
 
     ret = SetSandboxSpawnFlagsConfig(context, sandbox);
     APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
@@ -1278,6 +1513,26 @@ int StagedMountPostUnshare(const SandboxContext *context, const AppSpawnSandboxC
     return ret;
 }
 
+int BuildSandboxMountPlan(SandboxContext *context, const AppSpawnSandboxCfg *sandbox, SandboxMountPlan *plan)
+{
+    APPSPAWN_CHECK(sandbox != NULL && context != NULL && plan != NULL, return -1, "Invalid sandbox or context");
+    // 与StagedMountPostUnshare相同的section选择，只解析不挂载，expand配置依赖消息内容不进入计划
+    context->buildPlan = plan;
+    int ret = SetAppVariableConfig(context, sandbox);
+    plan->appVarCount = plan->itemCount;
+    if (ret == 0) {
+        ret = SetSandboxSpawnFlagsConfig(context, sandbox);
+    }
+    if (ret == 0) {
+        ret = SetSandboxPackageNameConfig(context, sandbox);
+    }
+    if (ret == 0) {
+        ret = SetSandboxPermissionConfig(context, sandbox);
+    }
+    context->buildPlan = NULL;
+    return ret;
+}
+
 int MountSandboxConfigs(AppSpawnSandboxCfg *sandbox, const AppSpawningCtx *property, int nwebspawn)
 {
     APPSPAWN_CHECK_ONLY_EXPER(property != NULL, return -1);
@@ -1288,9 +1543,10 @@ int MountSandboxConfigs(AppSpawnSandboxCfg *sandbox, const AppSpawningCtx *prope
     int ret = InitSandboxContext(context, sandbox, property, nwebspawn);
     APPSPAWN_CHECK_ONLY_EXPER(ret == 0, DeleteSandboxContext(&context);
                                         return ret);
+    context->mountPlan = GetSpawnMountPlan(sandbox, property, context);
 
-    APPSPAWN_LOGV("Set sandbox config %{public}s sandboxNsFlags 0x%{public}x",
-        context->rootPath, context->sandboxNsFlags);
+    APPSPAWN_LOGV("Set sandbox config %{public}s sandboxNsFlags 0x%{public}x plan %{public}d",
+        context->rootPath, context->sandboxNsFlags, context->mountPlan != NULL);
     do {
         ret = StagedMountPreUnShare(context, sandbox);
         APPSPAWN_CHECK_ONLY_EXPER(ret == 0, break);
@@ -1307,6 +1563,7 @@ int MountSandboxConfigs(AppSpawnSandboxCfg *sandbox, const AppSpawningCtx *prope
 
         ret = SandboxRootFolderCreate(context, sandbox);
         APPSPAWN_CHECK_ONLY_EXPER(ret == 0, break);
+        (void)OpenSandboxDirCache(context);  // 失败时按绝对路径创建目录
 
         ret = StagedMountPostUnshare(context, sandbox);
         APPSPAWN_CHECK_ONLY_EXPER(ret == 0, break);
@@ -102,7 +102,7 @@ static int RemoveDebugPermissionConfig(const SandboxContext *context, const AppS
 static int ConvertUserIdPath(const AppSpawningCtx *property, char *debugRootPath, char *debugTmpRootPath)
 {
     int ret = 0;
-    char *userId = (char *)GetAppSpawnMsgExtInfo(property->message, MSG_EXT_NAME_USERID, NULL);
+    char *userId = (char *)GetAppSpawnMsgKnownExtInfo(property->message, EXT_TLV_ID_USERID, NULL);
     if (userId == NULL) {
         AppSpawnMsgDacInfo *dacInfo = (AppSpawnMsgDacInfo *)GetAppProperty(property, TLV_DAC_INFO);
         APPSPAWN_CHECK(dacInfo != NULL, return APPSPAWN_TLV_NONE, "No tlv %{public}d in msg", TLV_DAC_INFO);
@@ -394,7 +394,7 @@ APPSPAWN_STATIC int InstallDebugSandbox(AppSpawnMgr *content, AppSpawningCtx *pr
     }
 
     uint32_t size = 0;
-    char *provisionType = GetAppSpawnMsgExtInfo(property->message, MSG_EXT_NAME_PROVISION_TYPE, &size);
+    char *provisionType = GetAppSpawnMsgKnownExtInfo(property->message, EXT_TLV_ID_PROVISION_TYPE, &size);
     if (provisionType == NULL || size == 0 || strcmp(provisionType, "debug") != 0) {
         return 0;
     }
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "securec.h"
+#include "appspawn_manager.h"
+#include "appspawn_sandbox.h"
+#include "appspawn_utils.h"
+
+#define SANDBOX_DIR_CACHE_MAX 256
+#define SANDBOX_DIR_NAMES_LEN (16 * 1024)  // 16K, 单次孵化的挂载目录足够
+
+typedef struct {
+    uint32_t hash;
+    uint32_t len;
+    uint32_t offset;  // names中的偏移
+} SandboxDirEntry;
+
+struct TagSandboxDirCache {
+    int rootFd;  // O_PATH打开的沙盒根目录
+    uint32_t rootLen;
+    uint32_t count;
+    uint32_t used;
+    uint32_t hitCount;
+    uint32_t createCount;
+    SandboxDirEntry entries[SANDBOX_DIR_CACHE_MAX];
+    char names[SANDBOX_DIR_NAMES_LEN];  // 相对根目录的路径，不以'/'结尾
+};
+
+static uint32_t DirHash(const char *path, uint32_t len)
+{
+    uint32_t hash = APPSPAWN_FNV_OFFSET;
+    for (uint32_t i = 0; i < len; i++) {
+        hash ^= (uint8_t)path[i];
+        hash *= APPSPAWN_FNV_PRIME;
+    }
+    return hash;
+}
+
+static bool IsDirCached(const SandboxDirCache *cache, const char *path, uint32_t len)
+{
+    uint32_t hash = DirHash(path, len);
+    for (uint32_t i = 0; i < cache->count; i++) {
+        const SandboxDirEntry *entry = &cache->entries[i];
+        if (entry->hash == hash && entry->len == len && memcmp(cache->names + entry->offset, path, len) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void AddCachedDir(SandboxDirCache *cache, const char *path, uint32_t len)
+{
+    if (cache->count >= SANDBOX_DIR_CACHE_MAX || len > SANDBOX_DIR_NAMES_LEN - cache->used ||
+        IsDirCached(cache, path, len)) {
+        return;
+    }
+    if (memcpy_s(cache->names + cache->used, SANDBOX_DIR_NAMES_LEN - cache->used, path, len) != 0) {
+        return;
+    }
+    SandboxDirEntry *entry = &cache->entries[cache->count++];
+    entry->hash = DirHash(path, len);
+    entry->len = len;
+    entry->offset = cache->used;
+    cache->used += len;
+}
+
+// 返回相对根目录的路径，不在根目录下返回NULL，根目录本身返回""
+static const char *GetRelativePath(const SandboxContext *context, const char *path)
+{
+    const SandboxDirCache *cache = context->dirCache;
+    if (cache == NULL || cache->rootFd < 0 || path == NULL ||
+        strncmp(path, context->rootPath, cache->rootLen) != 0) {
+        return NULL;
+    }
+    const char *relative = path + cache->rootLen;
+    if (*relative != '\0' && *relative != '/') {
+        return NULL;
+    }
+    while (*relative == '/') {
+        relative++;
+    }
+    return relative;
+}
+
+int OpenSandboxDirCache(SandboxContext *context)
+{
+    APPSPAWN_CHECK(context != NULL && context->rootPath != NULL, return APPSPAWN_ARG_INVALID, "Invalid context");
+    CloseSandboxDirCache(context);
+    SandboxDirCache *cache = (SandboxDirCache *)calloc(1, sizeof(SandboxDirCache));
+    APPSPAWN_CHECK(cache != NULL, return APPSPAWN_SYSTEM_ERROR, "Failed to alloc dir cache");
+    // 根目录已在SandboxRootFolderCreate中挂载完成，之后打开才能看到新的挂载
+    cache->rootFd = open(context->rootPath, O_PATH | O_DIRECTORY | O_CLOEXEC);
+    if (cache->rootFd < 0) {
+        int err = errno;
+        APPSPAWN_LOGW("Failed to open sandbox root %{public}s errno: %{public}d", context->rootPath, err);
+        free(cache);
+        return err;
+    }
+    uint32_t rootLen = strlen(context->rootPath);
+    while (rootLen > 1 && context->rootPath[rootLen - 1] == '/') {
+        rootLen--;
+    }
+    cache->rootLen = rootLen;
+    context->dirCache = cache;
+    return 0;
+}
+
+void CloseSandboxDirCache(SandboxContext *context)
+{
+    if (context == NULL || context->dirCache == NULL) {
+        return;
+    }
+    SandboxDirCache *cache = context->dirCache;
+    APPSPAWN_LOGV("Sandbox dir cache %{public}s hit %{public}u create %{public}u dirs %{public}u",
+        context->rootPath, cache->hitCount, cache->createCount, cache->count);
+    if (cache->rootFd >= 0) {
+        close(cache->rootFd);
+    }
+    free(cache);
+    context->dirCache = NULL;
+}
+
+void ResetSandboxDirCache(const SandboxContext *context)
+{
+    if (context == NULL || context->dirCache == NULL) {
+        return;
+    }
+    context->dirCache->count = 0;
+    context->dirCache->used = 0;
+}
+
+void InvalidateSandboxDirCache(const SandboxContext *context, const char *path)
+{
+    const char *relative = GetRelativePath(context, path);
+    if (relative == NULL) {
+        return;
+    }
+    SandboxDirCache *cache = context->dirCache;
+    if (*relative == '\0') {
+        // 根目录被覆盖，fd指向的是原目录，不再使用
+        APPSPAWN_LOGW("Sandbox root %{public}s remounted, disable dir cache", context->rootPath);
+        close(cache->rootFd);
+        cache->rootFd = -1;
+        cache->count = 0;
+        return;
+    }
+    uint32_t len = strlen(relative);
+    while (len > 0 && relative[len - 1] == '/') {
+        len--;
+    }
+    uint32_t i = 0;
+    while (i < cache->count) {
+        const SandboxDirEntry *entry = &cache->entries[i];
+        if (entry->len > len && cache->names[entry->offset + len] == '/' &&
+            memcmp(cache->names + entry->offset, relative, len) == 0) {
+            cache->entries[i] = cache->entries[--cache->count];  // names空间不回收
+            continue;
+        }
+        i++;
+    }
+}
+
+// path可以修改，len之后的内容保持不变
+static int MakeSandboxDirAt(SandboxDirCache *cache, char *path, uint32_t len)
+{
+    if (len == 0 || IsDirCached(cache, path, len)) {
+        cache->hitCount++;
+        return 0;
+    }
+    char last = path[len];
+    path[len] = '\0';
+    if (faccessat(cache->rootFd, path, F_OK, 0) == 0) {
+        path[len] = last;
+        AddCachedDir(cache, path, len);
+        return 0;
+    }
+
+    // 从已知存在的最长前缀开始逐级创建
+    uint32_t start = len;
+    while (start > 0) {
+        if (path[start - 1] == '/' && IsDirCached(cache, path, start - 1)) {
+            break;
+        }
+        start--;
+    }
+    int ret = 0;
+    for (uint32_t end = start; end <= len; end++) {
+        if (end < len && path[end] != '/') {
+            continue;
+        }
+        if (end == start) {  // 连续的'/'
+            start++;
+            continue;
+        }
+        char ch = path[end];
+        path[end] = '\0';
+        ret = mkdirat(cache->rootFd, path, FILE_MODE);
+        ret = (ret == -1 && errno != EEXIST) ? errno : 0;
+        cache->createCount++;
+        path[end] = ch;
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, break);
+        AddCachedDir(cache, path, end);
+        start = end + 1;
+    }
+    path[len] = last;
+    return ret;
+}
+
+static int CreateSandboxFileAt(SandboxDirCache *cache, char *path, uint32_t len)
+{
+    if (faccessat(cache->rootFd, path, F_OK, 0) == 0) {
+        APPSPAWN_LOGV("file %{public}s already exist", path);
+        return 0;
+    }
+    uint32_t dirLen = len;
+    while (dirLen > 0 && path[dirLen - 1] != '/') {
+        dirLen--;
+    }
+    while (dirLen > 0 && path[dirLen - 1] == '/') {
+        dirLen--;
+    }
+    (void)MakeSandboxDirAt(cache, path, dirLen);
+    int fd = openat(cache->rootFd, path, O_CREAT | O_CLOEXEC, FILE_MODE);
+    cache->createCount++;
+    if (fd < 0) {
+        APPSPAWN_LOGW("failed create %{public}s, err=%{public}d", path, errno);
+        return errno;
+    }
+    close(fd);
+    return 0;
+}
+
+bool CreateSandboxTargetPath(const SandboxContext *context, const char *path, bool isFile)
+{
+    const char *relative = GetRelativePath(context, path);
+    if (relative == NULL || (isFile && *relative == '\0')) {
+        return false;
+    }
+    char buffer[PATH_MAX] = {0};
+    APPSPAWN_CHECK(strcpy_s(buffer, sizeof(buffer), relative) == 0, return false,
+        "Path too long %{public}s", path);
+    uint32_t len = strlen(buffer);
+    while (len > 0 && buffer[len - 1] == '/') {
+        buffer[--len] = '\0';
+    }
+    int ret = isFile ? CreateSandboxFileAt(context->dirCache, buffer, len) :
+        MakeSandboxDirAt(context->dirCache, buffer, len);
+    APPSPAWN_CHECK_ONLY_LOG(ret == 0, "Failed to create %{public}s errno: %{public}d", path, ret);
+    return true;
+}
@@ -275,6 +275,8 @@ static PathMountNode *DecodeMountPathConfig(const SandboxSection *section, const
     sandboxNode->createDemand = demandInfo != NULL;
     sandboxNode->source = strdup(srcPath);
     sandboxNode->target = strdup(dstPath);
+    sandboxNode->sourceTpl = CompileSandboxPathTemplate(srcPath);
+    sandboxNode->targetTpl = CompileSandboxPathTemplate(dstPath);
 
     sandboxNode->destMode = GetChmodFromJson(config);
     sandboxNode->mountSharedFlag = GetBoolValueFromJsonObj(config, "mount-shared-flag", false);
@@ -576,6 +578,17 @@ static int AddSpawnerPermissionNode(AppSpawnSandboxCfg *sandbox)
     return 0;
 }
 
+static bool IsLiteralPathTemplate(const SandboxPathTemplate *tpl)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(tpl != NULL, return false);
+    for (uint32_t i = 0; i < tpl->tokenCount; i++) {
+        if (tpl->tokens[i].type != SANDBOX_PATH_TOKEN_LITERAL) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static SandboxNameGroupNode *ParseNameGroup(AppSpawnSandboxCfg *sandbox, const cJSON *groupConfig)
 {
     char *name = GetStringFromJsonObj(groupConfig, "name");
@@ -599,6 +612,8 @@ static SandboxNameGroupNode *ParseNameGroup(AppSpawnSandboxCfg *sandbox, const c
         }
         // "deps-mode": "not-exists"
         node->depMode = GetMountModeFromConfig(groupConfig, "deps-mode", MOUNT_MODE_ALWAYS);
+        node->depStatic = IsLiteralPathTemplate(node->depNode->sourceTpl) &&
+            IsLiteralPathTemplate(node->depNode->targetTpl);
     }
 
     int ret = ParseBaseConfig(sandbox, &node->section, groupConfig);
@@ -609,7 +624,6 @@ static SandboxNameGroupNode *ParseNameGroup(AppSpawnSandboxCfg *sandbox, const c
     // "type": "system-const",
     // "caps": ["shared"],
     node->destType = GetNameGroupTypeFromConfig(groupConfig, "type", SANDBOX_TAG_INVALID);
-    node->depMounted = 0;
     // success, insert section
     AddSandboxSection(&node->section, &sandbox->nameGroupsQueue);
     return node;
@@ -785,13 +799,20 @@ int LoadAppSandboxConfig(AppSpawnSandboxCfg *sandbox, ExtDataType type)
     APPSPAWN_LOGI("Sandbox pidNamespaceSupport: %{public}d appFullMountEnable: %{public}d",
         sandbox->pidNamespaceSupport, sandbox->appFullMountEnable);
 
-    uint32_t depNodeCount = sandbox->depNodeCount;
+    // 每个配置文件解析时depNodeCount都会重新计数，这里按合并后的name group重新统计
+    uint32_t depNodeCount = 0;
+    ListNode *node = sandbox->nameGroupsQueue.front.next;
+    while (node != &sandbox->nameGroupsQueue.front) {
+        SandboxNameGroupNode *groupNode = (SandboxNameGroupNode *)ListEntry(node, SandboxMountNode, node);
+        depNodeCount += (groupNode->depNode != NULL) ? 1 : 0;
+        node = node->next;
+    }
+    sandbox->depNodeCount = 0;
     APPSPAWN_CHECK_ONLY_EXPER(depNodeCount > 0, return 0);
 
     sandbox->depGroupNodes = (SandboxNameGroupNode **)calloc(1, sizeof(SandboxNameGroupNode *) * depNodeCount);
     APPSPAWN_CHECK(sandbox->depGroupNodes != NULL, return APPSPAWN_SYSTEM_ERROR, "Failed alloc memory ");
-    sandbox->depNodeCount = 0;
-    ListNode *node = sandbox->nameGroupsQueue.front.next;
+    node = sandbox->nameGroupsQueue.front.next;
     while (node != &sandbox->nameGroupsQueue.front) {
         SandboxNameGroupNode *groupNode = (SandboxNameGroupNode *)ListEntry(node, SandboxMountNode, node);
         if (groupNode->depNode) {
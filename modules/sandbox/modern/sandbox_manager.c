@@ -41,6 +41,14 @@ static void FreePathMountNode(SandboxMountNode *node)
         free(sandboxNode->appAplName);
         sandboxNode->appAplName = NULL;
     }
+    if (sandboxNode->sourceTpl) {
+        free(sandboxNode->sourceTpl);
+        sandboxNode->sourceTpl = NULL;
+    }
+    if (sandboxNode->targetTpl) {
+        free(sandboxNode->targetTpl);
+        sandboxNode->targetTpl = NULL;
+    }
     for (uint32_t i = 0; i < sandboxNode->decPolicyPaths.decPathCount; i++) {
         if (sandboxNode->decPolicyPaths.decPath[i] != NULL) {
             free(sandboxNode->decPolicyPaths.decPath[i]);
@@ -370,6 +378,136 @@ AppSpawnSandboxCfg *GetAppSpawnSandbox(const AppSpawnMgr *content, ExtDataType t
     return (AppSpawnSandboxCfg *)ListEntry(node, AppSpawnSandboxCfg, extData);
 }
 
+// flagIndex为0表示未配置flags，不参与分发
+static uint32_t GetSectionIndex(const SandboxSection *section)
+{
+    if (GetSectionType(section) == SANDBOX_TAG_PERMISSION) {
+        const SandboxPermissionNode *node = (const SandboxPermissionNode *)section;
+        return node->permissionIndex >= 0 ? (uint32_t)node->permissionIndex : UINT32_MAX;
+    }
+    const SandboxFlagsNode *node = (const SandboxFlagsNode *)section;
+    return node->flagIndex != 0 ? node->flagIndex : UINT32_MAX;
+}
+
+static void ClearSandboxSectionTable(SandboxSectionTable *table)
+{
+    free(table->start);
+    free(table->sections);
+    table->start = NULL;
+    table->sections = NULL;
+    table->indexCount = 0;
+}
+
+static int BuildSandboxSectionTable(SandboxSectionTable *table, const SandboxQueue *queue)
+{
+    ClearSandboxSectionTable(table);
+    uint32_t count = 0;
+    uint32_t indexCount = 0;
+    ListNode *node = queue->front.next;
+    for (; node != &queue->front; node = node->next) {
+        uint32_t index = GetSectionIndex((SandboxSection *)ListEntry(node, SandboxMountNode, node));
+        if (index != UINT32_MAX) {
+            count++;
+            indexCount = index >= indexCount ? index + 1 : indexCount;
+        }
+    }
+    table->start = (uint32_t *)calloc(indexCount + 1, sizeof(uint32_t));
+    table->sections = (SandboxSection **)calloc(count + 1, sizeof(SandboxSection *));
+    APPSPAWN_CHECK(table->start != NULL && table->sections != NULL, ClearSandboxSectionTable(table);
+        return APPSPAWN_SYSTEM_ERROR, "Failed to alloc section table");
+
+    // 计数排序，同一索引内保持队列顺序
+    for (node = queue->front.next; node != &queue->front; node = node->next) {
+        uint32_t index = GetSectionIndex((SandboxSection *)ListEntry(node, SandboxMountNode, node));
+        if (index != UINT32_MAX) {
+            table->start[index + 1]++;
+        }
+    }
+    for (uint32_t i = 0; i < indexCount; i++) {
+        table->start[i + 1] += table->start[i];
+    }
+    for (node = queue->front.next; node != &queue->front; node = node->next) {
+        SandboxSection *section = (SandboxSection *)ListEntry(node, SandboxMountNode, node);
+        uint32_t index = GetSectionIndex(section);
+        if (index == UINT32_MAX) {
+            continue;
+        }
+        uint32_t pos = table->start[index];
+        while (table->sections[pos] != NULL) {
+            pos++;
+        }
+        table->sections[pos] = section;
+    }
+    table->indexCount = indexCount;
+    return 0;
+}
+
+int BuildSandboxSectionTables(AppSpawnSandboxCfg *sandbox)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(sandbox != NULL, return APPSPAWN_ARG_INVALID);
+    int ret = BuildSandboxSectionTable(&sandbox->permissionTable, &sandbox->permissionQueue);
+    if (ret == 0) {
+        ret = BuildSandboxSectionTable(&sandbox->spawnFlagsTable, &sandbox->spawnFlagsQueue);
+    }
+    if (ret != 0) {
+        ClearSandboxSectionTables(sandbox);
+        return ret;
+    }
+    APPSPAWN_LOGV("Sandbox section table permission %{public}u flags %{public}u",
+        sandbox->permissionTable.indexCount, sandbox->spawnFlagsTable.indexCount);
+    return 0;
+}
+
+void ClearSandboxSectionTables(AppSpawnSandboxCfg *sandbox)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(sandbox != NULL, return);
+    ClearSandboxSectionTable(&sandbox->permissionTable);
+    ClearSandboxSectionTable(&sandbox->spawnFlagsTable);
+}
+
+static int ForEachSandboxSectionInQueue(const SandboxQueue *queue, const AppSpawnMsgFlags *msgFlags,
+    SandboxSectionHandler handler, void *data)
+{
+    ListNode *node = queue->front.next;
+    for (; node != &queue->front; node = node->next) {
+        SandboxSection *section = (SandboxSection *)ListEntry(node, SandboxMountNode, node);
+        uint32_t index = GetSectionIndex(section);
+        if (index == UINT32_MAX || !CheckAppSpawnMsgFlagsSet(msgFlags, index)) {
+            continue;
+        }
+        int ret = handler(section, data);
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    }
+    return 0;
+}
+
+int ForEachSandboxSectionSet(const AppSpawnSandboxCfg *sandbox, const AppSpawnMsgNode *message,
+    uint32_t type, SandboxSectionHandler handler, void *data)
+{
+    APPSPAWN_CHECK(sandbox != NULL && handler != NULL && (type == TLV_PERMISSION || type == TLV_MSG_FLAGS),
+        return APPSPAWN_ARG_INVALID, "Invalid args");
+    APPSPAWN_CHECK_ONLY_EXPER(message != NULL, return 0);
+    // 只定位一次TLV，之后按字遍历置位
+    const AppSpawnMsgFlags *msgFlags = (const AppSpawnMsgFlags *)GetAppSpawnMsgInfo(message, type);
+    if (msgFlags == NULL || msgFlags->count == 0) {
+        return 0;
+    }
+    const SandboxSectionTable *table = type == TLV_PERMISSION ? &sandbox->permissionTable : &sandbox->spawnFlagsTable;
+    if (table->start == NULL) {
+        const SandboxQueue *queue = type == TLV_PERMISSION ? &sandbox->permissionQueue : &sandbox->spawnFlagsQueue;
+        return ForEachSandboxSectionInQueue(queue, msgFlags, handler, data);
+    }
+    uint32_t limit = table->indexCount;
+    for (uint32_t index = GetNextMsgFlagIndex(msgFlags, 0, limit); index < limit;
+        index = GetNextMsgFlagIndex(msgFlags, index + 1, limit)) {
+        for (uint32_t i = table->start[index]; i < table->start[index + 1]; i++) {
+            int ret = handler(table->sections[i], data);
+            APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+        }
+    }
+    return 0;
+}
+
 void DeleteAppSpawnSandbox(AppSpawnSandboxCfg *sandbox)
 {
     APPSPAWN_CHECK_ONLY_EXPER(sandbox != NULL, return);
@@ -377,6 +515,8 @@ void DeleteAppSpawnSandbox(AppSpawnSandboxCfg *sandbox)
     OH_ListRemove(&sandbox->extData.node);
     OH_ListInit(&sandbox->extData.node);
 
+    ClearSandboxMountPlans(sandbox);
+    ClearSandboxSectionTables(sandbox);
     // delete all queue
     SandboxQueueClear(&sandbox->requiredQueue);
     SandboxQueueClear(&sandbox->permissionQueue);
@@ -461,6 +601,9 @@ AppSpawnSandboxCfg *CreateAppSpawnSandbox(ExtDataType type)
     InitSandboxQueue(&sandbox->packageNameQueue, SANDBOX_TAG_PACKAGE_NAME);
     InitSandboxQueue(&sandbox->spawnFlagsQueue, SANDBOX_TAG_SPAWN_FLAGS);
     InitSandboxQueue(&sandbox->nameGroupsQueue, SANDBOX_TAG_NAME_GROUP);
+    OH_ListInit(&sandbox->mountPlans);
+    sandbox->mountPlanCount = 0;
+    sandbox->spawnPlan = NULL;
 
     sandbox->topSandboxSwitch = 0;
     sandbox->appFullMountEnable = 0;
@@ -484,6 +627,7 @@ void DumpAppSpawnSandboxCfg(AppSpawnSandboxCfg *sandbox)
     APPSPAWN_DUMP("Sandbox topSandboxSwitch: %{public}s", sandbox->topSandboxSwitch ? "true" : "false");
     APPSPAWN_DUMP("Sandbox appFullMountEnable: %{public}s", sandbox->appFullMountEnable ? "true" : "false");
     APPSPAWN_DUMP("Sandbox pidNamespaceSupport: %{public}s", sandbox->pidNamespaceSupport ? "true" : "false");
+    APPSPAWN_DUMP("Sandbox mount plan count: %{public}u", sandbox->mountPlanCount);
     APPSPAWN_DUMP("Sandbox common info: ");
     DumpSandboxQueue(&sandbox->requiredQueue.front, DumpSandboxSectionNode);
     DumpSandboxQueue(&sandbox->packageNameQueue.front, DumpSandboxSectionNode);
@@ -508,6 +652,8 @@ static int PreLoadSandboxCfgByType(AppSpawnMgr *content, ExtDataType type)
     // load sandbox config by type
     LoadAppSandboxConfig(sandbox, type);
     sandbox->maxPermissionIndex = PermissionRenumber(&sandbox->permissionQueue);
+    int ret = BuildSandboxSectionTables(sandbox);
+    APPSPAWN_CHECK_ONLY_LOG(ret == 0, "Failed to build section tables, dispatch by queue");
 
     content->content.sandboxNsFlags = 0;
     if (IsNWebSpawnMode(content) || sandbox->pidNamespaceSupport) {
@@ -565,7 +711,7 @@ APPSPAWN_STATIC int IsolatedSandboxHandleServerExit(AppSpawnMgr *content)
 {
     AppSpawnSandboxCfg *sandbox = GetAppSpawnSandbox(content, EXT_DATA_ISOLATED_SANDBOX);
     APPSPAWN_CHECK(sandbox != NULL, return 0, "Isolated sandbox not load");
-
+    ClearSandboxMountPlans(sandbox);
     return 0;
 }
 
@@ -573,7 +719,33 @@ APPSPAWN_STATIC int SandboxHandleServerExit(AppSpawnMgr *content)
 {
     AppSpawnSandboxCfg *sandbox = GetAppSpawnSandbox(content, EXT_DATA_APP_SANDBOX);
     APPSPAWN_CHECK(sandbox != NULL, return 0, "Sandbox not load");
+    ClearSandboxMountPlans(sandbox);
+    return 0;
+}
 
+static void ClearAllSandboxMountPlans(AppSpawnMgr *content)
+{
+    const ExtDataType types[] = {
+        EXT_DATA_APP_SANDBOX, EXT_DATA_ISOLATED_SANDBOX, EXT_DATA_RENDER_SANDBOX, EXT_DATA_GPU_SANDBOX
+    };
+    for (size_t i = 0; i < ARRAY_LENGTH(types); i++) {
+        ClearSandboxMountPlans(GetAppSpawnSandbox(content, types[i]));
+    }
+}
+
+// 解锁后el2等目录挂载状态变化，已解析计划中的source检查结果不再可信
+APPSPAWN_STATIC int SandboxMountPlanHandleLock(AppSpawnMgr *content)
+{
+    APPSPAWN_LOGI("Clear sandbox mount plans for lock status change");
+    ClearAllSandboxMountPlans(content);
+    return 0;
+}
+
+// 卸载调试应用后其目录被删除，按应用缓存的计划全部失效
+APPSPAWN_STATIC int SandboxMountPlanHandleUninstall(AppSpawnMgr *content, AppSpawningCtx *property)
+{
+    APPSPAWN_LOGI("Clear sandbox mount plans for uninstall %{public}s", GetProcessName(property));
+    ClearAllSandboxMountPlans(content);
     return 0;
 }
 
@@ -581,7 +753,7 @@ static ExtDataType GetSandboxType(AppSpawnMgr *content, AppSpawningCtx *property
 {
     ExtDataType type = EXT_DATA_APP_SANDBOX;
     if (IsNWebSpawnMode(content)) {
-        char *processType = (char *)GetAppPropertyExt(property, MSG_EXT_NAME_PROCESS_TYPE, NULL);
+        char *processType = (char *)GetAppPropertyKnownExt(property, EXT_TLV_ID_PROCESS_TYPE, NULL);
         APPSPAWN_CHECK(processType != NULL, return type, "Invalid processType data");
         if (strcmp(processType, "render") == 0) {
             type = EXT_DATA_RENDER_SANDBOX;
@@ -626,7 +798,9 @@ static int SpawnBuildSandboxEnv(AppSpawnMgr *content, AppSpawningCtx *property)
             return ret;
         }
     }
+    SetSandboxMountStat(&property->childTiming.sandbox);
     int ret = MountSandboxConfigs(appSandbox, property, IsNWebSpawnMode(content));
+    SetSandboxMountStat(NULL);
     appSandbox->mounted = 1;
     // for module test do not create sandbox, use APP_FLAGS_IGNORE_SANDBOX to ignore sandbox result
     if (CheckAppMsgFlagsSet(property, APP_FLAGS_IGNORE_SANDBOX)) {
@@ -636,6 +810,38 @@ static int SpawnBuildSandboxEnv(AppSpawnMgr *content, AppSpawningCtx *property)
     return ret == 0 ? 0 : APPSPAWN_SANDBOX_MOUNT_FAIL;
 }
 
+typedef struct {
+    const AppSpawningCtx *property;
+    AppSpawnMsgDacInfo *dacInfo;
+} PermissionGidData;
+
+static int AppendSectionGid(SandboxSection *section, void *data)
+{
+    const AppSpawningCtx *property = ((PermissionGidData *)data)->property;
+    AppSpawnMsgDacInfo *dacInfo = ((PermissionGidData *)data)->dacInfo;
+    if (section->gidCount == 0) {
+        return 0;
+    }
+    APPSPAWN_LOGV("Add permission %{public}s gid %{public}d to %{public}s",
+        section->name, section->gidTable[0], GetProcessName(property));
+
+    size_t copyLen = section->gidCount;
+    if ((section->gidCount + dacInfo->gidCount) > APP_MAX_GIDS) {
+        APPSPAWN_LOGW("More gid for %{public}s msg count %{public}u permission %{public}u",
+            GetProcessName(property), dacInfo->gidCount, section->gidCount);
+        copyLen = APP_MAX_GIDS - dacInfo->gidCount;
+    }
+    int ret = memcpy_s(&dacInfo->gidTable[dacInfo->gidCount], sizeof(gid_t) * copyLen,
+        section->gidTable, sizeof(gid_t) * copyLen);
+    if (ret != EOK) {
+        APPSPAWN_LOGW("Failed to append permission %{public}s gid to %{public}s",
+            section->name, GetProcessName(property));
+        return 0;
+    }
+    dacInfo->gidCount += copyLen;
+    return 0;
+}
+
 static int AppendPermissionGid(const AppSpawnSandboxCfg *sandbox, AppSpawningCtx *property)
 {
     AppSpawnMsgDacInfo *dacInfo = (AppSpawnMsgDacInfo *)GetAppProperty(property, TLV_DAC_INFO);
@@ -643,37 +849,8 @@ static int AppendPermissionGid(const AppSpawnSandboxCfg *sandbox, AppSpawningCtx
         "No tlv %{public}d in msg %{public}s", TLV_DAC_INFO, GetProcessName(property));
 
     APPSPAWN_LOGV("AppendPermissionGid %{public}s", GetProcessName(property));
-    ListNode *node = sandbox->permissionQueue.front.next;
-    while (node != &sandbox->permissionQueue.front) {
-        SandboxPermissionNode *permissionNode = (SandboxPermissionNode *)ListEntry(node, SandboxMountNode, node);
-        if (!CheckAppPermissionFlagSet(property, (uint32_t)permissionNode->permissionIndex)) {
-            node = node->next;
-            continue;
-        }
-        if (permissionNode->section.gidCount == 0) {
-            node = node->next;
-            continue;
-        }
-        APPSPAWN_LOGV("Add permission %{public}s gid %{public}d to %{public}s",
-            permissionNode->section.name, permissionNode->section.gidTable[0], GetProcessName(property));
-
-        size_t copyLen = permissionNode->section.gidCount;
-        if ((permissionNode->section.gidCount + dacInfo->gidCount) > APP_MAX_GIDS) {
-            APPSPAWN_LOGW("More gid for %{public}s msg count %{public}u permission %{public}u",
-                GetProcessName(property), dacInfo->gidCount, permissionNode->section.gidCount);
-            copyLen = APP_MAX_GIDS - dacInfo->gidCount;
-        }
-        int ret = memcpy_s(&dacInfo->gidTable[dacInfo->gidCount], sizeof(gid_t) * copyLen,
-            permissionNode->section.gidTable, sizeof(gid_t) * copyLen);
-        if (ret != EOK) {
-            APPSPAWN_LOGW("Failed to append permission %{public}s gid to %{public}s",
-                permissionNode->section.name, GetProcessName(property));
-            node = node->next;
-            continue;
-        }
-        dacInfo->gidCount += copyLen;
-        node = node->next;
-    }
+    PermissionGidData data = {property, dacInfo};
+    (void)ForEachSandboxSectionSet(sandbox, property->message, TLV_PERMISSION, AppendSectionGid, &data);
     return 0;
 }
 
@@ -788,6 +965,8 @@ int SpawnPrepareSandboxCfg(AppSpawnMgr *content, AppSpawningCtx *property)
     APPSPAWN_CHECK(ret == 0, return ret, "Failed to add gid for %{public}s", GetProcessName(property));
     ret = StagedMountSystemConst(sandbox, property, IsNWebSpawnMode(content));
     APPSPAWN_CHECK(ret == 0, return ret, "Failed to mount system-const for %{public}s", GetProcessName(property));
+    // 计划只减少子进程的解析开销，生成失败时子进程按配置实时挂载
+    PrepareSandboxMountPlan(sandbox, property, IsNWebSpawnMode(content));
     return 0;
 }
 
@@ -821,6 +1000,8 @@ MODULE_CONSTRUCTOR(void)
     (void)AddServerStageHook(STAGE_SERVER_PRELOAD, HOOK_PRIO_SANDBOX, PreLoadDebugSandboxCfg);
     (void)AddServerStageHook(STAGE_SERVER_EXIT, HOOK_PRIO_SANDBOX, SandboxHandleServerExit);
     (void)AddServerStageHook(STAGE_SERVER_EXIT, HOOK_PRIO_SANDBOX, IsolatedSandboxHandleServerExit);
+    (void)AddServerStageHook(STAGE_SERVER_LOCK, HOOK_PRIO_SANDBOX, SandboxMountPlanHandleLock);
+    (void)AddAppSpawnHook(STAGE_PARENT_UNINSTALL, HOOK_PRIO_SANDBOX, SandboxMountPlanHandleUninstall);
     (void)AddAppSpawnHook(STAGE_PARENT_PRE_FORK, HOOK_PRIO_SANDBOX, SpawnPrepareSandboxCfg);
     (void)AddAppSpawnHook(STAGE_PARENT_PRE_FORK, HOOK_PRIO_SANDBOX, SpawnMountDirToShared);
     (void)AddAppSpawnHook(STAGE_CHILD_EXECUTE, HOOK_PRIO_SANDBOX, SpawnBuildSandboxEnv);
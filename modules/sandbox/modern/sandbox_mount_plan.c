@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "securec.h"
+#include "appspawn_manager.h"
+#include "appspawn_msg.h"
+#include "appspawn_sandbox.h"
+#include "appspawn_utils.h"
+#include "sandbox_shared.h"
+
+#define PLAN_ITEM_INIT_CAPACITY 16
+
+static int AppendPlanKey(SandboxBuffer *key, const void *data, uint32_t len)
+{
+    APPSPAWN_CHECK(len <= key->bufferLen - key->current, return APPSPAWN_ERROR_UTILS_MEM_FAIL,
+        "Mount plan key too long %{public}u", key->current + len);
+    if (len > 0) {
+        int ret = memcpy_s(key->buffer + key->current, key->bufferLen - key->current, data, len);
+        APPSPAWN_CHECK(ret == 0, return APPSPAWN_ERROR_UTILS_MEM_FAIL, "Failed to copy mount plan key");
+    }
+    key->current += len;
+    return 0;
+}
+
+static int AppendPlanKeyFlags(SandboxBuffer *key, const SandboxContext *context, uint32_t type)
+{
+    AppSpawnMsgFlags *msgFlags = (AppSpawnMsgFlags *)GetSandboxCtxMsgInfo(context, type);
+    uint32_t count = (msgFlags != NULL) ? msgFlags->count : 0;
+    int ret = AppendPlanKey(key, &count, sizeof(count));
+    APPSPAWN_CHECK_ONLY_EXPER(ret == 0 && count > 0, return ret);
+    return AppendPlanKey(key, msgFlags->flags, count * sizeof(uint32_t));
+}
+
+static int AppendPlanKeyExtInfo(SandboxBuffer *key, const SandboxContext *context, AppSpawnExtTlvId id)
+{
+    uint32_t len = 0;
+    const void *data = GetAppSpawnMsgKnownExtInfo(context->message, id, &len);
+    len = (data != NULL) ? len : 0;
+    int ret = AppendPlanKey(key, &len, sizeof(len));
+    APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    return AppendPlanKey(key, data, len);
+}
+
+static int AppendPlanKeyApl(SandboxBuffer *key, const SandboxContext *context)
+{
+    AppSpawnMsgDomainInfo *msgDomainInfo = (AppSpawnMsgDomainInfo *)GetSandboxCtxMsgInfo(context, TLV_DOMAIN_INFO);
+    const char *apl = (msgDomainInfo != NULL) ? msgDomainInfo->apl : "";
+    return AppendPlanKey(key, apl, strlen(apl) + 1);
+}
+
+/**
+ * 计划key包含路径解析依赖的全部消息内容：
+ *   uid、分身索引、bundle名、apl、消息flags和权限位，
+ *   以及<variablePackageName>、<hostUserId>用到的扩展tlv
+ * 沙盒类型由计划所在的沙盒配置区分
+ */
+static int BuildSandboxMountPlanKey(const SandboxContext *context, SandboxBuffer *key)
+{
+    AppSpawnMsgDacInfo *dacInfo = (AppSpawnMsgDacInfo *)GetSandboxCtxMsgInfo(context, TLV_DAC_INFO);
+    APPSPAWN_CHECK(dacInfo != NULL, return APPSPAWN_TLV_NONE,
+        "No tlv %{public}d in msg %{public}s", TLV_DAC_INFO, context->bundleName);
+    AppSpawnMsgBundleInfo *bundleInfo = (AppSpawnMsgBundleInfo *)GetSandboxCtxMsgInfo(context, TLV_BUNDLE_INFO);
+    uint32_t values[] = {
+        (uint32_t)dacInfo->uid, (bundleInfo != NULL) ? bundleInfo->bundleIndex : 0, context->nwebspawn
+    };
+
+    key->current = 0;
+    int ret = AppendPlanKey(key, values, sizeof(values));
+    APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    ret = AppendPlanKey(key, context->bundleName, strlen(context->bundleName) + 1);
+    APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    ret = AppendPlanKeyApl(key, context);  // app-apl-name按apl排除节点
+    APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    ret = AppendPlanKeyFlags(key, context, TLV_MSG_FLAGS);
+    APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    ret = AppendPlanKeyFlags(key, context, TLV_PERMISSION);
+    APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    ret = AppendPlanKeyExtInfo(key, context, EXT_TLV_ID_APP_EXTENSION);
+    APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    ret = AppendPlanKeyExtInfo(key, context, EXT_TLV_ID_ACCOUNT_ID);
+    APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    return AppendPlanKeyExtInfo(key, context, EXT_TLV_ID_PARENT_UID);
+}
+
+static uint32_t GetPlanKeyHash(const SandboxBuffer *key)
+{
+    uint32_t hash = APPSPAWN_FNV_OFFSET;
+    for (uint32_t i = 0; i < key->current; i++) {
+        hash = (hash ^ (uint8_t)key->buffer[i]) * APPSPAWN_FNV_PRIME;
+    }
+    return hash;
+}
+
+static bool IsPlanKeyMatch(const SandboxMountPlan *plan, const SandboxBuffer *key, uint32_t hash)
+{
+    return plan->keyHash == hash && plan->keyLen == key->current && memcmp(plan->key, key->buffer, key->current) == 0;
+}
+
+static void FreeSandboxMountPlan(SandboxMountPlan *plan)
+{
+    for (uint32_t i = 0; i < plan->itemCount; i++) {
+        free(plan->items[i].source);
+        free(plan->items[i].target);
+    }
+    free(plan->items);
+    free(plan->key);
+    free(plan);
+}
+
+static SandboxMountPlan *CreateSandboxMountPlan(const SandboxBuffer *key, uint32_t hash)
+{
+    SandboxMountPlan *plan = (SandboxMountPlan *)calloc(1, sizeof(SandboxMountPlan));
+    APPSPAWN_CHECK(plan != NULL, return NULL, "Failed to alloc mount plan");
+    OH_ListInit(&plan->node);
+    plan->key = (uint8_t *)malloc(key->current);
+    APPSPAWN_CHECK(plan->key != NULL, free(plan);
+        return NULL, "Failed to alloc mount plan key");
+    (void)memcpy_s(plan->key, key->current, key->buffer, key->current);
+    plan->keyLen = key->current;
+    plan->keyHash = hash;
+    return plan;
+}
+
+int AddSandboxMountPlanItem(SandboxMountPlan *plan, const SandboxMountPlanItem *item)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(plan != NULL && item != NULL, return APPSPAWN_ARG_INVALID);
+    if (plan->itemCount >= plan->capacity) {
+        uint32_t capacity = (plan->capacity == 0) ? PLAN_ITEM_INIT_CAPACITY : plan->capacity * 2;  // 2 double
+        SandboxMountPlanItem *items =
+            (SandboxMountPlanItem *)realloc(plan->items, capacity * sizeof(SandboxMountPlanItem));
+        APPSPAWN_CHECK(items != NULL, return APPSPAWN_SYSTEM_ERROR, "Failed to alloc mount plan items");
+        plan->items = items;
+        plan->capacity = capacity;
+    }
+
+    SandboxMountPlanItem *planItem = &plan->items[plan->itemCount];
+    *planItem = *item;
+    planItem->source = NULL;
+    planItem->target = NULL;
+    if (item->type == SANDBOX_PLAN_ITEM_MOUNT) {
+        planItem->source = strdup(item->source);
+        planItem->target = strdup(item->target);
+        if (planItem->source == NULL || planItem->target == NULL) {
+            free(planItem->source);
+            free(planItem->target);
+            APPSPAWN_LOGE("Failed to copy mount plan path %{public}s", item->section->name);
+            return APPSPAWN_SYSTEM_ERROR;
+        }
+    }
+    plan->itemCount++;
+    return 0;
+}
+
+static SandboxMountPlan *GetSandboxMountPlan(AppSpawnSandboxCfg *sandbox, SandboxContext *context)
+{
+    SandboxBuffer *key = &context->buffer[BUFFER_FOR_TMP];
+    int ret = BuildSandboxMountPlanKey(context, key);
+    APPSPAWN_CHECK(ret == 0, return NULL, "Failed to build mount plan key %{public}s", context->bundleName);
+    uint32_t hash = GetPlanKeyHash(key);
+    AppSpawnMsgDacInfo *dacInfo = (AppSpawnMsgDacInfo *)GetSandboxCtxMsgInfo(context, TLV_DAC_INFO);
+    bool unlocked = IsUnlockStatus(dacInfo->uid);
+
+    ListNode *node = sandbox->mountPlans.next;
+    while (node != &sandbox->mountPlans) {
+        SandboxMountPlan *plan = ListEntry(node, SandboxMountPlan, node);
+        if (!IsPlanKeyMatch(plan, key, hash)) {
+            node = node->next;
+            continue;
+        }
+        OH_ListRemove(&plan->node);
+        if (plan->unlocked != unlocked) {
+            APPSPAWN_LOGI("Lock status changed, rebuild mount plan %{public}s", context->bundleName);
+            FreeSandboxMountPlan(plan);
+            sandbox->mountPlanCount--;
+            break;
+        }
+        // 移到表头，表尾为最久未使用
+        OH_ListAddTail(sandbox->mountPlans.next, &plan->node);
+        return plan;
+    }
+
+    SandboxMountPlan *plan = CreateSandboxMountPlan(key, hash);
+    APPSPAWN_CHECK_ONLY_EXPER(plan != NULL, return NULL);
+    plan->unlocked = unlocked;
+    ret = BuildSandboxMountPlan(context, sandbox, plan);
+    APPSPAWN_CHECK(ret == 0, FreeSandboxMountPlan(plan);
+        return NULL, "Failed to build mount plan %{public}s result: %{public}d", context->bundleName, ret);
+
+    if (sandbox->mountPlanCount >= SANDBOX_MOUNT_PLAN_MAX) {
+        SandboxMountPlan *last = ListEntry(sandbox->mountPlans.prev, SandboxMountPlan, node);
+        OH_ListRemove(&last->node);
+        FreeSandboxMountPlan(last);
+        sandbox->mountPlanCount--;
+    }
+    OH_ListAddTail(sandbox->mountPlans.next, &plan->node);
+    sandbox->mountPlanCount++;
+    APPSPAWN_LOGV("Create mount plan for %{public}s items %{public}u app-variable %{public}u",
+        context->bundleName, plan->itemCount, plan->appVarCount);
+    return plan;
+}
+
+void PrepareSandboxMountPlan(AppSpawnSandboxCfg *sandbox, const AppSpawningCtx *property, int nwebspawn)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(sandbox != NULL && property != NULL, return);
+    sandbox->spawnPlan = NULL;
+    if (CheckAppMsgFlagsSet(property, APP_FLAGS_NO_SANDBOX)) {
+        return;
+    }
+
+    SandboxContext *context = GetSandboxContext();  // need free after plan
+    APPSPAWN_CHECK_ONLY_EXPER(context != NULL, return);
+    int ret = InitSandboxContext(context, sandbox, property, nwebspawn);
+    if (ret == 0) {
+        sandbox->spawnPlan = GetSandboxMountPlan(sandbox, context);
+    }
+    DeleteSandboxContext(&context);
+}
+
+const SandboxMountPlan *GetSpawnMountPlan(const AppSpawnSandboxCfg *sandbox,
+    const AppSpawningCtx *property, const SandboxContext *context)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(sandbox != NULL && property != NULL && context != NULL, return NULL);
+    // prefork子进程早于父进程准备计划fork，持有的计划可能已失效
+    const SandboxMountPlan *plan = sandbox->spawnPlan;
+    if (plan == NULL || property->isPrefork) {
+        return NULL;
+    }
+
+    // 父进程后续的hook可能修改了消息flags，重新校验key
+    SandboxBuffer *key = (SandboxBuffer *)&context->buffer[BUFFER_FOR_TMP];
+    int ret = BuildSandboxMountPlanKey(context, key);
+    if (ret != 0 || !IsPlanKeyMatch(plan, key, GetPlanKeyHash(key))) {
+        APPSPAWN_LOGW("Mount plan mismatch %{public}s, mount by config", context->bundleName);
+        return NULL;
+    }
+    return plan;
+}
+
+void ClearSandboxMountPlans(AppSpawnSandboxCfg *sandbox)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(sandbox != NULL, return);
+    while (!ListEmpty(sandbox->mountPlans)) {
+        SandboxMountPlan *plan = ListEntry(sandbox->mountPlans.next, SandboxMountPlan, node);
+        OH_ListRemove(&plan->node);
+        FreeSandboxMountPlan(plan);
+    }
+    sandbox->mountPlanCount = 0;
+    sandbox->spawnPlan = NULL;
+}
@@ -95,7 +95,7 @@ const DataGroupSandboxPathTemplate *GetDataGroupArgTemplate(uint32_t category)
     return NULL;
 }
 
-static bool IsUnlockStatus(uint32_t uid)
+bool IsUnlockStatus(uint32_t uid)
 {
     const int userIdBase = UID_BASE;
     uid = uid / userIdBase;
@@ -53,6 +53,7 @@ const DataGroupSandboxPathTemplate *GetDataGroupArgTemplate(uint32_t category);
  * @brief Mount the dirs as shared before device unlocking
  */
 int MountDirsToShared(AppSpawnMgr *content, SandboxContext *context, AppSpawnSandboxCfg *sandbox);
+bool IsUnlockStatus(uint32_t uid);
 
 #ifdef __cplusplus
 }
@@ -45,6 +45,7 @@ int32_t SandboxCommon::deviceTypeEnable_ = -1;
 int32_t SandboxCommon::mountFailedCount_ = 0;
 
 std::map<SandboxCommonDef::SandboxConfigType, std::vector<cJSON *>> SandboxCommon::appSandboxCJsonConfig_ = {};
+std::map<const cJSON *, SandboxSectionIR> SandboxCommon::sectionIR_ = {};
 
 // 加载配置文件
 uint32_t SandboxCommon::GetSandboxNsFlags(bool isNweb)
@@ -126,6 +127,132 @@ void SandboxCommon::StoreCJsonConfig(cJSON *root, SandboxCommonDef::SandboxConfi
     appSandboxCJsonConfig_[type].push_back(root);
 }
 
+// 含mount-paths或symbol-links的节点都是一个挂载配置节点，预加载时全部编译
+void SandboxCommon::CompileConfigIR(cJSON *root)
+{
+    if (root == nullptr || (!cJSON_IsObject(root) && !cJSON_IsArray(root))) {
+        return;
+    }
+    if (cJSON_IsObject(root) && (cJSON_GetObjectItemCaseSensitive(root, SandboxCommonDef::g_mountPrefix) != nullptr ||
+        cJSON_GetObjectItemCaseSensitive(root, SandboxCommonDef::g_symlinkPrefix) != nullptr)) {
+        CompileSectionIR(root, sectionIR_[root]);
+    }
+    cJSON *child = nullptr;
+    cJSON_ArrayForEach(child, root) {
+        CompileConfigIR(child);
+    }
+}
+
+static void CompileStringArray(cJSON *config, const char *key, std::vector<const char *> &result)
+{
+    result.clear();
+    cJSON *arrayJson = cJSON_GetObjectItemCaseSensitive(config, key);
+    if (arrayJson == nullptr || !cJSON_IsArray(arrayJson)) {
+        return;
+    }
+    cJSON *item = nullptr;
+    cJSON_ArrayForEach(item, arrayJson) {
+        const char *strItem = cJSON_GetStringValue(item);
+        if (strItem == nullptr) {  // 与逐项解析一致，任一项非法时整体忽略
+            result.clear();
+            return;
+        }
+        result.push_back(strItem);
+    }
+}
+
+void SandboxCommon::CompileMountPointIR(cJSON *mntPoint, SandboxMountPointIR &mountPoint)
+{
+    mountPoint.mntPoint = mntPoint;
+    mountPoint.srcPath = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_srcPath);
+    mountPoint.sandboxPath = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_sandBoxPath);
+    mountPoint.appAplName = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_appAplName);
+    mountPoint.controlledFusePath = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_controlledFusePath);
+    mountPoint.fsType = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_fsType);
+    mountPoint.options = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_sandBoxOptions);
+    CompileStringArray(mntPoint, SandboxCommonDef::g_sandBoxDecPath, mountPoint.decPaths);
+    CompileStringArray(mntPoint, SandboxCommonDef::g_sandBoxDecReadOnlyPath, mountPoint.decReadOnlyPaths);
+    mountPoint.mountFlags = GetMountFlags(mntPoint);
+    mountPoint.mountSharedFlag =
+        GetBoolValueFromJsonObj(mntPoint, SandboxCommonDef::g_mountSharedFlag, false) ? MS_SHARED : MS_SLAVE;
+    const char *fileMode = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_destMode);
+    mountPoint.hasDestMode = fileMode != nullptr;
+    mountPoint.destMode = ConvertMode(fileMode);
+    mountPoint.hasParamPath = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_paramPath) != nullptr;
+    mountPoint.hasFlags = cJSON_GetObjectItemCaseSensitive(mntPoint, SandboxCommonDef::g_sandBoxFlagsCustomized) ||
+        cJSON_GetObjectItemCaseSensitive(mntPoint, SandboxCommonDef::g_sandBoxFlags);
+    mountPoint.checkStatus = IsMountSuccessful(mntPoint);
+    mountPoint.createSandboxPath = GetBoolValueFromJsonObj(mntPoint, SandboxCommonDef::CREATE_SANDBOX_PATH, false);
+    mountPoint.controlledSkip = GetBoolValueFromJsonObj(mntPoint, SandboxCommonDef::g_controlledSkip, false);
+
+    std::string srcPath = mountPoint.srcPath == nullptr ? "" : mountPoint.srcPath;
+    mountPoint.wpsSkip = srcPath.find("/data/app") != std::string::npos &&
+        (srcPath.find("/base") != std::string::npos || srcPath.find("/database") != std::string::npos) &&
+        srcPath.find(SandboxCommonDef::g_packageName) != std::string::npos;
+
+    // create-on-daemon的源目录属性，uid/gid/mode缺一不可
+    mountPoint.pathInfoUid = 0;
+    mountPoint.pathInfoGid = 0;
+    mountPoint.pathInfoMode = SandboxCommonDef::FILE_MODE;
+    cJSON *pathInfo = cJSON_GetObjectItemCaseSensitive(mntPoint, SandboxCommonDef::g_srcPathInfo);
+    cJSON *uid = cJSON_GetObjectItemCaseSensitive(pathInfo, SandboxCommonDef::g_srcPathUid);
+    cJSON *gid = cJSON_GetObjectItemCaseSensitive(pathInfo, SandboxCommonDef::g_srcPathGid);
+    cJSON *mode = cJSON_GetObjectItemCaseSensitive(pathInfo, SandboxCommonDef::g_srcPathMode);
+    mountPoint.hasPathInfo = uid != nullptr && gid != nullptr && mode != nullptr;
+    if (cJSON_IsNumber(uid)) {
+        mountPoint.pathInfoUid = (uid_t)cJSON_GetNumberValue(uid);
+    }
+    if (cJSON_IsNumber(gid)) {
+        mountPoint.pathInfoGid = (gid_t)cJSON_GetNumberValue(gid);
+    }
+    if (cJSON_IsNumber(mode)) {
+        mountPoint.pathInfoMode = (mode_t)cJSON_GetNumberValue(mode);
+    }
+}
+
+void SandboxCommon::CompileSectionIR(cJSON *appConfig, SandboxSectionIR &section)
+{
+    section.flagsName = GetStringFromJsonObj(appConfig, SandboxCommonDef::g_flags);
+    section.flags = section.flagsName != nullptr ? ConvertFlagStr(section.flagsName) : 0;
+    section.mountPoints.clear();
+    section.symlinks.clear();
+
+    cJSON *mountPoints = cJSON_GetObjectItemCaseSensitive(appConfig, SandboxCommonDef::g_mountPrefix);
+    cJSON *item = nullptr;
+    if (cJSON_IsArray(mountPoints)) {
+        cJSON_ArrayForEach(item, mountPoints) {
+            SandboxMountPointIR mountPoint = {};
+            CompileMountPointIR(item, mountPoint);
+            section.mountPoints.push_back(std::move(mountPoint));
+        }
+    }
+
+    cJSON *symlinkPoints = cJSON_GetObjectItemCaseSensitive(appConfig, SandboxCommonDef::g_symlinkPrefix);
+    if (cJSON_IsArray(symlinkPoints)) {
+        cJSON_ArrayForEach(item, symlinkPoints) {
+            SandboxSymlinkIR symlink = {};
+            symlink.targetName = GetStringFromJsonObj(item, SandboxCommonDef::g_targetName);
+            symlink.linkName = GetStringFromJsonObj(item, SandboxCommonDef::g_linkName);
+            const char *fileMode = GetStringFromJsonObj(item, SandboxCommonDef::g_destMode);
+            symlink.hasDestMode = fileMode != nullptr;
+            symlink.destMode = ConvertMode(fileMode);
+            symlink.checkStatus = IsMountSuccessful(item);
+            section.symlinks.push_back(symlink);
+        }
+    }
+}
+
+const SandboxSectionIR &SandboxCommon::GetSectionIR(cJSON *appConfig, SandboxSectionIR &tmpSection)
+{
+    auto it = sectionIR_.find(appConfig);
+    if (it != sectionIR_.end()) {
+        return it->second;
+    }
+    // 不在预加载配置中的节点（如debug配置），临时编译
+    CompileSectionIR(appConfig, tmpSection);
+    return tmpSection;
+}
+
 int32_t SandboxCommon::HandleArrayForeach(cJSON *arrayJson, ArrayItemProcessor processor)
 {
     if (!arrayJson || !cJSON_IsArray(arrayJson) || !processor) {
@@ -159,6 +286,7 @@ int SandboxCommon::LoadAppSandboxConfigCJson(AppSpawnMgr *content)
         APPSPAWN_CHECK((sandboxCJsonRoot != nullptr && cJSON_IsObject(sandboxCJsonRoot)), continue,
                        "Failed to load app data sandbox config %{public}s", appPath.c_str());
         StoreCJsonConfig(sandboxCJsonRoot, SandboxCommonDef::SANDBOX_APP_JSON_CONFIG);
+        CompileConfigIR(sandboxCJsonRoot);
 
         std::string isolatedPath = path + SandboxCommonDef::APP_ISOLATED_JSON_CONFIG;
         APPSPAWN_LOGI("LoadAppSandboxConfig %{public}s", isolatedPath.c_str());
@@ -166,6 +294,7 @@ int SandboxCommon::LoadAppSandboxConfigCJson(AppSpawnMgr *content)
         APPSPAWN_CHECK_LOGW((sandboxCJsonRoot != nullptr && cJSON_IsObject(sandboxCJsonRoot)), continue,
                        "Failed to load app data sandbox config %{public}s", isolatedPath.c_str());
         StoreCJsonConfig(sandboxCJsonRoot, SandboxCommonDef::SANDBOX_ISOLATED_JSON_CONFIG);
+        CompileConfigIR(sandboxCJsonRoot);
     }
     FreeCfgFiles(files);
 
@@ -199,6 +328,7 @@ int SandboxCommon::FreeAppSandboxConfigCJson(AppSpawnMgr *content)
         isolated = nullptr;
     }
     isolatedJsonVec.clear();
+    sectionIR_.clear();
     return 0;
 }
 
@@ -328,33 +458,42 @@ void SandboxCommon::CreateFileIfNotExist(const char *file)
     return;
 }
 
-void SandboxCommon::SetSandboxPathChmod(cJSON *jsonConfig, std::string &sandboxRoot)
+mode_t SandboxCommon::ConvertMode(const char *fileMode)
 {
-    const std::map<std::string, mode_t> modeMap = {{"S_IRUSR", S_IRUSR}, {"S_IWUSR", S_IWUSR}, {"S_IXUSR", S_IXUSR},
-                                                   {"S_IRGRP", S_IRGRP}, {"S_IWGRP", S_IWGRP}, {"S_IXGRP", S_IXGRP},
-                                                   {"S_IROTH", S_IROTH}, {"S_IWOTH", S_IWOTH}, {"S_IXOTH", S_IXOTH},
-                                                   {"S_IRWXU", S_IRWXU}, {"S_IRWXG", S_IRWXG}, {"S_IRWXO", S_IRWXO}};
-    const char *fileMode = GetStringFromJsonObj(jsonConfig, SandboxCommonDef::g_destMode);
+    static const std::map<std::string, mode_t> modeMap = {
+        {"S_IRUSR", S_IRUSR}, {"S_IWUSR", S_IWUSR}, {"S_IXUSR", S_IXUSR},
+        {"S_IRGRP", S_IRGRP}, {"S_IWGRP", S_IWGRP}, {"S_IXGRP", S_IXGRP},
+        {"S_IROTH", S_IROTH}, {"S_IWOTH", S_IWOTH}, {"S_IXOTH", S_IXOTH},
+        {"S_IRWXU", S_IRWXU}, {"S_IRWXG", S_IRWXG}, {"S_IRWXO", S_IRWXO}};
     if (fileMode == nullptr) {
-        return;
+        return 0;
     }
 
     mode_t mode = 0;
     std::string fileModeStr = fileMode;
     std::vector<std::string> modeVec = SplitString(fileModeStr, "|");
     for (unsigned int i = 0; i < modeVec.size(); i++) {
-        if (modeMap.count(modeVec[i])) {
-            mode |= modeMap.at(modeVec[i]);
+        auto it = modeMap.find(modeVec[i]);
+        if (it != modeMap.end()) {
+            mode |= it->second;
         }
     }
+    return mode;
+}
 
-    chmod(sandboxRoot.c_str(), mode);
+void SandboxCommon::SetSandboxPathChmod(cJSON *jsonConfig, std::string &sandboxRoot)
+{
+    const char *fileMode = GetStringFromJsonObj(jsonConfig, SandboxCommonDef::g_destMode);
+    if (fileMode == nullptr) {
+        return;
+    }
+    chmod(sandboxRoot.c_str(), ConvertMode(fileMode));
 }
 
 // 获取挂载配置参数信息
 unsigned long SandboxCommon::GetMountFlagsFromConfig(const std::vector<std::string> &vec)
 {
-    const std::map<std::string, mode_t> MountFlagsMap = { {"rec", MS_REC}, {"MS_REC", MS_REC},
+    static const std::map<std::string, mode_t> MountFlagsMap = { {"rec", MS_REC}, {"MS_REC", MS_REC},
                                                           {"bind", MS_BIND}, {"MS_BIND", MS_BIND},
                                                           {"move", MS_MOVE}, {"MS_MOVE", MS_MOVE},
                                                           {"slave", MS_SLAVE}, {"MS_SLAVE", MS_SLAVE},
@@ -371,8 +510,9 @@ unsigned long SandboxCommon::GetMountFlagsFromConfig(const std::vector<std::stri
 
     unsigned long mountFlags = 0;
     for (unsigned int i = 0; i < vec.size(); i++) {
-        if (MountFlagsMap.count(vec[i])) {
-            mountFlags |= MountFlagsMap.at(vec[i]);
+        auto it = MountFlagsMap.find(vec[i]);
+        if (it != MountFlagsMap.end()) {
+            mountFlags |= it->second;
         }
     }
     return mountFlags;
@@ -391,7 +531,7 @@ bool SandboxCommon::GetSwitchStatus(cJSON *config) // GetSbxSwitchStatusByConfig
 
 uint32_t SandboxCommon::ConvertFlagStr(const std::string &flagStr)
 {
-    const std::map<std::string, int> flagsMap = {{"START_FLAGS_BACKUP", APP_FLAGS_BACKUP_EXTENSION},
+    static const std::map<std::string, int> flagsMap = {{"START_FLAGS_BACKUP", APP_FLAGS_BACKUP_EXTENSION},
         {"DLP_MANAGER_FULL_CONTROL", APP_FLAGS_DLP_MANAGER_FULL_CONTROL},
         {"DLP_MANAGER_READ_ONLY", APP_FLAGS_DLP_MANAGER_READ_ONLY},
         {"DEVELOPER_MODE", APP_FLAGS_DEVELOPER_MODE},
@@ -403,8 +543,9 @@ uint32_t SandboxCommon::ConvertFlagStr(const std::string &flagStr)
         {"APP_SKILLS_ENABLED", APP_FLAGS_SKILLS},
         {"DEBUGSERVER", APP_FLAGS_DEBUGSERVER}};
 
-    if (flagsMap.count(flagStr)) {
-        return flagsMap.at(flagStr);
+    auto it = flagsMap.find(flagStr);
+    if (it != flagsMap.end()) {
+        return it->second;
     }
     return 0;
 }
@@ -523,6 +664,22 @@ std::vector<std::string> SandboxCommon::GetDecReadOnlyPath(const AppSpawningCtx
     return decReadOnlyPaths;
 }
 
+std::vector<std::string> SandboxCommon::ConvertDecPaths(const AppSpawningCtx *appProperty,
+                                                        const std::vector<const char *> &paths)
+{
+    AppSpawnMsgDacInfo *dacInfo = reinterpret_cast<AppSpawnMsgDacInfo *>(GetAppProperty(appProperty, TLV_DAC_INFO));
+    if (dacInfo == nullptr) {
+        return {};
+    }
+
+    std::vector<std::string> decPaths;
+    decPaths.reserve(paths.size());
+    for (const char *path : paths) {
+        decPaths.emplace_back(ConvertToRealPathWithPermission(appProperty, path));
+    }
+    return decPaths;
+}
+
 bool SandboxCommon::IsCreateSandboxPathEnabled(cJSON *json, std::string srcPath) // GetCreateSandboxPath
 {
     bool isRet = GetBoolValueFromJsonObj(json, SandboxCommonDef::CREATE_SANDBOX_PATH, false);
@@ -609,6 +766,31 @@ void SandboxCommon::GetSandboxMountConfig(const AppSpawningCtx *appProperty, con
     return;
 }
 
+void SandboxCommon::GetSandboxMountConfig(const AppSpawningCtx *appProperty, const std::string &section,
+                                          const SandboxMountPointIR &mountPoint, SandboxMountConfig &mountConfig)
+{
+    mountConfig.fsType = mountPoint.fsType == nullptr ? "" : mountPoint.fsType;
+    if (section.compare(SandboxCommonDef::g_permissionPrefix) == 0 ||
+        section.compare(SandboxCommonDef::g_flagsPoint) == 0 ||
+        section.compare(SandboxCommonDef::g_debughap) == 0) {
+        AppSpawnMsgDacInfo *dacInfo =
+            reinterpret_cast<AppSpawnMsgDacInfo *>(GetAppProperty(appProperty, TLV_DAC_INFO));
+        mountConfig.optionsPoint = "";
+        if (dacInfo != nullptr && mountPoint.options != nullptr) {
+            mountConfig.optionsPoint = mountPoint.options;
+            mountConfig.optionsPoint += ",user_id=" + std::to_string(dacInfo->uid / UID_BASE);
+        }
+        mountConfig.decPaths = ConvertDecPaths(appProperty, mountPoint.decPaths);
+        mountConfig.decReadOnlyPaths = ConvertDecPaths(appProperty, mountPoint.decReadOnlyPaths);
+    } else {
+        mountConfig.optionsPoint = "";
+        mountConfig.decPaths = IsNoShareFsEnable() ?
+            ConvertDecPaths(appProperty, mountPoint.decPaths) : std::vector<std::string>{};
+        mountConfig.decReadOnlyPaths = IsNoShareFsEnable() ?
+            ConvertDecPaths(appProperty, mountPoint.decReadOnlyPaths) : std::vector<std::string>{};
+    }
+}
+
 // 校验操作
 bool SandboxCommon::IsNeededCheckPathStatus(const AppSpawningCtx *appProperty, const char *path)
 {
@@ -742,6 +924,25 @@ bool SandboxCommon::IsValidMountConfig(cJSON *mntPoint, const AppSpawningCtx *ap
     return true;
 }
 
+bool SandboxCommon::IsValidMountConfig(const SandboxMountPointIR &mountPoint, const AppSpawningCtx *appProperty,
+                                       bool checkFlag)
+{
+    if ((mountPoint.srcPath == nullptr && !mountPoint.hasParamPath) || mountPoint.sandboxPath == nullptr ||
+        !mountPoint.hasFlags) {
+        APPSPAWN_LOGE("read mount config failed, app name is %{public}s", GetBundleName(appProperty));
+        return false;
+    }
+
+    AppSpawnMsgDomainInfo *info =
+        reinterpret_cast<AppSpawnMsgDomainInfo *>(GetAppProperty(appProperty, TLV_DOMAIN_INFO));
+    APPSPAWN_CHECK(info != nullptr, return false, "Filed to get domain info %{public}s", GetBundleName(appProperty));
+    if (mountPoint.appAplName != nullptr && !strcmp(mountPoint.appAplName, info->apl)) {
+        return false;
+    }
+    // special handle wps and don't use /data/app/xxx/<Package> config
+    return !(checkFlag && mountPoint.wpsSkip);
+}
+
 // 路径处理
 std::string SandboxCommon::ReplaceAllVariables(std::string str, const std::string& from, const std::string& to)
 {
@@ -853,8 +1054,8 @@ std::string SandboxCommon::ReplaceVariablePackageName(const AppSpawningCtx *appP
     APPSPAWN_CHECK(bundleInfo != nullptr, return "", "No bundle info in msg %{public}s", GetBundleName(appProperty));
     uint32_t appIndex = bundleInfo->bundleIndex;
     int type = GetVarPackageNameType(appProperty, appIndex);
-    char *extension = reinterpret_cast<char *>(GetAppSpawnMsgExtInfo(appProperty->message,
-        MSG_EXT_NAME_APP_EXTENSION, nullptr));
+    char *extension = reinterpret_cast<char *>(GetAppSpawnMsgKnownExtInfo(appProperty->message,
+        EXT_TLV_ID_APP_EXTENSION, nullptr));
 
     std::ostringstream variablePackageName;
     switch (type) {
@@ -902,8 +1103,8 @@ std::string SandboxCommon::ReplaceSandboxRootVariablePackageName(const AppSpawni
     APPSPAWN_CHECK(bundleInfo != nullptr, return "", "No bundle info in msg %{public}s", GetBundleName(appProperty));
     uint32_t appIndex = bundleInfo->bundleIndex;
     int type = GetVarPackageNameType(appProperty, appIndex);
-    char *extension = reinterpret_cast<char *>(GetAppSpawnMsgExtInfo(appProperty->message,
-        MSG_EXT_NAME_APP_EXTENSION, nullptr));
+    char *extension = reinterpret_cast<char *>(GetAppSpawnMsgKnownExtInfo(appProperty->message,
+        EXT_TLV_ID_APP_EXTENSION, nullptr));
 
     std::ostringstream variablePackageName;
     switch (type) {
@@ -946,7 +1147,7 @@ std::string SandboxCommon::ReplaceHostUserId(const AppSpawningCtx *appProperty,
     std::string tmpSandboxPath = path;
     int32_t uid = 0;
     const char *userId =
-        (const char *)(GetAppSpawnMsgExtInfo(appProperty->message, MSG_EXT_NAME_PARENT_UID, nullptr));
+        (const char *)(GetAppSpawnMsgKnownExtInfo(appProperty->message, EXT_TLV_ID_PARENT_UID, nullptr));
     if (userId != nullptr) {
         uid = atoi(userId);
     }
@@ -49,6 +49,49 @@ typedef struct MountPointProcessParams {
     std::string bundleName;             // 包名
 } MountPointProcessParams;
 
+// 预编译的挂载点，配置加载时解析，孵化时只做变量替换
+typedef struct SandboxMountPointIR {
+    cJSON *mntPoint;                          // 原始配置，字符串指针指向其内部
+    const char *srcPath;
+    const char *sandboxPath;
+    const char *appAplName;
+    const char *controlledFusePath;
+    const char *fsType;
+    const char *options;
+    std::vector<const char *> decPaths;       // 未替换变量的dec路径
+    std::vector<const char *> decReadOnlyPaths;
+    unsigned long mountFlags;
+    mode_t mountSharedFlag;
+    mode_t destMode;
+    uid_t pathInfoUid;                        // create-on-daemon的src-path-info
+    gid_t pathInfoGid;
+    mode_t pathInfoMode;
+    bool hasParamPath;
+    bool hasFlags;
+    bool hasDestMode;
+    bool hasPathInfo;
+    bool checkStatus;                         // check-action-status
+    bool createSandboxPath;
+    bool controlledSkip;
+    bool wpsSkip;                             // 包含<PackageName>的/data/app/base|database路径，wps应用不挂载
+} SandboxMountPointIR;
+
+typedef struct SandboxSymlinkIR {
+    const char *targetName;
+    const char *linkName;
+    mode_t destMode;
+    bool hasDestMode;
+    bool checkStatus;
+} SandboxSymlinkIR;
+
+// 一个配置节点（app-base、某个权限、某个flags等）下的挂载点和链接
+typedef struct SandboxSectionIR {
+    const char *flagsName;                    // "flags"字段，未配置时为nullptr
+    uint32_t flags;                           // flagsName转换后的APP_FLAGS
+    std::vector<SandboxMountPointIR> mountPoints;
+    std::vector<SandboxSymlinkIR> symlinks;
+} SandboxSectionIR;
+
 using ArrayItemProcessor = std::function<int32_t(cJSON*)>;
 
 class SandboxCommon {
@@ -59,6 +102,10 @@ public:
     static int FreeAppSandboxConfigCJson(AppSpawnMgr *content);
     static void StoreJsonConfig(cJSON *appSandboxConfig, SandboxCommonDef::SandboxConfigType type);
     static std::vector<cJSON *> &GetCJsonConfig(SandboxCommonDef::SandboxConfigType type); // GetJsonConfig
+    // 配置预编译，预加载时生成，未预编译的节点在使用时临时编译
+    static const SandboxSectionIR &GetSectionIR(cJSON *appConfig, SandboxSectionIR &tmpSection);
+    static void CompileSectionIR(cJSON *appConfig, SandboxSectionIR &section);
+    static void CompileMountPointIR(cJSON *mntPoint, SandboxMountPointIR &mountPoint);
 
     static int32_t HandleArrayForeach(cJSON *arrayJson, ArrayItemProcessor processor);
 
@@ -70,6 +117,7 @@ public:
     static int CreateDirRecursive(const std::string &path, mode_t mode); // MakeDirRecursive
     static void CreateDirRecursiveWithClock(const std::string &path, mode_t mode); // MakeDirRecursiveWithClock
     static void SetSandboxPathChmod(cJSON *jsonConfig, std::string &sandboxRoot); // DoSandboxChmod
+    static mode_t ConvertMode(const char *fileMode);
 
     // 获取挂载配置参数信息
     static uint32_t ConvertFlagStr(const std::string &flagStr);
@@ -79,6 +127,8 @@ public:
     static bool IsAppSandboxEnabled(const AppSpawningCtx *appProperty); // CheckAppSandboxSwitchStatus
     static void GetSandboxMountConfig(const AppSpawningCtx *appProperty, const std::string &section,
                                       cJSON *mntPoint, SandboxMountConfig &mountConfig);
+    static void GetSandboxMountConfig(const AppSpawningCtx *appProperty, const std::string &section,
+                                      const SandboxMountPointIR &mountPoint, SandboxMountConfig &mountConfig);
 
     // 校验操作
     static bool HasPrivateInBundleName(const std::string &bundleName); // CheckBundleNameForPrivate
@@ -86,6 +136,8 @@ public:
     static int CheckBundleName(const std::string &bundleName);
     static bool IsValidMountConfig(cJSON *mntPoint, const AppSpawningCtx *appProperty,
                                    bool checkFlag); // CheckMountConfig
+    static bool IsValidMountConfig(const SandboxMountPointIR &mountPoint, const AppSpawningCtx *appProperty,
+                                   bool checkFlag);
     static bool IsPrivateSharedStatus(const std::string &bundleName,
                                       AppSpawningCtx *appProperty); // GetSandboxPrivateSharedStatus
     static int32_t CheckAppFullMountEnable();
@@ -114,6 +166,7 @@ private:
     static uint32_t GetSandboxNsFlags(bool isNweb);
     static bool AppSandboxPidNsIsSupport(void);
     static void StoreCJsonConfig(cJSON *root, SandboxCommonDef::SandboxConfigType type);
+    static void CompileConfigIR(cJSON *root);
 
     // 文件操作
     static void CreateFileIfNotExist(const char *file); // CheckAndCreatFile
@@ -126,6 +179,8 @@ private:
     static std::string GetOptions(const AppSpawningCtx *appProperty, cJSON *config); // GetSandboxOptions
     static std::vector<std::string> GetDecPath(const AppSpawningCtx *appProperty, cJSON *config); // GetSandboxDecPath
     static std::vector<std::string> GetDecReadOnlyPath(const AppSpawningCtx *appProperty, cJSON *config);
+    static std::vector<std::string> ConvertDecPaths(const AppSpawningCtx *appProperty,
+                                                    const std::vector<const char *> &paths);
 
     // 校验操作
     static bool IsNeededCheckPathStatus(const AppSpawningCtx *appProperty, const char *path);
@@ -146,6 +201,7 @@ private:
     static int32_t deviceTypeEnable_;
     static int32_t mountFailedCount_;
     static std::map<SandboxCommonDef::SandboxConfigType, std::vector<cJSON *>> appSandboxCJsonConfig_;
+    static std::map<const cJSON *, SandboxSectionIR> sectionIR_;
     typedef enum {
         SANDBOX_PACKAGENAME_DEFAULT = 0,
         SANDBOX_PACKAGENAME_CLONE,
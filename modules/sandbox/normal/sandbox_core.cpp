@@ -97,19 +97,12 @@ uint32_t SandboxCore::GetAppMsgFlags(const AppSpawningCtx *property)
 }
 
 bool SandboxCore::CheckMountFlag(const AppSpawningCtx *appProperty, const std::string bundleName,
-                                 cJSON *appConfig)
+                                 const SandboxSectionIR &section)
 {
-    const char *flagChr = GetStringFromJsonObj(appConfig, SandboxCommonDef::g_flags);
-    if (flagChr == nullptr) {
+    if (section.flagsName == nullptr) {
         return false;
     }
-    std::string flagStr(flagChr);
-    uint32_t flag = SandboxCommon::ConvertFlagStr(flagStr);
-    if ((CheckAppMsgFlagsSet(appProperty, flag) != 0) &&
-        bundleName.find("wps") != std::string::npos) {
-        return true;
-    }
-    return false;
+    return (CheckAppMsgFlagsSet(appProperty, section.flags) != 0) && bundleName.find("wps") != std::string::npos;
 }
 
 void SandboxCore::UpdateMsgFlagsWithPermission(AppSpawningCtx *appProperty, const std::string &permissionMode,
@@ -140,18 +133,21 @@ int32_t SandboxCore::UpdatePointFlags(AppSpawningCtx *appProperty)
 std::string SandboxCore::GetSandboxPath(const AppSpawningCtx *appProperty, cJSON *mntPoint,
     const std::string &section, std::string sandboxRoot)
 {
-    std::string sandboxPath = "";
     const char *tmpSandboxPathChr = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_sandBoxPath);
+    return GetSandboxPath(appProperty, tmpSandboxPathChr, section, sandboxRoot);
+}
+
+std::string SandboxCore::GetSandboxPath(const AppSpawningCtx *appProperty, const char *tmpSandboxPathChr,
+    const std::string &section, const std::string &sandboxRoot)
+{
     if (tmpSandboxPathChr == nullptr) {
         return "";
     }
     std::string tmpSandboxPath(tmpSandboxPathChr);
     if (section.compare(SandboxCommonDef::g_permissionPrefix) == 0) {
-        sandboxPath = sandboxRoot + SandboxCommon::ConvertToRealPathWithPermission(appProperty, tmpSandboxPath);
-    } else {
-        sandboxPath = sandboxRoot + SandboxCommon::ConvertToRealPath(appProperty, tmpSandboxPath);
+        return sandboxRoot + SandboxCommon::ConvertToRealPathWithPermission(appProperty, tmpSandboxPath);
     }
-    return sandboxPath;
+    return sandboxRoot + SandboxCommon::ConvertToRealPath(appProperty, tmpSandboxPath);
 }
 
 int32_t SandboxCore::HandleDlpMount(const AppSpawnMsgDacInfo *dacInfo)
@@ -583,38 +579,33 @@ int32_t SandboxCore::MountAllGroup(const AppSpawningCtx *appProperty, std::strin
 
 
 // Resolve mount source path considering controlled app FUSE override.
-static const char* ResolveMountSrcPath(cJSON *mntPoint, MountPointProcessParams &params,
+static const char* ResolveMountSrcPath(const SandboxMountPointIR &mountPoint, MountPointProcessParams &params,
                                        std::string &paramSrcPath, bool &usingFusePath)
 {
     usingFusePath = false;
-    if (params.isControlledApp) {
-        const char *fusePath = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_controlledFusePath);
-        if (fusePath != nullptr) {
-            usingFusePath = true;
-            return fusePath;
-        }
+    if (params.isControlledApp && mountPoint.controlledFusePath != nullptr) {
+        usingFusePath = true;
+        return mountPoint.controlledFusePath;
+    }
+    if (mountPoint.srcPath != nullptr) {
+        return mountPoint.srcPath;
     }
-    const char *srcPath = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_srcPath);
-    if (srcPath != nullptr) {
-        return srcPath;
+    // 系统参数的值可能变化，每次孵化时重新拼接
+    if (mountPoint.hasParamPath) {
+        paramSrcPath = SandboxCommon::BuildFullParamSrcPath(mountPoint.mntPoint);
     }
-    paramSrcPath = SandboxCommon::BuildFullParamSrcPath(mntPoint);
     return nullptr;
 }
 
 
 // Check and handle controlled-skip for mount point.
 // Returns true if the mount point should be skipped (caller returns 0).
-static bool TryControlledSkip(cJSON *mntPoint, const MountPointProcessParams &params)
+static bool TryControlledSkip(const SandboxMountPointIR &mountPoint, const MountPointProcessParams &params)
 {
-    if (!params.isControlledApp) {
+    if (!params.isControlledApp || !mountPoint.controlledSkip) {
         return false;
     }
-    if (!GetBoolValueFromJsonObj(mntPoint, SandboxCommonDef::g_controlledSkip, false)) {
-        return false;
-    }
-    const char *rawPathChr = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_sandBoxPath);
-    APPSPAWN_LOGV("ctrl skip: %{public}s", rawPathChr != nullptr ? rawPathChr : "?");
+    APPSPAWN_LOGV("ctrl skip: %{public}s", mountPoint.sandboxPath != nullptr ? mountPoint.sandboxPath : "?");
     return true;
 }
 
@@ -642,57 +633,64 @@ static int ExecuteMountOnce(const SharedMountArgs &arg, MountPointProcessParams
 }
 
 
-int32_t SandboxCore::ProcessMountPointCommmon(cJSON *mntPoint, MountPointProcessParams &params, bool enableLogging)
+int32_t SandboxCore::ProcessMountPointCommmon(const SandboxMountPointIR &mountPoint, MountPointProcessParams &params,
+                                              bool enableLogging)
 {
-    if (TryControlledSkip(mntPoint, params)) {
+    if (TryControlledSkip(mountPoint, params)) {
         return 0;
     }
     std::string paramSrcPath = "";
     bool usingFusePath = false;
-    const char *srcPathChr = ResolveMountSrcPath(mntPoint, params, paramSrcPath, usingFusePath);
+    const char *srcPathChr = ResolveMountSrcPath(mountPoint, params, paramSrcPath, usingFusePath);
     if (srcPathChr == nullptr) {
         APPSPAWN_CHECK_ONLY_EXPER(!paramSrcPath.empty(), return 0);
     }
     if (!usingFusePath) {
-        APPSPAWN_CHECK_ONLY_EXPER(SandboxCommon::IsValidMountConfig(mntPoint, params.appProperty, params.checkFlag),
+        APPSPAWN_CHECK_ONLY_EXPER(SandboxCommon::IsValidMountConfig(mountPoint, params.appProperty, params.checkFlag),
                                   return 0);
     }
-    const char *sandboxPathChr = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_sandBoxPath);
     std::string srcPath = srcPathChr == nullptr ? paramSrcPath : srcPathChr;
-    std::string sandboxPath(sandboxPathChr != nullptr ? sandboxPathChr : "");
     srcPath = SandboxCommon::ConvertToRealPath(params.appProperty, srcPath);
-    APPSPAWN_CHECK_ONLY_EXPER(SandboxCommon::IsCreateSandboxPathEnabled(mntPoint, srcPath), return 0);
-    sandboxPath = GetSandboxPath(params.appProperty, mntPoint, params.section, params.sandboxRoot);
+    if (mountPoint.createSandboxPath && access(srcPath.c_str(), F_OK) != 0) {
+        return 0;
+    }
+    std::string sandboxPath = GetSandboxPath(params.appProperty, mountPoint.sandboxPath, params.section,
+                                             params.sandboxRoot);
     SandboxMountConfig mountConfig = {0};
-    SandboxCommon::GetSandboxMountConfig(params.appProperty, params.section, mntPoint, mountConfig);
+    SandboxCommon::GetSandboxMountConfig(params.appProperty, params.section, mountPoint, mountConfig);
     SharedMountArgs arg = {
         .srcPath = srcPath.c_str(),
         .destPath = sandboxPath.c_str(),
         .fsType = mountConfig.fsType.c_str(),
-        .mountFlags = SandboxCommon::GetMountFlags(mntPoint),
+        .mountFlags = mountPoint.mountFlags,
         .options = mountConfig.optionsPoint.c_str(),
-        .mountSharedFlag =
-            GetBoolValueFromJsonObj(mntPoint, SandboxCommonDef::g_mountSharedFlag, false) ? MS_SHARED : MS_SLAVE
+        .mountSharedFlag = mountPoint.mountSharedFlag
     };
-    bool isMountCritical = SandboxCommon::IsMountSuccessful(mntPoint) || usingFusePath;
+    bool isMountCritical = mountPoint.checkStatus || usingFusePath;
     int ret = ExecuteMountOnce(arg, params, enableLogging, isMountCritical);
     if (ret != 0) {
         return ret;
     }
     SetDecPolicyWithPermission(params.appProperty, mountConfig);
     SetDecReadOnlyPolicyWithPermission(params.appProperty, mountConfig);
-    SandboxCommon::SetSandboxPathChmod(mntPoint, params.sandboxRoot);
+    if (mountPoint.hasDestMode) {
+        chmod(params.sandboxRoot.c_str(), mountPoint.destMode);
+    }
     return 0;
 }
 
 int32_t SandboxCore::ProcessMountPoint(cJSON *mntPoint, MountPointProcessParams &params)
 {
-    return ProcessMountPointCommmon(mntPoint, params, true);
+    SandboxMountPointIR mountPoint = {};
+    SandboxCommon::CompileMountPointIR(mntPoint, mountPoint);
+    return ProcessMountPointCommmon(mountPoint, params, true);
 }
 
 int32_t SandboxCore::ProcessMountPointNocheck(cJSON *mntPoint, MountPointProcessParams &params)
 {
-    return ProcessMountPointCommmon(mntPoint, params, false);
+    SandboxMountPointIR mountPoint = {};
+    SandboxCommon::CompileMountPointIR(mntPoint, mountPoint);
+    return ProcessMountPointCommmon(mountPoint, params, false);
 }
 
 int32_t SandboxCore::DoAllMntPointsMount(const AppSpawningCtx *appProperty, cJSON *appConfig,
@@ -707,8 +705,10 @@ int32_t SandboxCore::DoAllMntPointsMount(const AppSpawningCtx *appProperty, cJSO
         return 0;
     }
 
+    SandboxSectionIR tmpSection;
+    const SandboxSectionIR &sectionIR = SandboxCommon::GetSectionIR(appConfig, tmpSection);
     std::string sandboxRoot = SandboxCommon::GetSandboxRootPath(appProperty, appConfig);
-    bool checkFlag = CheckMountFlag(appProperty, bundleName, appConfig);
+    bool checkFlag = CheckMountFlag(appProperty, bundleName, sectionIR);
     MountPointProcessParams mountPointParams = {
         .appProperty = appProperty,
         .checkFlag = checkFlag,
@@ -718,11 +718,11 @@ int32_t SandboxCore::DoAllMntPointsMount(const AppSpawningCtx *appProperty, cJSO
         .bundleName = bundleName
     };
     mountPointParams.isControlledApp = CheckAppMsgFlagsSet(appProperty, APP_FLAGS_CONTROLLED_APP);
-    auto processor = [&mountPointParams](cJSON *mntPoint) {
-        return ProcessMountPoint(mntPoint, mountPointParams);
-    };
-
-    return SandboxCommon::HandleArrayForeach(mountPoints, processor);
+    for (const SandboxMountPointIR &mountPoint : sectionIR.mountPoints) {
+        int ret = ProcessMountPointCommmon(mountPoint, mountPointParams, true);
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    }
+    return 0;
 }
 
 int32_t SandboxCore::DoAllMntPointsMountNocheck(const AppSpawningCtx *appProperty, cJSON *appConfig,
@@ -737,8 +737,10 @@ int32_t SandboxCore::DoAllMntPointsMountNocheck(const AppSpawningCtx *appPropert
         return 0;
     }
 
+    SandboxSectionIR tmpSection;
+    const SandboxSectionIR &sectionIR = SandboxCommon::GetSectionIR(appConfig, tmpSection);
     std::string sandboxRoot = SandboxCommon::GetSandboxRootPath(appProperty, appConfig);
-    bool checkFlag = CheckMountFlag(appProperty, bundleName, appConfig);
+    bool checkFlag = CheckMountFlag(appProperty, bundleName, sectionIR);
     MountPointProcessParams mountPointParams = {
         .appProperty = appProperty,
         .checkFlag = checkFlag,
@@ -748,45 +750,33 @@ int32_t SandboxCore::DoAllMntPointsMountNocheck(const AppSpawningCtx *appPropert
         .bundleName = bundleName
     };
     mountPointParams.isControlledApp = CheckAppMsgFlagsSet(appProperty, APP_FLAGS_CONTROLLED_APP);
-    auto processor = [&mountPointParams](cJSON *mntPoint) {
-        return ProcessMountPointNocheck(mntPoint, mountPointParams);
-    };
-
-    return SandboxCommon::HandleArrayForeach(mountPoints, processor);
+    for (const SandboxMountPointIR &mountPoint : sectionIR.mountPoints) {
+        int ret = ProcessMountPointCommmon(mountPoint, mountPointParams, false);
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    }
+    return 0;
 }
 
 int32_t SandboxCore::ProcessCreateOnDaemonMount(cJSON *mntPoint, MountPointProcessParams &params)
 {
-    const char *srcPathChr = GetStringFromJsonObj(mntPoint, SandboxCommonDef::g_srcPath);
-    if (srcPathChr == nullptr) {
+    SandboxMountPointIR mountPoint = {};
+    SandboxCommon::CompileMountPointIR(mntPoint, mountPoint);
+    return ProcessCreateOnDaemonMount(mountPoint, params);
+}
+
+int32_t SandboxCore::ProcessCreateOnDaemonMount(const SandboxMountPointIR &mountPoint, MountPointProcessParams &params)
+{
+    if (mountPoint.srcPath == nullptr) {
         APPSPAWN_LOGI("path info config is not found");
         return 0;
     }
-    std::string srcPath(srcPathChr);
+    std::string srcPath(mountPoint.srcPath);
     srcPath = SandboxCommon::ConvertToRealPath(params.appProperty, srcPath);
 
-    uid_t uid = 0;
-    gid_t gid = 0;
-    mode_t mode = SandboxCommonDef::FILE_MODE;
-    cJSON *pathInfoPoints = cJSON_GetObjectItemCaseSensitive(mntPoint, SandboxCommonDef::g_srcPathInfo);
-    APPSPAWN_CHECK(pathInfoPoints != nullptr, return 0, "Invalid json object");
-    cJSON *item = cJSON_GetObjectItemCaseSensitive(pathInfoPoints, SandboxCommonDef::g_srcPathUid);
-    APPSPAWN_CHECK(item != nullptr, return 0, "Invalid json object");
-    if (cJSON_IsNumber(item)) {
-        uid = (uid_t)cJSON_GetNumberValue(item);
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(pathInfoPoints, SandboxCommonDef::g_srcPathGid);
-    APPSPAWN_CHECK(item != nullptr, return 0, "Invalid json object");
-    if (cJSON_IsNumber(item)) {
-        gid = (gid_t)cJSON_GetNumberValue(item);
-    }
-
-    item = cJSON_GetObjectItemCaseSensitive(pathInfoPoints, SandboxCommonDef::g_srcPathMode);
-    APPSPAWN_CHECK(item != nullptr, return 0, "Invalid json object");
-    if (cJSON_IsNumber(item)) {
-        mode = (mode_t)cJSON_GetNumberValue(item);
-    }
+    APPSPAWN_CHECK(mountPoint.hasPathInfo, return 0, "Invalid json object");
+    uid_t uid = mountPoint.pathInfoUid;
+    gid_t gid = mountPoint.pathInfoGid;
+    mode_t mode = mountPoint.pathInfoMode;
 
     struct stat statBuff;
     int ret = stat(srcPath.c_str(), &statBuff);
@@ -804,7 +794,7 @@ int32_t SandboxCore::ProcessCreateOnDaemonMount(cJSON *mntPoint, MountPointProce
             }
         }
     }
-    return ProcessMountPoint(mntPoint, params);
+    return ProcessMountPointCommmon(mountPoint, params, true);
 }
 
 int32_t SandboxCore::DoAllCreateOnDaemonMount(const AppSpawningCtx *appProperty, cJSON *appConfig,
@@ -819,8 +809,10 @@ int32_t SandboxCore::DoAllCreateOnDaemonMount(const AppSpawningCtx *appProperty,
         return 0;
     }
 
+    SandboxSectionIR tmpSection;
+    const SandboxSectionIR &sectionIR = SandboxCommon::GetSectionIR(appConfig, tmpSection);
     std::string sandboxRoot = SandboxCommon::GetSandboxRootPath(appProperty, appConfig);
-    bool checkFlag = CheckMountFlag(appProperty, bundleName, appConfig);
+    bool checkFlag = CheckMountFlag(appProperty, bundleName, sectionIR);
 
     MountPointProcessParams mountPointParams = {
         .appProperty = appProperty,
@@ -831,11 +823,11 @@ int32_t SandboxCore::DoAllCreateOnDaemonMount(const AppSpawningCtx *appProperty,
         .bundleName = bundleName
     };
     mountPointParams.isControlledApp = CheckAppMsgFlagsSet(appProperty, APP_FLAGS_CONTROLLED_APP);
-    auto processor = [&mountPointParams](cJSON *mntPoint) {
-        return ProcessCreateOnDaemonMount(mntPoint, mountPointParams);
-    };
-
-    return SandboxCommon::HandleArrayForeach(mountPoints, processor);
+    for (const SandboxMountPointIR &mountPoint : sectionIR.mountPoints) {
+        int ret = ProcessCreateOnDaemonMount(mountPoint, mountPointParams);
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    }
+    return 0;
 }
 
 int32_t SandboxCore::DoAddGid(AppSpawningCtx *appProperty, cJSON *appConfig,
@@ -878,28 +870,28 @@ int32_t SandboxCore::DoAllSymlinkPointslink(const AppSpawningCtx *appProperty, c
         return 0;
     }
 
+    SandboxSectionIR tmpSection;
+    const SandboxSectionIR &sectionIR = SandboxCommon::GetSectionIR(appConfig, tmpSection);
     std::string sandboxRoot = SandboxCommon::GetSandboxRootPath(appProperty, appConfig);
-    auto processor = [&appProperty, &sandboxRoot](cJSON *item) {
-        const char *targetNameChr = GetStringFromJsonObj(item, SandboxCommonDef::g_targetName);
-        const char *linkNameChr = GetStringFromJsonObj(item, SandboxCommonDef::g_linkName);
-        if (targetNameChr == nullptr || linkNameChr == nullptr) {
-            return 0;
+    for (const SandboxSymlinkIR &item : sectionIR.symlinks) {
+        if (item.targetName == nullptr || item.linkName == nullptr) {
+            continue;
         }
-        std::string targetName(targetNameChr);
-        std::string linkName(linkNameChr);
+        std::string targetName(item.targetName);
+        std::string linkName(item.linkName);
         targetName = SandboxCommon::ConvertToRealPath(appProperty, targetName);
         linkName = sandboxRoot + SandboxCommon::ConvertToRealPath(appProperty, linkName);
         MakeDirRec(linkName.c_str(), SandboxCommonDef::DIR_MODE, 0);
         int ret = symlink(targetName.c_str(), linkName.c_str());
-        if (ret && errno != EEXIST && SandboxCommon::IsMountSuccessful(item)) {
+        if (ret && errno != EEXIST && item.checkStatus) {
             APPSPAWN_LOGE("errno is %{public}d, symlink failed, %{public}s", errno, linkName.c_str());
             return -1;
         }
-        SandboxCommon::SetSandboxPathChmod(item, sandboxRoot);
-        return 0;
-    };
-
-    return SandboxCommon::HandleArrayForeach(symlinkPoints, processor);
+        if (item.hasDestMode) {
+            chmod(sandboxRoot.c_str(), item.destMode);
+        }
+    }
+    return 0;
 }
 
 int32_t SandboxCore::DoSandboxRootFolderCreateAdapt(std::string &sandboxPackagePath)
@@ -951,10 +943,8 @@ int32_t SandboxCore::DoSandboxRootFolderCreate(AppSpawnMgr *content, const AppSp
 void SandboxCore::GetSpecialMountCondition(bool &isPreInstalled, bool &isHaveSandBoxPermission,
                                            const AppSpawningCtx *appProperty)
 {
-    const std::string preInstallFlag = "PREINSTALLED_HAP";
-    const std::string customSandBoxFlag = "CUSTOM_SANDBOX_HAP";
-    isPreInstalled = CheckAppMsgFlagsSet(appProperty, SandboxCommon::ConvertFlagStr(preInstallFlag)) != 0;
-    isHaveSandBoxPermission = CheckAppMsgFlagsSet(appProperty, SandboxCommon::ConvertFlagStr(customSandBoxFlag)) != 0;
+    isPreInstalled = CheckAppMsgFlagsSet(appProperty, APP_FLAGS_PRE_INSTALLED_HAP) != 0;
+    isHaveSandBoxPermission = CheckAppMsgFlagsSet(appProperty, APP_FLAGS_CUSTOM_SANDBOX) != 0;
 }
 
 int32_t SandboxCore::MountNonShellPreInstallHap(const AppSpawningCtx *appProperty, cJSON *item)
@@ -990,26 +980,22 @@ int32_t SandboxCore::HandleFlagsPoint(const AppSpawningCtx *appProperty, cJSON *
     }
 
     auto processor = [&appProperty](cJSON *item) {
-        const char *flagsChr = GetStringFromJsonObj(item, SandboxCommonDef::g_flags);
-        if (flagsChr == nullptr) {
+        SandboxSectionIR tmpSection;
+        const SandboxSectionIR &sectionIR = SandboxCommon::GetSectionIR(item, tmpSection);
+        if (sectionIR.flagsName == nullptr) {
             return 0;
         }
-        std::string flagsStr(flagsChr);
-
-        const std::string preInstallFlag = "PREINSTALLED_HAP";
-        const std::string preInstallShellFlag = "PREINSTALLED_SHELL_HAP";
 
-        if (flagsStr == preInstallFlag) {
+        if (strcmp(sectionIR.flagsName, "PREINSTALLED_HAP") == 0) {
             return MountNonShellPreInstallHap(appProperty, item);
         }
 
-        if (flagsStr == preInstallShellFlag) {
+        if (strcmp(sectionIR.flagsName, "PREINSTALLED_SHELL_HAP") == 0) {
             return MountShellPreInstallHap(appProperty, item);
         }
 
-        uint32_t flag = SandboxCommon::ConvertFlagStr(flagsStr);
-        APPSPAWN_LOGV("Convert flag %{public}u from %{public}s", flag, flagsStr.c_str());
-        if (CheckAppMsgFlagsSet(appProperty, flag) == 0) {
+        APPSPAWN_LOGV("Convert flag %{public}u from %{public}s", sectionIR.flags, sectionIR.flagsName);
+        if (CheckAppMsgFlagsSet(appProperty, sectionIR.flags) == 0) {
             return 0;
         }
         DoAllSymlinkPointslink(appProperty, item);
@@ -1223,7 +1209,7 @@ int32_t SandboxCore::SetAppSandboxProperty(AppSpawnMgr *content, AppSpawningCtx
 
 int32_t SandboxCore::SetRenderSandboxPropertyNweb(const AppSpawningCtx *appProperty, std::string &sandboxPackagePath)
 {
-    char *processType = (char *)(GetAppSpawnMsgExtInfo(appProperty->message, MSG_EXT_NAME_PROCESS_TYPE, nullptr));
+    char *processType = (char *)(GetAppSpawnMsgKnownExtInfo(appProperty->message, EXT_TLV_ID_PROCESS_TYPE, nullptr));
     APPSPAWN_CHECK(processType != nullptr, return -1, "Invalid processType data");
     SandboxCommonDef::SandboxConfigType type = CheckAppMsgFlagsSet(appProperty, APP_FLAGS_ISOLATED_SANDBOX_TYPE) ?
         SandboxCommonDef::SANDBOX_ISOLATED_JSON_CONFIG : SandboxCommonDef::SANDBOX_APP_JSON_CONFIG;
@@ -1562,7 +1548,7 @@ int32_t SandboxCore::GetPackageList(AppSpawningCtx *property, std::vector<std::s
     if (GetBundleName(property) == nullptr || SandboxCommon::CheckBundleName(GetBundleName(property)) != 0 ||
         info == nullptr) {
         std::string uid;
-        char *userId = (char *)GetAppSpawnMsgExtInfo(property->message, MSG_EXT_NAME_USERID, nullptr);
+        char *userId = (char *)GetAppSpawnMsgKnownExtInfo(property->message, EXT_TLV_ID_USERID, nullptr);
         if (userId != nullptr) {
             uid = std::string(userId);
         } else {
@@ -1742,8 +1728,8 @@ int32_t SandboxCore::InstallDebugSandbox(AppSpawnMgr *content, AppSpawningCtx *p
     }
 
     uint32_t len = 0;
-    char *provisionType = reinterpret_cast<char *>(GetAppPropertyExt(property,
-        MSG_EXT_NAME_PROVISION_TYPE, &len));
+    char *provisionType = reinterpret_cast<char *>(GetAppPropertyKnownExt(property,
+        EXT_TLV_ID_PROVISION_TYPE, &len));
     if (provisionType == nullptr || len == 0 || strcmp(provisionType, "debug") != 0) {
         return 0;
     }
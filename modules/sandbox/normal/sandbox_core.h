@@ -82,12 +82,14 @@ private:
     static int EnableSandboxNamespace(AppSpawningCtx *appProperty, uint32_t sandboxNsFlags);
     static uint32_t GetAppMsgFlags(const AppSpawningCtx *property);
     static bool CheckMountFlag(const AppSpawningCtx *appProperty, const std::string bundleName,
-                               cJSON *appConfig);
+                               const SandboxSectionIR &section);
     static void UpdateMsgFlagsWithPermission(AppSpawningCtx *appProperty, const std::string &permissionMode,
                                              uint32_t flag);
     static int32_t UpdatePointFlags(AppSpawningCtx *appProperty);
     static std::string GetSandboxPath(const AppSpawningCtx *appProperty, cJSON *mntPoint,
                                       const std::string &section, std::string sandboxRoot);
+    static std::string GetSandboxPath(const AppSpawningCtx *appProperty, const char *tmpSandboxPathChr,
+                                      const std::string &section, const std::string &sandboxRoot);
 
     // 解析挂载信息公共函数
     static cJSON *GetFirstCommonConfig(cJSON *wholeConfig, const char *prefix);
@@ -123,8 +125,10 @@ private:
     // 沙箱回调函数
     static int32_t ProcessMountPoint(cJSON *mntPoint, MountPointProcessParams &params);
     static int32_t ProcessCreateOnDaemonMount(cJSON *mntPoint, MountPointProcessParams &params);
+    static int32_t ProcessCreateOnDaemonMount(const SandboxMountPointIR &mountPoint, MountPointProcessParams &params);
     static int32_t ProcessMountPointNocheck(cJSON *mntPoint, MountPointProcessParams &params);
-    static int32_t ProcessMountPointCommmon(cJSON *mntPoint, MountPointProcessParams &params, bool eableLogging);
+    static int32_t ProcessMountPointCommmon(const SandboxMountPointIR &mountPoint, MountPointProcessParams &params,
+                                            bool eableLogging);
 
     // debug hap
     static std::string ConvertDebugRealPath(const AppSpawningCtx *appProperty, std::string path);
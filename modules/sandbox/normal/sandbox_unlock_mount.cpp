@@ -26,7 +26,7 @@
 #include <atomic>
 #include <chrono>
 #include <algorithm>
-#include <queue>
+#include <deque>
 #include <mutex>
 #include <functional>
 
@@ -47,6 +47,7 @@ constexpr const char *USER_ID_PLACEHOLDER = "<userId>";
 constexpr const char *BUNDLE_NAME_PLACEHOLDER = "<bundleName>";
 
 #define DIR_MODE 0711
+#define UNLOCK_MOUNT_MAX_WORKERS 8U
 
 /**
  * @brief Replace placeholders in path template
@@ -77,24 +78,6 @@ APPSPAWN_STATIC std::string ReplacePlaceholders(const std::string &templateStr,
     return result;
 }
 
-// 单个挂载任务
-struct MountTask {
-    size_t configIndex;    // 挂载点配置索引
-    size_t bundleIndex;    // 应用索引
-};
-
-// 任务队列上下文
-struct MountQueueContext {
-    std::queue<MountTask> taskQueue;         // 任务队列
-    std::mutex queueMutex;                    // 互斥锁
-    const UnlockMountEntry *mountConfig;    // 配置指针
-    std::vector<LockBundleInfo> bundles;    // 应用列表（直接存储，不是指针）
-    std::atomic<int> successCount{0};       // 成功计数
-    std::atomic<int> failCount{0};          // 失败计数
-    std::atomic<int> skipCount{0};           // 跳过计数
-    unsigned int threadCount;                 // 线程数
-};
-
 // Returns mount result for one config entry: {success, fail, skip}
 APPSPAWN_STATIC MountEntryResult MountSingleConfigEntry(const UnlockMountEntry &config, const LockBundleInfo &bundle)
 {
@@ -145,36 +128,77 @@ APPSPAWN_STATIC MountEntryResult MountSingleConfigEntry(const UnlockMountEntry &
     return result;
 }
 
-// 工作队列核心逻辑：从共享队列中获取任务并执行
-APPSPAWN_STATIC void MountQueueWorkerThread(MountQueueContext &ctx, unsigned int workerId)
+static bool PopMountBatch(MountWorkerQueue &queue, size_t &bundleIndex, bool steal)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.batches.empty()) {
+        return false;
+    }
+    if (steal) {
+        bundleIndex = queue.batches.back();
+        queue.batches.pop_back();
+    } else {
+        bundleIndex = queue.batches.front();
+        queue.batches.pop_front();
+    }
+    return true;
+}
+
+// 先取自己队列中的任务，为空时依次从其他线程的队列尾部窃取
+APPSPAWN_STATIC bool GetNextMountBatch(MountQueueContext &ctx, unsigned int workerId, size_t &bundleIndex)
 {
-    size_t processedTasks = 0;
-    MountTask task;
-
-    while (true) {
-        // 从队列中获取任务（加锁保护）
-        {
-            std::lock_guard<std::mutex> lock(ctx.queueMutex);
-            if (ctx.taskQueue.empty()) {
-                // 队列为空，退出
-                break;
-            }
-            task = ctx.taskQueue.front();
-            ctx.taskQueue.pop();
+    if (PopMountBatch(ctx.queues[workerId], bundleIndex, false)) {
+        return true;
+    }
+    for (unsigned int i = 1; i < ctx.threadCount; i++) {
+        if (PopMountBatch(ctx.queues[(workerId + i) % ctx.threadCount], bundleIndex, true)) {
+            return true;
         }
+    }
+    return false;
+}
 
-        // 执行挂载任务（无需锁，避免阻塞其他线程）
-        const LockBundleInfo &bundle = ctx.bundles[task.bundleIndex];
-        auto r = MountSingleConfigEntry(ctx.mountConfig[task.configIndex], bundle);
-        ctx.successCount.fetch_add(r.success, std::memory_order_relaxed);
-        ctx.failCount.fetch_add(r.fail, std::memory_order_relaxed);
-        ctx.skipCount.fetch_add(r.skip, std::memory_order_relaxed);
+// 同一应用的全部挂载点在同一线程上按配置顺序执行
+static void MountBundleBatch(MountQueueContext &ctx, size_t bundleIndex)
+{
+    const LockBundleInfo &bundle = ctx.bundles[bundleIndex];
+    MountEntryResult total = {0};
+    for (size_t i = 0; i < ctx.configSize; i++) {
+        auto r = MountSingleConfigEntry(ctx.mountConfig[i], bundle);
+        total.success += r.success;
+        total.fail += r.fail;
+        total.skip += r.skip;
+    }
+    ctx.successCount.fetch_add(total.success, std::memory_order_relaxed);
+    ctx.failCount.fetch_add(total.fail, std::memory_order_relaxed);
+    ctx.skipCount.fetch_add(total.skip, std::memory_order_relaxed);
+
+    if (bundleIndex < ctx.runningCount && ctx.runningPending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        auto now = std::chrono::steady_clock::now();
+        ctx.runningDuration.store(
+            std::chrono::duration_cast<std::chrono::milliseconds>(now - ctx.mountStart).count(),
+            std::memory_order_relaxed);
+    }
+}
 
-        processedTasks++;
+// 工作队列核心逻辑：按应用批次取任务并执行，自己的队列为空时窃取其他线程的任务
+APPSPAWN_STATIC void MountQueueWorkerThread(MountQueueContext &ctx, unsigned int workerId)
+{
+    size_t processedBatches = 0;
+    size_t bundleIndex = 0;
+    while (GetNextMountBatch(ctx, workerId, bundleIndex)) {
+        MountBundleBatch(ctx, bundleIndex);
+        processedBatches++;
     }
 
-    APPSPAWN_LOGV("MountQueueWorkerThread[%{public}u]: processed %{public}zu tasks",
-                  workerId, processedTasks);
+    APPSPAWN_LOGV("MountQueueWorkerThread[%{public}u]: processed %{public}zu bundles",
+                  workerId, processedBatches);
+}
+
+static void CollectRunningUid(const AppSpawnMgr *mgr, AppSpawnedProcess *appInfo, void *data)
+{
+    (void)mgr;
+    static_cast<std::set<uint32_t> *>(data)->insert(appInfo->uid);
 }
 
 /**
@@ -202,29 +226,32 @@ APPSPAWN_STATIC std::unique_ptr<MountQueueContext> CreateMountContext(int uid)
     ReportKeyEvent(UNLOCK_MOUNT_SCAN_DONE);
 #endif
 
+    // 已运行（appQueue中）的应用排在前面，优先挂载
+    std::set<uint32_t> runningUids;
+    TraversalSpawnedProcess(CollectRunningUid, &runningUids);
+    auto runningEnd = std::stable_partition(filteredBundles.begin(), filteredBundles.end(),
+        [&runningUids](const LockBundleInfo &bundle) { return runningUids.count(bundle.uid) != 0; });
+    size_t runningCount = static_cast<size_t>(runningEnd - filteredBundles.begin());
+
     // Calculate thread count
-    unsigned int threadCount = std::min(
+    unsigned int hardwareCount = std::thread::hardware_concurrency();
+    unsigned int threadCount = std::min({
         static_cast<unsigned int>(filteredBundles.size()),
-        std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 4
-    );
-
-    // Get mount configuration
-    size_t configSize = 0;
-    const UnlockMountEntry* mountConfig = GetUnlockMountEntry(&configSize);
-
-    // Build task queue: all (configIndex, bundleIndex) combinations
-    std::queue<MountTask> taskQueue;
-    for (size_t i = 0; i < configSize; i++) {
-        for (size_t j = 0; j < filteredBundles.size(); j++) {
-            taskQueue.push({i, j});
-        }
-    }
+        hardwareCount > 0 ? hardwareCount : 4,
+        UNLOCK_MOUNT_MAX_WORKERS
+    });
 
     // Create context
     auto ctx = std::make_unique<MountQueueContext>();
-    ctx->taskQueue = std::move(taskQueue);
+    ctx->mountConfig = GetUnlockMountEntry(&ctx->configSize);
+    ctx->queues = std::vector<MountWorkerQueue>(threadCount);
+    // 按应用轮流分给各线程，每个线程的队列头部都是已运行的应用
+    for (size_t i = 0; i < filteredBundles.size(); i++) {
+        ctx->queues[i % threadCount].batches.push_back(i);
+    }
     ctx->bundles = std::move(filteredBundles);
-    ctx->mountConfig = mountConfig;
+    ctx->runningCount = runningCount;
+    ctx->runningPending.store(runningCount, std::memory_order_relaxed);
     ctx->threadCount = threadCount;
 
     return ctx;
@@ -235,9 +262,9 @@ int DoSharedMountForUser(int uid)
     APPSPAWN_LOGI("DoSharedMountForUser start, uid=%{public}d, g_lockBundleMap.size=%{public}zu",
                   uid, GetLockBundleMapSize());
 
-    auto mountStart = std::chrono::steady_clock::now();
+    auto scanStart = std::chrono::steady_clock::now();
 
-    // Create mount context (includes getting bundles, filtering, building task queue)
+    // Create mount context (includes getting bundles, filtering, building task queues)
     auto ctx = CreateMountContext(uid);
     if (ctx == nullptr) {
 #ifdef APPSPAWN_HISYSEVENT
@@ -246,11 +273,16 @@ int DoSharedMountForUser(int uid)
         return 0;
     }
 
-    // Create worker threads
+    ctx->mountStart = std::chrono::steady_clock::now();
+    int64_t scanDuration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(ctx->mountStart - scanStart).count();
+
+    // 父进程之后还要fork，工作线程只在本次挂载期间存在；当前线程作为0号工作线程
     std::vector<std::thread> workers;
-    for (unsigned int i = 0; i < ctx->threadCount; i++) {
+    for (unsigned int i = 1; i < ctx->threadCount; i++) {
         workers.emplace_back(MountQueueWorkerThread, std::ref(*ctx), i);
     }
+    MountQueueWorkerThread(*ctx, 0);
 
     // Wait for all threads to complete
     for (auto &worker : workers) {
@@ -258,14 +290,16 @@ int DoSharedMountForUser(int uid)
     }
 
     auto mountEnd = std::chrono::steady_clock::now();
-    int64_t duration = std::chrono::duration_cast<std::chrono::milliseconds>(mountEnd - mountStart).count();
+    int64_t duration = std::chrono::duration_cast<std::chrono::milliseconds>(mountEnd - scanStart).count();
+    int64_t runningDuration = ctx->runningDuration.load();
 
-    APPSPAWN_LOGI("DoSharedMountForUser done, %{public}d, %{public}d, %{public}d, %{public}d, %{public}" PRId64 " ms",
+    APPSPAWN_LOGI("DoSharedMountForUser done, %{public}d, %{public}d, %{public}d, %{public}d, %{public}" PRId64
+                  " ms, scan %{public}" PRId64 " ms, running %{public}zu apps %{public}" PRId64 " ms",
                   uid, ctx->successCount.load(), ctx->failCount.load(),
-                  ctx->skipCount.load(), duration);
+                  ctx->skipCount.load(), duration, scanDuration, ctx->runningCount, runningDuration);
 #ifdef APPSPAWN_HISYSEVENT
     ReportUnlockMountResult(uid, static_cast<int32_t>(ctx->bundles.size()),
-        ctx->successCount.load(), ctx->failCount.load(), duration);
+        ctx->successCount.load(), ctx->failCount.load(), duration, scanDuration, runningDuration);
 #endif
     return 0;
 }
@@ -29,6 +29,14 @@ int HandleUnlockMountForUser(AppSpawnMgr *mgr);
 #ifdef __cplusplus
 }
 
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "sandbox_shared_mount.h"
+
 // Mount result structure
 struct MountEntryResult {
     int success;
@@ -36,5 +44,27 @@ struct MountEntryResult {
     int skip;
 };
 
+// 每个工作线程的任务队列，元素为应用索引；自己从头部取，窃取时从尾部取
+struct MountWorkerQueue {
+    std::deque<size_t> batches;
+    std::mutex mutex;
+};
+
+// 任务队列上下文
+struct MountQueueContext {
+    std::vector<MountWorkerQueue> queues;   // 每个工作线程一个队列
+    const UnlockMountEntry *mountConfig;    // 配置指针
+    size_t configSize;                      // 配置数量
+    std::vector<LockBundleInfo> bundles;    // 应用列表（直接存储，不是指针），已运行的应用排在前面
+    size_t runningCount;                    // bundles中已运行的应用数
+    std::atomic<size_t> runningPending{0};  // 未完成挂载的已运行应用数
+    std::atomic<int64_t> runningDuration{0};  // 已运行应用全部挂载完成的耗时
+    std::chrono::steady_clock::time_point mountStart;
+    std::atomic<int> successCount{0};       // 成功计数
+    std::atomic<int> failCount{0};          // 失败计数
+    std::atomic<int> skipCount{0};           // 跳过计数
+    unsigned int threadCount;                 // 线程数
+};
+
 #endif
 #endif // SANDBOX_UNLOCK_MOUNT_H
@@ -83,6 +83,8 @@ static void DeleteAppSpawnMsgInternal(AppSpawnMsgNode **msgNode)
 
 // Global spawnId (will be initialized in SpmPreloadHook)
 static uint32_t g_spawnId = 0;
+// Permission opcode table is built only once, lookups fall back to scanning the queue on failure
+static bool g_opcodeTableInited = false;
 
 // SpawnId definitions for different spawn modes
 #define SPAWN_ID_APP       1   // Application spawn
@@ -279,6 +281,11 @@ static int ComputePermissionFlags(const AppSpawnMgr *mgr,
     const SandboxQueue *permQueue = mgr->content.permissionQueue;
     APPSPAWN_CHECK(permQueue != NULL, return -1,
         "Failed to get permission queue from AppSpawnContent");
+    if (!g_opcodeTableInited) {
+        // 预加载时权限队列可能还未挂到content上，首次重建消息时补建
+        (void)BuildPermissionOpcodeTable(permQueue);
+        g_opcodeTableInited = true;
+    }
 
     // Compute maxCount from permQueue length: ceil(queueLen / 32) bitmap words
     uint32_t queueLen = (uint32_t)OH_ListGetCnt(&permQueue->front);
@@ -1106,8 +1113,8 @@ static void BuildAndReplaceMessage(AppSpawnMsgNode *oldMsg,
     APPSPAWN_CHECK(ret == 0, FreeTlvEntries(&entryList);
         return, "BuildAndReplaceMessage: Failed to write TLVs (ret=%{public}d), using original message", ret);
 
-    // Replace message
-    DeleteAppSpawnMsgInternal(&oldMsg);
+    // Replace message, the received message may live in a recycled arena, so it must be freed by appspawn
+    DeleteAppSpawnMsg(&oldMsg);
     ctx->message = newMsg;
 
     FreeTlvEntries(&entryList);
@@ -1330,6 +1337,11 @@ APPSPAWN_STATIC int SpmPreloadHook(AppSpawnMgr *mgr)
         APPSPAWN_LOGW("CleanupStaleSpawns failed (ret=%{public}d)", ret);
     }
 
+    if (mgr->content.permissionQueue != NULL) {
+        (void)BuildPermissionOpcodeTable(mgr->content.permissionQueue);
+        g_opcodeTableInited = true;
+    }
+
     APPSPAWN_LOGI("SPM module initialized successfully");
     return 0;
 }
@@ -15,10 +15,79 @@
 #include "spm_permission.h"
 #include "appspawn_utils.h"
 
+#define PERM_BITS_PER_WORD 32
+#define PERM_OPCODE_LIMIT (MAX_PERM_BIT_MAP_SIZE * PERM_BITS_PER_WORD)  // 内核位图能表示的opcode上限
+
+typedef struct {
+    const SandboxQueue *queue;  // 建表时的权限队列，不一致时退回遍历队列
+    uint32_t opcodeCount;  // 最大opcode + 1
+    const SandboxPermissionNode **nodes;  // 按opcode直接索引
+} PermissionOpcodeTable;
+
+static PermissionOpcodeTable g_opcodeTable = {NULL, 0, NULL};
+
+static const PermissionOpcodeTable *GetPermissionOpcodeTable(const SandboxQueue *queue)
+{
+    return (queue != NULL && g_opcodeTable.queue == queue) ? &g_opcodeTable : NULL;
+}
+
+void ClearPermissionOpcodeTable(void)
+{
+    free((void *)g_opcodeTable.nodes);
+    g_opcodeTable.nodes = NULL;
+    g_opcodeTable.opcodeCount = 0;
+    g_opcodeTable.queue = NULL;
+}
+
+int32_t BuildPermissionOpcodeTable(const SandboxQueue *queue)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(queue != NULL, return -1);
+    ClearPermissionOpcodeTable();
+
+    uint32_t opcodeCount = 0;
+    ListNode *node = queue->front.next;
+    while (node != &queue->front) {
+        const SandboxPermissionNode *permNode =
+            (const SandboxPermissionNode *)ListEntry(node, SandboxMountNode, node);
+        if (permNode->opcode < PERM_OPCODE_LIMIT && permNode->opcode >= opcodeCount) {
+            opcodeCount = permNode->opcode + 1;
+        }
+        node = node->next;
+    }
+
+    const SandboxPermissionNode **nodes = NULL;
+    if (opcodeCount > 0) {
+        nodes = (const SandboxPermissionNode **)calloc(opcodeCount, sizeof(SandboxPermissionNode *));
+        APPSPAWN_CHECK(nodes != NULL, return -1, "Failed to alloc opcode table %{public}u", opcodeCount);
+    }
+    node = queue->front.next;
+    while (node != &queue->front) {
+        const SandboxPermissionNode *permNode =
+            (const SandboxPermissionNode *)ListEntry(node, SandboxMountNode, node);
+        node = node->next;
+        if (permNode->opcode >= opcodeCount) {  // OPCODE_INVALID 或超出位图范围
+            continue;
+        }
+        // 多个权限对应同一opcode时无法直接映射，保持遍历队列
+        APPSPAWN_CHECK(nodes[permNode->opcode] == NULL, free((void *)nodes); return -1,
+            "Duplicate permission opcode %{public}u", permNode->opcode);
+        nodes[permNode->opcode] = permNode;
+    }
+    g_opcodeTable.nodes = nodes;
+    g_opcodeTable.opcodeCount = opcodeCount;
+    g_opcodeTable.queue = queue;
+    APPSPAWN_LOGI("Build permission opcode table, opcodeCount: %{public}u", opcodeCount);
+    return 0;
+}
+
 const SandboxPermissionNode *GetPermissionNodeByOpcode(const SandboxQueue *queue, uint32_t opcode)
 {
     APPSPAWN_CHECK_ONLY_EXPER(queue != NULL, return NULL);
 
+    const PermissionOpcodeTable *table = GetPermissionOpcodeTable(queue);
+    if (table != NULL && opcode < PERM_OPCODE_LIMIT) {
+        return opcode < table->opcodeCount ? table->nodes[opcode] : NULL;
+    }
     ListNode *node = queue->front.next;
     while (node != &queue->front) {
         const SandboxPermissionNode *permissionNode =
@@ -44,6 +113,38 @@ const char *GetPermissionNameByOpcode(const SandboxQueue *queue, uint32_t opcode
     return NULL;
 }
 
+// 只遍历位图中已置位的opcode，按表直接找到权限节点
+static uint32_t GetSpawnFlagIndexesFromOpcodeTable(const PermissionOpcodeTable *table,
+    const uint32_t perms[MAX_PERM_BIT_MAP_SIZE], uint32_t *flagIndexes, uint32_t maxWords)
+{
+    uint32_t grantedCount = 0;
+    for (uint32_t bitmapIndex = 0; bitmapIndex < MAX_PERM_BIT_MAP_SIZE &&
+        bitmapIndex * PERM_BITS_PER_WORD < table->opcodeCount; bitmapIndex++) {
+        uint32_t bits = perms[bitmapIndex];
+        while (bits != 0) {
+            uint32_t opcode = bitmapIndex * PERM_BITS_PER_WORD + (uint32_t)__builtin_ctz(bits);
+            bits &= bits - 1;
+            if (opcode >= table->opcodeCount) {
+                break;
+            }
+            const SandboxPermissionNode *permNode = table->nodes[opcode];
+            if (permNode == NULL) {
+                continue;
+            }
+            uint32_t wordIdx = (uint32_t)permNode->permissionIndex / PERM_BITS_PER_WORD;
+            uint32_t bitIdx = (uint32_t)permNode->permissionIndex % PERM_BITS_PER_WORD;
+            if (wordIdx < maxWords) {
+                flagIndexes[wordIdx] |= (1U << bitIdx);
+                grantedCount++;
+            }
+            APPSPAWN_LOGV("GetSpawnFlagIndexesFromOpcodeTable: permission opcode=%{public}u, "
+                          "permIndex=%{public}d is granted, word[%{public}u] bit[%{public}u]",
+                          opcode, permNode->permissionIndex, wordIdx, bitIdx);
+        }
+    }
+    return grantedCount;
+}
+
 int32_t GetSpawnFlagIndexesFromPermissionBitmap(const SandboxQueue *queue,
     const uint32_t perms[MAX_PERM_BIT_MAP_SIZE], uint32_t *flagIndexes, uint32_t flagCount)
 {
@@ -52,6 +153,13 @@ int32_t GetSpawnFlagIndexesFromPermissionBitmap(const SandboxQueue *queue,
 
     uint32_t maxWords = flagCount;
     uint32_t grantedCount = 0;
+    const PermissionOpcodeTable *table = GetPermissionOpcodeTable(queue);
+    if (table != NULL) {
+        grantedCount = GetSpawnFlagIndexesFromOpcodeTable(table, perms, flagIndexes, maxWords);
+        APPSPAWN_LOGI("GetSpawnFlagIndexesFromPermissionBitmap: %{public}u granted permissions, "
+                      "maxWords=%{public}u", grantedCount, maxWords);
+        return 0;
+    }
 
     // flagIndexes is a bitmap: each word covers 32 permission bits
     // permissionIndex / 32 = word index, permissionIndex % 32 = bit position
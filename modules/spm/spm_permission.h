@@ -22,6 +22,14 @@
 extern "C" {
 #endif
 
+/**
+ * @brief 按 opcode 建立权限节点直接索引表，之后对同一队列的查询不再遍历队列
+ *        队列在建表后不可修改；存在重复 opcode 时建表失败，查询退回遍历队列
+ */
+int32_t BuildPermissionOpcodeTable(const SandboxQueue *queue);
+
+void ClearPermissionOpcodeTable(void);
+
 const SandboxPermissionNode *GetPermissionNodeByOpcode(const SandboxQueue *queue, uint32_t opcode);
 
 const char *GetPermissionNameByOpcode(const SandboxQueue *queue, uint32_t opcode);
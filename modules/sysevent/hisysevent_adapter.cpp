@@ -34,6 +34,9 @@ constexpr const char* SPAWN_ABNORMAL_DURATION = "SPAWN_ABNORMAL_DURATION";
 
 // statistic event
 constexpr const char* SPAWN_PROCESS_DURATION = "SPAWN_PROCESS_DURATION";
+constexpr const char* SPAWN_HOOK_DURATION = "SPAWN_HOOK_DURATION";
+constexpr const char* SPAWN_PROCESS_LATENCY = "SPAWN_PROCESS_LATENCY";
+constexpr const char* SPAWN_SANDBOX_MOUNT_STAT = "SPAWN_SANDBOX_MOUNT_STAT";
 
 // param
 constexpr const char* PROCESS_NAME = "PROCESS_NAME";
@@ -53,6 +56,8 @@ constexpr const char* APP_COUNT = "APP_COUNT";
 constexpr const char* SUCCESS_COUNT = "SUCCESS_COUNT";
 constexpr const char* FAIL_COUNT = "FAIL_COUNT";
 constexpr const char* BUNDLE_NAME = "BUNDLE_NAME";
+constexpr const char* SCAN_DURATION = "SCAN_DURATION";
+constexpr const char* RUNNING_APP_DURATION = "RUNNING_APP_DURATION";
 constexpr const char* UNLOCK_MOUNT_ALL_DONE = "UNLOCK_MOUNT_ALL_DONE";
 constexpr const char* UNLOCK_MOUNT_APP_FAIL = "UNLOCK_MOUNT_APP_FAIL";
 
@@ -63,6 +68,21 @@ constexpr const char* EVENTCOUNT = "EVENTCOUNT";
 constexpr const char* STAGE = "STAGE";
 constexpr const char* BOOTSTAGE = "BOOTSTAGE";
 constexpr const char* BOOTFINISHEDSTAGE = "BOOTFINISHEDSTAGE";
+constexpr const char* HOOK_STAGE = "HOOK_STAGE";
+constexpr const char* HOOK_PRIO = "HOOK_PRIO";
+constexpr const char* AVGDURATION = "AVGDURATION";
+constexpr const char* LATENCY_DIMENSION = "LATENCY_DIMENSION";
+constexpr const char* LATENCY_INDEX = "LATENCY_INDEX";
+constexpr const char* P50DURATION = "P50DURATION";
+constexpr const char* P90DURATION = "P90DURATION";
+constexpr const char* P99DURATION = "P99DURATION";
+constexpr const char* MOUNT_DIMENSION = "MOUNT_DIMENSION";
+constexpr const char* MOUNT_INDEX = "MOUNT_INDEX";
+constexpr const char* ATTEMPT_COUNT = "ATTEMPT_COUNT";
+constexpr const char* SKIP_COUNT = "SKIP_COUNT";
+constexpr uint32_t PERMILLE_P50 = 500;
+constexpr uint32_t PERMILLE_P90 = 900;
+constexpr uint32_t PERMILLE_P99 = 990;
 
 // cpu event
 static constexpr char PERFORMANCE_DOMAIN[] = "PERFORMANCE";
@@ -191,11 +211,113 @@ void ReportSpawnProcessDuration(AppSpawnHisysevent *hisysevent, const char* stag
     APPSPAWN_CHECK_ONLY_LOG(ret == 0, "ReportSpawnProcessDuration error, ret: %{public}d", ret);
 }
 
+static void ReportSpawnHookCost(int32_t stage, int32_t prio, const SpawnCostStat *stat)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(stat->count != 0, return);
+    int ret = HiSysEventWrite(HiSysEvent::Domain::APPSPAWN, SPAWN_HOOK_DURATION,
+        HiSysEvent::EventType::STATISTIC,
+        HOOK_STAGE, stage,
+        HOOK_PRIO, prio,
+        MAXDURATION, stat->maxUs,
+        AVGDURATION, stat->totalUs / stat->count,
+        EVENTCOUNT, stat->count);
+
+    APPSPAWN_CHECK_ONLY_LOG(ret == 0, "ReportSpawnHookCost error, ret: %{public}d", ret);
+}
+
+static void ReportSandboxMountCount(const char *dimension, int32_t index, uint32_t spawnCount,
+    const SandboxMountCount *count, uint64_t costNs)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(count->attempted != 0 || count->skipped != 0, return);
+    int ret = HiSysEventWrite(HiSysEvent::Domain::APPSPAWN, SPAWN_SANDBOX_MOUNT_STAT,
+        HiSysEvent::EventType::STATISTIC,
+        MOUNT_DIMENSION, dimension,
+        MOUNT_INDEX, index,
+        ATTEMPT_COUNT, count->attempted,
+        SUCCESS_COUNT, count->succeeded,
+        FAIL_COUNT, count->failed,
+        SKIP_COUNT, count->skipped,
+        TOTALDURATION, costNs,
+        EVENTCOUNT, spawnCount);
+
+    APPSPAWN_CHECK_ONLY_LOG(ret == 0, "ReportSandboxMountCount error, ret: %{public}d", ret);
+}
+
+// sandbox mount counters by section type / mount category and syscall cost, see AddSandboxMountStat
+static void ReportSandboxMountStat(const ChildTimingStat *timingStat)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(timingStat->sandboxCount != 0, return);
+    const SandboxMountStat *stat = &timingStat->sandbox;
+    for (int32_t i = 0; i < SANDBOX_STAT_SECTION_MAX; i++) {
+        ReportSandboxMountCount("SECTION", i, timingStat->sandboxCount, &stat->section[i], 0);
+    }
+    for (int32_t i = 0; i < SANDBOX_STAT_CATEGORY_MAX; i++) {
+        ReportSandboxMountCount("CATEGORY", i, timingStat->sandboxCount, &stat->category[i], 0);
+    }
+    for (int32_t i = 0; i < SANDBOX_STAT_OP_MAX; i++) {
+        SandboxMountCount count = {stat->opCount[i], 0, 0, 0};
+        ReportSandboxMountCount("OP", i, timingStat->sandboxCount, &count, stat->opCostNs[i]);
+    }
+}
+
+// per stage (prio -1) and per hook cost reported by child processes, see AddChildTimingStat
+static void ReportChildTimingStat(void)
+{
+    AppSpawnMgr *mgr = GetAppSpawnMgr();
+    APPSPAWN_CHECK_ONLY_EXPER(mgr != nullptr, return);
+    const ChildTimingStat *timingStat = &mgr->childTimingStat;
+    for (uint32_t i = 0; i < CHILD_TIMING_STAGE_COUNT; i++) {
+        ReportSpawnHookCost(static_cast<int32_t>(CHILD_TIMING_STAGE_BEGIN + i), -1, &timingStat->stage[i]);
+    }
+    for (uint32_t i = 0; i < timingStat->hookCount; i++) {
+        ReportSpawnHookCost(timingStat->hooks[i].stage, timingStat->hooks[i].prio, &timingStat->hooks[i].cost);
+    }
+    ReportSandboxMountStat(timingStat);
+    (void)memset_s(&mgr->childTimingStat, sizeof(mgr->childTimingStat), 0, sizeof(mgr->childTimingStat));
+}
+
+static void ReportSpawnLatencyHist(const char *dimension, int32_t index, const SpawnLatencyHist *hist)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(hist->count != 0, return);
+    int ret = HiSysEventWrite(HiSysEvent::Domain::APPSPAWN, SPAWN_PROCESS_LATENCY,
+        HiSysEvent::EventType::STATISTIC,
+        LATENCY_DIMENSION, dimension,
+        LATENCY_INDEX, index,
+        P50DURATION, GetSpawnLatencyPercentile(hist, PERMILLE_P50),
+        P90DURATION, GetSpawnLatencyPercentile(hist, PERMILLE_P90),
+        P99DURATION, GetSpawnLatencyPercentile(hist, PERMILLE_P99),
+        MAXDURATION, hist->maxUs,
+        AVGDURATION, hist->totalUs / hist->count,
+        EVENTCOUNT, hist->count);
+
+    APPSPAWN_CHECK_ONLY_LOG(ret == 0, "ReportSpawnLatencyHist error, ret: %{public}d", ret);
+}
+
+// spawn latency histograms by mode / boot phase / msg type, see AddSpawnLatency
+static void ReportSpawnLatencyStat(void)
+{
+    AppSpawnMgr *mgr = GetAppSpawnMgr();
+    APPSPAWN_CHECK_ONLY_EXPER(mgr != nullptr, return);
+    const SpawnLatencyStat *stat = &mgr->latencyStat;
+    for (int32_t i = 0; i < SPAWN_LATENCY_MODE_MAX; i++) {
+        ReportSpawnLatencyHist("MODE", i, &stat->mode[i]);
+    }
+    for (int32_t i = 0; i < 2; i++) {  // 2: booting and boot finished
+        ReportSpawnLatencyHist("PHASE", i, &stat->phase[i]);
+    }
+    for (int32_t i = 0; i < MAX_TYPE_INVALID; i++) {
+        ReportSpawnLatencyHist("MSG_TYPE", i, &stat->msgType[i]);
+    }
+    (void)memset_s(&mgr->latencyStat, sizeof(mgr->latencyStat), 0, sizeof(mgr->latencyStat));
+}
+
 void ReportSpawnStatisticDuration(const TimerHandle taskHandle, void *content)
 {
     AppSpawnHisyseventInfo *hisyseventInfo = static_cast<AppSpawnHisyseventInfo *>(content);
     ReportSpawnProcessDuration(&hisyseventInfo->bootEvent, BOOTSTAGE);
     ReportSpawnProcessDuration(&hisyseventInfo->manualEvent, BOOTFINISHEDSTAGE);
+    ReportChildTimingStat();
+    ReportSpawnLatencyStat();
 
     InitStatisticEventInfo(hisyseventInfo);
 }
@@ -266,7 +388,8 @@ void ReportMountFull(int32_t errCode, int32_t nsMountCount, int32_t deviceMountC
     APPSPAWN_CHECK_ONLY_LOG(ret == 0, "ReportMountFull error, ret: %{public}d", ret);
 }
 
-void ReportUnlockMountResult(int32_t uid, int32_t totalCount, int32_t successCount, int32_t failCount, int64_t duration)
+void ReportUnlockMountResult(int32_t uid, int32_t totalCount, int32_t successCount, int32_t failCount,
+    int64_t duration, int64_t scanDuration, int64_t runningDuration)
 {
     int ret = HiSysEventWrite(HiSysEvent::Domain::APPSPAWN, UNLOCK_MOUNT_ALL_DONE,
         HiSysEvent::EventType::STATISTIC,
@@ -274,7 +397,9 @@ void ReportUnlockMountResult(int32_t uid, int32_t totalCount, int32_t successCou
         APP_COUNT, totalCount,
         SUCCESS_COUNT, successCount,
         FAIL_COUNT, failCount,
-        DURATION, duration);
+        DURATION, duration,
+        SCAN_DURATION, scanDuration,
+        RUNNING_APP_DURATION, runningDuration);
 
     APPSPAWN_CHECK_ONLY_LOG(ret == 0, "ReportUnlockMountResult error, ret: %{public}d", ret);
 }
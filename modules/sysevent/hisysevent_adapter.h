@@ -130,7 +130,7 @@ void ReportMountFull(int32_t errCode, int32_t nsMountCount, int32_t deviceMountC
 
 // Unlock mount event report functions (structured events with queryable params)
 void ReportUnlockMountResult(int32_t uid, int32_t totalCount,
-    int32_t successCount, int32_t failCount, int64_t duration);
+    int32_t successCount, int32_t failCount, int64_t duration, int64_t scanDuration, int64_t runningDuration);
 void ReportUnlockMountAppFail(int32_t uid, const char *bundleName,
     const char *srcPath, const char *destPath, int32_t errorCode);
 
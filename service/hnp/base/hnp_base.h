@@ -24,6 +24,7 @@
 #include "securec.h"
 
 #include "contrib/minizip/zip.h"
+#include "contrib/minizip/unzip.h"
 
 #ifndef HNP_CLI
 
@@ -328,14 +329,18 @@ int GetRealPath(char *srcPath, char *realPath);
 
 int HnpZip(const char *inputDir, zipFile zf);
 
-int HnpUnZip(const char *inputFile, const char *outputDir, const char *hnpSignKeyPrefix,
+int HnpUnZipOpen(const char *inputFile, unzFile *zipFile);
+
+void HnpUnZipClose(unzFile *zipFile);
+
+int HnpUnZip(unzFile zipFile, const char *inputFile, const char *outputDir, const char *hnpSignKeyPrefix,
     HnpSignMapInfo *hnpSignMapInfos, int *count);
 
 int HnpAddFileToZip(zipFile zf, char *filename, char *buff, int size);
 
 void HnpLogPrintf(int logLevel, char *module, const char *format, ...);
 
-int HnpCfgGetFromZip(const char *inputFile, HnpCfgInfo *hnpCfg);
+int HnpCfgGetFromZip(unzFile zipFile, const char *inputFile, HnpCfgInfo *hnpCfg);
 
 bool CanRecovery(const char *hnpPackageName, HnpCfgInfo *hnpcfgInfo);
 
@@ -363,13 +368,19 @@ int HnpPackageInfoDelete(const char *packageName, int uid);
 
 char *HnpCurrentVersionUninstallCheck(const char *name, int uid);
 
-int HnpFileCountGet(const char *path, int *count);
+int HnpFileCountGet(unzFile zipFile, int *count);
 
 int HnpPathFileCount(const char *path);
 
 char *HnpCurrentVersionGet(const char *name, int uid);
 
 int DoRebuildHnpInfoCfg(int uid);
+
+/* hnp_info事务：Begin与End之间的增删只修改内存文档，End时一次原子落盘，需与查询接口串行调用 */
+int HnpPackageInfoTransBegin(int uid);
+
+int HnpPackageInfoTransEnd(int uid);
+
 typedef int32_t (*ProcessHnpInstall)(BssString bundleName, BssString appIdentifier, int32_t userId, HnpFiles hnpFiles);
 
 typedef int32_t (*ProcessHnpUninstall)(BssString bundleName, int32_t userId);
@@ -13,6 +13,8 @@
  * limitations under the License.
  */
 
+#include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
@@ -180,6 +182,210 @@ int GetHnpJsonBuff(HnpCfgInfo *hnpCfg, char **buff)
     return 0;
 }
 
+/* hnp_info事务缓存，事务内的增删仅修改内存文档，结束时一次性落盘；调用者需保证串行访问 */
+typedef struct {
+    int uid;
+    int depth;              // 事务嵌套层数，0表示未开启事务
+    bool dirty;
+    cJSON *json;
+} HnpPackageInfoStore;
+
+static HnpPackageInfoStore g_hnpPackageInfoStore = {0};
+
+static bool HnpPackageInfoStoreHit(int uid)
+{
+    return (g_hnpPackageInfoStore.depth > 0) && (g_hnpPackageInfoStore.uid == uid);
+}
+
+typedef struct {
+    int hapIndex;
+    int hnpIndex;
+    const char *hap;        // 当前hnp项所属的hap包名
+    cJSON *hnpItem;
+} HnpPackageItemIter;
+
+/* 按文档顺序查找下一个名称为name的hnp项，iter首次使用前需置零 */
+static bool HnpPackageItemNext(cJSON *json, const char *name, HnpPackageItemIter *iter)
+{
+    for (; iter->hapIndex < cJSON_GetArraySize(json); iter->hapIndex++, iter->hnpIndex = 0) {
+        cJSON *hapItem = cJSON_GetArrayItem(json, iter->hapIndex);
+        cJSON *hapJson = cJSON_GetObjectItem(hapItem, HAP_PACKAGE_INFO_HAP_PREFIX);
+        cJSON *hnpItemArr = cJSON_GetObjectItem(hapItem, HAP_PACKAGE_INFO_HNP_PREFIX);
+        if (!cJSON_IsString(hapJson) || (hapJson->valuestring == NULL) || !cJSON_IsArray(hnpItemArr)) {
+            continue;
+        }
+        while (iter->hnpIndex < cJSON_GetArraySize(hnpItemArr)) {
+            cJSON *hnpItem = cJSON_GetArrayItem(hnpItemArr, iter->hnpIndex++);
+            cJSON *nameJson = cJSON_GetObjectItem(hnpItem, HAP_PACKAGE_INFO_NAME_PREFIX);
+            if (cJSON_IsString(nameJson) && (nameJson->valuestring != NULL) &&
+                (strcmp(nameJson->valuestring, name) == 0)) {
+                iter->hap = hapJson->valuestring;
+                iter->hnpItem = hnpItem;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static int HnpPackageJsonRead(cJSON **pJson, int uid)
+{
+    char *infoStream;
+    int size;
+
+    char cfgPath[PATH_MAX] = {0};
+    int ret = snprintf_s(cfgPath, PATH_MAX, PATH_MAX - 1, HNP_PACKAGE_INFO_JSON_FILE_PATH, uid);
+    HNP_ERROR_CHECK(ret > 0, return HNP_ERRNO_BASE_SPRINTF_FAILED, "build cfg path failed");
+    ret = ReadFileToStream(cfgPath, &infoStream, &size);
+    if (ret != 0) {
+        if (ret == HNP_ERRNO_BASE_FILE_OPEN_FAILED || ret == HNP_ERRNO_BASE_GET_FILE_LEN_NULL) {
+            return 0;
+        }
+        HNP_LOGE("package info get read hnp info file unsuccess");
+        return HNP_ERRNO_BASE_READ_FILE_STREAM_FAILED;
+    }
+
+    cJSON *json = cJSON_Parse(infoStream);
+    free(infoStream);
+    if (json == NULL) {
+        HNP_LOGE("package info get parse json file unsuccess.");
+        return HNP_ERRNO_BASE_PARSE_JSON_FAILED;
+    }
+
+    *pJson = json;
+
+    return 0;
+}
+
+/* 获取hnp_info文档，文件不存在或为空时*pJson为NULL；事务内直接返回缓存文档 */
+static int HnpPackageJsonGet(cJSON **pJson, int uid)
+{
+    if (HnpPackageInfoStoreHit(uid)) {
+        *pJson = g_hnpPackageInfoStore.json;
+        return 0;
+    }
+    return HnpPackageJsonRead(pJson, uid);
+}
+
+static void HnpPackageJsonPut(cJSON *json)
+{
+    if ((json != NULL) && (json != g_hnpPackageInfoStore.json)) {
+        cJSON_Delete(json);
+    }
+}
+
+#ifndef _WIN32
+/* rename后同步所在目录，确保新的目录项落盘；失败时文件内容已替换，仅记录日志 */
+static void HnpParentDirSync(const char *path)
+{
+    char dirPath[PATH_MAX] = {0};
+    HNP_ONLY_EXPER(strcpy_s(dirPath, PATH_MAX, path) != EOK, return);
+    char *sep = strrchr(dirPath, '/');
+    HNP_ONLY_EXPER(sep == NULL, return);
+    *(sep == dirPath ? sep + 1 : sep) = '\0';
+    int fd = open(dirPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        HNP_LOGE("package info open dir:%{public}s unsuccess, errno:%{public}d", dirPath, errno);
+        return;
+    }
+    if (fsync(fd) != 0) {
+        HNP_LOGE("package info sync dir:%{public}s unsuccess, errno:%{public}d", dirPath, errno);
+    }
+    (void)close(fd);
+}
+#endif
+
+/* 先写临时文件并落盘，再rename覆盖，中途中断时文件保持旧内容 */
+static int HnpHapJsonWrite(cJSON *json, int uid)
+{
+    char cfgPath[PATH_MAX] = {0};
+    char tmpPath[PATH_MAX] = {0};
+    int ret = snprintf_s(cfgPath, PATH_MAX, PATH_MAX - 1, HNP_PACKAGE_INFO_JSON_FILE_PATH, uid);
+    HNP_ERROR_CHECK(ret > 0, return HNP_ERRNO_BASE_SPRINTF_FAILED, "build cfg path failed");
+    ret = snprintf_s(tmpPath, PATH_MAX, PATH_MAX - 1, "%s.tmp", cfgPath);
+    HNP_ERROR_CHECK(ret > 0, return HNP_ERRNO_BASE_SPRINTF_FAILED, "build cfg tmp path failed");
+    char *jsonStr = cJSON_Print(json);
+    if (jsonStr == NULL) {
+        HNP_LOGE("get json str unsuccess!");
+        return HNP_ERRNO_BASE_PARAMS_INVALID;
+    }
+    FILE *fp = fopen(tmpPath, "wb");
+    if (fp == NULL) {
+        HNP_LOGE("open file:%{public}s unsuccess!", tmpPath);
+        free(jsonStr);
+        return HNP_ERRNO_BASE_FILE_OPEN_FAILED;
+    }
+    size_t jsonStrSize = strlen(jsonStr);
+    bool writeOk = (fwrite(jsonStr, sizeof(char), jsonStrSize, fp) == jsonStrSize) && (fflush(fp) == 0);
+    free(jsonStr);
+#ifndef _WIN32
+    writeOk = writeOk && (fsync(fileno(fp)) == 0);
+#endif
+    writeOk = (fclose(fp) == 0) && writeOk;
+    if (!writeOk) {
+        HNP_LOGE("package info write file:%{public}s unsuccess, errno:%{public}d", tmpPath, errno);
+        (void)remove(tmpPath);
+        return HNP_ERRNO_BASE_FILE_WRITE_FAILED;
+    }
+#ifdef _WIN32
+    (void)remove(cfgPath);
+#endif
+    if (rename(tmpPath, cfgPath) != 0) {
+        HNP_LOGE("package info rename file:%{public}s unsuccess, errno:%{public}d", cfgPath, errno);
+        (void)remove(tmpPath);
+        return HNP_ERRNO_BASE_FILE_WRITE_FAILED;
+    }
+#ifndef _WIN32
+    HnpParentDirSync(cfgPath);
+#endif
+
+    return 0;
+}
+
+/* 保存修改后的文档，事务内仅标记，由事务结束时统一落盘 */
+static int HnpPackageJsonSave(cJSON *json, int uid)
+{
+    if (HnpPackageInfoStoreHit(uid)) {
+        g_hnpPackageInfoStore.json = json;
+        g_hnpPackageInfoStore.dirty = true;
+        return 0;
+    }
+    return HnpHapJsonWrite(json, uid);
+}
+
+int HnpPackageInfoTransBegin(int uid)
+{
+    if (g_hnpPackageInfoStore.depth > 0) {
+        HNP_ERROR_CHECK(g_hnpPackageInfoStore.uid == uid, return HNP_ERRNO_BASE_PARAMS_INVALID,
+            "hnp info trans already begin with uid %{public}d", g_hnpPackageInfoStore.uid);
+        g_hnpPackageInfoStore.depth++;
+        return 0;
+    }
+
+    cJSON *json = NULL;
+    int ret = HnpPackageJsonRead(&json, uid);
+    HNP_ERROR_CHECK(ret == 0, return ret, "hnp info trans begin read unsuccess %{public}d", ret);
+    g_hnpPackageInfoStore.uid = uid;
+    g_hnpPackageInfoStore.depth = 1;
+    g_hnpPackageInfoStore.dirty = false;
+    g_hnpPackageInfoStore.json = json;
+    return 0;
+}
+
+int HnpPackageInfoTransEnd(int uid)
+{
+    HNP_ONLY_EXPER(!HnpPackageInfoStoreHit(uid), return 0);
+    HNP_ONLY_EXPER(--g_hnpPackageInfoStore.depth > 0, return 0);
+
+    int ret = 0;
+    if (g_hnpPackageInfoStore.dirty && (g_hnpPackageInfoStore.json != NULL)) {
+        ret = HnpHapJsonWrite(g_hnpPackageInfoStore.json, uid);
+    }
+    cJSON_Delete(g_hnpPackageInfoStore.json);
+    (void)memset_s(&g_hnpPackageInfoStore, sizeof(g_hnpPackageInfoStore), 0, sizeof(g_hnpPackageInfoStore));
+    return ret;
+}
+
 static bool HnpInstallHapExistCheck(const char *hnpPackageName, cJSON *json, cJSON **hapItemOut, int *hapIndex)
 {
     cJSON *hapItem = NULL;
@@ -250,34 +456,6 @@ static void HnpPackageVersionUpdateAll(cJSON *json, const HnpCfgInfo *hnpCfg)
     return;
 }
 
-static int HnpHapJsonWrite(cJSON *json, int uid)
-{
-    char cfgPath[PATH_MAX] = {0};
-    int ret = snprintf_s(cfgPath, PATH_MAX, PATH_MAX - 1, HNP_PACKAGE_INFO_JSON_FILE_PATH, uid);
-    HNP_ERROR_CHECK(ret > 0, return HNP_ERRNO_BASE_SPRINTF_FAILED, "build cfg path failed");
-    FILE *fp = fopen(cfgPath, "wb");
-    if (fp == NULL) {
-        HNP_LOGE("open file:%{public}s unsuccess!", HNP_PACKAGE_INFO_JSON_FILE_PATH);
-        return HNP_ERRNO_BASE_FILE_OPEN_FAILED;
-    }
-    char *jsonStr = cJSON_Print(json);
-    if (jsonStr == NULL) {
-        HNP_LOGE("get json str unsuccess!");
-        (void)fclose(fp);
-        return HNP_ERRNO_BASE_PARAMS_INVALID;
-    }
-    size_t jsonStrSize = strlen(jsonStr);
-    size_t writeLen = fwrite(jsonStr, sizeof(char), jsonStrSize, fp);
-    (void)fclose(fp);
-    free(jsonStr);
-    if (writeLen != jsonStrSize) {
-        HNP_LOGE("package info write file:%{public}s unsuccess!", HNP_PACKAGE_INFO_JSON_FILE_PATH);
-        return HNP_ERRNO_BASE_FILE_WRITE_FAILED;
-    }
-
-    return 0;
-}
-
 static int HnpHapJsonHnpAdd(bool hapExist, cJSON *json, cJSON *hapItem, const char *hnpPackageName,
     const HnpCfgInfo *hnpCfg)
 {
@@ -323,7 +501,7 @@ static int HnpHapJsonHnpAdd(bool hapExist, cJSON *json, cJSON *hapItem, const ch
 
     HnpPackageVersionUpdateAll(json, hnpCfg);
 
-    ret = HnpHapJsonWrite(json, hnpCfg->uid);
+    ret = HnpPackageJsonSave(json, hnpCfg->uid);
     return ret;
 }
 
@@ -333,30 +511,17 @@ int HnpInstallInfoJsonWrite(const char *hapPackageName, const HnpCfgInfo *hnpCfg
     bool hapExist = false;
     int hapIndex = 0;
     int hnpIndex = 0;
-    char *infoStream;
-    int size;
     cJSON *hapItem = NULL;
     cJSON *hnpItem = NULL;
     cJSON *json = NULL;
-    char cfgPath[PATH_MAX] = {0};
-    int ret = snprintf_s(cfgPath, PATH_MAX, PATH_MAX - 1, HNP_PACKAGE_INFO_JSON_FILE_PATH, hnpCfg->uid);
-    HNP_ERROR_CHECK(ret > 0, return HNP_ERRNO_BASE_SPRINTF_FAILED, "build cfg path failed");
-    ret = ReadFileToStream(cfgPath, &infoStream, &size);
-    if (ret != 0) {
-        if ((ret == HNP_ERRNO_BASE_FILE_OPEN_FAILED) || (ret == HNP_ERRNO_BASE_GET_FILE_LEN_NULL)) {
-            if ((json = cJSON_CreateArray()) == NULL) {
-                HNP_LOGE("hnp json write array create unsuccess");
-                return HNP_ERRNO_BASE_JSON_ARRAY_CREATE_FAILED;
-            }
-        } else {
-            HNP_LOGE("hnp json write read hnp info file unsuccess");
-            return HNP_ERRNO_BASE_READ_FILE_STREAM_FAILED;
+    int ret = HnpPackageJsonGet(&json, hnpCfg->uid);
+    HNP_ERROR_CHECK(ret == 0, return ret, "hnp json write get hnp info unsuccess");
+    if (json == NULL) {
+        if ((json = cJSON_CreateArray()) == NULL) {
+            HNP_LOGE("hnp json write array create unsuccess");
+            return HNP_ERRNO_BASE_JSON_ARRAY_CREATE_FAILED;
         }
     } else {
-        json = cJSON_Parse(infoStream);
-        free(infoStream);
-        HNP_ERROR_CHECK(json != NULL, return HNP_ERRNO_BASE_PARSE_JSON_FAILED,
-            "hnp json write parse json file unsuccess.");
         hapExist = HnpInstallHapExistCheck(hapPackageName, json, &hapItem, &hapIndex);
     }
     if (hapExist) {
@@ -367,31 +532,26 @@ int HnpInstallInfoJsonWrite(const char *hapPackageName, const HnpCfgInfo *hnpCfg
             if (versionJson != NULL) { // 当前版本存在，即非新增版本，仅更新current_version即可，无需更新install_version
                 cJSON_SetValuestring(versionJson, hnpCfg->version);
                 HnpPackageVersionUpdateAll(json, hnpCfg);
-                ret = HnpHapJsonWrite(json, hnpCfg->uid);
-                cJSON_Delete(json);
+                ret = HnpPackageJsonSave(json, hnpCfg->uid);
+                HnpPackageJsonPut(json);
                 return ret;
             }
         }
     }
     ret = HnpHapJsonHnpAdd(hapExist, json, hapItem, hapPackageName, hnpCfg);
-    cJSON_Delete(json);
+    HnpPackageJsonPut(json);
     return ret;
 }
 
 static bool HnpOtherPackageInstallCheck(const char *name, const char *version, int packageIndex, cJSON *json)
 {
-    bool hnpExist = false;
-    int hnpIndex = 0;
-
-    for (int i = 0; i < cJSON_GetArraySize(json); i++) {
-        if (i == packageIndex) {
+    HnpPackageItemIter iter = {0};
+    while (HnpPackageItemNext(json, name, &iter)) {
+        if (iter.hapIndex == packageIndex) {
             continue;
         }
-        cJSON *hapItem = cJSON_GetArrayItem(json, i);
-        cJSON *hnpItemArr = cJSON_GetObjectItem(hapItem, "hnp");
-        cJSON *hnpItem = NULL;
-        hnpExist = HnpInstallHnpExistCheck(hnpItemArr, name, &hnpItem, &hnpIndex, version);
-        if (hnpExist) {
+        cJSON *versionJson = cJSON_GetObjectItem(iter.hnpItem, "current_version");
+        if ((versionJson != NULL) && cJSON_IsString(versionJson) && (strcmp(versionJson->valuestring, version) == 0)) {
             return true;
         }
     }
@@ -424,35 +584,6 @@ static int HnpPackageInfoGetOut(HnpPackageInfo *packageInfos, int sum, HnpPackag
     return 0;
 }
 
-static int HnpPackageJsonGet(cJSON **pJson, int uid)
-{
-    char *infoStream;
-    int size;
-
-    char cfgPath[PATH_MAX] = {0};
-    int ret = snprintf_s(cfgPath, PATH_MAX, PATH_MAX - 1, HNP_PACKAGE_INFO_JSON_FILE_PATH, uid);
-    HNP_ERROR_CHECK(ret > 0, return HNP_ERRNO_BASE_SPRINTF_FAILED, "build cfg path failed");
-    ret = ReadFileToStream(cfgPath, &infoStream, &size);
-    if (ret != 0) {
-        if (ret == HNP_ERRNO_BASE_FILE_OPEN_FAILED || ret == HNP_ERRNO_BASE_GET_FILE_LEN_NULL) {
-            return 0;
-        }
-        HNP_LOGE("package info get read hnp info file unsuccess");
-        return HNP_ERRNO_BASE_READ_FILE_STREAM_FAILED;
-    }
-
-    cJSON *json = cJSON_Parse(infoStream);
-    free(infoStream);
-    if (json == NULL) {
-        HNP_LOGE("package info get parse json file unsuccess.");
-        return HNP_ERRNO_BASE_PARSE_JSON_FAILED;
-    }
-
-    *pJson = json;
-
-    return 0;
-}
-
 /**
  * 读取配置文件 仅当未安装过对应hnp或者当前hap与之前安装者一致 方可覆盖
  */
@@ -463,62 +594,27 @@ bool CanRecovery(const char *hnpPackageName, HnpCfgInfo *hnpCfg)
     int ret = HnpPackageJsonGet(&json, hnpCfg->uid);
     HNP_ERROR_CHECK(ret == 0, return false, "Get Package Json failed");
     HNP_INFO_CHECK(json != NULL, return true, "No Config, ingore");
-    HNP_INFO_CHECK(cJSON_IsArray(json), cJSON_Delete(json);
+    HNP_INFO_CHECK(cJSON_IsArray(json), HnpPackageJsonPut(json);
         return false, "Config file structed damaged");
 
-    // 默认可以覆盖
+    // 默认可以覆盖，找到对应hnp的安装信息时 要求当前hap与安装hap包名一致
     bool canRecovery = true;
-    cJSON *hapItem = NULL;
-    cJSON *hapJson = NULL;
-
-    for (int i = 0; i < cJSON_GetArraySize(json); i++) {
-        hapItem = cJSON_GetArrayItem(json, i);
-        hapJson = cJSON_GetObjectItem(hapItem, HAP_PACKAGE_INFO_HAP_PREFIX);
-        HNP_ERROR_CHECK(hapJson != NULL && cJSON_IsString(hapJson), continue,
-            "invalid hap info");
-        cJSON *hnpItemArr = cJSON_GetObjectItem(hapItem, HAP_PACKAGE_INFO_HNP_PREFIX);
-        HNP_ERROR_CHECK(hnpItemArr != NULL && cJSON_IsArray(hnpItemArr), continue,
-            "invalid hnp info");
-        for (int j = 0; j < cJSON_GetArraySize(hnpItemArr); j++) {
-            cJSON *hnpItem = cJSON_GetArrayItem(hnpItemArr, j);
-            cJSON *name = cJSON_GetObjectItem(hnpItem, HAP_PACKAGE_INFO_NAME_PREFIX);
-            HNP_ERROR_CHECK(name != NULL && cJSON_IsString(name), continue,
-                "invalid name info");
-            
-            HNP_ONLY_EXPER(strcmp(name->valuestring, hnpCfg->name) != 0, continue);
-            // 找到对应hnp的安装信息时 要求当前hap与安装hap包名一致
-            canRecovery = false;
-            HNP_LOGI("Found hnp Info %{public}s %{public}s", hapJson->valuestring, name->valuestring);
-            if (strcmp(hapJson->valuestring, hnpPackageName) == 0) {
-                cJSON_Delete(json);
-                return true;
-            }
+    HnpPackageItemIter iter = {0};
+    while (HnpPackageItemNext(json, hnpCfg->name, &iter)) {
+        canRecovery = false;
+        HNP_LOGI("Found hnp Info %{public}s %{public}s", iter.hap, hnpCfg->name);
+        if (strcmp(iter.hap, hnpPackageName) == 0) {
+            canRecovery = true;
+            break;
         }
     }
-    cJSON_Delete(json);
+    HnpPackageJsonPut(json);
     return canRecovery;
 }
 
-int HnpPackageInfoGet(const char *packageName, HnpPackageInfo **packageInfoOut, int *count, int uid)
+static int HnpPackageInfoCollect(cJSON *json, cJSON *hnpItemArr, int hapIndex, HnpPackageInfo *packageInfos,
+    int *sum)
 {
-    bool hnpExist = false;
-    int hapIndex = 0;
-    HnpPackageInfo packageInfos[MAX_PACKAGE_HNP_NUM] = {0};
-    int sum = 0;
-    cJSON *json = NULL;
-
-    int ret = HnpPackageJsonGet(&json, uid);
-    if (ret != 0 || json == NULL) {
-        return ret;
-    }
-
-    cJSON *hapItem = NULL;
-    if (HnpInstallHapExistCheck(packageName, json, &hapItem, &hapIndex) == false) {
-        cJSON_Delete(json);
-        return 0;
-    }
-
-    cJSON *hnpItemArr = cJSON_GetObjectItem(hapItem, "hnp");
     for (int j = 0; j < cJSON_GetArraySize(hnpItemArr); j++) {
         cJSON *hnpItem = cJSON_GetArrayItem(hnpItemArr, j);
         cJSON *name = cJSON_GetObjectItem(hnpItem, "name");
@@ -528,66 +624,72 @@ int HnpPackageInfoGet(const char *packageName, HnpPackageInfo **packageInfoOut,
             !cJSON_IsString(version) || !cJSON_IsString(installVersion)) {
             continue;
         }
-        hnpExist = HnpOtherPackageInstallCheck(name->valuestring, version->valuestring, hapIndex, json);
+        bool hnpExist = HnpOtherPackageInstallCheck(name->valuestring, version->valuestring, hapIndex, json);
         // 当卸载当前版本未被其他hap使用或者存在安装版本的时候，需要卸载对应的当前版本或者安装版本
         if (!hnpExist || strcmp(installVersion->valuestring, "none") != 0) {
-            if (sum >= MAX_PACKAGE_HNP_NUM - 1) {
+            if (*sum >= MAX_PACKAGE_HNP_NUM - 1) {
                 HNP_LOGE("package info num over limit");
-                cJSON_Delete(json);
                 return HNP_ERRNO_BASE_FILE_COUNT_OVER;
             }
 
-            if ((strcpy_s(packageInfos[sum].name, MAX_FILE_PATH_LEN, name->valuestring) != EOK) ||
-                (strcpy_s(packageInfos[sum].currentVersion, HNP_VERSION_LEN, version->valuestring) != EOK) ||
-                (strcpy_s(packageInfos[sum].installVersion, HNP_VERSION_LEN, installVersion->valuestring) != EOK)) {
+            if ((strcpy_s(packageInfos[*sum].name, MAX_FILE_PATH_LEN, name->valuestring) != EOK) ||
+                (strcpy_s(packageInfos[*sum].currentVersion, HNP_VERSION_LEN, version->valuestring) != EOK) ||
+                (strcpy_s(packageInfos[*sum].installVersion, HNP_VERSION_LEN, installVersion->valuestring) != EOK)) {
                 HNP_LOGE("strcpy hnp info name[%{public}s],version[%{public}s],install version[%{public}s] unsuccess.",
                     name->valuestring, version->valuestring, installVersion->valuestring);
-                cJSON_Delete(json);
                 return HNP_ERRNO_BASE_COPY_FAILED;
             }
-            packageInfos[sum].hnpExist = hnpExist;
-            sum++;
+            packageInfos[*sum].hnpExist = hnpExist;
+            (*sum)++;
         }
     }
-    cJSON_Delete(json);
+    return 0;
+}
+
+int HnpPackageInfoGet(const char *packageName, HnpPackageInfo **packageInfoOut, int *count, int uid)
+{
+    int hapIndex = 0;
+    HnpPackageInfo packageInfos[MAX_PACKAGE_HNP_NUM] = {0};
+    int sum = 0;
+    cJSON *json = NULL;
+
+    int ret = HnpPackageJsonGet(&json, uid);
+    if (ret != 0 || json == NULL) {
+        return ret;
+    }
+
+    cJSON *hapItem = NULL;
+    if (HnpInstallHapExistCheck(packageName, json, &hapItem, &hapIndex) == false) {
+        HnpPackageJsonPut(json);
+        return 0;
+    }
+
+    ret = HnpPackageInfoCollect(json, cJSON_GetObjectItem(hapItem, "hnp"), hapIndex, packageInfos, &sum);
+    HnpPackageJsonPut(json);
+    HNP_ONLY_EXPER(ret != 0, return ret);
 
     return HnpPackageInfoGetOut(packageInfos, sum, packageInfoOut, count);
 }
 
 int HnpPackageInfoHnpDelete(const char *packageName, const char *name, const char *version, int uid)
 {
-    char *infoStream;
-    int size;
     cJSON *hapItem = NULL;
     cJSON *hnpItem = NULL;
     int hapIndex = 0;
     bool hapExist = false;
     int hnpIndex = 0;
     bool hnpExist = false;
+    cJSON *json = NULL;
 
-    char cfgPath[PATH_MAX] = {0};
-    int ret = snprintf_s(cfgPath, PATH_MAX, PATH_MAX - 1, HNP_PACKAGE_INFO_JSON_FILE_PATH, uid);
-    HNP_ERROR_CHECK(ret > 0, return HNP_ERRNO_BASE_SPRINTF_FAILED, "build cfg path failed");
-    ret = ReadFileToStream(cfgPath, &infoStream, &size);
-    if (ret != 0) {
-        if (ret == HNP_ERRNO_BASE_FILE_OPEN_FAILED || ret == HNP_ERRNO_BASE_GET_FILE_LEN_NULL) {
-            return 0;
-        } else {
-            HNP_LOGE("hnp delete read hnp info file unsuccess");
-            return HNP_ERRNO_BASE_READ_FILE_STREAM_FAILED;
-        }
-    }
-
-    cJSON *json = cJSON_Parse(infoStream);
-    free(infoStream);
-    if (json == NULL) {
-        HNP_LOGE("hnp delete parse json file unsuccess.");
-        return HNP_ERRNO_BASE_PARSE_JSON_FAILED;
+    int ret = HnpPackageJsonGet(&json, uid);
+    if (ret != 0 || json == NULL) {
+        HNP_ONLY_EXPER(ret != 0, HNP_LOGE("hnp delete get hnp info unsuccess"));
+        return ret;
     }
 
     hapExist = HnpInstallHapExistCheck(packageName, json, &hapItem, &hapIndex);
     if (!hapExist) {
-        cJSON_Delete(json);
+        HnpPackageJsonPut(json);
         return 0;
     }
 
@@ -597,36 +699,22 @@ int HnpPackageInfoHnpDelete(const char *packageName, const char *name, const cha
         cJSON_DeleteItemFromArray(hnpItemArr, hnpIndex);
     }
 
-    ret = HnpHapJsonWrite(json, uid);
-    cJSON_Delete(json);
+    ret = HnpPackageJsonSave(json, uid);
+    HnpPackageJsonPut(json);
     return ret;
 }
 
 int HnpPackageInfoDelete(const char *packageName, int uid)
 {
-    char *infoStream;
-    int size;
     cJSON *hapItem = NULL;
     int hapIndex = 0;
     bool hapExist = false;
+    cJSON *json = NULL;
 
-    char cfgPath[PATH_MAX] = {0};
-    int ret = snprintf_s(cfgPath, PATH_MAX, PATH_MAX, HNP_PACKAGE_INFO_JSON_FILE_PATH, uid);
-    HNP_ERROR_CHECK(ret > 0, return HNP_ERRNO_BASE_SPRINTF_FAILED, "build hnp info path failed");
-    ret = ReadFileToStream(cfgPath, &infoStream, &size);
-    if (ret != 0) {
-        if (ret == HNP_ERRNO_BASE_FILE_OPEN_FAILED || ret == HNP_ERRNO_BASE_GET_FILE_LEN_NULL) {
-            return 0;
-        }
-        HNP_LOGE("package info delete read hnp info file unsuccess");
-        return HNP_ERRNO_BASE_READ_FILE_STREAM_FAILED;
-    }
-
-    cJSON *json = cJSON_Parse(infoStream);
-    free(infoStream);
-    if (json == NULL) {
-        HNP_LOGE("package info delete parse json file unsuccess.");
-        return HNP_ERRNO_BASE_PARSE_JSON_FAILED;
+    int ret = HnpPackageJsonGet(&json, uid);
+    if (ret != 0 || json == NULL) {
+        HNP_ONLY_EXPER(ret != 0, HNP_LOGE("package info delete get hnp info unsuccess"));
+        return ret;
     }
 
     hapExist = HnpInstallHapExistCheck(packageName, json, &hapItem, &hapIndex);
@@ -634,8 +722,8 @@ int HnpPackageInfoDelete(const char *packageName, int uid)
         cJSON_DeleteItemFromArray(json, hapIndex);
     }
 
-    ret = HnpHapJsonWrite(json, uid);
-    cJSON_Delete(json);
+    ret = HnpPackageJsonSave(json, uid);
+    HnpPackageJsonPut(json);
     return ret;
 }
 
@@ -698,117 +786,58 @@ int DoRebuildHnpInfoCfg(int uid)
     return ret;
 }
 
-static char *HnpNeedUnInstallHnpVersionGet(cJSON *hnpItemArr, const char *name)
-{
-    char *version = NULL;
-    if (hnpItemArr == NULL) {
-        return NULL;
-    }
-
-    for (int i = 0; i < cJSON_GetArraySize(hnpItemArr); i++) {
-        cJSON *hnpItem = cJSON_GetArrayItem(hnpItemArr, i);
-        cJSON *nameItem = cJSON_GetObjectItem(hnpItem, "name");
-        cJSON *currentItem = cJSON_GetObjectItem(hnpItem, "current_version");
-        cJSON *installItem = cJSON_GetObjectItem(hnpItem, "install_version");
-        if ((nameItem != NULL) && (currentItem != NULL) && (installItem != NULL) &&
-            (cJSON_IsString(nameItem)) && (cJSON_IsString(currentItem)) && (cJSON_IsString(installItem)) &&
-            (nameItem->valuestring != NULL) && (strcmp(nameItem->valuestring, name) == 0) &&
-            (currentItem->valuestring != NULL) && (installItem->valuestring != NULL) &&
-            (strcmp(currentItem->valuestring, installItem->valuestring) == 0)) {
-            version = strdup(currentItem->valuestring);
-            return version;
-        }
-    }
+typedef bool (*HnpVersionMatch)(cJSON *hnpItem, cJSON **versionOut);
 
-    return NULL;
-}
-
-char *HnpCurrentVersionGet(const char *name, int uid)
+/* 按文档顺序返回第一个名称为name且满足match的hnp版本，返回值需调用者释放 */
+static char *HnpVersionGetByName(const char *name, int uid, HnpVersionMatch match)
 {
     if (name == NULL) {
         return NULL;
     }
-    char *infoStream;
-    int size;
-    cJSON *hapItem = NULL;
+    cJSON *json = NULL;
     char *version = NULL;
+    int ret = HnpPackageJsonGet(&json, uid);
+    HNP_ONLY_EXPER(ret != 0 || json == NULL, return NULL);
 
-    char cfgPath[PATH_MAX] = {0};
-    int ret = snprintf_s(cfgPath, PATH_MAX, PATH_MAX, HNP_PACKAGE_INFO_JSON_FILE_PATH, uid);
-    HNP_ERROR_CHECK(ret > 0, return NULL, "build hnp info path failed");
-    ret = ReadFileToStream(cfgPath, &infoStream, &size);
-    if (ret != 0) {
-        return NULL;
-    }
-
-    cJSON *json = cJSON_Parse(infoStream);
-    free(infoStream);
-    if (json == NULL) {
-        HNP_LOGE("hnp delete parse json file unsuccess.");
-        return NULL;
-    }
-
-    for (int i = 0; i < cJSON_GetArraySize(json); i++) {
-        hapItem = cJSON_GetArrayItem(json, i);
-        cJSON *hnpItemArr = cJSON_GetObjectItem(hapItem, "hnp");
-        if (hnpItemArr == NULL) {
-            cJSON_Delete(json);
-            return NULL;
-        }
-
-        for (int j = 0; j < cJSON_GetArraySize(hnpItemArr); j++) {
-            cJSON *hnpItem = cJSON_GetArrayItem(hnpItemArr, j);
-            cJSON *nameItem = cJSON_GetObjectItem(hnpItem, "name");
-            cJSON *versionItem = cJSON_GetObjectItem(hnpItem, "current_version");
-            if ((nameItem != NULL) && (versionItem != NULL) && (cJSON_IsString(nameItem)) &&
-                (cJSON_IsString(versionItem)) && (versionItem->valuestring != NULL) &&
-                (nameItem->valuestring != NULL) && (strcmp(nameItem->valuestring, name) == 0)) {
-                version = strdup(versionItem->valuestring);
-                cJSON_Delete(json);
-                return version;
-            }
+    HnpPackageItemIter iter = {0};
+    while (HnpPackageItemNext(json, name, &iter)) {
+        cJSON *versionItem = NULL;
+        if (match(iter.hnpItem, &versionItem)) {
+            version = strdup(versionItem->valuestring);
+            break;
         }
     }
-
-    cJSON_Delete(json);
-    return NULL;
+    HnpPackageJsonPut(json);
+    return version;
 }
 
-char *HnpCurrentVersionUninstallCheck(const char *name, int uid)
+static bool HnpCurrentVersionMatch(cJSON *hnpItem, cJSON **versionOut)
 {
-    if (name == NULL) {
-        return NULL;
-    }
-    char *infoStream;
-    int size;
-    cJSON *hapItem = NULL;
-    char *version = NULL;
-    char cfgPath[PATH_MAX] = {0};
-    int ret = snprintf_s(cfgPath, PATH_MAX, PATH_MAX, HNP_PACKAGE_INFO_JSON_FILE_PATH, uid);
-    HNP_ERROR_CHECK(ret > 0, return NULL, "build hnp info path failed");
-    ret = ReadFileToStream(cfgPath, &infoStream, &size);
-    if (ret != 0) {
-        return NULL;
-    }
+    cJSON *currentItem = cJSON_GetObjectItem(hnpItem, "current_version");
+    HNP_ONLY_EXPER(!cJSON_IsString(currentItem) || (currentItem->valuestring == NULL), return false);
+    *versionOut = currentItem;
+    return true;
+}
 
-    cJSON *json = cJSON_Parse(infoStream);
-    free(infoStream);
-    if (json == NULL) {
-        HNP_LOGE("hnp delete parse json file unsuccess.");
-        return NULL;
-    }
+static bool HnpUninstallVersionMatch(cJSON *hnpItem, cJSON **versionOut)
+{
+    cJSON *currentItem = cJSON_GetObjectItem(hnpItem, "current_version");
+    cJSON *installItem = cJSON_GetObjectItem(hnpItem, "install_version");
+    HNP_ONLY_EXPER(!cJSON_IsString(currentItem) || (currentItem->valuestring == NULL), return false);
+    HNP_ONLY_EXPER(!cJSON_IsString(installItem) || (installItem->valuestring == NULL), return false);
+    HNP_ONLY_EXPER(strcmp(currentItem->valuestring, installItem->valuestring) != 0, return false);
+    *versionOut = currentItem;
+    return true;
+}
 
-    for (int i = 0; i < cJSON_GetArraySize(json); i++) {
-        hapItem = cJSON_GetArrayItem(json, i);
-        cJSON *hnpItemArr = cJSON_GetObjectItem(hapItem, "hnp");
-        version = HnpNeedUnInstallHnpVersionGet(hnpItemArr, name);
-        if (version != NULL) {
-            break;
-        }
-    }
+char *HnpCurrentVersionGet(const char *name, int uid)
+{
+    return HnpVersionGetByName(name, uid, HnpCurrentVersionMatch);
+}
 
-    cJSON_Delete(json);
-    return version;
+char *HnpCurrentVersionUninstallCheck(const char *name, int uid)
+{
+    return HnpVersionGetByName(name, uid, HnpUninstallVersionMatch);
 }
 
 #ifdef __cplusplus
@@ -24,6 +24,9 @@
 #ifdef _WIN32
 #include <windows.h>
 
+#else
+#include <fcntl.h>
+#include <pthread.h>
 #endif
 
 #include "zlib.h"
@@ -54,6 +57,21 @@ extern "C" {
 #endif
 
 #define ZIP_EXTERNAL_FA_OFFSET 16
+#define HNP_UNZIP_BUFFER_SIZE (256 * 1024)
+#define HNP_UNZIP_BUFFER_ALIGN 4096
+#define HNP_UNZIP_FALLOCATE_MAX (256 * 1024 * 1024)     // 超过该大小的文件不预分配
+#define HNP_ZIP_BUFFER_SIZE (256 * 1024)
+#define HNP_ZIP_ENTRY_INIT_CAPACITY 64
+#define HNP_ZIP_MAX_WORKERS 8
+#define HNP_ZIP_STREAM_SIZE HNP_ZIP_BUFFER_SIZE          // 超过该大小的文件由写入线程流式压缩
+#define HNP_ZIP_PENDING_SIZE (16 * 1024 * 1024)         // 已压缩未写入的数据预留内存上限
+#define HNP_ELF_HEAD_LEN 64     // 不小于sizeof(Elf64_Ehdr)
+
+typedef struct {
+    char *data;                     // 解压缓冲区，按页对齐，所有文件复用
+    char head[HNP_ELF_HEAD_LEN];    // 当前文件的起始字节，用于elf判断
+    size_t headLen;
+} HnpUnZipBuffer;
 
 // zipOpenNewFileInZip3只识别带‘/’的路径，需要将路径中‘\’转换成‘/’
 static void TransPath(const char *input, char *output)
@@ -83,61 +101,417 @@ static bool TransWidePath(const char *inPath, wchar_t *outPath)
 }
 #endif
 
-// 向zip压缩包中添加文件
-static int ZipAddFile(const char* file, int offset, zipFile zf)
+/* 打包条目，小文件由worker并发压缩，大文件由写入线程流式压缩，按遍历顺序写入zip */
+typedef struct {
+    char *path;             // 源路径，目录以分隔符结尾
+    bool isDir;
+    bool stream;            // 写入时流式压缩，不缓存压缩数据
+    bool done;              // 压缩完成，受list->lock保护
+    int ret;
+    uLong externalFa;
+    uLong crc;
+    uLong size;             // 压缩前大小
+    size_t fileSize;        // 收集时的文件大小
+    unsigned char *data;    // 压缩后数据，写入zip后释放
+    size_t dataLen;
+    size_t capacity;
+} HnpZipEntry;
+
+typedef struct {
+    HnpZipEntry *entries;
+    int count;
+    int capacity;
+    int next;               // 下一个待压缩的条目
+    size_t pending;         // 已领取未写入的条目预留的内存，限制内存占用
+    bool abort;
+#ifndef _WIN32
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif
+} HnpZipEntryList;
+
+#ifndef _WIN32
+APPSPAWN_STATIC int g_hnpZipMaxWorkers = HNP_ZIP_MAX_WORKERS;  // 压缩线程数上限，为0时由写入线程串行压缩
+#endif
+
+static void ZipEntryListLock(HnpZipEntryList *list)
 {
-    int err;
-    char buf[1024];
-    char transPath[MAX_FILE_PATH_LEN];
-    size_t len;
-    FILE *f;
-    zip_fileinfo fileInfo = {0};
+#ifndef _WIN32
+    (void)pthread_mutex_lock(&list->lock);
+#endif
+}
+
+static void ZipEntryListUnlock(HnpZipEntryList *list)
+{
+#ifndef _WIN32
+    (void)pthread_mutex_unlock(&list->lock);
+#endif
+}
+
+static void ZipEntryListWait(HnpZipEntryList *list)
+{
+#ifndef _WIN32
+    (void)pthread_cond_wait(&list->cond, &list->lock);
+#endif
+}
 
+static void ZipEntryListNotify(HnpZipEntryList *list)
+{
+#ifndef _WIN32
+    (void)pthread_cond_broadcast(&list->cond);
+#endif
+}
+
+static void ZipEntryListClear(HnpZipEntryList *list)
+{
+    for (int i = 0; i < list->count; i++) {
+        free(list->entries[i].path);
+        free(list->entries[i].data);
+    }
+    free(list->entries);
+    list->entries = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+static int ZipEntryStat(HnpZipEntry *entry, size_t *fileSize)
+{
 #ifdef _WIN32
     struct _stat buffer = {0};
     // 使用wchar_t支持处理字符串长度超过260的路径字符串
     wchar_t wideFullPath[MAX_FILE_PATH_LEN] = {0};
-    if (!TransWidePath(file, wideFullPath)) {
+    if (!TransWidePath(entry->path, wideFullPath)) {
         return HNP_ERRNO_BASE_STAT_FAILED;
     }
     if (_wstat(wideFullPath, &buffer) != 0) {
-        HNP_LOGE("get filefile[%{public}s] stat fail.", file);
+        HNP_LOGE("get filefile[%{public}s] stat fail.", entry->path);
         return HNP_ERRNO_BASE_STAT_FAILED;
     }
     buffer.st_mode |= S_IXOTH;
 #else
     struct stat buffer = {0};
-    if (stat(file, &buffer) != 0) {
-        HNP_LOGE("get filefile[%{public}s] stat fail.", file);
+    if (stat(entry->path, &buffer) != 0) {
+        HNP_LOGE("get filefile[%{public}s] stat fail.", entry->path);
         return HNP_ERRNO_BASE_STAT_FAILED;
     }
 #endif
-    fileInfo.external_fa = (buffer.st_mode & 0xFFFF) << ZIP_EXTERNAL_FA_OFFSET;
-    TransPath(file, transPath);
-    err = zipOpenNewFileInZip3(zf, transPath + offset, &fileInfo, NULL, 0, NULL, 0, NULL, Z_DEFLATED,
-        Z_BEST_COMPRESSION, 0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, NULL, 0);
-    if (err != ZIP_OK) {
-        HNP_LOGE("open new file[%{public}s] in zip unsuccess ", file);
-        return HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
+    entry->externalFa = (buffer.st_mode & 0xFFFF) << ZIP_EXTERNAL_FA_OFFSET;
+    *fileSize = (size_t)buffer.st_size;
+    return 0;
+}
+
+static int ZipEntryAdd(HnpZipEntryList *list, const char *path, bool isDir)
+{
+    if (list->count >= list->capacity) {
+        int capacity = (list->capacity == 0) ? HNP_ZIP_ENTRY_INIT_CAPACITY : list->capacity * 2;
+        HnpZipEntry *entries = (HnpZipEntry *)realloc(list->entries, sizeof(HnpZipEntry) * capacity);
+        HNP_ERROR_CHECK(entries != NULL, return HNP_ERRNO_NOMEM, "alloc zip entry unsuccess, count=%{public}d",
+            capacity);
+        list->entries = entries;
+        list->capacity = capacity;
     }
+    HnpZipEntry *entry = &list->entries[list->count];
+    (void)memset_s(entry, sizeof(HnpZipEntry), 0, sizeof(HnpZipEntry));
+    entry->path = strdup(path);
+    HNP_ERROR_CHECK(entry->path != NULL, return HNP_ERRNO_BASE_STRDUP_FAILED, "strdup zip entry unsuccess");
+    entry->isDir = isDir;
+    list->count++;
+    HNP_ONLY_EXPER(isDir, return 0);
+
+    int ret = ZipEntryStat(entry, &entry->fileSize);
+    HNP_ONLY_EXPER(ret != 0, return ret);
+    entry->stream = (entry->fileSize > HNP_ZIP_STREAM_SIZE);
+    return 0;
+}
+
+/* 按压缩上限预留，流式压缩的条目不占用 */
+static size_t ZipEntryReserve(const HnpZipEntry *entry)
+{
+    return (entry->isDir || entry->stream) ? 0 : (size_t)compressBound((uLong)entry->fileSize);
+}
+
+static FILE *ZipEntryOpen(const HnpZipEntry *entry)
+{
 #ifdef _WIN32
-    f = _wfopen(wideFullPath, L"rb");
+    wchar_t wideFullPath[MAX_FILE_PATH_LEN] = {0};
+    if (!TransWidePath(entry->path, wideFullPath)) {
+        return NULL;
+    }
+    return _wfopen(wideFullPath, L"rb");
 #else
-    f = fopen(file, "rb");
+    return fopen(entry->path, "rb");
 #endif
+}
+
+static int ZipEntryDeflate(HnpZipEntry *entry, z_stream *strm, int flush)
+{
+    int ret;
+    do {
+        if (entry->dataLen >= entry->capacity) {
+            size_t capacity = entry->capacity * 2 + HNP_ZIP_BUFFER_SIZE;
+            unsigned char *data = (unsigned char *)realloc(entry->data, capacity);
+            HNP_ERROR_CHECK(data != NULL, return HNP_ERRNO_NOMEM, "alloc zip data unsuccess");
+            entry->data = data;
+            entry->capacity = capacity;
+        }
+        size_t remain = entry->capacity - entry->dataLen;
+        uInt outLen = (remain > UINT_MAX) ? UINT_MAX : (uInt)remain;
+        strm->next_out = entry->data + entry->dataLen;
+        strm->avail_out = outLen;
+        ret = deflate(strm, flush);
+        HNP_ERROR_CHECK(ret != Z_STREAM_ERROR, return HNP_ERRNO_BASE_CREATE_ZIP_FAILED,
+            "deflate file[%{public}s] unsuccess", entry->path);
+        entry->dataLen += outLen - strm->avail_out;
+    } while ((strm->avail_in > 0) || ((flush == Z_FINISH) && (ret != Z_STREAM_END)));
+    return 0;
+}
+
+/* 使用与zipOpenNewFileInZip3相同的参数做raw deflate，写入时以raw方式追加，结果与串行压缩一致 */
+static int ZipEntryCompressFile(HnpZipEntry *entry, FILE *f, size_t fileSize, unsigned char *buf)
+{
+    z_stream strm = {0};
+    if (deflateInit2(&strm, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+        HNP_LOGE("deflate init file[%{public}s] unsuccess ", entry->path);
+        return HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
+    }
+    /* 按文件大小预估压缩后长度，文件变大时再扩容 */
+    entry->capacity = deflateBound(&strm, (uLong)fileSize);
+    entry->data = (unsigned char *)malloc(entry->capacity);
+    if (entry->data == NULL) {
+        HNP_LOGE("alloc zip data for file[%{public}s] unsuccess ", entry->path);
+        entry->capacity = 0;
+        (void)deflateEnd(&strm);
+        return HNP_ERRNO_NOMEM;
+    }
+    int ret;
+    int flush;
+    do {
+        size_t len = fread(buf, 1, HNP_ZIP_BUFFER_SIZE, f);
+        flush = (len > 0) ? Z_NO_FLUSH : Z_FINISH;
+        entry->crc = crc32(entry->crc, buf, (uInt)len);
+        entry->size += len;
+        strm.next_in = buf;
+        strm.avail_in = (uInt)len;
+        ret = ZipEntryDeflate(entry, &strm, flush);
+    } while ((ret == 0) && (flush != Z_FINISH));
+    (void)deflateEnd(&strm);
+    return ret;
+}
+
+static int ZipEntryCompress(HnpZipEntry *entry)
+{
+    HNP_ONLY_EXPER(entry->isDir || entry->stream, return 0);
+    FILE *f = ZipEntryOpen(entry);
     if (f == NULL) {
-        HNP_LOGE("open file[%{public}s] unsuccess ", file);
+        HNP_LOGE("open file[%{public}s] unsuccess ", entry->path);
         return HNP_ERRNO_BASE_FILE_OPEN_FAILED;
     }
+    unsigned char *buf = (unsigned char *)malloc(HNP_ZIP_BUFFER_SIZE);
+    if (buf == NULL) {
+        HNP_LOGE("alloc zip buffer for file[%{public}s] unsuccess ", entry->path);
+        (void)fclose(f);
+        return HNP_ERRNO_NOMEM;
+    }
+    int ret = ZipEntryCompressFile(entry, f, entry->fileSize, buf);
+    free(buf);
+    (void)fclose(f);
+    return ret;
+}
+
+static void ZipEntryRun(HnpZipEntryList *list, int index)
+{
+    HnpZipEntry *entry = &list->entries[index];
+    int ret = ZipEntryCompress(entry);
+    ZipEntryListLock(list);
+    entry->ret = ret;
+    entry->done = true;
+    ZipEntryListNotify(list);
+    ZipEntryListUnlock(list);
+}
+
+#ifndef _WIN32
+static void *ZipEntryWorker(void *arg)
+{
+    HnpZipEntryList *list = (HnpZipEntryList *)arg;
+    while (true) {
+        ZipEntryListLock(list);
+        /* 预留内存超过上限时等待写入释放，没有待写入的数据时总可以领取 */
+        while (!list->abort && (list->next < list->count) && (list->pending > 0) &&
+            (list->pending + ZipEntryReserve(&list->entries[list->next]) > HNP_ZIP_PENDING_SIZE)) {
+            ZipEntryListWait(list);
+        }
+        if (list->abort || (list->next >= list->count)) {
+            ZipEntryListUnlock(list);
+            break;
+        }
+        int index = list->next++;
+        list->pending += ZipEntryReserve(&list->entries[index]);
+        ZipEntryListUnlock(list);
+        ZipEntryRun(list, index);
+    }
+    return NULL;
+}
+#endif
 
-    while ((len = fread(buf, 1, sizeof(buf), f)) > 0) {
-        zipWriteInFileInZip(zf, buf, len);
+/* 大文件边读边压缩写入，压缩参数与缓存压缩相同，输出一致 */
+static int ZipEntryWriteStream(const HnpZipEntry *entry, const char *name, const zip_fileinfo *fileInfo, zipFile zf)
+{
+    FILE *f = ZipEntryOpen(entry);
+    if (f == NULL) {
+        HNP_LOGE("open file[%{public}s] unsuccess ", entry->path);
+        return HNP_ERRNO_BASE_FILE_OPEN_FAILED;
+    }
+    unsigned char *buf = (unsigned char *)malloc(HNP_ZIP_BUFFER_SIZE);
+    if (buf == NULL) {
+        HNP_LOGE("alloc zip buffer for file[%{public}s] unsuccess ", entry->path);
+        (void)fclose(f);
+        return HNP_ERRNO_NOMEM;
     }
+    if (zipOpenNewFileInZip3(zf, name, fileInfo, NULL, 0, NULL, 0, NULL, Z_DEFLATED,
+        Z_BEST_COMPRESSION, 0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, NULL, 0) != ZIP_OK) {
+        HNP_LOGE("open new file[%{public}s] in zip unsuccess ", entry->path);
+        free(buf);
+        (void)fclose(f);
+        return HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
+    }
+    int ret = 0;
+    size_t len;
+    while ((ret == 0) && ((len = fread(buf, 1, HNP_ZIP_BUFFER_SIZE, f)) > 0)) {
+        if (zipWriteInFileInZip(zf, buf, (unsigned int)len) != ZIP_OK) {
+            HNP_LOGE("write file[%{public}s] in zip unsuccess ", entry->path);
+            ret = HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
+        }
+    }
+    if ((zipCloseFileInZip(zf) != ZIP_OK) && (ret == 0)) {
+        HNP_LOGE("close file[%{public}s] in zip unsuccess ", entry->path);
+        ret = HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
+    }
+    free(buf);
     (void)fclose(f);
-    zipCloseFileInZip(zf);
+    return ret;
+}
+
+static int ZipEntryWrite(const HnpZipEntry *entry, int offset, zipFile zf)
+{
+    char transPath[MAX_FILE_PATH_LEN];
+    TransPath(entry->path, transPath);
+    if (entry->isDir) {
+        if (zipOpenNewFileInZip3(zf, transPath + offset, NULL, NULL, 0, NULL, 0, NULL, Z_DEFLATED,
+            Z_BEST_COMPRESSION, 0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, NULL, 0) != ZIP_OK) {
+            HNP_LOGE("open new file[%{public}s] in zip unsuccess ", entry->path);
+            return HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
+        }
+        HNP_ERROR_CHECK(zipCloseFileInZip(zf) == ZIP_OK, return HNP_ERRNO_BASE_CREATE_ZIP_FAILED,
+            "close dir[%{public}s] in zip unsuccess ", entry->path);
+        return 0;
+    }
+
+    zip_fileinfo fileInfo = {0};
+    fileInfo.external_fa = entry->externalFa;
+    HNP_ONLY_EXPER(entry->stream, return ZipEntryWriteStream(entry, transPath + offset, &fileInfo, zf));
+    if (zipOpenNewFileInZip3(zf, transPath + offset, &fileInfo, NULL, 0, NULL, 0, NULL, Z_DEFLATED,
+        Z_BEST_COMPRESSION, 1, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, NULL, 0) != ZIP_OK) {
+        HNP_LOGE("open new file[%{public}s] in zip unsuccess ", entry->path);
+        return HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
+    }
+    int ret = 0;
+    for (size_t pos = 0; (ret == 0) && (pos < entry->dataLen);) {
+        size_t len = entry->dataLen - pos;
+        len = (len > HNP_ZIP_BUFFER_SIZE) ? HNP_ZIP_BUFFER_SIZE : len;
+        if (zipWriteInFileInZip(zf, entry->data + pos, (unsigned int)len) != ZIP_OK) {
+            HNP_LOGE("write file[%{public}s] in zip unsuccess ", entry->path);
+            ret = HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
+        }
+        pos += len;
+    }
+    if ((zipCloseFileInZipRaw(zf, entry->size, entry->crc) != ZIP_OK) && (ret == 0)) {
+        HNP_LOGE("close file[%{public}s] in zip unsuccess ", entry->path);
+        ret = HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
+    }
+    return ret;
+}
+
+/* 按条目顺序等待压缩完成并写入，条目未被worker领取时由当前线程压缩 */
+static int ZipEntryListWrite(HnpZipEntryList *list, int offset, zipFile zf)
+{
+    for (int i = 0; i < list->count; i++) {
+        HnpZipEntry *entry = &list->entries[i];
+        ZipEntryListLock(list);
+        while (!entry->done && (list->next > i)) {
+            ZipEntryListWait(list);
+        }
+        bool claim = !entry->done;
+        if (claim) {
+            list->next++;
+            list->pending += ZipEntryReserve(entry);
+        }
+        ZipEntryListUnlock(list);
+        HNP_ONLY_EXPER(claim, ZipEntryRun(list, i));
+
+        int ret = entry->ret;
+        if (ret != 0) {
+            HNP_LOGE("zip add file[%{public}s] unsuccess ", entry->path);
+            return ret;
+        }
+        ret = ZipEntryWrite(entry, offset, zf);
+        HNP_ONLY_EXPER(ret != 0, return ret);
+        free(entry->data);
+        entry->data = NULL;
+
+        ZipEntryListLock(list);
+        list->pending -= ZipEntryReserve(entry);
+        ZipEntryListNotify(list);
+        ZipEntryListUnlock(list);
+    }
     return 0;
 }
 
+static int ZipEntryWorkerCountGet(const HnpZipEntryList *list)
+{
+#ifdef _WIN32
+    return 0;
+#else
+    int maxWorkers = (g_hnpZipMaxWorkers < HNP_ZIP_MAX_WORKERS) ? g_hnpZipMaxWorkers : HNP_ZIP_MAX_WORKERS;
+    HNP_ONLY_EXPER(list->count <= 1 || maxWorkers <= 0, return 0);
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int workers = (cpus > 0 && cpus < maxWorkers) ? (int)cpus : maxWorkers;
+    return (workers < list->count) ? workers : list->count;
+#endif
+}
+
+static int ZipEntryListRun(HnpZipEntryList *list, int offset, zipFile zf)
+{
+    int workers = ZipEntryWorkerCountGet(list);
+#ifndef _WIN32
+    pthread_t threads[HNP_ZIP_MAX_WORKERS];
+    int started = 0;
+    (void)pthread_mutex_init(&list->lock, NULL);
+    (void)pthread_cond_init(&list->cond, NULL);
+    for (int i = 0; i < workers; i++) {
+        int err = pthread_create(&threads[started], NULL, ZipEntryWorker, list);
+        if (err != 0) {
+            HNP_LOGI("create zip worker unsuccess, ret=%{public}d, workers=%{public}d", err, started);
+            break;
+        }
+        started++;
+    }
+#endif
+    int ret = ZipEntryListWrite(list, offset, zf);
+
+    ZipEntryListLock(list);
+    list->abort = true;
+    ZipEntryListNotify(list);
+    ZipEntryListUnlock(list);
+#ifndef _WIN32
+    for (int i = 0; i < started; i++) {
+        (void)pthread_join(threads[i], NULL);
+    }
+    (void)pthread_cond_destroy(&list->cond);
+    (void)pthread_mutex_destroy(&list->lock);
+#endif
+    return ret;
+}
+
 // 判断是否为目录
 static int IsDirPath(struct dirent *entry, char *fullPath, int *isDir)
 {
@@ -161,30 +535,8 @@ static int IsDirPath(struct dirent *entry, char *fullPath, int *isDir)
     return 0;
 }
 
-static int ZipAddDir(const char *sourcePath, int offset, zipFile zf);
-
-static int ZipHandleDir(char *fullPath, int offset, zipFile zf)
-{
-    int ret;
-    char transPath[MAX_FILE_PATH_LEN];
-    TransPath(fullPath, transPath);
-    if (zipOpenNewFileInZip3(zf, transPath + offset, NULL, NULL, 0, NULL, 0, NULL, Z_DEFLATED,
-                             Z_BEST_COMPRESSION, 0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY,
-                             NULL, 0) != ZIP_OK) {
-        HNP_LOGE("open new file[%{public}s] in zip unsuccess ", fullPath);
-        return HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
-    }
-    zipCloseFileInZip(zf);
-    ret = ZipAddDir(fullPath, offset, zf);
-    if (ret != 0) {
-        HNP_LOGE("zip add dir[%{public}s] unsuccess ", fullPath);
-        return ret;
-    }
-    return 0;
-}
-
-// sourcePath--文件夹路径  zf--压缩文件句柄
-static int ZipAddDir(const char *sourcePath, int offset, zipFile zf)
+// sourcePath--文件夹路径，按遍历顺序收集打包条目
+static int ZipCollectDir(const char *sourcePath, HnpZipEntryList *list)
 {
     struct dirent *entry;
     char fullPath[MAX_FILE_PATH_LEN];
@@ -219,13 +571,12 @@ static int ZipAddDir(const char *sourcePath, int offset, zipFile zf)
                 closedir(dir);
                 return HNP_ERRNO_BASE_STRING_LEN_OVER_LIMIT;
             }
-            ret = ZipHandleDir(fullPath, offset, zf);
-            if (ret != 0) {
-                closedir(dir);
-                return ret;
-            }
-        } else if ((ret = ZipAddFile(fullPath, offset, zf)) != 0) {
-            HNP_LOGE("zip add file[%{public}s] unsuccess ", fullPath);
+            ret = ZipEntryAdd(list, fullPath, true);
+            HNP_ONLY_EXPER(ret == 0, ret = ZipCollectDir(fullPath, list));
+        } else {
+            ret = ZipEntryAdd(list, fullPath, false);
+        }
+        if (ret != 0) {
             closedir(dir);
             return ret;
         }
@@ -235,26 +586,6 @@ static int ZipAddDir(const char *sourcePath, int offset, zipFile zf)
     return 0;
 }
 
-static int ZipDir(const char *sourcePath, int offset, zipFile zf)
-{
-    int ret;
-    char transPath[MAX_FILE_PATH_LEN];
-
-    TransPath(sourcePath, transPath);
-
-    // 将外层文件夹信息保存到zip文件中
-    ret = zipOpenNewFileInZip3(zf, transPath + offset, NULL, NULL, 0, NULL, 0, NULL, Z_DEFLATED, Z_BEST_COMPRESSION,
-        0, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, NULL, 0);
-    if (ret != ZIP_OK) {
-        HNP_LOGE("open new file[%{public}s] in zip unsuccess ", sourcePath + offset);
-        return HNP_ERRNO_BASE_CREATE_ZIP_FAILED;
-    }
-    zipCloseFileInZip(zf);
-    ret = ZipAddDir(sourcePath, offset, zf);
-
-    return ret;
-}
-
 int HnpZip(const char *inputDir, zipFile zf)
 {
     int ret;
@@ -277,7 +608,12 @@ int HnpZip(const char *inputDir, zipFile zf)
         return HNP_ERRNO_BASE_SPRINTF_FAILED;
     }
 
-    ret = ZipDir(sourcePath, offset, zf);
+    // 先按遍历顺序收集条目（外层文件夹在前），再并发压缩、顺序写入
+    HnpZipEntryList list = {0};
+    ret = ZipEntryAdd(&list, sourcePath, true);
+    HNP_ONLY_EXPER(ret == 0, ret = ZipCollectDir(sourcePath, &list));
+    HNP_ONLY_EXPER(ret == 0, ret = ZipEntryListRun(&list, offset, zf));
+    ZipEntryListClear(&list);
 
     return ret;
 }
@@ -302,114 +638,153 @@ int HnpAddFileToZip(zipFile zf, char *filename, char *buff, int size)
     return 0;
 }
 
-static int HnpUnZipForFile(const char *filePath, unzFile zipFile, unz_file_info fileInfo)
+#ifndef _WIN32
+static int HnpWriteAll(int fd, const char *buff, size_t len)
+{
+    while (len > 0) {
+        ssize_t written = write(fd, buff, len);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return HNP_ERRNO_BASE_FILE_WRITE_FAILED;
+        }
+        buff += written;
+        len -= (size_t)written;
+    }
+    return 0;
+}
+
+static int HnpUnZipStream(const char *filePath, unzFile zipFile, int fd, HnpUnZipBuffer *buf)
+{
+    size_t total = 0;
+    int readSize;
+
+    do {
+        readSize = unzReadCurrentFile(zipFile, buf->data, HNP_UNZIP_BUFFER_SIZE);
+        if (readSize < 0) {
+            HNP_LOGE("unzip read file:%{public}s unsuccess", filePath);
+            return HNP_ERRNO_BASE_UNZIP_READ_FAILED;
+        }
+        /* 边解压边记录文件头，避免解压后重新读取文件判断elf */
+        if (buf->headLen < HNP_ELF_HEAD_LEN && readSize > 0) {
+            size_t copyLen = HNP_ELF_HEAD_LEN - buf->headLen;
+            copyLen = ((size_t)readSize < copyLen) ? (size_t)readSize : copyLen;
+            (void)memcpy_s(buf->head + buf->headLen, HNP_ELF_HEAD_LEN - buf->headLen, buf->data, copyLen);
+            buf->headLen += copyLen;
+        }
+        if (HnpWriteAll(fd, buf->data, (size_t)readSize) != 0) {
+            HNP_LOGE("unzip write file:%{public}s unsuccess, errno:%{public}d", filePath, errno);
+            return HNP_ERRNO_BASE_FILE_WRITE_FAILED;
+        }
+        total += (size_t)readSize;
+    } while (readSize > 0);
+
+    /* 预分配会扩展文件大小，实际解压长度不一致时以实际长度为准 */
+    if (ftruncate(fd, (off_t)total) != 0) {
+        HNP_LOGE("unzip truncate file:%{public}s unsuccess, errno:%{public}d", filePath, errno);
+        return HNP_ERRNO_BASE_FILE_WRITE_FAILED;
+    }
+    return 0;
+}
+#endif
+
+static int HnpUnZipForFile(const char *filePath, unzFile zipFile, unz_file_info fileInfo, HnpUnZipBuffer *buf)
 {
+    buf->headLen = 0;
 #ifdef _WIN32
     return 0;
 #else
-    int ret;
     mode_t mode = (fileInfo.external_fa >> ZIP_EXTERNAL_FA_OFFSET) & 0xFFFF;
 
     /* 如果解压缩的是目录 */
     if (filePath[strlen(filePath) - 1] == '/') {
         mkdir(filePath, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
-    } else {
-        FILE *outFile = fopen(filePath, "wb");
-        if (outFile == NULL) {
-            HNP_LOGE("unzip open file:%{public}s unsuccess!", filePath);
-            return HNP_ERRNO_BASE_FILE_OPEN_FAILED;
-        }
-        unzOpenCurrentFile(zipFile);
-        int readSize = 0;
-        do {
-            char buffer[BUFFER_SIZE];
-            readSize = unzReadCurrentFile(zipFile, buffer, sizeof(buffer));
-            if (readSize < 0) {
-                HNP_LOGE("unzip read zip:%{public}s file unsuccess", (char *)zipFile);
-                fclose(outFile);
-                unzCloseCurrentFile(zipFile);
-                return HNP_ERRNO_BASE_UNZIP_READ_FAILED;
-            }
-
-            fwrite(buffer, readSize, sizeof(char), outFile);
-        } while (readSize > 0);
+        return 0;
+    }
 
-        fclose(outFile);
-        unzCloseCurrentFile(zipFile);
-        /* 如果其他人有可执行权限，那么将解压后的权限设置成755，否则为744 */
-        if ((mode & S_IXOTH) != 0) {
-            ret = chmod(filePath, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-        } else {
-            ret = chmod(filePath, S_IRWXU | S_IRGRP | S_IROTH);
-        }
-        if (ret != 0) {
-            HNP_LOGE("hnp install chmod unsuccess, src:%{public}s, errno:%{public}d", filePath, errno);
-            return HNP_ERRNO_BASE_CHMOD_FAILED;
+    /* 如果其他人有可执行权限，那么将解压后的权限设置成755，否则为744 */
+    mode_t finalMode = ((mode & S_IXOTH) != 0) ? (S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) :
+        (S_IRWXU | S_IRGRP | S_IROTH);
+    int fd = open(filePath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, finalMode);
+    if (fd < 0) {
+        HNP_LOGE("unzip open file:%{public}s unsuccess!", filePath);
+        return HNP_ERRNO_BASE_FILE_OPEN_FAILED;
+    }
+    /* 创建时的权限受umask影响，文件已存在时也不会生效，通过fd直接设置 */
+    if (fchmod(fd, finalMode) != 0) {
+        HNP_LOGE("hnp install chmod unsuccess, src:%{public}s, errno:%{public}d", filePath, errno);
+        (void)close(fd);
+        return HNP_ERRNO_BASE_CHMOD_FAILED;
+    }
+#ifndef HNP_CLI
+    /* 按解压后大小预分配，减少写入时的块分配；大小取自压缩包，过大时不预分配；文件系统不支持时忽略 */
+    if (fileInfo.uncompressed_size > 0 && fileInfo.uncompressed_size <= HNP_UNZIP_FALLOCATE_MAX) {
+        int ret = posix_fallocate(fd, 0, (off_t)fileInfo.uncompressed_size);
+        if (ret == ENOSPC) {
+            HNP_LOGE("unzip fallocate file:%{public}s no space", filePath);
+            (void)close(fd);
+            return HNP_ERRNO_BASE_FILE_WRITE_FAILED;
         }
     }
-    return 0;
+#endif
+
+    if (unzOpenCurrentFile(zipFile) != UNZ_OK) {
+        HNP_LOGE("unzip open current file:%{public}s unsuccess", filePath);
+        (void)close(fd);
+        return HNP_ERRNO_BASE_UNZIP_READ_FAILED;
+    }
+    int ret = HnpUnZipStream(filePath, zipFile, fd, buf);
+    unzCloseCurrentFile(zipFile);
+    if (close(fd) != 0 && ret == 0) {
+        HNP_LOGE("unzip close file:%{public}s unsuccess, errno:%{public}d", filePath, errno);
+        ret = HNP_ERRNO_BASE_FILE_WRITE_FAILED;
+    }
+    return ret;
 #endif
 }
 
 /**
-* 判断是否为elf文件
-* 1.非二进制文件/读取文件头失败时 返回false
+* 根据解压时记录的文件头判断是否为elf文件
+* 1.非二进制文件/文件头长度不足时 返回false
 * 2.当文件头符合要求时（`\\177ELF`） 返回true
 *   此时会额外判断是否为exec文件, 通过文件头判断如下均符合要求
 *   1.ehdr.e_type == ET_DYN && ehdr.e_entry != 0 动态库文件且e_entry非空时 认为是可执行文件
 *   2.ehdr.e_type == ET_EXEC 直接为可执行文件
 */
-APPSPAWN_STATIC bool HnpELFFileCheck(const char *path, HnpSignMapInfo *signInfo)
+APPSPAWN_STATIC bool HnpELFHeaderCheck(const char *head, size_t headLen, const char *path, HnpSignMapInfo *signInfo)
 {
-    FILE *fp;
-    char buff[EI_NIDENT];
-
-    fp = fopen(path, "rb");
-    if (fp == NULL) {
-        return false;
-    }
-
-    size_t readLen = fread(buff, sizeof(char), EI_NIDENT, fp);
-    HNP_ONLY_EXPER(readLen != EI_NIDENT, (void)fclose(fp);
-        return false);
-    HNP_ONLY_EXPER(memcmp(buff, ELFMAG, SELFMAG) != 0, (void)fclose(fp);
-        return false);
+    HNP_ONLY_EXPER(headLen < EI_NIDENT, return false);
+    HNP_ONLY_EXPER(memcmp(head, ELFMAG, SELFMAG) != 0, return false);
 
 #ifndef HNP_CLI
-    HNP_INFO_CHECK(buff[EI_CLASS] == ELFCLASS32 || buff[EI_CLASS] == ELFCLASS64, (void)fclose(fp);
-        return true, "unknown elf type %{public}d", buff[EI_CLASS]);
-
-    int ret = fseek(fp, 0, SEEK_SET);
-    HNP_ERROR_CHECK(ret == 0, (void)fclose(fp);
-        return true, "set seek_set failed %{public}d %{public}s", errno, path);
+    HNP_INFO_CHECK(head[EI_CLASS] == ELFCLASS32 || head[EI_CLASS] == ELFCLASS64,
+        return true, "unknown elf type %{public}d", head[EI_CLASS]);
 
-    if (buff[EI_CLASS] == ELFCLASS32) {
+    if (head[EI_CLASS] == ELFCLASS32) {
         Elf32_Ehdr ehdr = {0};
-        readLen = fread(&ehdr, sizeof(Elf32_Ehdr), 1, fp);
-        HNP_ERROR_CHECK(readLen != sizeof(Elf32_Ehdr),  (void)fclose(fp);
-            return true, "fread ehdr failed");
+        HNP_ERROR_CHECK(headLen >= sizeof(Elf32_Ehdr), return true, "elf head too short %{public}s", path);
+        (void)memcpy_s(&ehdr, sizeof(ehdr), head, sizeof(Elf32_Ehdr));
         signInfo->isExec = (ehdr.e_type == ET_DYN && ehdr.e_entry != 0) || (ehdr.e_type == ET_EXEC);
     } else {
         Elf64_Ehdr ehdr = {0};
-        readLen = fread(&ehdr, sizeof(Elf64_Ehdr), 1, fp);
-        HNP_ERROR_CHECK(readLen != sizeof(Elf64_Ehdr),  (void)fclose(fp);
-            return true, "fread ehdr failed");
+        HNP_ERROR_CHECK(headLen >= sizeof(Elf64_Ehdr), return true, "elf head too short %{public}s", path);
+        (void)memcpy_s(&ehdr, sizeof(ehdr), head, sizeof(Elf64_Ehdr));
         signInfo->isExec = (ehdr.e_type == ET_DYN && ehdr.e_entry != 0) || (ehdr.e_type == ET_EXEC);
     }
     HNP_LOGI("get elffile with %{public}s %{public}d", path, signInfo->isExec);
 #endif
-    (void)fclose(fp);
     return true;
 }
 
 static int HnpInstallAddSignMap(const char* hnpSignKeyPrefix, const char *key, const char *value,
-    HnpSignMapInfo *hnpSignMapInfos, int *count)
+    const HnpUnZipBuffer *buf, HnpSignMapInfo *hnpSignMapInfos, int *count)
 {
     int ret;
     int sum = *count;
 
     HnpSignMapInfo temp = {0};
-    HNP_ONLY_EXPER(HnpELFFileCheck(value, &temp) == false, return 0);
+    HNP_ONLY_EXPER(HnpELFHeaderCheck(buf->head, buf->headLen, value, &temp) == false, return 0);
 
     hnpSignMapInfos[sum].isExec = temp.isExec;
     ret = sprintf_s(hnpSignMapInfos[sum].key, MAX_FILE_PATH_LEN, "%s!/%s", hnpSignKeyPrefix, key);
@@ -428,67 +803,69 @@ static int HnpInstallAddSignMap(const char* hnpSignKeyPrefix, const char *key, c
     return 0;
 }
 
-int HnpFileCountGet(const char *path, int *count)
+int HnpUnZipOpen(const char *inputFile, unzFile *zipFile)
 {
-    int sum = 0;
-
-    unzFile zipFile = unzOpen(path);
-    if (zipFile == NULL) {
-        HNP_LOGE("unzip open hnp:%{public}s unsuccess!", path);
+    *zipFile = unzOpen(inputFile);
+    if (*zipFile == NULL) {
+        HNP_LOGE("unzip open hnp:%{public}s unsuccess!", inputFile);
         return HNP_ERRNO_BASE_UNZIP_OPEN_FAILED;
     }
+    return 0;
+}
 
-    int ret = unzGoToFirstFile(zipFile);
-    while (ret == UNZ_OK) {
-        if (sum == INT_MAX) {
-            unzClose(zipFile);
-            return HNP_ERRNO_BASE_FILE_COUNT_OVER;
-        }
-        sum++;
-        ret = unzGetCurrentFileInfo(zipFile, NULL, NULL, 0, NULL, 0, NULL, 0);
-        if (ret != UNZ_OK) {
-            HNP_LOGE("unzip get zip:%{public}s info unsuccess!", path);
-            unzClose(zipFile);
-            return HNP_ERRNO_BASE_UNZIP_GET_INFO_FAILED;
-        }
-
-        ret = unzGoToNextFile(zipFile);
+void HnpUnZipClose(unzFile *zipFile)
+{
+    if (*zipFile != NULL) {
+        unzClose(*zipFile);
+        *zipFile = NULL;
     }
+}
+
+int HnpFileCountGet(unzFile zipFile, int *count)
+{
+    unz_global_info globalInfo;
 
-    unzClose(zipFile);
-    if (INT_MAX - sum < *count) {
+    /* 文件个数取自中心目录结尾记录，无需遍历 */
+    if (unzGetGlobalInfo(zipFile, &globalInfo) != UNZ_OK) {
+        HNP_LOGE("unzip get global info unsuccess!");
+        return HNP_ERRNO_BASE_UNZIP_GET_INFO_FAILED;
+    }
+    if (globalInfo.number_entry > (uLong)(INT_MAX - *count)) {
         return HNP_ERRNO_BASE_FILE_COUNT_OVER;
     }
-    *count += sum;
+    *count += (int)globalInfo.number_entry;
     return 0;
 }
 
-int HnpUnZip(const char *inputFile, const char *outputDir, const char *hnpSignKeyPrefix,
-    HnpSignMapInfo *hnpSignMapInfos, int *count)
+static char *HnpUnZipBufferAlloc(void)
+{
+#ifdef _WIN32
+    return (char *)malloc(HNP_UNZIP_BUFFER_SIZE);
+#else
+    void *data = NULL;
+    if (posix_memalign(&data, HNP_UNZIP_BUFFER_ALIGN, HNP_UNZIP_BUFFER_SIZE) != 0) {
+        return NULL;
+    }
+    return (char *)data;
+#endif
+}
+
+static int HnpUnZipEntries(unzFile zipFile, const char *inputFile, const char *outputDir,
+    const char *hnpSignKeyPrefix, HnpSignMapInfo *hnpSignMapInfos, int *count, HnpUnZipBuffer *buf)
 {
     char fileName[MAX_FILE_PATH_LEN];
     unz_file_info fileInfo;
     char filePath[MAX_FILE_PATH_LEN];
 
-    HNP_LOGI("HnpUnZip zip=%{public}s, output=%{public}s", inputFile, outputDir);
-
-    unzFile zipFile = unzOpen(inputFile);
-    if (zipFile == NULL) {
-        HNP_LOGE("unzip open hnp:%{public}s unsuccess!", inputFile);
-        return HNP_ERRNO_BASE_UNZIP_OPEN_FAILED;
-    }
-
     int result = unzGoToFirstFile(zipFile);
     while (result == UNZ_OK) {
         result = unzGetCurrentFileInfo(zipFile, &fileInfo, fileName, sizeof(fileName), NULL, 0, NULL, 0);
         if (result != UNZ_OK) {
             HNP_LOGE("unzip get zip:%{public}s info unsuccess!", inputFile);
-            unzClose(zipFile);
             return HNP_ERRNO_BASE_UNZIP_GET_INFO_FAILED;
         }
         if (strstr(fileName, "..")) {
             HNP_LOGE("unzip filename[%{public}s],does not allow the use of ..", fileName);
-            unzClose(zipFile);
             return HNP_ERRNO_BASE_UNZIP_GET_INFO_FAILED;
         }
         char *slash = strchr(fileName, '/');
@@ -500,77 +877,120 @@ int HnpUnZip(const char *inputFile, const char *outputDir, const char *hnpSignKe
 
         if (sprintf_s(filePath, MAX_FILE_PATH_LEN, "%s/%s", outputDir, slash) < 0) {
             HNP_LOGE("sprintf unsuccess.");
-            unzClose(zipFile);
             return HNP_ERRNO_BASE_SPRINTF_FAILED;
         }
 
-        result = HnpUnZipForFile(filePath, zipFile, fileInfo);
+        result = HnpUnZipForFile(filePath, zipFile, fileInfo, buf);
         if (result != 0) {
             HNP_LOGE("unzip for file:%{public}s unsuccess", filePath);
-            unzClose(zipFile);
             return result;
         }
-        result = HnpInstallAddSignMap(hnpSignKeyPrefix, fileName, filePath, hnpSignMapInfos, count);
+        result = HnpInstallAddSignMap(hnpSignKeyPrefix, fileName, filePath, buf, hnpSignMapInfos, count);
         if (result != 0) {
-            unzClose(zipFile);
             return result;
         }
         result = unzGoToNextFile(zipFile);
     }
 
-    unzClose(zipFile);
     return 0;
 }
 
-int HnpCfgGetFromZip(const char *inputFile, HnpCfgInfo *hnpCfg)
+int HnpUnZip(unzFile zipFile, const char *inputFile, const char *outputDir, const char *hnpSignKeyPrefix,
+    HnpSignMapInfo *hnpSignMapInfos, int *count)
 {
-    char fileName[MAX_FILE_PATH_LEN];
-    unz_file_info fileInfo;
-    char *cfgStream = NULL;
+    HnpUnZipBuffer buf = {0};
 
-    unzFile zipFile = unzOpen(inputFile);
-    if (zipFile == NULL) {
-        HNP_LOGE("unzip open hnp:%{public}s unsuccess!", inputFile);
-        return HNP_ERRNO_BASE_UNZIP_OPEN_FAILED;
+    HNP_LOGI("HnpUnZip zip=%{public}s, output=%{public}s", inputFile, outputDir);
+
+    buf.data = HnpUnZipBufferAlloc();
+    if (buf.data == NULL) {
+        HNP_LOGE("unzip malloc buffer unsuccess.");
+        return HNP_ERRNO_NOMEM;
     }
+    int ret = HnpUnZipEntries(zipFile, inputFile, outputDir, hnpSignKeyPrefix, hnpSignMapInfos, count, &buf);
+    free(buf.data);
+    return ret;
+}
+
+static bool HnpCfgFileNameCheck(const char *fileName)
+{
+    const char *fileNameTmp = strrchr(fileName, DIR_SPLIT_SYMBOL);
+    if (fileNameTmp == NULL) {
+        fileNameTmp = fileName;
+    } else {
+        fileNameTmp++;
+    }
+    return strcmp(fileNameTmp, HNP_CFG_FILE_NAME) == 0;
+}
 
+/* 打包时cfg位于{目录名}/hnp.json，先按该名称在中心目录中定位，定位不到再逐个比较文件名 */
+static int HnpCfgLocate(unzFile zipFile, const char *inputFile, bool *found)
+{
+    char fileName[MAX_FILE_PATH_LEN];
+
+    *found = false;
     int ret = unzGoToFirstFile(zipFile);
+    HNP_ONLY_EXPER(ret != UNZ_OK, return 0);
+    ret = unzGetCurrentFileInfo(zipFile, NULL, fileName, sizeof(fileName), NULL, 0, NULL, 0);
+    if (ret != UNZ_OK) {
+        HNP_LOGE("unzip get zip:%{public}s info unsuccess!", inputFile);
+        return HNP_ERRNO_BASE_UNZIP_GET_INFO_FAILED;
+    }
+    char *slash = strchr(fileName, '/');
+    if (slash != NULL) {
+        size_t offset = (size_t)(slash + 1 - fileName);
+        if ((strcpy_s(fileName + offset, sizeof(fileName) - offset, HNP_CFG_FILE_NAME) == EOK) &&
+            (unzLocateFile(zipFile, fileName, 1) == UNZ_OK)) {
+            *found = true;
+            return 0;
+        }
+    }
+
+    ret = unzGoToFirstFile(zipFile);
     while (ret == UNZ_OK) {
-        ret = unzGetCurrentFileInfo(zipFile, &fileInfo, fileName, sizeof(fileName), NULL, 0, NULL, 0);
+        ret = unzGetCurrentFileInfo(zipFile, NULL, fileName, sizeof(fileName), NULL, 0, NULL, 0);
         if (ret != UNZ_OK) {
             HNP_LOGE("unzip get zip:%{public}s info unsuccess!", inputFile);
-            unzClose(zipFile);
             return HNP_ERRNO_BASE_UNZIP_GET_INFO_FAILED;
         }
-        char *fileNameTmp = strrchr(fileName, DIR_SPLIT_SYMBOL);
-        if (fileNameTmp == NULL) {
-            fileNameTmp = fileName;
-        } else {
-            fileNameTmp++;
-        }
-        if (strcmp(fileNameTmp, HNP_CFG_FILE_NAME) != 0) {
-            ret = unzGoToNextFile(zipFile);
-            continue;
+        if (HnpCfgFileNameCheck(fileName)) {
+            *found = true;
+            return 0;
         }
+        ret = unzGoToNextFile(zipFile);
+    }
+    return 0;
+}
 
-        unzOpenCurrentFile(zipFile);
+int HnpCfgGetFromZip(unzFile zipFile, const char *inputFile, HnpCfgInfo *hnpCfg)
+{
+    unz_file_info fileInfo;
+    char *cfgStream = NULL;
+    bool found = false;
+
+    int ret = HnpCfgLocate(zipFile, inputFile, &found);
+    HNP_ONLY_EXPER(ret != 0, return ret);
+    if (found) {
+        ret = unzGetCurrentFileInfo(zipFile, &fileInfo, NULL, 0, NULL, 0, NULL, 0);
+        if (ret != UNZ_OK) {
+            HNP_LOGE("unzip get zip:%{public}s info unsuccess!", inputFile);
+            return HNP_ERRNO_BASE_UNZIP_GET_INFO_FAILED;
+        }
         cfgStream = malloc(fileInfo.uncompressed_size);
         if (cfgStream == NULL) {
             HNP_LOGE("malloc unsuccess. size=%{public}lu, errno=%{public}d", fileInfo.uncompressed_size, errno);
-            unzClose(zipFile);
             return HNP_ERRNO_NOMEM;
         }
+        unzOpenCurrentFile(zipFile);
         int readSize = unzReadCurrentFile(zipFile, cfgStream, fileInfo.uncompressed_size);
+        unzCloseCurrentFile(zipFile);
         if (readSize < 0 || (uLong)readSize != fileInfo.uncompressed_size) {
             free(cfgStream);
-            unzClose(zipFile);
             HNP_LOGE("unzip read zip:%{public}s info size[%{public}lu]=>[%{public}d] error!", inputFile,
                 fileInfo.uncompressed_size, readSize);
             return HNP_ERRNO_BASE_FILE_READ_FAILED;
         }
-        break;
     }
-    unzClose(zipFile);
     ret = HnpCfgGetFromSteam(cfgStream, hnpCfg);
     free(cfgStream);
     return ret;
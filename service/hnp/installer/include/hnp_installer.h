@@ -16,6 +16,8 @@
 #ifndef HNP_INSTALLER_H
 #define HNP_INSTALLER_H
 
+#include <pthread.h>
+
 #include "hnp_base.h"
 
 #ifdef __cplusplus
@@ -69,6 +71,32 @@ typedef struct HnpInstallInfoStru {
     char hnpSignKeyPrefix[MAX_FILE_PATH_LEN]; // hnp包验签前缀,hnp/{abi}/xxxx/xxx.hnp
 } HnpInstallInfo;
 
+/* 单个hnp包的安装任务，解压与验签信息填充可并发执行，软链与hnp_info按任务顺序提交 */
+typedef struct HnpInstallJobStru {
+    char srcFile[MAX_FILE_PATH_LEN];
+    HnpInstallInfo hnpInfo;                   // 任务私有，安装路径与验签前缀互不影响
+    HnpCfgInfo hnpCfg;
+    unzFile zipFile;                          // 仅在读取cfg与解压期间打开
+    int signOffset;                           // 在验签信息数组中预留的起始位置
+    int signCount;                            // 解压后实际填充的个数
+    bool prepared;                            // 已在并发阶段解压到新建的安装目录
+    int ret;
+} HnpInstallJob;
+
+typedef struct HnpInstallJobListStru {
+    HnpInstallJob *jobs;
+    int count;
+    int capacity;
+    int signTotal;                            // 所有任务预留的验签信息个数
+    HnpSignMapInfo *hnpSignMapInfos;
+    int next;                                 // 下一个待领取的任务，原子访问
+    bool abort;                               // 有任务失败后不再领取新任务，原子访问
+    int turn;                                 // 下一个待提交的任务，mutex保护
+    bool failed;                              // 已提交的任务中有失败，mutex保护
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} HnpInstallJobList;
+
 int HnpCmdInstall(int argc, char *argv[]);
 
 int HnpCmdUnInstall(int argc, char *argv[]);
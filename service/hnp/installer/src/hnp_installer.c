@@ -23,6 +23,7 @@
 #include <errno.h>
 #include <getopt.h>
 #include <dlfcn.h>
+#include <pthread.h>
 
 #include "policycoreutils.h"
 #ifdef CODE_SIGNATURE_ENABLE
@@ -37,6 +38,8 @@
 #endif
 #define HNP_BASE_DEC (10)
 #define HNP_BASE_UID (100)
+#define HNP_INSTALL_MAX_WORKERS (4)
+#define HNP_INSTALL_JOB_INIT_CAPACITY (8)
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -215,13 +218,14 @@ static bool CheckIsSignHnp(const char *hnpFile, HapInstallInfo *installInfo)
     return isSign;
 }
 
-static int HnpInstall(const char *hnpFile, HnpInstallInfo *hnpInfo, HnpCfgInfo *hnpCfg,
+/* 软链在提交阶段按任务顺序生成 */
+static int HnpInstall(const char *hnpFile, unzFile zipFile, HnpInstallInfo *hnpInfo,
     HnpSignMapInfo *hnpSignMapInfos, int *count)
 {
     int ret;
     int currentIndex = *count;
     /* 解压hnp文件 */
-    ret = HnpUnZip(hnpFile, hnpInfo->hnpVersionPath, hnpInfo->hnpSignKeyPrefix, hnpSignMapInfos, count);
+    ret = HnpUnZip(zipFile, hnpFile, hnpInfo->hnpVersionPath, hnpInfo->hnpSignKeyPrefix, hnpSignMapInfos, count);
     if (ret != 0) {
         return ret; /* 内部已打印日志 */
     }
@@ -231,9 +235,7 @@ static int HnpInstall(const char *hnpFile, HnpInstallInfo *hnpInfo, HnpCfgInfo *
         hnpSignMapInfos[i].independentSign = isSign;
         hnpSignMapInfos[i].hnpType = hnpInfo->isPublic;
     }
-
-    /* 生成软链 */
-    return HnpGenerateSoftLink(hnpInfo, hnpCfg);
+    return 0;
 }
 
 /**
@@ -419,12 +421,33 @@ APPSPAWN_STATIC int RebuildHnpInfoCfg(int uid)
     return DoRebuildHnpInfoCfg(uid);
 }
 
+static int HnpPublicUnInstall(int uid, const char *packageName)
+{
+    HnpPackageInfo *packageInfo = NULL;
+    int count = 0;
+
+    int ret = HnpPackageInfoGet(packageName, &packageInfo, &count, uid);
+    if (ret != 0) {
+        return ret;
+    }
+
+    /* 卸载公有native */
+    for (int i = 0; i < count; i++) {
+        ret = HnpNativeUnInstall(&packageInfo[i], uid, packageName);
+        if (ret != 0) {
+            free(packageInfo);
+            return ret;
+        }
+    }
+    free(packageInfo);
+
+    return HnpPackageInfoDelete(packageName, uid);
+}
+
 static int HnpUnInstall(int uid, const char *packageName)
 {
     int ret = RebuildHnpInfoCfg(uid);
     HNP_LOGI("rebuild cfg with ret %{public}d", ret);
-    HnpPackageInfo *packageInfo = NULL;
-    int count = 0;
     char privatePath[MAX_FILE_PATH_LEN];
     char dstPath[MAX_FILE_PATH_LEN];
 
@@ -440,22 +463,11 @@ static int HnpUnInstall(int uid, const char *packageName)
         return HNP_ERRNO_UNINSTALLER_HNP_PATH_NOT_EXIST;
     }
 
-    ret = HnpPackageInfoGet(packageName, &packageInfo, &count, uid);
-    if (ret != 0) {
-        return ret;
-    }
-
-    /* 卸载公有native */
-    for (int i = 0; i < count; i++) {
-        ret = HnpNativeUnInstall(&packageInfo[i], uid, packageName);
-        if (ret != 0) {
-            free(packageInfo);
-            return ret;
-        }
-    }
-    free(packageInfo);
-
-    ret = HnpPackageInfoDelete(packageName, uid);
+    /* 本次卸载的hnp信息变更合并为一次落盘 */
+    (void)HnpPackageInfoTransBegin(uid);
+    ret = HnpPublicUnInstall(uid, packageName);
+    int transRet = HnpPackageInfoTransEnd(uid);
+    HNP_ONLY_EXPER(ret == 0, ret = transRet);
     if (ret != 0) {
         return ret;
     }
@@ -540,69 +552,117 @@ static int HnpPublicDealAfterInstall(HnpInstallInfo *hnpInfo, HnpCfgInfo *hnpCfg
     return HnpInstallInfoJsonWrite(hnpInfo->hapInstallInfo->hapPackageName, hnpCfg);
 }
 
-static int HnpReadAndInstall(char *srcFile, HnpInstallInfo *hnpInfo, HnpSignMapInfo *hnpSignMapInfos, int *count)
+/* 收集阶段读取配置后已关闭句柄，解压时重新打开，同一时刻只有正在解压的任务占用句柄 */
+static int HnpInstallJobUnZip(HnpInstallJob *job, HnpSignMapInfo *hnpSignMapInfos)
 {
-    int ret;
-    HnpCfgInfo hnpCfg = {0};
-    hnpCfg.uid = hnpInfo->hapInstallInfo->uid;
-    HNP_LOGI("hnp install start now! src file=%{public}s, dst path=%{public}s", srcFile, hnpInfo->hnpBasePath);
-    /* 从hnp zip获取cfg信息 */
-    ret = HnpCfgGetFromZip(srcFile, &hnpCfg);
-    if (ret != 0) {
-        return ret;
-    }
+    int ret = HnpUnZipOpen(job->srcFile, &job->zipFile);
+    HNP_ONLY_EXPER(ret != 0, return ret);
+    int count = job->signOffset;
+    ret = HnpInstall(job->srcFile, job->zipFile, &job->hnpInfo, hnpSignMapInfos, &count);
+    job->signCount = count - job->signOffset;
+    HnpUnZipClose(&job->zipFile);
+    return ret;
+}
 
-    ret = HnpInstallPathGet(&hnpCfg, hnpInfo);
-    if (ret != 0) {
-        // 释放软链接占用的内存
-        if (hnpCfg.links != NULL) {
-            free(hnpCfg.links);
-        }
-        return ret;
-    }
+/* 安装目录不存在时只涉及本任务新建的目录，可与其他任务并发解压；其余情况在提交阶段串行处理 */
+static void HnpInstallJobPrepare(HnpInstallJob *job, HnpSignMapInfo *hnpSignMapInfos)
+{
+    HnpInstallInfo *hnpInfo = &job->hnpInfo;
+    HNP_LOGI("hnp install start now! src file=%{public}s, dst path=%{public}s", job->srcFile, hnpInfo->hnpBasePath);
+    HNP_ONLY_EXPER(access(hnpInfo->hnpSoftwarePath, F_OK) == 0, return);
 
-    /* 存在对应版本的公有hnp包跳过安装 */
-    if (access(hnpInfo->hnpVersionPath, F_OK) == 0 && hnpInfo->isPublic) {
-        /* 刷新软链 */
-        ret = HnpGenerateSoftLink(hnpInfo, &hnpCfg);
+    job->prepared = true;
+    job->ret = HnpInstallForceCheck(&job->hnpCfg, hnpInfo);
+    HNP_ONLY_EXPER(job->ret == 0, job->ret = HnpInstallJobUnZip(job, hnpSignMapInfos));
+}
 
-        // 释放软链接占用的内存
-        HNP_ONLY_EXPER(hnpCfg.links != NULL, free(hnpCfg.links));
+/* 按任务顺序串行执行，软链、hnp_info与失败回退的结果与串行安装一致 */
+static int HnpInstallJobCommit(HnpInstallJob *job, HnpSignMapInfo *hnpSignMapInfos)
+{
+    int ret = job->ret;
+    HnpInstallInfo *hnpInfo = &job->hnpInfo;
+    HnpCfgInfo *hnpCfg = &job->hnpCfg;
+
+    if (!job->prepared) {
+        /* 存在对应版本的公有hnp包跳过安装，刷新软链 */
+        if (access(hnpInfo->hnpVersionPath, F_OK) == 0 && hnpInfo->isPublic) {
+            ret = HnpGenerateSoftLink(hnpInfo, hnpCfg);
+            return (ret == 0) ? HnpPublicDealAfterInstall(hnpInfo, hnpCfg) : ret;
+        }
+        ret = HnpInstallForceCheck(hnpCfg, hnpInfo);
         HNP_ONLY_EXPER(ret != 0, return ret);
-
-        return HnpPublicDealAfterInstall(hnpInfo, &hnpCfg);
+        ret = HnpInstallJobUnZip(job, hnpSignMapInfos);
     }
 
-    ret = HnpInstallForceCheck(&hnpCfg, hnpInfo);
+    HNP_ONLY_EXPER(ret == 0, ret = HnpGenerateSoftLink(hnpInfo, hnpCfg));
+    HNP_ONLY_EXPER(ret == 0 && hnpInfo->isPublic, ret = HnpPublicDealAfterInstall(hnpInfo, hnpCfg));
     if (ret != 0) {
-        // 释放软链接占用的内存
-        if (hnpCfg.links != NULL) {
-            free(hnpCfg.links);
-        }
-        return ret;
+        HnpUnInstallPublicHnp(hnpInfo->hapInstallInfo->hapPackageName, hnpCfg->name, hnpCfg->version,
+            hnpInfo->hapInstallInfo->uid, false);
     }
+    return ret;
+}
 
-    /* hnp安装 */
-    ret = HnpInstall(srcFile, hnpInfo, &hnpCfg, hnpSignMapInfos, count);
-    // 释放软链接占用的内存
-    if (hnpCfg.links != NULL) {
-        free(hnpCfg.links);
-    }
-    if (ret != 0) {
-        HnpUnInstallPublicHnp(hnpInfo->hapInstallInfo->hapPackageName, hnpCfg.name, hnpCfg.version,
-            hnpInfo->hapInstallInfo->uid, false);
-        return ret;
+APPSPAWN_STATIC void HnpInstallJobListClear(HnpInstallJobList *list)
+{
+    for (int i = 0; i < list->count; i++) {
+        HnpUnZipClose(&list->jobs[i].zipFile);
+        // 释放软链接占用的内存
+        HNP_ONLY_EXPER(list->jobs[i].hnpCfg.links != NULL, free(list->jobs[i].hnpCfg.links));
     }
+    free(list->jobs);
+    list->jobs = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
 
-    if (hnpInfo->isPublic) {
-        ret = HnpPublicDealAfterInstall(hnpInfo, &hnpCfg);
-        if (ret != 0) {
-            HnpUnInstallPublicHnp(hnpInfo->hapInstallInfo->hapPackageName, hnpCfg.name, hnpCfg.version,
-                hnpInfo->hapInstallInfo->uid, false);
-        }
+static HnpInstallJob *HnpInstallJobAlloc(HnpInstallJobList *list)
+{
+    if (list->count >= list->capacity) {
+        int capacity = (list->capacity == 0) ? HNP_INSTALL_JOB_INIT_CAPACITY : list->capacity * 2;
+        HnpInstallJob *jobs = (HnpInstallJob *)realloc(list->jobs, sizeof(HnpInstallJob) * capacity);
+        HNP_ERROR_CHECK(jobs != NULL, return NULL, "alloc install job unsuccess, count=%{public}d", capacity);
+        list->jobs = jobs;
+        list->capacity = capacity;
+    }
+    HnpInstallJob *job = &list->jobs[list->count];
+    (void)memset_s(job, sizeof(HnpInstallJob), 0, sizeof(HnpInstallJob));
+    return job;
+}
+
+/* 读取hnp包配置并组装安装路径，预留验签信息空间 */
+static int HnpInstallJobAdd(HnpInstallJobList *list, const char *srcFile, const HnpInstallInfo *hnpInfo)
+{
+    HnpInstallJob *job = HnpInstallJobAlloc(list);
+    HNP_ONLY_EXPER(job == NULL, return HNP_ERRNO_NOMEM);
+    if (strcpy_s(job->srcFile, MAX_FILE_PATH_LEN, srcFile) != EOK) {
+        HNP_LOGE("hnp install copy src file[%{public}s] unsuccess", srcFile);
+        return HNP_ERRNO_BASE_COPY_FAILED;
     }
+    job->hnpInfo = *hnpInfo;
+    job->hnpCfg.uid = hnpInfo->hapInstallInfo->uid;
 
-    return ret;
+    int ret = HnpUnZipOpen(srcFile, &job->zipFile);
+    HNP_ONLY_EXPER(ret != 0, return ret);
+    list->count++;  // 之后失败时句柄与links由HnpInstallJobListClear释放
+
+    /* 从hnp zip获取cfg信息 */
+    ret = HnpCfgGetFromZip(job->zipFile, srcFile, &job->hnpCfg);
+    HNP_ONLY_EXPER(ret != 0, return ret);
+
+    ret = HnpInstallPathGet(&job->hnpCfg, &job->hnpInfo);
+    HNP_ONLY_EXPER(ret != 0, return ret);
+
+    int signCount = 0;
+    ret = HnpFileCountGet(job->zipFile, &signCount);
+    HNP_ONLY_EXPER(ret != 0, return ret);
+    if (INT_MAX - signCount < list->signTotal) {
+        return HNP_ERRNO_BASE_FILE_COUNT_OVER;
+    }
+    job->signOffset = list->signTotal;
+    list->signTotal += signCount;
+    HnpUnZipClose(&job->zipFile);
+    return 0;
 }
 
 static bool HnpFileCheck(const char *file)
@@ -617,8 +677,7 @@ static bool HnpFileCheck(const char *file)
     return false;
 }
 
-static int HnpPackageGetAndInstall(const char *dirPath, HnpInstallInfo *hnpInfo, char *sunDir,
-    HnpSignMapInfo *hnpSignMapInfos, int *count)
+static int HnpPackageCollect(const char *dirPath, HnpInstallInfo *hnpInfo, char *sunDir, HnpInstallJobList *list)
 {
     DIR *dir;
     struct dirent *entry;
@@ -646,7 +705,7 @@ static int HnpPackageGetAndInstall(const char *dirPath, HnpInstallInfo *hnpInfo,
                 closedir(dir);
                 return HNP_ERRNO_BASE_SPRINTF_FAILED;
             }
-            int ret = HnpPackageGetAndInstall(path, hnpInfo, sunDirNew, hnpSignMapInfos, count);
+            int ret = HnpPackageCollect(path, hnpInfo, sunDirNew, list);
             if (ret != 0) {
                 closedir(dir);
                 return ret;
@@ -661,8 +720,7 @@ static int HnpPackageGetAndInstall(const char *dirPath, HnpInstallInfo *hnpInfo,
                 closedir(dir);
                 return HNP_ERRNO_BASE_SPRINTF_FAILED;
             }
-            int ret = HnpReadAndInstall(path, hnpInfo, hnpSignMapInfos, count);
-            HNP_LOGI("hnp install end, ret=%{public}d", ret);
+            int ret = HnpInstallJobAdd(list, path, hnpInfo);
             if (ret != 0) {
                 closedir(dir);
                 return ret;
@@ -673,14 +731,20 @@ static int HnpPackageGetAndInstall(const char *dirPath, HnpInstallInfo *hnpInfo,
     return 0;
 }
 
-static int HapReadAndInstall(const char *dstPath, HapInstallInfo *installInfo, HnpSignMapInfo *hnpSignMapInfos,
-    int *count)
+APPSPAWN_STATIC int HapPackageCollect(const char *dstPath, HapInstallInfo *installInfo, HnpInstallJobList *list)
 {
     struct dirent *entry;
     char hnpPath[MAX_FILE_PATH_LEN];
+    char realPath[MAX_FILE_PATH_LEN] = {0};
     HnpInstallInfo hnpInfo = {0};
     int ret;
 
+    if ((realpath(installInfo->hnpRootPath, realPath) == NULL) ||
+        (strnlen(realPath, MAX_FILE_PATH_LEN) >= MAX_FILE_PATH_LEN)) {
+        HNP_LOGE("hnp root path:%{public}s invalid", installInfo->hnpRootPath);
+        return HNP_ERRNO_BASE_PARAMS_INVALID;
+    }
+
     DIR *dir = opendir(installInfo->hnpRootPath);
     if (dir == NULL) {
         HNP_LOGE("hnp install opendir:%{public}s unsuccess, errno=%{public}d", installInfo->hnpRootPath, errno);
@@ -711,7 +775,7 @@ static int HapReadAndInstall(const char *dstPath, HapInstallInfo *installInfo, H
             continue;
         }
 
-        ret = HnpPackageGetAndInstall(hnpPath, &hnpInfo, "", hnpSignMapInfos, count);
+        ret = HnpPackageCollect(hnpPath, &hnpInfo, "", list);
         if (ret != 0) {
             closedir(dir);
             return ret;
@@ -722,92 +786,114 @@ static int HapReadAndInstall(const char *dstPath, HapInstallInfo *installInfo, H
     return 0;
 }
 
-static int HnpInstallHnpFileCountGet(char *hnpPath, int *count)
+/* 同名软件安装到同一目录，存在时按原顺序串行安装 */
+static bool HnpInstallJobConflict(const HnpInstallJobList *list)
 {
-    DIR *dir;
-    struct dirent *entry;
-    char path[MAX_FILE_PATH_LEN];
-    int ret;
-
-    if ((dir = opendir(hnpPath)) == NULL) {
-        HNP_LOGE("hnp install count get opendir:%{public}s unsuccess, errno=%{public}d", hnpPath, errno);
-        return HNP_ERRNO_BASE_DIR_OPEN_FAILED;
-    }
-
-    while ((entry = readdir(dir)) != NULL) {
-        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0)) {
-            continue;
-        }
-
-        if (sprintf_s(path, MAX_FILE_PATH_LEN, "%s/%s", hnpPath, entry->d_name) < 0) {
-            HNP_LOGE("hnp install count get sprintf unsuccess, dir[%{public}s], path[%{public}s]", hnpPath,
-                entry->d_name);
-            closedir(dir);
-            return HNP_ERRNO_BASE_SPRINTF_FAILED;
-        }
-
-        if (entry->d_type == DT_DIR) {
-            if (sprintf_s(path, MAX_FILE_PATH_LEN, "%s/%s", hnpPath, entry->d_name) < 0) {
-                HNP_LOGE("hnp install sprintf sub dir unsuccess");
-                closedir(dir);
-                return HNP_ERRNO_BASE_SPRINTF_FAILED;
-            }
-            ret = HnpInstallHnpFileCountGet(path, count);
-            if (ret != 0) {
-                closedir(dir);
-                return ret;
-            }
-        } else {
-            if (HnpFileCheck(path) == false) {
-                continue;
-            }
-            ret = HnpFileCountGet(path, count);
-            if (ret != 0) {
-                closedir(dir);
-                return ret;
+    for (int i = 0; i < list->count; i++) {
+        for (int j = i + 1; j < list->count; j++) {
+            if (strcmp(list->jobs[i].hnpInfo.hnpSoftwarePath, list->jobs[j].hnpInfo.hnpSoftwarePath) == 0) {
+                HNP_LOGI("hnp %{public}s installed more than once, install serially", list->jobs[i].hnpCfg.name);
+                return true;
             }
         }
     }
-
-    closedir(dir);
-    return 0;
+    return false;
 }
 
-static int HnpInstallHapFileCountGet(const char *root, int *count)
+APPSPAWN_STATIC int HnpInstallWorkerCountGet(const HnpInstallJobList *list)
 {
-    struct dirent *entry;
-    char hnpPath[MAX_FILE_PATH_LEN];
-    char realPath[MAX_FILE_PATH_LEN] = {0};
+    HNP_ONLY_EXPER(list->count <= 1 || HnpInstallJobConflict(list), return 1);
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int workers = (cpus > 0 && cpus < HNP_INSTALL_MAX_WORKERS) ? (int)cpus : HNP_INSTALL_MAX_WORKERS;
+    return (workers < list->count) ? workers : list->count;
+}
 
-    if ((realpath(root, realPath) == NULL) || (strnlen(realPath, MAX_FILE_PATH_LEN) >= MAX_FILE_PATH_LEN)) {
-        HNP_LOGE("hnp root path:%{public}s invalid", root);
-        return HNP_ERRNO_BASE_PARAMS_INVALID;
+/* 等待前面的任务提交完成，返回其中是否有失败 */
+static bool HnpInstallJobTurnWait(HnpInstallJobList *list, int index)
+{
+    pthread_mutex_lock(&list->mutex);
+    while (list->turn != index) {
+        pthread_cond_wait(&list->cond, &list->mutex);
     }
+    bool failed = list->failed;
+    pthread_mutex_unlock(&list->mutex);
+    return failed;
+}
 
-    DIR *dir = opendir(realPath);
-    if (dir == NULL) {
-        HNP_LOGE("hnp install opendir:%{public}s unsuccess, errno=%{public}d", realPath, errno);
-        return HNP_ERRNO_BASE_DIR_OPEN_FAILED;
-    }
+static void HnpInstallJobTurnDone(HnpInstallJobList *list, bool failed)
+{
+    pthread_mutex_lock(&list->mutex);
+    list->failed = failed;
+    list->turn++;
+    pthread_cond_broadcast(&list->cond);
+    pthread_mutex_unlock(&list->mutex);
+}
 
-    while ((entry = readdir(dir)) != NULL) {
-        if ((strcmp(entry->d_name, "public") != 0) && (strcmp(entry->d_name, "private") != 0)) {
-            continue;
-        }
-        if (sprintf_s(hnpPath, MAX_FILE_PATH_LEN, "%s/%s", realPath, entry->d_name) < 0) {
-            HNP_LOGE("hnp install private base path sprintf unsuccess.");
-            closedir(dir);
-            return HNP_ERRNO_BASE_SPRINTF_FAILED;
+static void *HnpInstallWorker(void *arg)
+{
+    HnpInstallJobList *list = (HnpInstallJobList *)arg;
+    while (!__atomic_load_n(&list->abort, __ATOMIC_RELAXED)) {
+        int index = __atomic_fetch_add(&list->next, 1, __ATOMIC_RELAXED);
+        HNP_ONLY_EXPER(index >= list->count, break);
+        HnpInstallJob *job = &list->jobs[index];
+        HnpInstallJobPrepare(job, list->hnpSignMapInfos);
+        HNP_ONLY_EXPER(job->ret != 0, __atomic_store_n(&list->abort, true, __ATOMIC_RELAXED));
+
+        bool failed = HnpInstallJobTurnWait(list, index);
+        if (failed) {
+            /* 前面的任务已失败，与串行安装一致不再安装本任务，删除并发阶段解压的内容 */
+            HNP_ONLY_EXPER(job->prepared, (void)HnpDeleteFolder(job->hnpInfo.hnpSoftwarePath));
+            job->signCount = 0;
+        } else {
+            job->ret = HnpInstallJobCommit(job, list->hnpSignMapInfos);
+            HNP_LOGI("hnp install end, ret=%{public}d", job->ret);
+            failed = (job->ret != 0);
         }
+        HnpInstallJobTurnDone(list, failed);
+        HNP_ONLY_EXPER(failed, __atomic_store_n(&list->abort, true, __ATOMIC_RELAXED));
+    }
+    return NULL;
+}
 
-        int ret = HnpInstallHnpFileCountGet(hnpPath, count);
-        if (ret != 0) {
-            closedir(dir);
-            return ret;
+/*
+ * 按任务顺序领取，调用线程也作为一个worker；解压并发执行，提交按任务顺序串行执行。
+ * 有任务失败时其后的任务不再提交，并发阶段已解压的内容被删除，已安装的只有失败任务之前的hnp，与串行安装一致。
+ * 返回序号最小的失败任务的错误码。
+ */
+APPSPAWN_STATIC int HnpInstallJobListRun(HnpInstallJobList *list, int *count)
+{
+    pthread_t threads[HNP_INSTALL_MAX_WORKERS];
+    int workers = HnpInstallWorkerCountGet(list);
+    int started = 0;
+    (void)pthread_mutex_init(&list->mutex, NULL);
+    (void)pthread_cond_init(&list->cond, NULL);
+    for (int i = 1; i < workers; i++) {
+        int err = pthread_create(&threads[started], NULL, HnpInstallWorker, list);
+        if (err != 0) {
+            HNP_LOGI("create install worker unsuccess, ret=%{public}d, workers=%{public}d", err, started + 1);
+            break;
         }
+        started++;
+    }
+    (void)HnpInstallWorker(list);
+    for (int i = 0; i < started; i++) {
+        (void)pthread_join(threads[i], NULL);
+    }
+    (void)pthread_cond_destroy(&list->cond);
+    (void)pthread_mutex_destroy(&list->mutex);
+
+    /* 验签信息按任务顺序紧凑排列，与串行安装一致 */
+    int sum = 0;
+    for (int i = 0; i < list->count; i++) {
+        HnpInstallJob *job = &list->jobs[i];
+        HNP_ONLY_EXPER(job->ret != 0, return job->ret);
+        if (job->signCount > 0 && job->signOffset != sum) {
+            (void)memmove_s(&list->hnpSignMapInfos[sum], sizeof(HnpSignMapInfo) * (list->signTotal - sum),
+                &list->hnpSignMapInfos[job->signOffset], sizeof(HnpSignMapInfo) * job->signCount);
+        }
+        sum += job->signCount;
     }
-
-    closedir(dir);
+    *count = sum;
     return 0;
 }
 
@@ -954,14 +1040,22 @@ static int HnpInstallPre(HapInstallInfo *installInfo)
     int i;
 #endif
     int ret;
+    HnpInstallJobList list = {0};
     HNP_ONLY_EXPER((ret = CheckInstallPath(dstPath, installInfo)) != 0 ||
-        (ret = HnpInstallHapFileCountGet(installInfo->hnpRootPath, &count)) != 0, return ret);
-    if (count > 0) {
-        hnpSignMapInfos = (HnpSignMapInfo *)malloc(sizeof(HnpSignMapInfo) * count);
-        HNP_ONLY_EXPER(hnpSignMapInfos == NULL, return HNP_ERRNO_NOMEM);
-    }
-    count = 0;
-    ret = HapReadAndInstall(dstPath, installInfo, hnpSignMapInfos, &count);
+        (ret = HapPackageCollect(dstPath, installInfo, &list)) != 0, HnpInstallJobListClear(&list);
+        return ret);
+    if (list.signTotal > 0) {
+        hnpSignMapInfos = (HnpSignMapInfo *)malloc(sizeof(HnpSignMapInfo) * list.signTotal);
+        HNP_ONLY_EXPER(hnpSignMapInfos == NULL, HnpInstallJobListClear(&list);
+            return HNP_ERRNO_NOMEM);
+    }
+    list.hnpSignMapInfos = hnpSignMapInfos;
+    /* 本次安装的所有hnp信息变更合并为一次落盘 */
+    (void)HnpPackageInfoTransBegin(installInfo->uid);
+    ret = HnpInstallJobListRun(&list, &count);
+    int transRet = HnpPackageInfoTransEnd(installInfo->uid);
+    HNP_ONLY_EXPER(ret == 0, ret = transRet);
+    HnpInstallJobListClear(&list);
     HNP_LOGI("sign start [%{public}s],[%{public}s],%{public}d", installInfo->hapPath, installInfo->abi, count);
 #ifdef CODE_SIGNATURE_ENABLE
     if ((ret == 0) && (count > 0)) {
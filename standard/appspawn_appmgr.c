@@ -32,10 +32,13 @@
 #include "appspawn_modulemgr.h"
 #include "appspawn_msg.h"
 #include "appspawn_manager.h"
+#include "appspawn_param_cache.h"
 #include "securec.h"
 
 #define SLEEP_DURATION 3000 // us
 #define EXIT_APP_TIMEOUT 1000000 // us
+#define SPAWNED_INDEX_INIT_CAPACITY 64
+#define SPAWNED_INDEX_HASH_FACTOR 0x9e3779b1U  // golden ratio
 
 static AppSpawnMgr *g_appSpawnMgr = NULL;
 
@@ -65,6 +68,8 @@ AppSpawnMgr *CreateAppSpawnMgr(int mode)
     OH_ListInit(&appMgr->dataGroupCtxQueue);
     OH_ListInit(&appMgr->checkPointIdQueue);
     OH_ListInit(&appMgr->spawningFdsQueue);
+    OH_ListInit(&appMgr->idleMsgArena);
+    OH_ListInit(&appMgr->idleSpawningCtx);
     appMgr->diedAppCount = 0;
     OH_ListInit(&appMgr->extData);
     g_appSpawnMgr = appMgr;
@@ -89,6 +94,12 @@ static void SpawningQueueDestroy(ListNode *node)
     DeleteAppSpawningCtx(property);
 }
 
+static void IdleSpawningCtxDestroy(ListNode *node)
+{
+    AppSpawningCtx *property = ListEntry(node, AppSpawningCtx, node);
+    free(property);
+}
+
 static void ExtDataDestroy(ListNode *node)
 {
     AppSpawnExtData *extData = ListEntry(node, AppSpawnExtData, node);
@@ -98,16 +109,31 @@ static void ExtDataDestroy(ListNode *node)
     }
 }
 
+static void SpawnedIndexDestroy(SpawnedProcessIndex *index)
+{
+    free(index->slots);
+    index->slots = NULL;
+    index->capacity = 0;
+    index->count = 0;
+}
+
 void DeleteAppSpawnMgr(AppSpawnMgr *mgr)
 {
     APPSPAWN_CHECK_ONLY_EXPER(mgr != NULL, return);
     OH_ListRemoveAll(&mgr->appQueue, NULL);
+    SpawnedIndexDestroy(&mgr->pidIndex);
+    SpawnedIndexDestroy(&mgr->nameIndex);
+    DestroyParamCache();
     OH_ListRemoveAll(&mgr->diedQueue, NULL);
     OH_ListRemoveAll(&mgr->appSpawnQueue, SpawningQueueDestroy);
     OH_ListRemoveAll(&mgr->extData, ExtDataDestroy);
     OH_ListRemoveAll(&mgr->dataGroupCtxQueue, NULL);
     OH_ListRemoveAll(&mgr->checkPointIdQueue, NULL);
     OH_ListRemoveAll(&mgr->spawningFdsQueue, SpawningFdsDestroy);
+    // after the queues above, their messages and ctxs may have been recycled to the pools
+    OH_ListRemoveAll(&mgr->idleSpawningCtx, IdleSpawningCtxDestroy);
+    mgr->idleSpawningCtxCount = 0;
+    ClearAppSpawnMsgArenaPool(mgr);
 #ifdef APPSPAWN_HISYSEVENT
     DeleteHisyseventInfo(mgr->hisyseventInfo);
     mgr->hisyseventInfo = NULL;
@@ -139,17 +165,122 @@ static int AppInfoPidComparePro(ListNode *node, void *data)
     return node1->pid - pid;
 }
 
-static int AppInfoNameComparePro(ListNode *node, void *data)
+typedef uint32_t (*SpawnedIndexHash)(const AppSpawnedProcess *appInfo);
+typedef bool (*SpawnedIndexMatch)(const AppSpawnedProcess *appInfo, const void *key);
+
+static uint32_t PidHash(pid_t pid)
 {
-    AppSpawnedProcess *node1 = ListEntry(node, AppSpawnedProcess, node);
-    return strcmp(node1->name, (char *)data);
+    uint32_t hash = (uint32_t)pid * SPAWNED_INDEX_HASH_FACTOR;
+    return hash ^ (hash >> 16);  // 16: fold high bits into the slot mask
 }
 
-static int AppInfoCompareProc(ListNode *node, ListNode *newNode)
+static uint32_t NameHash(const char *name)
 {
-    AppSpawnedProcess *node1 = ListEntry(node, AppSpawnedProcess, node);
-    AppSpawnedProcess *node2 = ListEntry(newNode, AppSpawnedProcess, node);
-    return node1->pid - node2->pid;
+    return GetAppSpawnNameHash(name, UINT32_MAX);
+}
+
+static uint32_t AppInfoPidHash(const AppSpawnedProcess *appInfo)
+{
+    return PidHash(appInfo->pid);
+}
+
+static uint32_t AppInfoNameHash(const AppSpawnedProcess *appInfo)
+{
+    return NameHash(appInfo->name);
+}
+
+static bool AppInfoPidMatch(const AppSpawnedProcess *appInfo, const void *key)
+{
+    return appInfo->pid == *(const pid_t *)key;
+}
+
+static bool AppInfoNameMatch(const AppSpawnedProcess *appInfo, const void *key)
+{
+    return strcmp(appInfo->name, (const char *)key) == 0;
+}
+
+static void SpawnedIndexInsert(SpawnedProcessIndex *index, SpawnedIndexHash hashProc, AppSpawnedProcess *appInfo)
+{
+    uint32_t mask = index->capacity - 1;
+    uint32_t i = hashProc(appInfo) & mask;
+    while (index->slots[i] != NULL) {
+        i = (i + 1) & mask;
+    }
+    index->slots[i] = appInfo;
+    index->count++;
+}
+
+static int SpawnedIndexGrow(SpawnedProcessIndex *index, SpawnedIndexHash hashProc)
+{
+    uint32_t capacity = index->capacity == 0 ? SPAWNED_INDEX_INIT_CAPACITY : index->capacity * 2;  // 2: double
+    AppSpawnedProcess **slots = (AppSpawnedProcess **)calloc(capacity, sizeof(AppSpawnedProcess *));
+    APPSPAWN_CHECK(slots != NULL, return APPSPAWN_SYSTEM_ERROR, "Failed to alloc index %{public}u", capacity);
+    AppSpawnedProcess **oldSlots = index->slots;
+    uint32_t oldCapacity = index->capacity;
+    index->slots = slots;
+    index->capacity = capacity;
+    index->count = 0;
+    for (uint32_t i = 0; i < oldCapacity; i++) {
+        APPSPAWN_ONLY_EXPER(oldSlots[i] != NULL, SpawnedIndexInsert(index, hashProc, oldSlots[i]));
+    }
+    free(oldSlots);
+    return 0;
+}
+
+static int SpawnedIndexAdd(SpawnedProcessIndex *index, SpawnedIndexHash hashProc, AppSpawnedProcess *appInfo)
+{
+    // keep load factor <= 1/2 so that linear probing stays short
+    if ((index->count + 1) * 2 > index->capacity) {  // 2: load factor 1/2
+        int ret = SpawnedIndexGrow(index, hashProc);
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, return ret);
+    }
+    SpawnedIndexInsert(index, hashProc, appInfo);
+    return 0;
+}
+
+static AppSpawnedProcess *SpawnedIndexFind(const SpawnedProcessIndex *index, uint32_t hash,
+    SpawnedIndexMatch matchProc, const void *key)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(index->count > 0, return NULL);
+    uint32_t mask = index->capacity - 1;
+    for (uint32_t i = hash & mask; index->slots[i] != NULL; i = (i + 1) & mask) {
+        if (matchProc(index->slots[i], key)) {
+            return index->slots[i];
+        }
+    }
+    return NULL;
+}
+
+static void SpawnedIndexRemove(SpawnedProcessIndex *index, SpawnedIndexHash hashProc, const AppSpawnedProcess *appInfo)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(index->count > 0, return);
+    uint32_t mask = index->capacity - 1;
+    uint32_t hole = hashProc(appInfo) & mask;
+    while (index->slots[hole] != appInfo) {
+        APPSPAWN_CHECK_ONLY_EXPER(index->slots[hole] != NULL, return);
+        hole = (hole + 1) & mask;
+    }
+    // backward shift deletion: move later entries of the probe run into the hole, no tombstones
+    for (uint32_t next = (hole + 1) & mask; index->slots[next] != NULL; next = (next + 1) & mask) {
+        uint32_t home = hashProc(index->slots[next]) & mask;
+        bool inRange = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!inRange) {
+            index->slots[hole] = index->slots[next];
+            hole = next;
+        }
+    }
+    index->slots[hole] = NULL;
+    index->count--;
+}
+
+static void AddSpawnedProcessWithOrder(ListNode *head, AppSpawnedProcess *appInfo)
+{
+    // keep appQueue ordered by pid, new pids are mostly the largest so search from the tail
+    ListNode *prev = head->prev;
+    while (prev != head && ListEntry(prev, AppSpawnedProcess, node)->pid > appInfo->pid) {
+        prev = prev->prev;
+    }
+    OH_ListAddTail(prev->next, &appInfo->node);
 }
 
 AppSpawnedProcess *AddSpawnedProcess(pid_t pid, const char *processName, uint32_t appIndex, bool isDebuggable,
@@ -174,18 +305,34 @@ AppSpawnedProcess *AddSpawnedProcess(pid_t pid, const char *processName, uint32_
     APPSPAWN_CHECK(ret == 0, free(node);
         return NULL, "Failed to strcpy process name");
 
+    ret = SpawnedIndexAdd(&g_appSpawnMgr->pidIndex, AppInfoPidHash, node);
+    APPSPAWN_CHECK(ret == 0, free(node);
+        return NULL, "Failed to index pid %{public}d", pid);
+    ret = SpawnedIndexAdd(&g_appSpawnMgr->nameIndex, AppInfoNameHash, node);
+    APPSPAWN_CHECK(ret == 0, SpawnedIndexRemove(&g_appSpawnMgr->pidIndex, AppInfoPidHash, node);
+        free(node);
+        return NULL, "Failed to index process name %{public}s", processName);
+
     OH_ListInit(&node->node);
     APPSPAWN_DUMPI("Add %{public}s,pid=%{public}d success", processName, pid);
-    OH_ListAddWithOrder(&g_appSpawnMgr->appQueue, &node->node, AppInfoCompareProc);
+    AddSpawnedProcessWithOrder(&g_appSpawnMgr->appQueue, node);
     return node;
 }
 
-void TerminateSpawnedProcess(AppSpawnedProcess *node)
+void RemoveSpawnedProcess(AppSpawnedProcess *node)
 {
     APPSPAWN_CHECK_ONLY_EXPER(g_appSpawnMgr != NULL && node != NULL, return);
-    // delete node
+    SpawnedIndexRemove(&g_appSpawnMgr->pidIndex, AppInfoPidHash, node);
+    SpawnedIndexRemove(&g_appSpawnMgr->nameIndex, AppInfoNameHash, node);
     OH_ListRemove(&node->node);
     OH_ListInit(&node->node);
+}
+
+void TerminateSpawnedProcess(AppSpawnedProcess *node)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(g_appSpawnMgr != NULL && node != NULL, return);
+    // delete node
+    RemoveSpawnedProcess(node);
     if (!IsNWebSpawnMode(g_appSpawnMgr)) {
         APPSPAWN_ONLY_EXPER(node->lockPath != NULL, free(node->lockPath);
             node->lockPath = NULL);
@@ -209,22 +356,17 @@ void TerminateSpawnedProcess(AppSpawnedProcess *node)
 AppSpawnedProcess *GetSpawnedProcess(pid_t pid)
 {
     APPSPAWN_CHECK_ONLY_EXPER(g_appSpawnMgr != NULL, return NULL);
-    ListNode *node = OH_ListFind(&g_appSpawnMgr->appQueue, &pid, AppInfoPidComparePro);
-    APPSPAWN_CHECK_ONLY_EXPER(node != NULL, return NULL);
-    return ListEntry(node, AppSpawnedProcess, node);
+    return SpawnedIndexFind(&g_appSpawnMgr->pidIndex, PidHash(pid), AppInfoPidMatch, &pid);
 }
 
 AppSpawnedProcess *GetSpawnedProcessByName(const char *name)
 {
     APPSPAWN_CHECK_ONLY_EXPER(g_appSpawnMgr != NULL, return NULL);
     APPSPAWN_CHECK_ONLY_EXPER(name != NULL, return NULL);
-
-    ListNode *node = OH_ListFind(&g_appSpawnMgr->appQueue, (void *)name, AppInfoNameComparePro);
-    APPSPAWN_CHECK_ONLY_EXPER(node != NULL, return NULL);
-    return ListEntry(node, AppSpawnedProcess, node);
+    return SpawnedIndexFind(&g_appSpawnMgr->nameIndex, NameHash(name), AppInfoNameMatch, name);
 }
 
-static void DumpProcessSpawnStack(pid_t pid)
+void DumpProcessSpawnStack(pid_t pid)
 {
 #if (!defined(CJAPP_SPAWN) && !defined(NATIVE_SPAWN))
     DumpSpawnStack(pid);
@@ -266,7 +408,44 @@ int KillAndWaitStatus(pid_t pid, int sig, int *exitStatus)
     return -1;
 }
 
-static int GetProcessTerminationStatus(pid_t pid)
+static bool TakeDiedProcessStatus(pid_t pid, int *exitStatus)
+{
+    ListNode *node = OH_ListFind(&g_appSpawnMgr->diedQueue, &pid, AppInfoPidComparePro);
+    APPSPAWN_CHECK_ONLY_EXPER(node != NULL, return false);
+    AppSpawnedProcess *info = ListEntry(node, AppSpawnedProcess, node);
+    *exitStatus = info->exitStatus;
+    OH_ListRemove(node);
+    OH_ListInit(node);
+    free(info);
+    if (g_appSpawnMgr->diedAppCount > 0) {
+        g_appSpawnMgr->diedAppCount--;
+    }
+    return true;
+}
+
+int ReapTerminatedProcess(pid_t pid, int *exitStatus)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(g_appSpawnMgr != NULL && exitStatus != NULL, return -1);
+    *exitStatus = -1;
+    // SIGCHLD handled first, the status has been moved to died queue
+    APPSPAWN_CHECK_ONLY_EXPER(!TakeDiedProcessStatus(pid, exitStatus), return 0);
+
+    pid_t exitPid = waitpid(pid, exitStatus, WNOHANG);
+    if (exitPid != pid) {
+        *exitStatus = -1;
+        return -1;
+    }
+    AppSpawnedProcess *app = GetSpawnedProcess(pid);
+    if (app != NULL) {
+        app->exitStatus = *exitStatus;
+        ProcessMgrHookExecute(STAGE_SERVER_APP_CLEANUP, GetAppSpawnContent(), app);
+        RemoveSpawnedProcess(app);
+        free(app);
+    }
+    return 0;
+}
+
+static int GetProcessTerminationStatus(pid_t pid, bool *pending)
 {
     APPSPAWN_CHECK_ONLY_EXPER(g_appSpawnMgr != NULL, return -1);
     APPSPAWN_LOGV("GetProcessTerminationStatus pid: %{public}d ", pid);
@@ -274,16 +453,7 @@ static int GetProcessTerminationStatus(pid_t pid)
         return 0;
     }
     int exitStatus = 0;
-    ListNode *node = OH_ListFind(&g_appSpawnMgr->diedQueue, &pid, AppInfoPidComparePro);
-    if (node != NULL) {
-        AppSpawnedProcess *info = ListEntry(node, AppSpawnedProcess, node);
-        exitStatus = info->exitStatus;
-        OH_ListRemove(node);
-        OH_ListInit(node);
-        free(info);
-        if (g_appSpawnMgr->diedAppCount > 0) {
-            g_appSpawnMgr->diedAppCount--;
-        }
+    if (TakeDiedProcessStatus(pid, &exitStatus)) {
         return exitStatus;
     }
     AppSpawnedProcess *app = GetSpawnedProcess(pid);
@@ -292,20 +462,40 @@ static int GetProcessTerminationStatus(pid_t pid)
         return -1;
     }
 
-    if (KillAndWaitStatus(pid, SIGKILL, &exitStatus) == 0) { // kill success, delete app
-        app->exitStatus = exitStatus;
-        ProcessMgrHookExecute(STAGE_SERVER_APP_CLEANUP, GetAppSpawnContent(), app);
-        OH_ListRemove(&app->node);
-        OH_ListInit(&app->node);
-        free(app);
+    if (kill(pid, SIGKILL) != 0) {
+        APPSPAWN_LOGE("unable to kill process, pid: %{public}d ret %{public}d", pid, errno);
+        return -1;
     }
-    return exitStatus;
+    // wait for the pid fd instead of polling waitpid, the reply is sent after the process is reaped
+    *pending = true;
+    return -1;
+}
+
+static AppSpawningCtx *AllocAppSpawningCtx(void)
+{
+    if (g_appSpawnMgr != NULL && g_appSpawnMgr->idleSpawningCtxCount > 0) {
+        ListNode *node = g_appSpawnMgr->idleSpawningCtx.next;
+        OH_ListRemove(node);
+        g_appSpawnMgr->idleSpawningCtxCount--;
+        return ListEntry(node, AppSpawningCtx, node);
+    }
+    return (AppSpawningCtx *)malloc(sizeof(AppSpawningCtx));
+}
+
+static void FreeAppSpawningCtx(AppSpawningCtx *property)
+{
+    if (g_appSpawnMgr != NULL && g_appSpawnMgr->idleSpawningCtxCount < SPAWNING_CTX_POOL_MAX) {
+        OH_ListAddTail(&g_appSpawnMgr->idleSpawningCtx, &property->node);
+        g_appSpawnMgr->idleSpawningCtxCount++;
+        return;
+    }
+    free(property);
 }
 
 AppSpawningCtx *CreateAppSpawningCtx(void)
 {
     static uint32_t requestId = 0;
-    AppSpawningCtx *property = (AppSpawningCtx *)malloc(sizeof(AppSpawningCtx));
+    AppSpawningCtx *property = AllocAppSpawningCtx();
     APPSPAWN_CHECK(property != NULL, return NULL, "Failed to create AppSpawningCtx ");
     property->client.id = ++requestId;
     property->client.flags = 0;
@@ -317,6 +507,7 @@ AppSpawningCtx *CreateAppSpawningCtx(void)
     property->forkCtx.fd[1] = -1;
     property->isPrefork = false;
     property->forkCtx.childMsg = NULL;
+    property->forkCtx.msgFd = -1;
     property->message = NULL;
     property->pid = 0;
     property->state = APP_STATE_IDLE;
@@ -324,6 +515,7 @@ AppSpawningCtx *CreateAppSpawningCtx(void)
     property->spmRefAdded = 0;
     property->lockBundleRefAdded = false;  // Initialize flag to false
     property->lockPath = NULL;
+    (void)memset_s(&property->childTiming, sizeof(property->childTiming), 0, sizeof(property->childTiming));
     OH_ListInit(&property->node);
     if (g_appSpawnMgr) {
         OH_ListAddTail(&g_appSpawnMgr->appSpawnQueue, &property->node);
@@ -366,8 +558,12 @@ void DeleteAppSpawningCtx(AppSpawningCtx *property)
         close(property->forkCtx.fd[1]);
         property->forkCtx.fd[1] = -1;
     }
+    if (property->forkCtx.msgFd >= 0) {
+        close(property->forkCtx.msgFd);
+        property->forkCtx.msgFd = -1;
+    }
 
-    free(property);
+    FreeAppSpawningCtx(property);
 }
 
 static int AppPropertyComparePid(ListNode *node, void *data)
@@ -420,6 +616,174 @@ static int DumpAppQueue(ListNode *node, void *data)
     return 0;
 }
 
+static void AddSpawnCost(SpawnCostStat *stat, uint32_t costUs)
+{
+    stat->count++;
+    stat->totalUs += costUs;
+    if (costUs > stat->maxUs) {
+        stat->maxUs = costUs;
+    }
+}
+
+static HookCostStat *GetHookCostStat(ChildTimingStat *timingStat, int32_t stage, int32_t prio)
+{
+    for (uint32_t i = 0; i < timingStat->hookCount; i++) {
+        if (timingStat->hooks[i].stage == stage && timingStat->hooks[i].prio == prio) {
+            return &timingStat->hooks[i];
+        }
+    }
+    APPSPAWN_CHECK_ONLY_EXPER(timingStat->hookCount < CHILD_TIMING_HOOK_MAX, return NULL);
+    HookCostStat *hookStat = &timingStat->hooks[timingStat->hookCount++];
+    hookStat->stage = stage;
+    hookStat->prio = prio;
+    return hookStat;
+}
+
+static void AddSandboxMountCount(SandboxMountCount *total, const SandboxMountCount *count)
+{
+    total->attempted += count->attempted;
+    total->succeeded += count->succeeded;
+    total->failed += count->failed;
+    total->skipped += count->skipped;
+}
+
+static void AddSandboxMountStat(ChildTimingStat *timingStat, const SandboxMountStat *stat)
+{
+    uint32_t opCount = 0;
+    for (uint32_t i = 0; i < SANDBOX_STAT_OP_MAX; i++) {
+        opCount += stat->opCount[i];
+    }
+    APPSPAWN_CHECK_ONLY_EXPER(opCount != 0, return);  // no sandbox built
+    timingStat->sandboxCount++;
+    for (uint32_t i = 0; i < SANDBOX_STAT_SECTION_MAX; i++) {
+        AddSandboxMountCount(&timingStat->sandbox.section[i], &stat->section[i]);
+    }
+    for (uint32_t i = 0; i < SANDBOX_STAT_CATEGORY_MAX; i++) {
+        AddSandboxMountCount(&timingStat->sandbox.category[i], &stat->category[i]);
+    }
+    for (uint32_t i = 0; i < SANDBOX_STAT_OP_MAX; i++) {
+        timingStat->sandbox.opCount[i] += stat->opCount[i];
+        timingStat->sandbox.opCostNs[i] += stat->opCostNs[i];
+    }
+}
+
+void AddChildTimingStat(AppSpawnMgr *mgr, const AppSpawnChildTiming *timing)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(mgr != NULL && timing != NULL, return);
+    ChildTimingStat *timingStat = &mgr->childTimingStat;
+    for (uint32_t i = 0; i < CHILD_TIMING_STAGE_COUNT; i++) {
+        // a stage without hooks registered or not reached reports 0, skip it
+        APPSPAWN_ONLY_EXPER(timing->stageCostUs[i] != 0, AddSpawnCost(&timingStat->stage[i], timing->stageCostUs[i]));
+    }
+    uint32_t hookCount = timing->hookCount < CHILD_TIMING_HOOK_MAX ? timing->hookCount : CHILD_TIMING_HOOK_MAX;
+    for (uint32_t i = 0; i < hookCount; i++) {
+        HookCostStat *hookStat = GetHookCostStat(timingStat, timing->hooks[i].stage, timing->hooks[i].prio);
+        APPSPAWN_ONLY_EXPER(hookStat != NULL, AddSpawnCost(&hookStat->cost, timing->hooks[i].costUs));
+    }
+    AddSandboxMountStat(timingStat, &timing->sandbox);
+}
+
+static void DumpSandboxMountCount(const char *dimension, uint32_t index, const SandboxMountCount *count)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(count->attempted != 0 || count->skipped != 0, return);
+    APPSPAWN_DUMP("    %{public}s %{public}u attempted %{public}u succeeded %{public}u failed %{public}u"
+        " skipped %{public}u", dimension, index, count->attempted, count->succeeded, count->failed, count->skipped);
+}
+
+static void DumpSandboxMountStat(const ChildTimingStat *timingStat)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(timingStat->sandboxCount != 0, return);
+    const SandboxMountStat *stat = &timingStat->sandbox;
+    APPSPAWN_DUMP("Sandbox mount stat of %{public}u spawns: ", timingStat->sandboxCount);
+    for (uint32_t i = 0; i < SANDBOX_STAT_SECTION_MAX; i++) {
+        DumpSandboxMountCount("section", i, &stat->section[i]);
+    }
+    for (uint32_t i = 0; i < SANDBOX_STAT_CATEGORY_MAX; i++) {
+        DumpSandboxMountCount("category", i, &stat->category[i]);
+    }
+    const char *opNames[SANDBOX_STAT_OP_MAX] = {"mount", "umount2", "symlink", "mkdir"};
+    for (uint32_t i = 0; i < SANDBOX_STAT_OP_MAX; i++) {
+        APPSPAWN_ONLY_EXPER(stat->opCount[i] == 0, continue);
+        APPSPAWN_DUMP("    %{public}s count %{public}u total %{public}" PRIu64 " ns avg %{public}" PRIu64 " ns",
+            opNames[i], stat->opCount[i], stat->opCostNs[i], stat->opCostNs[i] / stat->opCount[i]);
+    }
+}
+
+static void DumpChildTimingStat(const ChildTimingStat *timingStat)
+{
+    APPSPAWN_DUMP("Child spawn stage cost: ");
+    for (uint32_t i = 0; i < CHILD_TIMING_STAGE_COUNT; i++) {
+        const SpawnCostStat *stat = &timingStat->stage[i];
+        APPSPAWN_ONLY_EXPER(stat->count == 0, continue);
+        APPSPAWN_DUMP("    stage %{public}u count %{public}u avg %{public}" PRIu64 " us max %{public}u us",
+            CHILD_TIMING_STAGE_BEGIN + i, stat->count, stat->totalUs / stat->count, stat->maxUs);
+    }
+    for (uint32_t i = 0; i < timingStat->hookCount; i++) {
+        const HookCostStat *hookStat = &timingStat->hooks[i];
+        APPSPAWN_ONLY_EXPER(hookStat->cost.count == 0, continue);
+        APPSPAWN_DUMP("    hook stage %{public}d prio %{public}d count %{public}u avg %{public}" PRIu64
+            " us max %{public}u us", hookStat->stage, hookStat->prio, hookStat->cost.count,
+            hookStat->cost.totalUs / hookStat->cost.count, hookStat->cost.maxUs);
+    }
+    DumpSandboxMountStat(timingStat);
+}
+
+static void AddSpawnLatencyHist(SpawnLatencyHist *hist, uint32_t costUs)
+{
+    // relaxed atomics only, the histogram may be read by dump or report while being updated
+    __atomic_fetch_add(&hist->buckets[GetSpawnLatencyBucket(costUs)], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&hist->totalUs, costUs, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&hist->count, 1, __ATOMIC_RELAXED);
+    uint32_t maxUs = __atomic_load_n(&hist->maxUs, __ATOMIC_RELAXED);
+    while (costUs > maxUs &&
+        !__atomic_compare_exchange_n(&hist->maxUs, &maxUs, costUs, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void AddSpawnLatency(AppSpawnMgr *mgr, SpawnLatencyMode mode, bool bootFinished, int msgType, uint64_t costUs)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(mgr != NULL && mode < SPAWN_LATENCY_MODE_MAX, return);
+    uint32_t cost = costUs > UINT32_MAX ? UINT32_MAX : (uint32_t)costUs;
+    SpawnLatencyStat *stat = &mgr->latencyStat;
+    AddSpawnLatencyHist(&stat->mode[mode], cost);
+    AddSpawnLatencyHist(&stat->phase[bootFinished ? 1 : 0], cost);
+    APPSPAWN_ONLY_EXPER(msgType >= 0 && msgType < MAX_TYPE_INVALID, AddSpawnLatencyHist(&stat->msgType[msgType], cost));
+}
+
+static void DumpSpawnLatencyHist(const char *dimension, const char *name, const SpawnLatencyHist *hist)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(hist->count != 0, return);
+    APPSPAWN_DUMP("    %{public}s %{public}s count %{public}u avg %{public}" PRIu64 " p50 %{public}u p90 %{public}u"
+        " p99 %{public}u max %{public}u us", dimension, name, hist->count, hist->totalUs / hist->count,
+        GetSpawnLatencyPercentile(hist, 500), GetSpawnLatencyPercentile(hist, 900),  // 500: p50, 900: p90
+        GetSpawnLatencyPercentile(hist, 990), hist->maxUs);  // 990: p99
+}
+
+static void DumpSpawnLatencyStat(const SpawnLatencyStat *stat)
+{
+    static const char *modeNames[SPAWN_LATENCY_MODE_MAX] = {"fork", "prefork", "coldrun"};
+    APPSPAWN_DUMP("Spawn latency: ");
+    for (uint32_t i = 0; i < SPAWN_LATENCY_MODE_MAX; i++) {
+        DumpSpawnLatencyHist("mode", modeNames[i], &stat->mode[i]);
+    }
+    DumpSpawnLatencyHist("phase", "boot", &stat->phase[0]);
+    DumpSpawnLatencyHist("phase", "bootfinished", &stat->phase[1]);
+    for (uint32_t i = 0; i < MAX_TYPE_INVALID; i++) {
+        char name[16] = {0};  // 16 enough for msg type
+        APPSPAWN_ONLY_EXPER(snprintf_s(name, sizeof(name), sizeof(name) - 1, "%u", i) <= 0, continue);
+        DumpSpawnLatencyHist("msgtype", name, &stat->msgType[i]);
+    }
+}
+
+static void DumpParamCacheStat(const AppSpawnParamCacheStat *stat)
+{
+    APPSPAWN_DUMP("Param cache: spawn %{public}" PRIu64 " hit %{public}" PRIu64 " lookup %{public}" PRIu64,
+        stat->spawnCount, stat->cacheHits, stat->lookups);
+    APPSPAWN_CHECK_ONLY_EXPER(stat->spawnCount != 0, return);
+    APPSPAWN_DUMP("    lookups avoided per 100 spawns %{public}" PRIu64,
+        stat->cacheHits * 100 / stat->spawnCount);  // 100: per 100 spawns
+}
+
 static int DumpExtData(ListNode *node, void *data)
 {
     AppSpawnExtData *extData = ListEntry(node, AppSpawnExtData, node);
@@ -456,6 +820,14 @@ void ProcessAppSpawnDumpMsg(const AppSpawnMsgNode *message)
     OH_ListTraversal((ListNode *)&g_appSpawnMgr->diedQueue, "App died queue", DumpAppQueue, 0);
     APPSPAWN_DUMP("Ext data: ");
     OH_ListTraversal((ListNode *)&g_appSpawnMgr->extData, "Ext data", DumpExtData, 0);
+    const PreforkPool *pool = &g_appSpawnMgr->preforkPool;
+    APPSPAWN_DUMP("Prefork pool: size %{public}u low %{public}u high %{public}u target %{public}u",
+        pool->size, pool->lowWatermark, pool->highWatermark, pool->target);
+    APPSPAWN_DUMP("    reserved pid %{public}d standby %{public}u", g_appSpawnMgr->content.reservedPid,
+        pool->standbyCount);
+    DumpChildTimingStat(&g_appSpawnMgr->childTimingStat);
+    DumpSpawnLatencyStat(&g_appSpawnMgr->latencyStat);
+    DumpParamCacheStat(GetParamCacheStat());
     APPSPAWN_DUMP("Dump appspawn info finish ");
     if (stream != NULL) {
         (void)fflush(stream);
@@ -483,6 +855,7 @@ int ProcessTerminationStatusMsg(const AppSpawnMsgNode *message, AppSpawnResult *
     }
     // get render process termination status, only nwebspawn need this logic.
     result->pid = *pid;
-    result->result = GetProcessTerminationStatus(*pid);
-    return 0;
+    bool pending = false;
+    result->result = GetProcessTerminationStatus(*pid, &pending);
+    return pending ? TERMINATION_STATUS_PENDING : 0;
 }
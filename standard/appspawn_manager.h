@@ -46,6 +46,7 @@ extern "C" {
 #define PARAM_VALUE_INDEX 8
 #define CLIENT_ID_INDEX 9
 #define ARG_NULL 10
+#define MSG_FD_INDEX 10  // optional, sealed memfd carrying the message
 
 #define MAX_DIED_PROCESS_COUNT 5
 
@@ -53,7 +54,9 @@ extern "C" {
 
 #define APP_STATE_IDLE 1
 #define APP_STATE_SPAWNING 2
+#define APP_STATE_TERMINATING 3
 #define APPSPAWN_MAX_TIME 3000000
+#define PREFORK_POOL_MAX_SIZE 8
 #define UUID_MAX_LEN 37
 #define PATH_MAX_LEN 256
 
@@ -63,14 +66,64 @@ typedef struct AppSpawnContent AppSpawnContent;
 typedef struct AppSpawnClient AppSpawnClient;
 typedef struct TagAppSpawnConnection AppSpawnConnection;
 
+#define APPSPAWN_FNV_OFFSET 2166136261U
+#define APPSPAWN_FNV_PRIME 16777619U
+
+#define MSG_ARENA_BLOCK_SIZE (16 * 1024)  // 回收池中消息内存块的大小，超过的消息单独申请
+#define MSG_ARENA_POOL_MAX 4
+#define SPAWNING_CTX_POOL_MAX 4
+
+/**
+ * @brief 常用扩展TLV的预置id，DecodeAppSpawnMsg 时解析，按id直接取偏移
+ */
+typedef enum {
+    EXT_TLV_ID_RENDER_CMD,          // MSG_EXT_NAME_RENDER_CMD
+    EXT_TLV_ID_HSP_LIST,            // MSG_EXT_NAME_HSP_LIST
+    EXT_TLV_ID_OVERLAY,             // MSG_EXT_NAME_OVERLAY
+    EXT_TLV_ID_DATA_GROUP,          // MSG_EXT_NAME_DATA_GROUP
+    EXT_TLV_ID_APP_ENV,             // MSG_EXT_NAME_APP_ENV
+    EXT_TLV_ID_APP_EXTENSION,       // MSG_EXT_NAME_APP_EXTENSION
+    EXT_TLV_ID_ACCOUNT_ID,          // MSG_EXT_NAME_ACCOUNT_ID
+    EXT_TLV_ID_PROVISION_TYPE,      // MSG_EXT_NAME_PROVISION_TYPE
+    EXT_TLV_ID_PROCESS_TYPE,        // MSG_EXT_NAME_PROCESS_TYPE
+    EXT_TLV_ID_MAX_CHILD_PROCESS,   // MSG_EXT_NAME_MAX_CHILD_PROCCESS_MAX
+    EXT_TLV_ID_JIT_PERMISSIONS,     // MSG_EXT_NAME_JIT_PERMISSIONS
+    EXT_TLV_ID_USERID,              // MSG_EXT_NAME_USERID
+    EXT_TLV_ID_EXTENSION_TYPE,      // MSG_EXT_NAME_EXTENSION_TYPE
+    EXT_TLV_ID_API_TARGET_VERSION,  // MSG_EXT_NAME_API_TARGET_VERSION
+    EXT_TLV_ID_PARENT_UID,          // MSG_EXT_NAME_PARENT_UID
+    EXT_TLV_ID_XPM_ID_TYPE,         // MSG_EXT_NAME_XPM_ID_TYPE
+    EXT_TLV_ID_MAX
+} AppSpawnExtTlvId;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t offset;
+} AppSpawnExtTlvSlot;
+
 typedef struct TagAppSpawnMsgNode {
     AppSpawnConnection *connection;
     AppSpawnMsg msgHeader;
     uint32_t tlvCount;
     uint32_t *tlvOffset;  // 记录属性的在msg中的偏移，不完全拷贝试消息完整
     uint8_t *buffer;
+    // 扩展TLV名称索引，与 tlvOffset 同一块内存，随 tlvOffset 释放；为 NULL 时按顺序查找
+    uint32_t extSlotCount;
+    AppSpawnExtTlvSlot *extSlots;
+    uint32_t *knownExtOffset;  // 按 AppSpawnExtTlvId 记录的偏移
+    // 非0时 node、buffer、tlvOffset 及扩展TLV索引在同一块内存中，整块释放或回收
+    uint32_t arenaSize;
 } AppSpawnMsgNode;
 
+APPSPAWN_INLINE uint32_t GetAppSpawnNameHash(const char *name, uint32_t maxLen)
+{
+    uint32_t hash = APPSPAWN_FNV_OFFSET;
+    for (uint32_t i = 0; i < maxLen && name[i] != '\0'; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * APPSPAWN_FNV_PRIME;
+    }
+    return hash;
+}
+
 typedef struct {
     int32_t fd[2];  // 2 fd count
     WatcherHandle watcherHandle;
@@ -78,9 +131,80 @@ typedef struct {
     TimerHandle timer;
     char *childMsg;
     uint32_t msgSize;
+    int32_t msgFd;  // sealed memfd carrying the message, -1 when the file mapping is used
     char *coldRunPath;
 } AppSpawnForkCtx;
 
+#define CHILD_TIMING_HOOK_MAX 32
+#define CHILD_TIMING_STAGE_BEGIN STAGE_CHILD_PRE_COLDBOOT
+#define CHILD_TIMING_STAGE_COUNT (STAGE_CHILD_PRE_RELY - STAGE_CHILD_PRE_COLDBOOT + 1)
+
+typedef struct TagAppSpawnHookCost {
+    int32_t stage;
+    int32_t prio;
+    uint32_t costUs;
+    int32_t result;
+} AppSpawnHookCost;
+
+// 沙盒挂载统计按 section 类型区分，不属于配置 section 的挂载（expand、shared 等）只计入操作耗时
+typedef enum {
+    SANDBOX_STAT_SECTION_SYSTEM_CONST,
+    SANDBOX_STAT_SECTION_APP_VARIABLE,
+    SANDBOX_STAT_SECTION_APP_CONST,
+    SANDBOX_STAT_SECTION_PACKAGE_NAME,
+    SANDBOX_STAT_SECTION_SPAWN_FLAGS,
+    SANDBOX_STAT_SECTION_PERMISSION,
+    SANDBOX_STAT_SECTION_NAME_GROUP,
+    SANDBOX_STAT_SECTION_OTHER,
+    SANDBOX_STAT_SECTION_MAX
+} SandboxStatSection;
+
+#define SANDBOX_STAT_CATEGORY_MAX 8  // 不小于 MOUNT_TMP_MAX，appspawn_sandbox.c 中静态检查
+
+typedef enum {
+    SANDBOX_STAT_OP_MOUNT,
+    SANDBOX_STAT_OP_UMOUNT,
+    SANDBOX_STAT_OP_SYMLINK,
+    SANDBOX_STAT_OP_MKDIR,
+    SANDBOX_STAT_OP_MAX
+} SandboxStatOp;
+
+typedef struct TagSandboxMountCount {
+    uint32_t attempted;
+    uint32_t succeeded;
+    uint32_t failed;
+    uint32_t skipped;  // 条件不满足未挂载，或符号链接已存在
+} SandboxMountCount;
+
+/**
+ * @brief 沙盒挂载统计，子进程单次孵化与父进程汇总使用同一结构
+ * @param section 按 section 类型统计的挂载/符号链接结果
+ * @param category 按挂载类别（MOUNT_TMP_*）统计的挂载结果
+ * @param opCount mount/umount2/symlink/mkdir 调用次数，一次绑定挂载（含传播属性设置）计为一次
+ * @param opCostNs 上述调用累计耗时（CLOCK_MONOTONIC，ns）
+ */
+typedef struct TagSandboxMountStat {
+    SandboxMountCount section[SANDBOX_STAT_SECTION_MAX];
+    SandboxMountCount category[SANDBOX_STAT_CATEGORY_MAX];
+    uint32_t opCount[SANDBOX_STAT_OP_MAX];
+    uint64_t opCostNs[SANDBOX_STAT_OP_MAX];
+} SandboxMountStat;
+
+/**
+ * @brief 子进程各阶段耗时记录，随孵化结果一次性写入 forkCtx.fd[1] 回传父进程
+ * @param result 孵化结果，必须为首成员，父进程读到仅含 int 的旧格式时只取结果
+ * @param stageCostUs STAGE_CHILD_PRE_COLDBOOT ~ STAGE_CHILD_PRE_RELY 各阶段总耗时（CLOCK_MONOTONIC，us）
+ * @param hooks 上述阶段中每个 hook（按 stage + prio 区分）的耗时，超过 CHILD_TIMING_HOOK_MAX 的不记录
+ * @param sandbox 沙盒挂载统计，未构建沙盒时全为 0
+ */
+typedef struct TagAppSpawnChildTiming {
+    int32_t result;
+    uint32_t hookCount;
+    uint32_t stageCostUs[CHILD_TIMING_STAGE_COUNT];
+    AppSpawnHookCost hooks[CHILD_TIMING_HOOK_MAX];
+    SandboxMountStat sandbox;
+} AppSpawnChildTiming;
+
 typedef struct TagAppSpawningCtx {
     AppSpawnClient client;
     struct ListNode node;
@@ -97,6 +221,7 @@ typedef struct TagAppSpawningCtx {
                                   //   bit1 (0x02): uid refcount
     bool lockBundleRefAdded;  // Flag: whether AddLockBundleRef has been called for _preunlock directory
     char *lockPath;           // Sandbox root path for _preunlock directory (set by MountDirToShared)
+    AppSpawnChildTiming childTiming;  // filled by child hooks, sent with the spawn result
 } AppSpawningCtx;
 
 typedef struct TagAppSpawnedProcess {
@@ -141,11 +266,84 @@ typedef struct TagAppSpawnedCheckPointProcesses {
     char name[0];
 } AppSpawnedCheckPointProcesses;
 
+/**
+ * @brief appQueue 的开放寻址（线性探测）索引，槽位保存 AppSpawnedProcess 指针，允许键重复；
+ *        appQueue 仍按 pid 有序，用于遍历
+ * @param slots 槽位数组，容量为 2 的幂
+ * @param capacity 槽位数
+ * @param count 已用槽位数，负载超过 1/2 时扩容
+ */
+typedef struct TagSpawnedProcessIndex {
+    AppSpawnedProcess **slots;
+    uint32_t capacity;
+    uint32_t count;
+} SpawnedProcessIndex;
+
 typedef struct SpawnTime {
     int minAppspawnTime;
     int maxAppspawnTime;
 } SpawnTime;
 
+typedef struct TagSpawnCostStat {
+    uint32_t count;
+    uint32_t maxUs;
+    uint64_t totalUs;
+} SpawnCostStat;
+
+typedef struct TagHookCostStat {
+    int32_t stage;
+    int32_t prio;
+    SpawnCostStat cost;
+} HookCostStat;
+
+/**
+ * @brief 父进程汇总的子进程阶段耗时，通过 dump 消息查看，并随统计事件定时上报后清零
+ */
+typedef struct TagChildTimingStat {
+    SpawnCostStat stage[CHILD_TIMING_STAGE_COUNT];
+    uint32_t hookCount;
+    HookCostStat hooks[CHILD_TIMING_HOOK_MAX];
+    uint32_t sandboxCount;  // 上报了沙盒挂载统计的孵化次数
+    SandboxMountStat sandbox;
+} ChildTimingStat;
+
+#define SPAWN_HIST_SUB_BITS 2
+#define SPAWN_HIST_SUB_COUNT (1 << SPAWN_HIST_SUB_BITS)
+#define SPAWN_HIST_GROUP_COUNT 28  // covers 0 ~ 2^29 us, larger values fall into the last bucket
+#define SPAWN_HIST_BUCKET_COUNT (SPAWN_HIST_GROUP_COUNT * SPAWN_HIST_SUB_COUNT)
+#define SPAWN_HIST_PERMILLE 1000
+
+typedef enum {
+    SPAWN_LATENCY_FORK,
+    SPAWN_LATENCY_PREFORK,
+    SPAWN_LATENCY_COLD_RUN,
+    SPAWN_LATENCY_MODE_MAX
+} SpawnLatencyMode;
+
+/**
+ * @brief 孵化时延直方图，按 2 的幂分组、每组 SPAWN_HIST_SUB_COUNT 个子桶（HDR 风格），相对误差不超过 25%
+ * @param count 样本数
+ * @param maxUs 最大时延（us）
+ * @param totalUs 总时延（us）
+ * @param buckets 各桶样本数，下标由 GetSpawnLatencyBucket 计算
+ */
+typedef struct TagSpawnLatencyHist {
+    uint32_t count;
+    uint32_t maxUs;
+    uint64_t totalUs;
+    uint32_t buckets[SPAWN_HIST_BUCKET_COUNT];
+} SpawnLatencyHist;
+
+/**
+ * @brief 父进程统计的孵化时延（收到请求到收到子进程结果），分别按孵化方式、开机阶段、消息类型归类，
+ *        通过 dump 消息查看，并随统计事件定时上报后清零
+ */
+typedef struct TagSpawnLatencyStat {
+    SpawnLatencyHist mode[SPAWN_LATENCY_MODE_MAX];
+    SpawnLatencyHist phase[2];  // 0: booting, 1: boot finished
+    SpawnLatencyHist msgType[MAX_TYPE_INVALID];
+} SpawnLatencyStat;
+
 typedef struct TagPathBuffer {
     uint32_t pathLen;
     char path[PATH_MAX_LEN];
@@ -159,6 +357,33 @@ typedef struct TagDataGroupCtx {
     PathBuffer destPath;
 } DataGroupCtx;
 
+/**
+ * @brief prefork pool: content->reservedPid is the slot handed out next, standby
+ *        holds additional ready prefork children that are promoted into it.
+ * @param standby Standby prefork child pids
+ * @param standbyCount Number of valid entries in standby
+ * @param size Configured pool size N, including reservedPid
+ * @param lowWatermark Background refill starts when ready count drops below it
+ * @param highWatermark Background refill stops when ready count reaches it
+ * @param target Current refill target, shrinks towards lowWatermark while idle
+ * @param takenCount Slots handed out since the last idle check
+ * @param idlePeriods Consecutive idle checks without any slot handed out
+ * @param refillTimer One-shot timer used to refill from the event loop
+ * @param idleTimer Periodic timer used to shrink an idle pool
+ */
+typedef struct TagPreforkPool {
+    pid_t standby[PREFORK_POOL_MAX_SIZE];
+    uint32_t standbyCount;
+    uint32_t size;
+    uint32_t lowWatermark;
+    uint32_t highWatermark;
+    uint32_t target;
+    uint32_t takenCount;
+    uint32_t idlePeriods;
+    TimerHandle refillTimer;
+    TimerHandle idleTimer;
+} PreforkPool;
+
 typedef struct TagAppSpawnMgr {
     AppSpawnContent content;
     struct timespec perLoadStart;
@@ -170,12 +395,21 @@ typedef struct TagAppSpawnMgr {
     TaskHandle server;
     SignalHandle sigHandler;
     struct ListNode appQueue;           // save spawned app pid and name
+    SpawnedProcessIndex pidIndex;       // appQueue indexed by pid
+    SpawnedProcessIndex nameIndex;      // appQueue indexed by process name
     struct ListNode diedQueue;          // save died app pid and name
     struct ListNode appSpawnQueue;      // save spawning app pid and name
     struct ListNode extData;
     struct ListNode dataGroupCtxQueue;
     struct ListNode checkPointIdQueue;  // Image boot process queue
     struct ListNode spawningFdsQueue;
+    struct ListNode idleMsgArena;       // recycled message arena, see MSG_ARENA_BLOCK_SIZE
+    uint32_t idleMsgArenaCount;
+    struct ListNode idleSpawningCtx;    // recycled AppSpawningCtx
+    uint32_t idleSpawningCtxCount;
+    PreforkPool preforkPool;
+    ChildTimingStat childTimingStat;
+    SpawnLatencyStat latencyStat;
 #ifdef APPSPAWN_HISYSEVENT
     AppSpawnHisyseventInfo *hisyseventInfo;
 #endif
@@ -200,6 +434,7 @@ AppSpawnedProcess *AddSpawnedProcess(pid_t pid, const char *processName, uint32_
     bool isDebuggable, uint64_t tokenid);
 AppSpawnedProcess *GetSpawnedProcess(pid_t pid);
 AppSpawnedProcess *GetSpawnedProcessByName(const char *name);
+void RemoveSpawnedProcess(AppSpawnedProcess *node);
 void TerminateSpawnedProcess(AppSpawnedProcess *node);
 
 /**
@@ -212,13 +447,24 @@ AppSpawningCtx *GetAppSpawningCtxByPid(pid_t pid);
 AppSpawningCtx *CreateAppSpawningCtx();
 void DeleteAppSpawningCtx(AppSpawningCtx *property);
 int KillAndWaitStatus(pid_t pid, int sig, int *exitStatus);
+void DumpProcessSpawnStack(pid_t pid);
 
 /**
  * @brief 消息解析、处理
  *
  */
 void ProcessAppSpawnDumpMsg(const AppSpawnMsgNode *message);
+void AddChildTimingStat(AppSpawnMgr *mgr, const AppSpawnChildTiming *timing);
+void AddSpawnLatency(AppSpawnMgr *mgr, SpawnLatencyMode mode, bool bootFinished, int msgType, uint64_t costUs);
+/**
+ * @brief 获取render进程退出状态
+ *
+ * 进程仍存活时发送 SIGKILL 并返回 TERMINATION_STATUS_PENDING，由调用者监听 pidfd，
+ * 进程可回收后调用 ReapTerminatedProcess 获取退出状态，不在事件循环中轮询等待。
+ */
+#define TERMINATION_STATUS_PENDING 1
 int ProcessTerminationStatusMsg(const AppSpawnMsgNode *message, AppSpawnResult *result);
+int ReapTerminatedProcess(pid_t pid, int *exitStatus);
 
 AppSpawnMsgNode *CreateAppSpawnMsg(void);
 void DeleteAppSpawnMsg(AppSpawnMsgNode **msgNode);
@@ -227,6 +473,17 @@ int DecodeAppSpawnMsg(AppSpawnMsgNode *message);
 int GetAppSpawnMsgFromBuffer(const uint8_t *buffer, uint32_t bufferLen,
     AppSpawnMsgNode **outMsg, uint32_t *msgRecvLen, uint32_t *reminder);
 AppSpawnMsgNode *RebuildAppSpawnMsgNode(AppSpawnMsgNode *message, AppSpawnedProcess *appInfo);
+void ClearAppSpawnMsgArenaPool(AppSpawnMgr *mgr);
+
+/**
+ * @brief 通过密封的memfd向子进程传递消息
+ *
+ * CreateAppSpawnMsgMemfd 将消息头与消息体写入memfd并加上 SHRINK/GROW/WRITE/SEAL 密封，
+ * inheritable 为 true 时不设置 MFD_CLOEXEC，用于冷启动 execv 后继承。
+ * MapAppSpawnMsgMemfd 校验密封与长度后只读映射，mapSize 返回映射长度。
+ */
+int CreateAppSpawnMsgMemfd(const AppSpawnMsgNode *message, const char *name, bool inheritable);
+uint8_t *MapAppSpawnMsgMemfd(int fd, uint32_t *mapSize);
 
 /**
  * @brief 消息内容操作接口
@@ -235,6 +492,7 @@ AppSpawnMsgNode *RebuildAppSpawnMsgNode(AppSpawnMsgNode *message, AppSpawnedProc
 void DumpAppSpawnMsg(const AppSpawnMsgNode *message);
 void *GetAppSpawnMsgInfo(const AppSpawnMsgNode *message, int type);
 void *GetAppSpawnMsgExtInfo(const AppSpawnMsgNode *message, const char *name, uint32_t *len);
+void *GetAppSpawnMsgKnownExtInfo(const AppSpawnMsgNode *message, AppSpawnExtTlvId id, uint32_t *len);
 int CheckAppSpawnMsgFlag(const AppSpawnMsgNode *message, uint32_t type, uint32_t index);
 int SetAppSpawnMsgFlag(const AppSpawnMsgNode *message, uint32_t type, uint32_t index);
 int CheckAppSpawnMsgFlagsSet(const AppSpawnMsgFlags *msgFlags, uint32_t flagIndex);
@@ -335,6 +593,13 @@ APPSPAWN_INLINE void *GetAppPropertyExt(const AppSpawningCtx *property, const ch
     return GetAppSpawnMsgExtInfo(property->message, name, len);
 }
 
+APPSPAWN_INLINE void *GetAppPropertyKnownExt(const AppSpawningCtx *property, AppSpawnExtTlvId id, uint32_t *len)
+{
+    APPSPAWN_CHECK(property != NULL && property->message != NULL,
+        return NULL, "Invalid property for ext id %{public}d", id);
+    return GetAppSpawnMsgKnownExtInfo(property->message, id, len);
+}
+
 APPSPAWN_INLINE int CheckAppMsgFlagsSet(const AppSpawningCtx *property, uint32_t index)
 {
     APPSPAWN_CHECK(property != NULL && property->message != NULL,
@@ -362,6 +627,49 @@ APPSPAWN_INLINE int IsIsolatedNativeSpawnMode(const AppSpawnMgr *content, const
         CheckAppMsgFlagsSet(property, APP_FLAGS_ISOLATED_SANDBOX_TYPE);
 }
 
+APPSPAWN_INLINE uint32_t GetSpawnLatencyBucket(uint32_t costUs)
+{
+    if (costUs < SPAWN_HIST_SUB_COUNT) {
+        return costUs;
+    }
+    uint32_t msb = 31 - (uint32_t)__builtin_clz(costUs);  // 31: highest bit of uint32_t
+    uint32_t group = msb - SPAWN_HIST_SUB_BITS + 1;
+    uint32_t sub = (costUs >> (msb - SPAWN_HIST_SUB_BITS)) & (SPAWN_HIST_SUB_COUNT - 1);
+    uint32_t index = group * SPAWN_HIST_SUB_COUNT + sub;
+    return index < SPAWN_HIST_BUCKET_COUNT ? index : SPAWN_HIST_BUCKET_COUNT - 1;
+}
+
+APPSPAWN_INLINE uint32_t GetSpawnLatencyBucketMax(uint32_t index)
+{
+    if (index < SPAWN_HIST_SUB_COUNT) {
+        return index;
+    }
+    uint32_t shift = index / SPAWN_HIST_SUB_COUNT - 1;
+    uint32_t sub = index % SPAWN_HIST_SUB_COUNT;
+    return ((SPAWN_HIST_SUB_COUNT + sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief 计算直方图分位值，返回所在桶的上界（不超过 maxUs）
+ * @param permille 千分位，如 500 表示 p50，990 表示 p99
+ */
+APPSPAWN_INLINE uint32_t GetSpawnLatencyPercentile(const SpawnLatencyHist *hist, uint32_t permille)
+{
+    uint32_t count = __atomic_load_n(&hist->count, __ATOMIC_RELAXED);
+    uint32_t maxUs = __atomic_load_n(&hist->maxUs, __ATOMIC_RELAXED);
+    APPSPAWN_CHECK_ONLY_EXPER(count != 0 && permille != 0, return 0);
+    uint64_t rank = ((uint64_t)count * permille + SPAWN_HIST_PERMILLE - 1) / SPAWN_HIST_PERMILLE;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < SPAWN_HIST_BUCKET_COUNT; i++) {
+        seen += __atomic_load_n(&hist->buckets[i], __ATOMIC_RELAXED);
+        if (seen >= rank) {
+            uint32_t value = GetSpawnLatencyBucketMax(i);
+            return value < maxUs ? value : maxUs;
+        }
+    }
+    return maxUs;
+}
+
 #ifdef __cplusplus
 }
 #endif
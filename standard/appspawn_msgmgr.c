@@ -13,10 +13,15 @@
  * limitations under the License.
  */
 
+#undef _GNU_SOURCE
+#define _GNU_SOURCE
 #include <fcntl.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 
 #include "appspawn.h"
 #include "appspawn_manager.h"
@@ -33,13 +38,66 @@ void *GetAppSpawnMsgInfo(const AppSpawnMsgNode *message, int type)
     return (void *)(message->buffer + message->tlvOffset[type] + sizeof(AppSpawnTlv));
 }
 
-void *GetAppSpawnMsgExtInfo(const AppSpawnMsgNode *message, const char *name, uint32_t *len)
+#define EXT_TLV_SLOT_MIN_COUNT 8
+#define MSG_ARENA_ALIGN(len) (((len) + 7) & (~7))  // 8 bytes align
+
+static uint32_t GetExtTlvSlotCount(uint32_t tlvCount)
 {
-    APPSPAWN_CHECK(name != NULL, return NULL, "Invalid name ");
-    APPSPAWN_CHECK_ONLY_EXPER(message != NULL && message->buffer != NULL, return NULL);
-    APPSPAWN_CHECK_ONLY_EXPER(message->tlvOffset != NULL, return NULL);
+    uint32_t slotCount = EXT_TLV_SLOT_MIN_COUNT;
+    while (slotCount < tlvCount * 2) {  // 2 keep load factor <= 1/2
+        slotCount <<= 1;
+    }
+    return slotCount;
+}
 
-    APPSPAWN_LOGV("GetAppSpawnMsgExtInfo tlvCount %{public}d name %{public}s", message->tlvCount, name);
+static const char *g_knownExtNames[EXT_TLV_ID_MAX] = {
+    MSG_EXT_NAME_RENDER_CMD,
+    MSG_EXT_NAME_HSP_LIST,
+    MSG_EXT_NAME_OVERLAY,
+    MSG_EXT_NAME_DATA_GROUP,
+    MSG_EXT_NAME_APP_ENV,
+    MSG_EXT_NAME_APP_EXTENSION,
+    MSG_EXT_NAME_ACCOUNT_ID,
+    MSG_EXT_NAME_PROVISION_TYPE,
+    MSG_EXT_NAME_PROCESS_TYPE,
+    MSG_EXT_NAME_MAX_CHILD_PROCCESS_MAX,
+    MSG_EXT_NAME_JIT_PERMISSIONS,
+    MSG_EXT_NAME_USERID,
+    MSG_EXT_NAME_EXTENSION_TYPE,
+    MSG_EXT_NAME_API_TARGET_VERSION,
+    MSG_EXT_NAME_PARENT_UID,
+    MSG_EXT_NAME_XPM_ID_TYPE,
+};
+
+static inline void *GetExtTlvData(const AppSpawnMsgNode *message, uint32_t offset, uint32_t *len)
+{
+    AppSpawnTlvExt *tlv = (AppSpawnTlvExt *)(message->buffer + offset);
+    if (len != NULL) {
+        *len = tlv->dataLen;
+    }
+    return (uint8_t *)tlv + sizeof(AppSpawnTlvExt);
+}
+
+static uint32_t FindExtTlvSlot(const AppSpawnMsgNode *message, const char *name, uint32_t hash)
+{
+    uint32_t mask = message->extSlotCount - 1;
+    for (uint32_t i = hash & mask;; i = (i + 1) & mask) {
+        const AppSpawnExtTlvSlot *slot = &message->extSlots[i];
+        if (slot->offset == INVALID_OFFSET) {
+            return INVALID_OFFSET;
+        }
+        if (slot->hash != hash) {
+            continue;
+        }
+        AppSpawnTlvExt *tlv = (AppSpawnTlvExt *)(message->buffer + slot->offset);
+        if (strncmp(tlv->tlvName, name, sizeof(tlv->tlvName)) == 0) {
+            return slot->offset;
+        }
+    }
+}
+
+static void *FindExtTlvByScan(const AppSpawnMsgNode *message, const char *name, uint32_t *len)
+{
     for (uint32_t index = TLV_MAX; index < (TLV_MAX + message->tlvCount); index++) {
         if (message->tlvOffset[index] == INVALID_OFFSET) {
             return NULL;
@@ -52,14 +110,84 @@ void *GetAppSpawnMsgExtInfo(const AppSpawnMsgNode *message, const char *name, ui
         if (strcmp(tlv->tlvName, name) != 0) {
             continue;
         }
-        if (len != NULL) {
-            *len = tlv->dataLen;
-        }
-        return data + sizeof(AppSpawnTlvExt);
+        return GetExtTlvData(message, message->tlvOffset[index], len);
     }
     return NULL;
 }
 
+void *GetAppSpawnMsgExtInfo(const AppSpawnMsgNode *message, const char *name, uint32_t *len)
+{
+    APPSPAWN_CHECK(name != NULL, return NULL, "Invalid name ");
+    APPSPAWN_CHECK_ONLY_EXPER(message != NULL && message->buffer != NULL, return NULL);
+    APPSPAWN_CHECK_ONLY_EXPER(message->tlvOffset != NULL, return NULL);
+
+    APPSPAWN_LOGV("GetAppSpawnMsgExtInfo tlvCount %{public}d name %{public}s", message->tlvCount, name);
+    if (message->extSlots == NULL) {
+        return FindExtTlvByScan(message, name, len);
+    }
+    uint32_t offset = FindExtTlvSlot(message, name, GetAppSpawnNameHash(name, APPSPAWN_TLV_NAME_LEN));
+    return offset == INVALID_OFFSET ? NULL : GetExtTlvData(message, offset, len);
+}
+
+void *GetAppSpawnMsgKnownExtInfo(const AppSpawnMsgNode *message, AppSpawnExtTlvId id, uint32_t *len)
+{
+    APPSPAWN_CHECK((uint32_t)id < EXT_TLV_ID_MAX, return NULL, "Invalid ext tlv id %{public}d", id);
+    APPSPAWN_CHECK_ONLY_EXPER(message != NULL && message->buffer != NULL, return NULL);
+    if (message->knownExtOffset == NULL) {
+        return GetAppSpawnMsgExtInfo(message, g_knownExtNames[id], len);
+    }
+    uint32_t offset = message->knownExtOffset[id];
+    return offset == INVALID_OFFSET ? NULL : GetExtTlvData(message, offset, len);
+}
+
+/**
+ * @brief Build the ext tlv name index behind tlvOffset, the first tlv wins for duplicate names
+ * like the sequential lookup. Failure only leaves the message without index.
+ */
+static void BuildExtTlvIndex(AppSpawnMsgNode *message)
+{
+    message->extSlots = NULL;
+    message->knownExtOffset = NULL;
+    message->extSlotCount = 0;
+    uint32_t slotCount = GetExtTlvSlotCount(message->msgHeader.tlvCount);
+    uint32_t offsetCount = TLV_MAX + message->msgHeader.tlvCount;
+    uint32_t *tlvOffset = message->tlvOffset;
+    if (message->arenaSize == 0) {  // arena message has reserved the index space behind tlvOffset
+        size_t size = (offsetCount + EXT_TLV_ID_MAX) * sizeof(uint32_t) + slotCount * sizeof(AppSpawnExtTlvSlot);
+        tlvOffset = (uint32_t *)realloc(message->tlvOffset, size);
+        APPSPAWN_CHECK(tlvOffset != NULL, return, "Failed to alloc ext tlv index %{public}u", slotCount);
+        message->tlvOffset = tlvOffset;
+    }
+    message->knownExtOffset = tlvOffset + offsetCount;
+    message->extSlots = (AppSpawnExtTlvSlot *)(message->knownExtOffset + EXT_TLV_ID_MAX);
+    message->extSlotCount = slotCount;
+    for (uint32_t i = 0; i < slotCount; i++) {
+        message->extSlots[i].offset = INVALID_OFFSET;
+    }
+
+    uint32_t mask = slotCount - 1;
+    for (uint32_t index = TLV_MAX; index < (TLV_MAX + message->tlvCount); index++) {
+        AppSpawnTlvExt *tlv = (AppSpawnTlvExt *)(message->buffer + tlvOffset[index]);
+        if (tlv->tlvType != TLV_MAX) {
+            continue;
+        }
+        uint32_t hash = GetAppSpawnNameHash(tlv->tlvName, sizeof(tlv->tlvName));
+        if (FindExtTlvSlot(message, tlv->tlvName, hash) != INVALID_OFFSET) {
+            continue;
+        }
+        uint32_t i = hash & mask;
+        while (message->extSlots[i].offset != INVALID_OFFSET) {
+            i = (i + 1) & mask;
+        }
+        message->extSlots[i].hash = hash;
+        message->extSlots[i].offset = tlvOffset[index];
+    }
+    for (uint32_t id = 0; id < EXT_TLV_ID_MAX; id++) {
+        const char *name = g_knownExtNames[id];
+        message->knownExtOffset[id] = FindExtTlvSlot(message, name, GetAppSpawnNameHash(name, APPSPAWN_TLV_NAME_LEN));
+    }
+}
+
 int CheckAppSpawnMsgFlag(const AppSpawnMsgNode *message, uint32_t type, uint32_t index)
 {
     APPSPAWN_CHECK(type == TLV_MSG_FLAGS || type == TLV_PERMISSION, return 0, "Invalid tlv %{public}u ", type);
@@ -106,11 +234,61 @@ AppSpawnMsgNode *CreateAppSpawnMsg(void)
     return message;
 }
 
+static void *AllocMsgArena(size_t size, uint32_t *arenaSize)
+{
+    AppSpawnMgr *mgr = GetAppSpawnMgr();
+    if (size <= MSG_ARENA_BLOCK_SIZE) {
+        // all pooled blocks have the same size, so any of them fits a small message
+        if (mgr != NULL && mgr->idleMsgArenaCount > 0) {
+            ListNode *node = mgr->idleMsgArena.next;
+            OH_ListRemove(node);
+            mgr->idleMsgArenaCount--;
+            *arenaSize = MSG_ARENA_BLOCK_SIZE;
+            return node;
+        }
+        size = MSG_ARENA_BLOCK_SIZE;
+    }
+    void *arena = malloc(size);
+    APPSPAWN_CHECK(arena != NULL, return NULL, "Failed to alloc msg arena %{public}zu", size);
+    *arenaSize = (uint32_t)size;
+    return arena;
+}
+
+static void FreeMsgArena(void *arena, uint32_t arenaSize)
+{
+    AppSpawnMgr *mgr = GetAppSpawnMgr();
+    if (mgr != NULL && arenaSize == MSG_ARENA_BLOCK_SIZE && mgr->idleMsgArenaCount < MSG_ARENA_POOL_MAX) {
+        ListNode *node = (ListNode *)arena;
+        OH_ListInit(node);
+        OH_ListAddTail(&mgr->idleMsgArena, node);
+        mgr->idleMsgArenaCount++;
+        return;
+    }
+    free(arena);
+}
+
+static void MsgArenaDestroy(ListNode *node)
+{
+    free(node);
+}
+
+void ClearAppSpawnMsgArenaPool(AppSpawnMgr *mgr)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(mgr != NULL, return);
+    OH_ListRemoveAll(&mgr->idleMsgArena, MsgArenaDestroy);
+    mgr->idleMsgArenaCount = 0;
+}
+
 void DeleteAppSpawnMsg(AppSpawnMsgNode **msgNode)
 {
     if (msgNode == NULL || *msgNode == NULL) {
         return;
     }
+    if ((*msgNode)->arenaSize != 0) {
+        FreeMsgArena(*msgNode, (*msgNode)->arenaSize);
+        *msgNode = NULL;
+        return;
+    }
     if ((*msgNode)->buffer) {
         free((*msgNode)->buffer);
         (*msgNode)->buffer = NULL;
@@ -135,24 +313,40 @@ static inline int CheckRecvMsg(const AppSpawnMsg *msg)
     return 0;
 }
 
-static int AppSpawnMsgRebuild(AppSpawnMsgNode *message, const AppSpawnMsg *msg)
+/**
+ * @brief Move the received header into one arena holding the node, the tlv buffer, tlvOffset and the
+ * ext tlv index: [node][buffer][tlvOffset][knownExtOffset][extSlots]. The old node is freed and
+ * *msgNode is replaced, so callers must not keep another pointer to it.
+ */
+static int AppSpawnMsgRebuild(AppSpawnMsgNode **msgNode)
 {
+    AppSpawnMsgNode *message = *msgNode;
     APPSPAWN_CHECK_ONLY_EXPER(CheckRecvMsg(&message->msgHeader) == 0, return APPSPAWN_MSG_INVALID);
+    const AppSpawnMsg *msg = &message->msgHeader;
     if (msg->msgLen == sizeof(message->msgHeader)) {  // only has msg header
         return 0;
     }
-    if (message->buffer == NULL) {
-        message->buffer = calloc(1, msg->msgLen - sizeof(message->msgHeader));
-        APPSPAWN_CHECK(message->buffer != NULL, return -1, "Failed to alloc memory for recv message");
-    }
-    if (message->tlvOffset == NULL) {
-        uint32_t totalCount = msg->tlvCount + TLV_MAX;
-        message->tlvOffset = malloc(totalCount * sizeof(uint32_t));
-        APPSPAWN_CHECK(message->tlvOffset != NULL, return -1, "Failed to alloc memory for recv message");
-        for (uint32_t i = 0; i < totalCount; i++) {
-            message->tlvOffset[i] = INVALID_OFFSET;
-        }
+    APPSPAWN_CHECK_ONLY_EXPER(message->buffer == NULL && message->tlvOffset == NULL, return 0);
+    uint32_t bufferLen = msg->msgLen - sizeof(message->msgHeader);
+    uint32_t offsetCount = msg->tlvCount + TLV_MAX;
+    size_t size = MSG_ARENA_ALIGN(sizeof(AppSpawnMsgNode)) + MSG_ARENA_ALIGN(bufferLen) +
+        (offsetCount + EXT_TLV_ID_MAX) * sizeof(uint32_t) +
+        GetExtTlvSlotCount(msg->tlvCount) * sizeof(AppSpawnExtTlvSlot);
+    uint32_t arenaSize = 0;
+    uint8_t *arena = (uint8_t *)AllocMsgArena(size, &arenaSize);
+    APPSPAWN_CHECK(arena != NULL, return -1, "Failed to alloc memory for recv message");
+
+    AppSpawnMsgNode *node = (AppSpawnMsgNode *)arena;
+    (void)memcpy_s(node, sizeof(AppSpawnMsgNode), message, sizeof(AppSpawnMsgNode));
+    node->arenaSize = arenaSize;
+    node->buffer = arena + MSG_ARENA_ALIGN(sizeof(AppSpawnMsgNode));
+    (void)memset_s(node->buffer, bufferLen, 0, bufferLen);
+    node->tlvOffset = (uint32_t *)(node->buffer + MSG_ARENA_ALIGN(bufferLen));
+    for (uint32_t i = 0; i < offsetCount; i++) {
+        node->tlvOffset[i] = INVALID_OFFSET;
     }
+    DeleteAppSpawnMsg(msgNode);
+    *msgNode = node;
     return 0;
 }
 
@@ -169,7 +363,7 @@ AppSpawnMsgNode *RebuildAppSpawnMsgNode(AppSpawnMsgNode *message, AppSpawnedProc
     node->msgHeader.msgLen = bufferLen;
     node->msgHeader.msgType = MSG_SPAWN_NATIVE_PROCESS;
     node->msgHeader.tlvCount += message->msgHeader.tlvCount;
-    ret = AppSpawnMsgRebuild(node, &node->msgHeader);
+    ret = AppSpawnMsgRebuild(&node);
     APPSPAWN_CHECK(ret == 0, DeleteAppSpawnMsg(&node); return NULL, "Failed to alloc memory for recv message");
     uint32_t appInfoBufLen = appInfo->message->msgHeader.msgLen - sizeof(AppSpawnMsg);
     uint32_t msgBufLen = message->msgHeader.msgLen - sizeof(AppSpawnMsg);
@@ -299,6 +493,7 @@ int DecodeAppSpawnMsg(AppSpawnMsgNode *message)
     APPSPAWN_CHECK_ONLY_EXPER(currLen >= bufferLen, return APPSPAWN_MSG_INVALID);
     // save real ext tlv count
     message->tlvCount = tlvCount;
+    BuildExtTlvIndex(message);
     return 0;
 }
 
@@ -324,8 +519,9 @@ int GetAppSpawnMsgFromBuffer(const uint8_t *buffer, uint32_t bufferLen,
                 buffer, sizeof(message->msgHeader) - *msgRecvLen);
             APPSPAWN_CHECK(ret == EOK, return -1, "Failed to copy recv buffer");
 
-            ret = AppSpawnMsgRebuild(message, &message->msgHeader);
+            ret = AppSpawnMsgRebuild(outMsg);
             APPSPAWN_CHECK(ret == 0, return -1, "Failed to alloc buffer for receive msg");
+            message = *outMsg;
             reminderLen = bufferLen - (sizeof(message->msgHeader) - *msgRecvLen);
             reminderBuffer = buffer + sizeof(message->msgHeader) - *msgRecvLen;
             *msgRecvLen = sizeof(message->msgHeader);
@@ -355,6 +551,56 @@ int GetAppSpawnMsgFromBuffer(const uint8_t *buffer, uint32_t bufferLen,
     return 0;
 }
 
+#define MEMFD_MSG_SEALS (F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL)
+
+int CreateAppSpawnMsgMemfd(const AppSpawnMsgNode *message, const char *name, bool inheritable)
+{
+    APPSPAWN_CHECK(message != NULL && message->buffer != NULL && name != NULL, return -1, "Invalid msg for memfd");
+    uint32_t msgLen = message->msgHeader.msgLen;
+    APPSPAWN_CHECK(msgLen > sizeof(AppSpawnMsg) && msgLen < MAX_MSG_TOTAL_LENGTH,
+        return -1, "Invalid msg len %{public}u for memfd", msgLen);
+
+    unsigned int flags = inheritable ? MFD_ALLOW_SEALING : (MFD_ALLOW_SEALING | MFD_CLOEXEC);
+    int fd = memfd_create(name, flags);
+    APPSPAWN_CHECK(fd >= 0, return -1, "Failed to create memfd %{public}s errno %{public}d", name, errno);
+
+    struct iovec iov[2] = {  // 2 header and tlv buffer
+        { (void *)&message->msgHeader, sizeof(AppSpawnMsg) },
+        { message->buffer, msgLen - sizeof(AppSpawnMsg) },
+    };
+    ssize_t len = writev(fd, iov, ARRAY_LENGTH(iov));
+    APPSPAWN_CHECK(len == (ssize_t)msgLen, close(fd);
+        return -1, "Failed to write memfd %{public}zd errno %{public}d", len, errno);
+    // once sealed the content is immutable, the receiver only has to verify the seals
+    int ret = fcntl(fd, F_ADD_SEALS, MEMFD_MSG_SEALS);
+    APPSPAWN_CHECK(ret == 0, close(fd);
+        return -1, "Failed to seal memfd errno %{public}d", errno);
+    return fd;
+}
+
+uint8_t *MapAppSpawnMsgMemfd(int fd, uint32_t *mapSize)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(fd >= 0 && mapSize != NULL, return NULL);
+    int seals = fcntl(fd, F_GET_SEALS);
+    APPSPAWN_CHECK(seals >= 0 && ((unsigned int)seals & MEMFD_MSG_SEALS) == MEMFD_MSG_SEALS,
+        return NULL, "Invalid memfd %{public}d seals %{public}d errno %{public}d", fd, seals, errno);
+    struct stat st = {};
+    APPSPAWN_CHECK(fstat(fd, &st) == 0, return NULL, "Failed to stat memfd errno %{public}d", errno);
+    APPSPAWN_CHECK(st.st_size > (off_t)sizeof(AppSpawnMsg) && st.st_size < MAX_MSG_TOTAL_LENGTH,
+        return NULL, "Invalid memfd size %{public}lld", (long long)st.st_size);
+
+    uint32_t size = (uint32_t)st.st_size;
+    uint8_t *buffer = (uint8_t *)mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    APPSPAWN_CHECK(buffer != MAP_FAILED, return NULL, "Failed to map memfd errno %{public}d", errno);
+    if (((AppSpawnMsg *)buffer)->msgLen != size) {
+        APPSPAWN_LOGE("Invalid msg len %{public}u memfd size %{public}u", ((AppSpawnMsg *)buffer)->msgLen, size);
+        munmap(buffer, size);
+        return NULL;
+    }
+    *mapSize = size;
+    return buffer;
+}
+
 static inline void DumpMsgFlags(const char *processName, const char *info, const AppSpawnMsgFlags *msgFlags)
 {
     char logBuffer[DUMP_MAX_LOG_BUFF_LEN];
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#include "appspawn_param_cache.h"
+#include "appspawn_utils.h"
+#include "parameter.h"
+#include "securec.h"
+
+#define PARAM_CACHE_VALUE_LEN 32
+
+typedef struct TagAppSpawnParamCacheItem {
+    const char *name;
+    const char *defValue;
+    CachedHandle handle;
+    char value[PARAM_CACHE_VALUE_LEN];  // only used when the cached handle can not be created
+} AppSpawnParamCacheItem;
+
+static AppSpawnParamCacheItem g_paramCache[APPSPAWN_PARAM_MAX] = {
+    {"bootevent.boot.completed", "false", NULL, {0}},
+    {"const.security.developermode.state", "false", NULL, {0}},
+    {"const.startup.hnp.execute.enable", "false", NULL, {0}},
+    {SPAWN_TIMEOUT_PARAM, "0", NULL, {0}},
+    {COLD_SPAWN_TIMEOUT_PARAM, "0", NULL, {0}},
+};
+static AppSpawnParamCacheStat g_paramCacheStat = {0};
+
+static const char *ReadParameterDirect(AppSpawnParamCacheItem *item)
+{
+    g_paramCacheStat.lookups++;
+    int ret = GetParameter(item->name, item->defValue, item->value, sizeof(item->value));
+    return ret > 0 ? item->value : item->defValue;
+}
+
+const char *GetCachedParameter(AppSpawnParamIndex index)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(index < APPSPAWN_PARAM_MAX, return NULL);
+    AppSpawnParamCacheItem *item = &g_paramCache[index];
+    if (item->handle == NULL) {
+        item->handle = CachedParameterCreate(item->name, item->defValue);
+        APPSPAWN_CHECK_LOGW(item->handle != NULL, return ReadParameterDirect(item),
+            "Failed to create cached parameter %{public}s", item->name);
+        g_paramCacheStat.lookups++;
+        const char *value = CachedParameterGet(item->handle);
+        return value != NULL ? value : item->defValue;
+    }
+
+    int changed = 0;
+    const char *value = CachedParameterGetChanged(item->handle, &changed);
+    if (changed) {
+        g_paramCacheStat.lookups++;
+        APPSPAWN_LOGI("Cached parameter %{public}s changed to %{public}s", item->name,
+            value != NULL ? value : item->defValue);
+    } else {
+        g_paramCacheStat.cacheHits++;
+    }
+    return value != NULL ? value : item->defValue;
+}
+
+bool IsCachedParameterTrue(AppSpawnParamIndex index)
+{
+    const char *value = GetCachedParameter(index);
+    return value != NULL && strcmp(value, "true") == 0;
+}
+
+uint32_t GetCachedSpawnTimeout(uint32_t def, bool isColdRun)
+{
+    AppSpawnParamIndex index = isColdRun ? APPSPAWN_PARAM_COLD_SPAWN_TIMEOUT : APPSPAWN_PARAM_SPAWN_TIMEOUT;
+    return ParseSpawnTimeout(GetCachedParameter(index), def);
+}
+
+void AddParamCacheSpawnCount(void)
+{
+    g_paramCacheStat.spawnCount++;
+}
+
+const AppSpawnParamCacheStat *GetParamCacheStat(void)
+{
+    return &g_paramCacheStat;
+}
+
+void DestroyParamCache(void)
+{
+    for (uint32_t i = 0; i < APPSPAWN_PARAM_MAX; i++) {
+        APPSPAWN_ONLY_EXPER(g_paramCache[i].handle != NULL, CachedParameterDestroy(g_paramCache[i].handle));
+        g_paramCache[i].handle = NULL;
+    }
+    (void)memset_s(&g_paramCacheStat, sizeof(g_paramCacheStat), 0, sizeof(g_paramCacheStat));
+}
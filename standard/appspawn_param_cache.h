@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef APPSPAWN_PARAM_CACHE_H
+#define APPSPAWN_PARAM_CACHE_H
+
+/**
+ * @file appspawn_param_cache.h
+ * @brief System parameter snapshot for the spawn path.
+ *
+ * Parameters read on every spawn request are opened once as CachedParameter
+ * handles. A read only checks the commit id of the parameter node and returns
+ * the cached value, the trie lookup is done again only after the value changed.
+ * All functions are called from the appspawn event loop.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    APPSPAWN_PARAM_BOOT_COMPLETED,       /**< bootevent.boot.completed */
+    APPSPAWN_PARAM_DEVELOPER_MODE,       /**< const.security.developermode.state */
+    APPSPAWN_PARAM_HNP_EXECUTE_ENABLE,   /**< const.startup.hnp.execute.enable */
+    APPSPAWN_PARAM_SPAWN_TIMEOUT,        /**< persist.appspawn.reqMgr.timeout */
+    APPSPAWN_PARAM_COLD_SPAWN_TIMEOUT,   /**< const.appspawn.reqMgr.asanTimeout */
+    APPSPAWN_PARAM_MAX
+} AppSpawnParamIndex;
+
+/**
+ * @brief Parameter cache statistics.
+ * @param spawnCount Spawn requests handled
+ * @param cacheHits Reads served from the cache, i.e. GetParameter lookups avoided
+ * @param lookups Reads that needed a full parameter lookup (first read, change or fallback)
+ */
+typedef struct TagAppSpawnParamCacheStat {
+    uint64_t spawnCount;
+    uint64_t cacheHits;
+    uint64_t lookups;
+} AppSpawnParamCacheStat;
+
+/**
+ * @brief Read a cached parameter as a string.
+ * @return Current value, the default value when the parameter is not set
+ */
+const char *GetCachedParameter(AppSpawnParamIndex index);
+
+/**
+ * @brief Whether the cached parameter value is "true".
+ */
+bool IsCachedParameterTrue(AppSpawnParamIndex index);
+
+/**
+ * @brief Spawn response timeout in seconds, same rule as GetSpawnTimeout but from the cache.
+ */
+uint32_t GetCachedSpawnTimeout(uint32_t def, bool isColdRun);
+
+void AddParamCacheSpawnCount(void);
+const AppSpawnParamCacheStat *GetParamCacheStat(void);
+void DestroyParamCache(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // APPSPAWN_PARAM_CACHE_H
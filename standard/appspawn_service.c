@@ -42,6 +42,7 @@
 #include "parameter.h"
 #include "appspawn_adapter.h"
 #include "appspawn_fd_manager.h"
+#include "appspawn_param_cache.h"
 #include "securec.h"
 #include "cJSON.h"
 #ifdef APPSPAWN_HISYSEVENT
@@ -51,12 +52,16 @@
 #define PATH_SIZE 256
 #define FD_PATH_SIZE 128
 #define UNLOCK_MOUNT_TIMEOUT_MS 30000  // 30s timeout for unlock mount
+#define TERMINATE_CHILD_TIMEOUT_MS 1000  // 1s wait for the killed render process
 
 #define PREFORK_PROCESS "apppool"
 #define APPSPAWN_MSG_USER_CHECK_COUNT 4
 #define USER_ID_MIN_VALUE 100
 #define USER_ID_MAX_VALUE 10736
 #define LOCK_STATUS_PARAM_SIZE 64
+#define PREFORK_POOL_REFILL_DELAY 10  // 10ms, refill prefork pool off the request path
+#define PREFORK_POOL_IDLE_CHECK_TIME (30 * 1000)  // 30s
+#define PREFORK_POOL_IDLE_PERIODS 2
 #ifndef PIDFD_NONBLOCK
 #define PIDFD_NONBLOCK O_NONBLOCK
 #endif
@@ -78,6 +83,13 @@ APPSPAWN_STATIC int DoUnlockMountSerial(AppSpawnContent *content, int uid);
 APPSPAWN_STATIC int ProcessUnlockMessage(int uid);
 APPSPAWN_STATIC int ForkAndDoUnlockMount(AppSpawnContent *content, int uid, AppSpawningCtx *property);
 
+// Forward declarations for prefork pool functions
+APPSPAWN_STATIC void CleanupPreforkChild(AppSpawnMgr *mgr, pid_t childPid);
+APPSPAWN_STATIC bool PromotePreforkStandby(AppSpawnMgr *mgr);
+APPSPAWN_STATIC bool RemovePreforkStandby(AppSpawnMgr *mgr, pid_t pid);
+APPSPAWN_STATIC void SchedulePreforkPoolRefill(AppSpawnMgr *mgr);
+static void StopPreforkPool(AppSpawnMgr *mgr);
+
 // FD_CLOEXEC
 static inline void SetFdCtrl(int fd, int opt)
 {
@@ -99,8 +111,7 @@ static void AppQueueDestroyProc(const AppSpawnMgr *mgr, AppSpawnedProcess *appIn
     // notify child proess died,clean sandbox info
     ProcessMgrHookExecute(STAGE_SERVER_APP_DIED, GetAppSpawnContent(), appInfo);
     ProcessMgrHookExecute(STAGE_SERVER_APP_CLEANUP, GetAppSpawnContent(), appInfo);
-    OH_ListRemove(&appInfo->node);
-    OH_ListInit(&appInfo->node);
+    RemoveSpawnedProcess(appInfo);
     free(appInfo);
     if (pid > 0 && kill(pid, SIGKILL) != 0) {
         APPSPAWN_LOGE("unable to kill process, pid: %{public}d errno: %{public}d", pid, errno);
@@ -123,6 +134,9 @@ APPSPAWN_STATIC void StopAppSpawn(void)
         // This frees both TYPE_CHILD_PARENT and TYPE_PARENT_CHILD nodes from the queue.
         CleanupSpawningFdsByPid((AppSpawnMgr *)content, reservedPid);
     }
+    if (content != NULL) {
+        StopPreforkPool((AppSpawnMgr *)content);
+    }
     TraversalSpawnedProcess(AppQueueDestroyProc, NULL);
     APPSPAWN_LOGI("StopAppSpawn ");
 #ifdef APPSPAWN_HISYSEVENT
@@ -183,6 +197,12 @@ APPSPAWN_STATIC void HandleDiedPid(pid_t pid, uid_t uid, int status)
         // Cleanup spawning fds so the parent doesn't hold stale pipe fds.
         CleanupSpawningFdsByPid((AppSpawnMgr *)content, pid);
         content->reservedPid = 0;
+        (void)PromotePreforkStandby((AppSpawnMgr *)content);
+        SchedulePreforkPoolRefill((AppSpawnMgr *)content);
+    } else if (RemovePreforkStandby((AppSpawnMgr *)content, pid)) {
+        APPSPAWN_LOGW("HandleDiedPid with standby prefork pid %{public}d", pid);
+        CleanupSpawningFdsByPid((AppSpawnMgr *)content, pid);
+        SchedulePreforkPoolRefill((AppSpawnMgr *)content);
     }
     int signal = 0;
     AppSpawnedProcess *appInfo = GetSpawnedProcess(pid);
@@ -238,6 +258,10 @@ static void AppSpawningCtxOnClose(const AppSpawnMgr *mgr, AppSpawningCtx *ctx, v
     if (ctx == NULL || ctx->message == NULL || ctx->message->connection != data) {
         return;
     }
+    if (ctx->state == APP_STATE_TERMINATING) {  // already killed, SIGCHLD reaps it
+        DeleteAppSpawningCtx(ctx);
+        return;
+    }
     APPSPAWN_LOGI("Kill process, pid: %{public}d app: %{public}s", ctx->pid, GetProcessName(ctx));
     if (ctx->pid > 0 && kill(ctx->pid, SIGKILL) != 0) {
         APPSPAWN_LOGE("unable to kill process, pid: %{public}d errno: %{public}d", ctx->pid, errno);
@@ -419,7 +443,7 @@ APPSPAWN_STATIC bool OnConnectionUserCheck(uid_t uid)
     }
 
     // shell 2000
-    if (uid == 2000 && IsDeveloperModeOpen()) {
+    if (uid == 2000 && IsCachedParameterTrue(APPSPAWN_PARAM_DEVELOPER_MODE)) {
         return true;
     }
 
@@ -608,6 +632,15 @@ APPSPAWN_STATIC int WriteMsgToChild(AppSpawningCtx *property, RunMode mode)
 {
     APPSPAWN_CHECK(property != NULL && property->message != NULL, return APPSPAWN_MSG_INVALID,
         "Failed to WriteMsgToChild property invalid");
+#ifdef APPSPAWN_SUPPORT_MEMFD_MSG
+    // the memfd is inherited by the cold run process through execv, so it must not be close-on-exec
+    property->forkCtx.msgFd = CreateAppSpawnMsgMemfd(property->message, GetProcessName(property), true);
+    if (property->forkCtx.msgFd >= 0) {
+        property->forkCtx.msgSize = property->message->msgHeader.msgLen;
+        APPSPAWN_LOGV("Write msg to child: %{public}u by memfd success", property->client.id);
+        return 0;
+    }
+#endif
     const uint32_t memSize = (property->message->msgHeader.msgLen / 4096 + 1) * 4096; // 4096 4K
     char *buffer = GetMapMem(property->client.id, GetProcessName(property), memSize, false, mode);
     APPSPAWN_CHECK(buffer != NULL, return APPSPAWN_SYSTEM_ERROR,
@@ -727,6 +760,80 @@ static void WatchChildProcessFd(AppSpawningCtx *property)
     }
 }
 
+static void ProcessTerminatedChild(const WatcherHandle taskHandle, int fd, uint32_t *events, const void *context)
+{
+    AppSpawningCtx *property = (AppSpawningCtx *)context;
+    APPSPAWN_CHECK_ONLY_EXPER(property != NULL, return);
+    property->forkCtx.watcherHandle = NULL;
+    LE_RemoveWatcher(LE_GetDefaultLoop(), (WatcherHandle)taskHandle);
+
+    int exitStatus = -1;
+    int ret = ReapTerminatedProcess(property->pid, &exitStatus);
+    APPSPAWN_CHECK_ONLY_LOG(ret == 0, "Failed to reap process %{public}d errno %{public}d", property->pid, errno);
+    APPSPAWN_LOGI("Process %{public}d terminated, status %{public}d", property->pid, exitStatus);
+    APPSPAWN_ONLY_EXPER(property->message != NULL && property->message->connection != NULL,
+        SendResponse(property->message->connection, &property->message->msgHeader, exitStatus, property->pid));
+    DeleteAppSpawningCtx(property);
+}
+
+static void TerminateChildTimeout(const TimerHandle taskHandle, void *context)
+{
+    AppSpawningCtx *property = (AppSpawningCtx *)context;
+    APPSPAWN_CHECK_ONLY_EXPER(property != NULL, return);
+    int exitStatus = -1;
+    if (ReapTerminatedProcess(property->pid, &exitStatus) != 0) {
+        APPSPAWN_LOGE("Terminate process %{public}d timeout", property->pid);
+        DumpProcessSpawnStack(property->pid);
+    }
+    APPSPAWN_ONLY_EXPER(property->message != NULL && property->message->connection != NULL,
+        SendResponse(property->message->connection, &property->message->msgHeader, exitStatus, property->pid));
+    DeleteAppSpawningCtx(property);
+}
+
+/**
+ * @brief Wait for a killed process through its pid fd, the reply is sent from the loop
+ * @return 0 when the message is owned by the terminating ctx
+ */
+static int WatchTerminatingProcess(AppSpawnMsgNode *message, pid_t pid)
+{
+    int fd = OpenPidFd(pid, PIDFD_NONBLOCK);
+    APPSPAWN_CHECK(fd >= 0, return APPSPAWN_SYSTEM_ERROR,
+        "Failed to open pid fd for %{public}d errno %{public}d", pid, errno);
+    AppSpawningCtx *property = CreateAppSpawningCtx();
+    APPSPAWN_CHECK(property != NULL, close(fd);
+        return APPSPAWN_SYSTEM_ERROR, "Failed to create terminating ctx for %{public}d", pid);
+    property->state = APP_STATE_TERMINATING;
+    property->pid = pid;
+    property->forkCtx.fd[0] = fd;  // closed in DeleteAppSpawningCtx
+
+    LE_WatchInfo watchInfo = {};
+    watchInfo.fd = fd;
+    watchInfo.flags = WATCHER_ONCE;
+    watchInfo.events = EVENT_READ;
+    watchInfo.processEvent = ProcessTerminatedChild;
+    LE_STATUS status = LE_StartWatcher(LE_GetDefaultLoop(), &property->forkCtx.watcherHandle, &watchInfo, property);
+    APPSPAWN_ONLY_EXPER(status == LE_SUCCESS,
+        status = LE_CreateTimer(LE_GetDefaultLoop(), &property->forkCtx.timer, TerminateChildTimeout, property));
+    APPSPAWN_ONLY_EXPER(status == LE_SUCCESS,
+        status = LE_StartTimer(LE_GetDefaultLoop(), property->forkCtx.timer, TERMINATE_CHILD_TIMEOUT_MS, 0));
+    APPSPAWN_CHECK(status == LE_SUCCESS, DeleteAppSpawningCtx(property);
+        return APPSPAWN_SYSTEM_ERROR, "Failed to watch terminating process %{public}d", pid);
+    property->message = message;
+    return 0;
+}
+
+APPSPAWN_STATIC void ProcessTerminationStatusReq(AppSpawnConnection *connection, AppSpawnMsgNode *message)
+{
+    AppSpawnResult result = {0};
+    int ret = ProcessTerminationStatusMsg(message, &result);
+    if (ret == TERMINATION_STATUS_PENDING && WatchTerminatingProcess(message, result.pid) == 0) {
+        return;
+    }
+    ret = (ret == 0 || ret == TERMINATION_STATUS_PENDING) ? result.result : ret;
+    SendResponse(connection, &message->msgHeader, ret, result.pid);
+    DeleteAppSpawnMsg(&message);
+}
+
 static int IsChildColdRun(AppSpawningCtx *property)
 {
     return CheckAppMsgFlagsSet(property, APP_FLAGS_UBSAN_ENABLED) ||
@@ -739,7 +846,7 @@ static int IsChildColdRun(AppSpawningCtx *property)
 static int AddChildWatcher(AppSpawningCtx *property)
 {
     uint32_t defTimeout = IsChildColdRun(property) ? COLD_CHILD_RESPONSE_TIMEOUT : WAIT_CHILD_RESPONSE_TIMEOUT;
-    uint32_t timeout = GetSpawnTimeout(defTimeout, IsChildColdRun(property));
+    uint32_t timeout = GetCachedSpawnTimeout(defTimeout, IsChildColdRun(property));
 
     LE_WatchInfo watchInfo = {};
     watchInfo.fd = property->forkCtx.fd[0];
@@ -769,18 +876,7 @@ static int AddChildWatcher(AppSpawningCtx *property)
 
 static bool IsSupportRunHnp()
 {
-    char buffer[PARAM_BUFFER_SIZE] = {0};
-    int ret = GetParameter("const.startup.hnp.execute.enable", "false", buffer, PARAM_BUFFER_SIZE);
-    if (ret <= 0) {
-        APPSPAWN_LOGE("Get hnp execute enable param unsuccess! ret =%{public}d", ret);
-        return false;
-    }
-
-    if (strcmp(buffer, "true") == 0) {
-        return true;
-    }
-
-    return false;
+    return IsCachedParameterTrue(APPSPAWN_PARAM_HNP_EXECUTE_ENABLE);
 }
 
 APPSPAWN_STATIC void ClearMMAP(int clientId, uint32_t memSize)
@@ -810,6 +906,12 @@ APPSPAWN_STATIC void ClearPreforkInfo(AppSpawningCtx *property)
         APPSPAWN_CHECK_ONLY_LOG(ret == 0, "munmap failed %{public}d %{public}d", ret, errno);
         property->forkCtx.childMsg = NULL;
     }
+    // message handed over by memfd, there is no prefork file to unlink
+    if (property->forkCtx.msgFd >= 0) {
+        close(property->forkCtx.msgFd);
+        property->forkCtx.msgFd = -1;
+        return;
+    }
 
     char path[PATH_MAX] = {0};
     int ret = snprintf_s(path, sizeof(path), sizeof(path) - 1, APPSPAWN_MSG_DIR "appspawn/prefork_%u",
@@ -851,7 +953,12 @@ APPSPAWN_STATIC int WritePreforkMsg(AppSpawningCtx *property, uint32_t memSize)
 
 APPSPAWN_STATIC int GetAppSpawnMsg(AppSpawningCtx *property, uint32_t memSize, RunMode mode)
 {
-    uint8_t *buffer = (uint8_t *)GetMapMem(property->client.id, "prefork", memSize, true, mode);
+    uint8_t *buffer = NULL;
+    if (property->forkCtx.msgFd >= 0) {
+        buffer = MapAppSpawnMsgMemfd(property->forkCtx.msgFd, &memSize);
+    } else {
+        buffer = (uint8_t *)GetMapMem(property->client.id, "prefork", memSize, true, mode);
+    }
     APPSPAWN_CHECK(buffer != NULL, return -1, "prefork buffer is null can not write propery");
 
     uint32_t msgRecvLen = 0;
@@ -1091,8 +1198,14 @@ APPSPAWN_STATIC pid_t ForkAndRegisterFds(AppSpawnMgr *mgr, AppSpawningCtx *prope
     APPSPAWN_CHECK(pipe(childToParentFd) == 0, return -1,
         "prefork with prefork pipe failed %{public}d", errno);
 
-    // 2. Create parent-to-child pipe (parent -> child, for sending fork requests)
-    APPSPAWN_CHECK(pipe(parentToChildFd) == 0, ClearPipeFd(childToParentFd, PIPE_FD_LENGTH);
+    // 2. Create parent-to-child pipe (parent -> child, for sending fork requests).
+    // With memfd message handoff a socketpair is used instead, so the memfd can travel by SCM_RIGHTS.
+#ifdef APPSPAWN_SUPPORT_MEMFD_MSG
+    int ret = socketpair(AF_UNIX, SOCK_STREAM, 0, parentToChildFd);
+#else
+    int ret = pipe(parentToChildFd);
+#endif
+    APPSPAWN_CHECK(ret == 0, ClearPipeFd(childToParentFd, PIPE_FD_LENGTH);
         return -1, "prefork with parent-child pipe failed %{public}d", errno);
 
     // 3. Register fds BEFORE fork (pid = -1 as placeholder)
@@ -1136,6 +1249,58 @@ APPSPAWN_STATIC pid_t ForkAndRegisterFds(AppSpawnMgr *mgr, AppSpawningCtx *prope
     return pid;
 }
 
+/**
+ * @brief Close the pipe fds of sibling prefork children inherited from the pool.
+ *
+ * Runs in a freshly forked prefork child. The parent's spawningFdsQueue still holds
+ * the pipes of content->reservedPid and every standby slot; they are useless here.
+ */
+static void ClosePreforkSiblingFds(AppSpawnMgr *mgr)
+{
+    pid_t self = getpid();
+    PreforkPool *pool = &mgr->preforkPool;
+    if (mgr->content.reservedPid > 0 && mgr->content.reservedPid != self) {
+        CleanupSpawningFdsByPid(mgr, mgr->content.reservedPid);
+    }
+    for (uint32_t i = 0; i < pool->standbyCount; i++) {
+        APPSPAWN_ONLY_EXPER(pool->standby[i] != self, CleanupSpawningFdsByPid(mgr, pool->standby[i]));
+        pool->standby[i] = 0;
+    }
+    pool->standbyCount = 0;
+}
+
+/**
+ * @brief Read a pipe message from the parent, together with the memfd attached by SCM_RIGHTS.
+ *
+ * Falls back to read() when the parent-child fd is a plain pipe.
+ *
+ * @param fd       Read end of the parent-child channel
+ * @param pipeMsg  [out] Received pipe message
+ * @param msgFd    [out] Received memfd, -1 when none was attached
+ * @return bytes read, -1 on failure
+ */
+static ssize_t ReadPipeMsgFromParent(int fd, AppSpawnPipeMsg *pipeMsg, int *msgFd)
+{
+    *msgFd = -1;
+    struct iovec iov = { pipeMsg, sizeof(AppSpawnPipeMsg) };
+    char ctrlBuffer[CMSG_SPACE(sizeof(int))] = {0};
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrlBuffer;
+    msg.msg_controllen = sizeof(ctrlBuffer);
+    ssize_t size = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+    if (size < 0 && errno == ENOTSOCK) {
+        return read(fd, pipeMsg, sizeof(AppSpawnPipeMsg));
+    }
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (size > 0 && cmsg != NULL && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
+        cmsg->cmsg_len == CMSG_LEN(sizeof(int))) {
+        (void)memcpy_s(msgFd, sizeof(int), CMSG_DATA(cmsg), sizeof(int));
+    }
+    return size;
+}
+
 /**
  * @brief Prefork child process main loop: wait for pipe message and dispatch.
  *
@@ -1159,6 +1324,8 @@ APPSPAWN_STATIC void PreforkChildLoop(AppSpawnContent *content, AppSpawningCtx *
 {
     // Clear inherited forkCtx fds - they belong to the parent process
     ClearPipeFd(property->forkCtx.fd, PIPE_FD_LENGTH);
+    // Close pipes of sibling prefork children inherited from the prefork pool
+    ClosePreforkSiblingFds(mgr);
 
     // Set process name for debugging (visible in ps/top)
     int isRet = SetPreforkProcessName(content);
@@ -1170,11 +1337,18 @@ APPSPAWN_STATIC void PreforkChildLoop(AppSpawnContent *content, AppSpawningCtx *
 
     // Block until parent sends a message (or pipe is closed)
     AppSpawnPipeMsg pipeMsg = {0};
-    int infoSize = read(pcFds->fds[0], &pipeMsg, sizeof(AppSpawnPipeMsg));
+    int msgFd = -1;
+    int infoSize = (int)ReadPipeMsgFromParent(pcFds->fds[0], &pipeMsg, &msgFd);
     if (infoSize != sizeof(AppSpawnPipeMsg)) {
         APPSPAWN_LOGE("prefork process read msg failed %{public}d,%{public}d", infoSize, errno);
         ProcessExit(0);
     }
+    // Only a fork request carries the message memfd, HandlePreforkForkMsg maps it
+    if (pipeMsg.type == MSG_APP_SPAWN) {
+        property->forkCtx.msgFd = msgFd;
+    } else if (msgFd >= 0) {
+        close(msgFd);
+    }
 
     // Inherit the fdsan error level of the parent process before doing any fd operations
     (void)fdsan_set_error_level(errorLevel);
@@ -1223,6 +1397,216 @@ static void ProcessPreFork(AppSpawnContent *content, AppSpawningCtx *property)
     APPSPAWN_ONLY_EXPER(content->reservedPid == 0, PreforkChildLoop(content, property, mgr, errorLevel));
 }
 
+static uint32_t GetPreforkPoolParameter(const char *key, uint32_t def)
+{
+    char buffer[32] = {0};  // 32 max
+    int ret = GetParameter(key, "", buffer, sizeof(buffer));
+    APPSPAWN_ONLY_EXPER(ret <= 0, return def);
+    char *end = NULL;
+    errno = 0;
+    unsigned long value = strtoul(buffer, &end, 10);  // 10 decimal
+    return (errno != 0 || end == buffer) ? def : (uint32_t)value;
+}
+
+static inline bool IsPreforkPoolEnabled(const AppSpawnMgr *mgr)
+{
+    // A pool of one slot is the plain reservedPid prefork and keeps its synchronous refill
+    return mgr->content.enablePerfork && mgr->preforkPool.size > 1;
+}
+
+static inline uint32_t GetPreforkReadyCount(const AppSpawnMgr *mgr)
+{
+    return (mgr->content.reservedPid > 0 ? 1 : 0) + mgr->preforkPool.standbyCount;
+}
+
+/**
+ * @brief Load prefork pool configuration.
+ *
+ * persist.appspawn.prefork.pool.size is the total number of ready prefork children N,
+ * persist.appspawn.prefork.pool.low / .high are the refill watermarks. The values are
+ * clamped to 1 <= low <= high <= N <= PREFORK_POOL_MAX_SIZE.
+ */
+APPSPAWN_STATIC void InitPreforkPool(AppSpawnMgr *mgr)
+{
+    PreforkPool *pool = &mgr->preforkPool;
+    uint32_t size = GetPreforkPoolParameter("persist.appspawn.prefork.pool.size", 1);
+    size = (size == 0) ? 1 : ((size > PREFORK_POOL_MAX_SIZE) ? PREFORK_POOL_MAX_SIZE : size);
+    uint32_t high = GetPreforkPoolParameter("persist.appspawn.prefork.pool.high", size);
+    high = (high == 0 || high > size) ? size : high;
+    uint32_t low = GetPreforkPoolParameter("persist.appspawn.prefork.pool.low", (high + 1) / 2);  // 2 half
+    low = (low == 0 || low > high) ? high : low;
+
+    pool->size = size;
+    pool->highWatermark = high;
+    pool->lowWatermark = low;
+    pool->target = high;
+    pool->standbyCount = 0;
+    pool->takenCount = 0;
+    pool->idlePeriods = 0;
+    APPSPAWN_LOGI("InitPreforkPool size %{public}u low %{public}u high %{public}u", size, low, high);
+}
+
+/**
+ * @brief Move a standby prefork child into content->reservedPid.
+ * @return true if reservedPid holds a ready prefork child afterwards
+ */
+APPSPAWN_STATIC bool PromotePreforkStandby(AppSpawnMgr *mgr)
+{
+    APPSPAWN_ONLY_EXPER(mgr->content.reservedPid > 0, return true);
+    PreforkPool *pool = &mgr->preforkPool;
+    APPSPAWN_ONLY_EXPER(pool->standbyCount == 0, return false);
+    pool->standbyCount--;
+    mgr->content.reservedPid = pool->standby[pool->standbyCount];
+    pool->standby[pool->standbyCount] = 0;
+    APPSPAWN_LOGV("Promote standby prefork %{public}d", mgr->content.reservedPid);
+    return true;
+}
+
+APPSPAWN_STATIC bool RemovePreforkStandby(AppSpawnMgr *mgr, pid_t pid)
+{
+    PreforkPool *pool = &mgr->preforkPool;
+    for (uint32_t i = 0; i < pool->standbyCount; i++) {
+        if (pool->standby[i] != pid) {
+            continue;
+        }
+        pool->standbyCount--;
+        pool->standby[i] = pool->standby[pool->standbyCount];
+        pool->standby[pool->standbyCount] = 0;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Fork one prefork child for the pool. Never returns in the child.
+ * @return child pid in the parent, <0 on failure
+ */
+static pid_t ForkPreforkPoolChild(AppSpawnMgr *mgr)
+{
+    AppSpawningCtx *property = CreateAppSpawningCtx();
+    APPSPAWN_CHECK(property != NULL, return -1, "Failed to create ctx for prefork pool");
+    int childToParentFd[PIPE_FD_LENGTH] = {-1, -1};
+    int parentToChildFd[PIPE_FD_LENGTH] = {-1, -1};
+    enum fdsan_error_level errorLevel = fdsan_get_error_level();
+
+    pid_t pid = ForkAndRegisterFds(mgr, property, childToParentFd, parentToChildFd);
+    APPSPAWN_ONLY_EXPER(pid == 0, PreforkChildLoop(&mgr->content, property, mgr, errorLevel));
+    DeleteAppSpawningCtx(property);
+    return pid;
+}
+
+static void PreforkPoolRefillTimeout(const TimerHandle taskHandle, void *context)
+{
+    AppSpawnMgr *mgr = (AppSpawnMgr *)context;
+    APPSPAWN_ONLY_EXPER(mgr == NULL || !IsPreforkPoolEnabled(mgr), return);
+    PreforkPool *pool = &mgr->preforkPool;
+    APPSPAWN_ONLY_EXPER(GetPreforkReadyCount(mgr) >= pool->target, return);
+
+    // Fork a single child per timer callback so that queued requests are served in between
+    pid_t pid = ForkPreforkPoolChild(mgr);
+    APPSPAWN_CHECK(pid > 0, return, "Failed to refill prefork pool %{public}d", errno);
+    if (mgr->content.reservedPid <= 0) {
+        mgr->content.reservedPid = pid;
+    } else if (pool->standbyCount < PREFORK_POOL_MAX_SIZE) {
+        pool->standby[pool->standbyCount++] = pid;
+    }
+    APPSPAWN_LOGV("Refill prefork pool pid %{public}d ready %{public}u target %{public}u",
+        pid, GetPreforkReadyCount(mgr), pool->target);
+    if (GetPreforkReadyCount(mgr) < pool->target) {
+        LE_StartTimer(LE_GetDefaultLoop(), pool->refillTimer, PREFORK_POOL_REFILL_DELAY, 0);
+    }
+}
+
+/**
+ * @brief Periodic idle check of the prefork pool.
+ *
+ * While no slot is handed out for PREFORK_POOL_IDLE_PERIODS checks in a row the refill
+ * target drops by one towards lowWatermark and a standby child is released. Any demand
+ * restores the target to highWatermark.
+ */
+static void PreforkPoolIdleTimeout(const TimerHandle taskHandle, void *context)
+{
+    AppSpawnMgr *mgr = (AppSpawnMgr *)context;
+    APPSPAWN_ONLY_EXPER(mgr == NULL || !IsPreforkPoolEnabled(mgr), return);
+    PreforkPool *pool = &mgr->preforkPool;
+    if (pool->takenCount > 0) {
+        pool->takenCount = 0;
+        pool->idlePeriods = 0;
+        pool->target = pool->highWatermark;
+        if (GetPreforkReadyCount(mgr) < pool->target) {
+            LE_StartTimer(LE_GetDefaultLoop(), pool->refillTimer, PREFORK_POOL_REFILL_DELAY, 0);
+        }
+        return;
+    }
+    pool->idlePeriods++;
+    APPSPAWN_ONLY_EXPER(pool->idlePeriods < PREFORK_POOL_IDLE_PERIODS || pool->target <= pool->lowWatermark,
+        return);
+    pool->idlePeriods = 0;
+    pool->target--;
+    if (pool->standbyCount > 0 && GetPreforkReadyCount(mgr) > pool->target) {
+        pid_t pid = pool->standby[pool->standbyCount - 1];
+        (void)RemovePreforkStandby(mgr, pid);
+        CleanupPreforkChild(mgr, pid);
+        APPSPAWN_LOGI("Shrink idle prefork pool pid %{public}d target %{public}u", pid, pool->target);
+    }
+}
+
+/**
+ * @brief Refill the prefork pool from the event loop once it drops below lowWatermark.
+ */
+APPSPAWN_STATIC void SchedulePreforkPoolRefill(AppSpawnMgr *mgr)
+{
+    APPSPAWN_ONLY_EXPER(!IsPreforkPoolEnabled(mgr), return);
+    PreforkPool *pool = &mgr->preforkPool;
+    LoopHandle loop = LE_GetDefaultLoop();
+    if (pool->idleTimer == NULL) {
+        LE_STATUS status = LE_CreateTimer(loop, &pool->idleTimer, PreforkPoolIdleTimeout, mgr);
+        APPSPAWN_ONLY_EXPER(status == LE_SUCCESS,
+            status = LE_StartTimer(loop, pool->idleTimer, PREFORK_POOL_IDLE_CHECK_TIME, INT64_MAX));
+        APPSPAWN_CHECK_ONLY_LOG(status == LE_SUCCESS, "Failed to start prefork pool idle timer");
+    }
+    APPSPAWN_ONLY_EXPER(GetPreforkReadyCount(mgr) >= pool->lowWatermark, return);
+    if (pool->refillTimer == NULL) {
+        LE_STATUS status = LE_CreateTimer(loop, &pool->refillTimer, PreforkPoolRefillTimeout, mgr);
+        APPSPAWN_CHECK(status == LE_SUCCESS, pool->refillTimer = NULL;
+            return, "Failed to create prefork pool refill timer");
+    }
+    LE_StartTimer(loop, pool->refillTimer, PREFORK_POOL_REFILL_DELAY, 0);
+}
+
+/**
+ * @brief Refill content->reservedPid after its prefork child was handed out.
+ *
+ * A standby child is promoted when one is ready; otherwise the slot is forked synchronously
+ * as before. The standby slots are refilled in the background.
+ */
+static void ReplenishReservedPrefork(AppSpawnContent *content, AppSpawningCtx *property)
+{
+    AppSpawnMgr *mgr = (AppSpawnMgr *)content;
+    if (!PromotePreforkStandby(mgr)) {
+        ProcessPreFork(content, property);
+    }
+    SchedulePreforkPoolRefill(mgr);
+}
+
+static void StopPreforkPool(AppSpawnMgr *mgr)
+{
+    PreforkPool *pool = &mgr->preforkPool;
+    if (pool->refillTimer != NULL) {
+        LE_StopTimer(LE_GetDefaultLoop(), pool->refillTimer);
+        pool->refillTimer = NULL;
+    }
+    if (pool->idleTimer != NULL) {
+        LE_StopTimer(LE_GetDefaultLoop(), pool->idleTimer);
+        pool->idleTimer = NULL;
+    }
+    while (pool->standbyCount > 0) {
+        pid_t pid = pool->standby[--pool->standbyCount];
+        pool->standby[pool->standbyCount] = 0;
+        CleanupPreforkChild(mgr, pid);
+    }
+}
+
 static int NormalSpawnChild(AppSpawnContent *content, AppSpawnClient *client, pid_t *childPid)
 {
     APPSPAWN_CHECK(client != NULL, return APPSPAWN_ARG_INVALID, "client is null");
@@ -1237,6 +1621,8 @@ static int NormalSpawnChild(AppSpawnContent *content, AppSpawnClient *client, pi
  * Three-step preparation:
  * 1. Allocate shared memory (mmap) for the app spawn message
  * 2. Write the message to shared memory via WritePreforkMsg
+ *    With APPSPAWN_SUPPORT_MEMFD_MSG, steps 1-2 are replaced by a sealed memfd kept in
+ *    property->forkCtx.msgFd, falling back to the file mapping when memfd creation fails
  * 3. Build a lightweight AppSpawnPipeMsg containing only client id, flags, and msgLen
  *    (the prefork child will read the full message from mmap using these hints)
  *
@@ -1250,19 +1636,27 @@ static int NormalSpawnChild(AppSpawnContent *content, AppSpawnClient *client, pi
 APPSPAWN_STATIC int PreparePreforkMsg(AppSpawnContent *content, AppSpawningCtx *property,
     const AppSpawnClient *client, uint32_t memSize, AppSpawnPipeMsg **outPipeMsg)
 {
-    // Step 1: Allocate shared memory for the app spawn message.
-    // The prefork child will read from this mmap instead of receiving via socket.
-    content->propertyBuffer = GetMapMem(property->client.id, "prefork", memSize, false, content->mode);
-    APPSPAWN_ONLY_EXPER(content->propertyBuffer == NULL, ClearMMAP(property->client.id, memSize);
-        return APPSPAWN_SYSTEM_ERROR);
-    // Step 2: Copy the message from property->message to the shared memory
-    int ret = WritePreforkMsg(property, memSize);
-    APPSPAWN_ONLY_EXPER(ret != 0, ClearMMAP(property->client.id, memSize);
-        return APPSPAWN_SYSTEM_ERROR);
+#ifdef APPSPAWN_SUPPORT_MEMFD_MSG
+    // Sealed memfd: no file under APPSPAWN_MSG_DIR, nothing to unlink, child maps it read-only
+    property->forkCtx.msgFd = CreateAppSpawnMsgMemfd(property->message, "prefork", false);
+#endif
+    if (property->forkCtx.msgFd < 0) {
+        // Step 1: Allocate shared memory for the app spawn message.
+        // The prefork child will read from this mmap instead of receiving via socket.
+        content->propertyBuffer = GetMapMem(property->client.id, "prefork", memSize, false, content->mode);
+        APPSPAWN_ONLY_EXPER(content->propertyBuffer == NULL, ClearMMAP(property->client.id, memSize);
+            return APPSPAWN_SYSTEM_ERROR);
+        // Step 2: Copy the message from property->message to the shared memory
+        int ret = WritePreforkMsg(property, memSize);
+        APPSPAWN_ONLY_EXPER(ret != 0, ClearMMAP(property->client.id, memSize);
+            return APPSPAWN_SYSTEM_ERROR);
+    }
     // Step 3: Build a lightweight pipe message to signal the prefork child.
     // Only sends metadata (id, flags, msgLen); the child reads full data from mmap.
     AppSpawnPipeMsg *pipeMsg = (AppSpawnPipeMsg *)calloc(1, sizeof(AppSpawnPipeMsg));
     APPSPAWN_ONLY_EXPER(pipeMsg == NULL, APPSPAWN_LOGE("calloc failed");
+        APPSPAWN_ONLY_EXPER(property->forkCtx.msgFd >= 0, close(property->forkCtx.msgFd);
+            property->forkCtx.msgFd = -1);
         ClearMMAP(property->client.id, memSize);
         return APPSPAWN_SYSTEM_ERROR);
 
@@ -1274,19 +1668,42 @@ APPSPAWN_STATIC int PreparePreforkMsg(AppSpawnContent *content, AppSpawningCtx *
     return APPSPAWN_OK;
 }
 
+static ssize_t WritePipeMsgToChild(int fd, const AppSpawnPipeMsg *pipeMsg, int msgFd)
+{
+    if (msgFd < 0) {
+        return write(fd, pipeMsg, sizeof(AppSpawnPipeMsg));
+    }
+    struct iovec iov = { (void *)pipeMsg, sizeof(AppSpawnPipeMsg) };
+    char ctrlBuffer[CMSG_SPACE(sizeof(int))] = {0};
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrlBuffer;
+    msg.msg_controllen = sizeof(ctrlBuffer);
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    (void)memcpy_s(CMSG_DATA(cmsg), sizeof(int), &msgFd, sizeof(int));
+    return sendmsg(fd, &msg, MSG_NOSIGNAL);
+}
+
 /**
  * @brief Send pipe message to prefork child process.
  *
  * Writes the AppSpawnPipeMsg to parentToChildFd[1] (write end of the pipe).
+ * When msgFd >= 0 it is attached by SCM_RIGHTS, which requires the parent-child
+ * channel to be a socketpair (see ForkAndRegisterFds).
  * On success, immediately closes and unregisters the parent-child pipe fds
  * since they are no longer needed after the message is sent.
  *
  * @param mgr       AppSpawn manager instance
  * @param childPid  Prefork child process ID
  * @param pipeMsg   Pipe message to send
+ * @param msgFd     Sealed memfd carrying the app spawn message, -1 for none
  * @return APPSPAWN_OK on success, APPSPAWN_ARG_INVALID if fd not found, APPSPAWN_SYSTEM_ERROR on write failure
  */
-APPSPAWN_STATIC int SendPipeMsgToChild(AppSpawnMgr *mgr, pid_t childPid, AppSpawnPipeMsg *pipeMsg)
+APPSPAWN_STATIC int SendPipeMsgToChild(AppSpawnMgr *mgr, pid_t childPid, AppSpawnPipeMsg *pipeMsg, int msgFd)
 {
     // Look up parent-to-child pipe from spawningFdsQueue
     AppSpawnFds *pcFds = FindSpawningFdsByPid(mgr, childPid, TYPE_PARENT_CHILD);
@@ -1297,7 +1714,7 @@ APPSPAWN_STATIC int SendPipeMsgToChild(AppSpawnMgr *mgr, pid_t childPid, AppSpaw
 
     // Write the pipe message (blocks if pipe buffer is full, which should not happen
     // since sizeof(AppSpawnPipeMsg) is small and child is blocking on read)
-    ssize_t writesize = write(pcFds->fds[1], pipeMsg, sizeof(AppSpawnPipeMsg));
+    ssize_t writesize = WritePipeMsgToChild(pcFds->fds[1], pipeMsg, msgFd);
     if (writesize < 0 || (size_t)writesize != sizeof(AppSpawnPipeMsg)) {
         APPSPAWN_LOGE("write msg to child failed %{public}d", errno);
         return APPSPAWN_SYSTEM_ERROR;
@@ -1364,14 +1781,17 @@ APPSPAWN_STATIC int TransferPreforkFdToForkCtx(AppSpawnMgr *mgr, pid_t childPid,
  * Prefork flow:
  * 1. If no prefork child exists (reservedPid <= 0):
  *    - Fall back to normal fork for this request
- *    - Fork a new prefork child for future requests (ProcessPreFork)
+ *    - Refill the reserved slot for future requests (ReplenishReservedPrefork)
  *
  * 2. If prefork child exists (reservedPid > 0):
  *    - Prepare message in shared memory (PreparePreforkMsg)
  *    - Send pipe message to prefork child (SendPipeMsgToChild)
  *    - Take over prefork pipe for result notification (TransferPreforkFdToForkCtx)
- *    - On failure: kill prefork child, cleanup fds, fork a new one (ProcessPreFork)
- *    - On success: fork a new prefork child for next request (ProcessPreFork)
+ *    - On failure: kill prefork child, cleanup fds, refill the slot (ReplenishReservedPrefork)
+ *    - On success: refill the slot for next request (ReplenishReservedPrefork)
+ *
+ * ReplenishReservedPrefork promotes a standby child of the prefork pool when available
+ * and only forks on the request path when the pool is drained.
  *
  * @return APPSPAWN_OK on success, APPSPAWN_SYSTEM_ERROR on failure
  */
@@ -1385,7 +1805,7 @@ static int AppSpawnProcessMsgForPrefork(AppSpawnContent *content, AppSpawnClient
         // No prefork child available: use normal fork for this request,
         // then create a new prefork child for future requests
         ret = NormalSpawnChild(content, client, childPid);
-        ProcessPreFork(content, property);
+        ReplenishReservedPrefork(content, property);
         return ret;
     }
 
@@ -1397,20 +1817,28 @@ static int AppSpawnProcessMsgForPrefork(AppSpawnContent *content, AppSpawnClient
     APPSPAWN_ONLY_EXPER(PreparePreforkMsg(content, property, client, memSize, &pipeMsg) != APPSPAWN_OK,
         return NormalSpawnChild(content, client, childPid));
     *childPid = content->reservedPid;
+    content->reservedPid = 0;
+    mgr->preforkPool.takenCount++;
+    property->isPrefork = true;  // parent side, for spawn latency statistics
 
     // Send pipe message and transfer prefork fd. If either fails,
     // kill the prefork child and cleanup its fds.
-    if (SendPipeMsgToChild(mgr, *childPid, pipeMsg) != APPSPAWN_OK ||
+    if (SendPipeMsgToChild(mgr, *childPid, pipeMsg, property->forkCtx.msgFd) != APPSPAWN_OK ||
         TransferPreforkFdToForkCtx(mgr, *childPid, property) != APPSPAWN_OK) {
         CleanupPreforkChild(mgr, *childPid);
         *childPid = 0;
         ret = APPSPAWN_SYSTEM_ERROR;
     }
+    // The prefork child holds its own reference to the memfd now
+    if (property->forkCtx.msgFd >= 0) {
+        close(property->forkCtx.msgFd);
+        property->forkCtx.msgFd = -1;
+    }
 
     free(pipeMsg);
-    // Always try to create a new prefork child for the next request,
+    // Always refill the reserved slot for the next request,
     // regardless of whether this request succeeded or failed
-    ProcessPreFork(content, property);
+    ReplenishReservedPrefork(content, property);
     return ret;
 }
 
@@ -1436,10 +1864,7 @@ static bool IsSupportPrefork(AppSpawnContent *content, AppSpawnClient *client)
 
 static bool IsBootFinished(void)
 {
-    char buffer[32] = {0};  // 32 max
-    int ret = GetParameter("bootevent.boot.completed", "false", buffer, sizeof(buffer));
-    bool isBootCompleted = (ret > 0 && strcmp(buffer, "true") == 0);
-    return isBootCompleted;
+    return IsCachedParameterTrue(APPSPAWN_PARAM_BOOT_COMPLETED);
 }
 
 
@@ -1472,7 +1897,8 @@ static void ProcessSpawnReqMsg(AppSpawnConnection *connection, AppSpawnMsgNode *
         return;
     }
 
-    if (IsDeveloperModeOpen()) {
+    AddParamCacheSpawnCount();
+    if (IsCachedParameterTrue(APPSPAWN_PARAM_DEVELOPER_MODE)) {
         if (IsSupportRunHnp()) {
             SetAppSpawnMsgFlag(message, TLV_MSG_FLAGS, APP_FLAGS_DEVELOPER_MODE);
         } else {
@@ -1584,8 +2010,11 @@ static void WaitChildTimeout(const TimerHandle taskHandle, void *context)
 
 static int ProcessChildFdCheck(int fd, AppSpawningCtx *property)
 {
-    int result = 0;
-    (void)read(fd, &result, sizeof(result));
+    AppSpawnChildTiming timing = {0};
+    ssize_t len = read(fd, &timing, sizeof(timing));
+    int result = timing.result;
+    // a bare int result carries no timing
+    APPSPAWN_ONLY_EXPER(len == (ssize_t)sizeof(timing), AddChildTimingStat(GetAppSpawnMgr(), &timing));
     APPSPAWN_DUMPI("Child process:%{public}s success pid:%{public}d appId:%{public}u result:%{public}d",
         GetProcessName(property), property->pid, property->client.id, result);
     APPSPAWN_CHECK(property->message != NULL, return -1, "Invalid message in ctx %{public}d", property->client.id);
@@ -1666,11 +2095,16 @@ static void ProcessChildResponse(const WatcherHandle taskHandle, int fd, uint32_
         return);
 
 #ifdef DEBUG_BEGETCTL_BOOT
-    if (IsDeveloperModeOpen()) {
+    if (IsCachedParameterTrue(APPSPAWN_PARAM_DEVELOPER_MODE)) {
         appInfo->message = property->message;
     }
 #endif
     clock_gettime(CLOCK_MONOTONIC, &appInfo->spawnEnd);
+    bool bootFinished = IsBootFinished();
+    SpawnLatencyMode latencyMode = property->isPrefork ? SPAWN_LATENCY_PREFORK :
+        (IsChildColdRun(property) ? SPAWN_LATENCY_COLD_RUN : SPAWN_LATENCY_FORK);
+    AddSpawnLatency(GetAppSpawnMgr(), latencyMode, bootFinished, GetAppSpawnMsgType(property),
+        DiffTime(&appInfo->spawnStart, &appInfo->spawnEnd));
 
 #ifdef APPSPAWN_HISYSEVENT
     //add process spawn duration into hisysevent,(ms)
@@ -1679,7 +2113,7 @@ static void ProcessChildResponse(const WatcherHandle taskHandle, int fd, uint32_
         (APPSPAWN_MSEC_TO_NSEC));
     AppSpawnMgr *appspawnMgr = GetAppSpawnMgr();
     if (appspawnMgr != NULL) {
-        AddStatisticEventInfo(appspawnMgr->hisyseventInfo, spawnProcessDuration, IsBootFinished());
+        AddStatisticEventInfo(appspawnMgr->hisyseventInfo, spawnProcessDuration, bootFinished);
     }
 #ifndef ASAN_DETECTOR
     uint64_t diff = DiffTime(&appInfo->spawnStart, &appInfo->spawnEnd);
@@ -1697,7 +2131,7 @@ static void ProcessChildResponse(const WatcherHandle taskHandle, int fd, uint32_
     FinishAppspawnTrace();
     AppSpawnHookExecute(STAGE_PARENT_POST_RELY, 0, GetAppSpawnContent(), &property->client);
 #ifdef DEBUG_BEGETCTL_BOOT
-    if (IsDeveloperModeOpen()) {
+    if (IsCachedParameterTrue(APPSPAWN_PARAM_DEVELOPER_MODE)) {
         property->message = NULL;
     }
 #endif
@@ -1710,7 +2144,9 @@ static void NotifyResToParent(AppSpawnContent *content, AppSpawnClient *client,
     APPSPAWN_CHECK(property != NULL && client != NULL, return, "invalid param");
     int fd = property->forkCtx.fd[1];
     if (fd >= 0) {
-        (void)write(fd, &result, sizeof(result));
+        // result and stage timing in one write, smaller than PIPE_BUF so the parent never sees a partial record
+        property->childTiming.result = result;
+        (void)write(fd, &property->childTiming, sizeof(property->childTiming));
         (void)close(fd);
         property->forkCtx.fd[1] = -1;
     }
@@ -1792,7 +2228,7 @@ APPSPAWN_STATIC int AppSpawnColdStartApp(struct AppSpawnContent *content, AppSpa
 #else
     char *path = property->forkCtx.coldRunPath != NULL ? property->forkCtx.coldRunPath : "/system/bin/appspawn";
 #endif
-    char buffer[4][32] = {0};  // 4 32 buffer for fd
+    char buffer[5][32] = {0};  // 5 32 buffer for fd
     int len = sprintf_s(buffer[0], sizeof(buffer[0]), " %d ", property->forkCtx.fd[1]);
     APPSPAWN_CHECK(len > 0, return APPSPAWN_SYSTEM_ERROR, "Invalid to format fd");
     len = sprintf_s(buffer[1], sizeof(buffer[1]), " %u ", property->client.flags);
@@ -1801,13 +2237,15 @@ APPSPAWN_STATIC int AppSpawnColdStartApp(struct AppSpawnContent *content, AppSpa
     APPSPAWN_CHECK(len > 0, return APPSPAWN_SYSTEM_ERROR, "Invalid to format msgSize");
     len = sprintf_s(buffer[3], sizeof(buffer[3]), " %u ", property->client.id); // 3 3 index for client id
     APPSPAWN_CHECK(len > 0, return APPSPAWN_SYSTEM_ERROR, "Invalid to format clientId");
+    len = sprintf_s(buffer[4], sizeof(buffer[4]), " %d ", property->forkCtx.msgFd); // 4 4 index for msg fd
+    APPSPAWN_CHECK(len > 0, return APPSPAWN_SYSTEM_ERROR, "Invalid to format msgFd");
     char *mode = IsAppSpawnMode(mgr) ? "app_cold" : (IsNWebSpawnMode(mgr) ? "nweb_cold" :
         (IsCJSpawnMode(mgr) ? "cj_app_cold" : (IsNativeSpawnMode(mgr) ? "native_cold" : "hybrid_cold")));
     APPSPAWN_LOGI("ColdStartApp::processName:%{public}s path:%{public}s mode:%{public}s", processName, path, mode);
 
 #ifndef APPSPAWN_TEST
     const char *const formatCmds[] = {
-        path, "-mode", mode, "-fd", buffer[0], buffer[1], buffer[2], "-param", processName, buffer[3], NULL
+        path, "-mode", mode, "-fd", buffer[0], buffer[1], buffer[2], "-param", processName, buffer[3], buffer[4], NULL
     };
     ret = execv(path, (char **)formatCmds);
     if (ret != 0) {
@@ -1828,8 +2266,14 @@ static AppSpawningCtx *GetAppSpawningCtxFromArg(AppSpawnMgr *content, int argc,
 
     uint32_t size = (uint32_t)atoi(argv[SHM_SIZE_INDEX]);
     property->client.id = (uint32_t)atoi(argv[CLIENT_ID_INDEX]);
-    uint8_t *buffer = (uint8_t *)GetMapMem(property->client.id,
-        argv[PARAM_VALUE_INDEX], size, true, content->content.mode);
+    // msg fd is optional, absent or -1 means the message is in the file under APPSPAWN_MSG_DIR
+    property->forkCtx.msgFd = argc > MSG_FD_INDEX ? atoi(argv[MSG_FD_INDEX]) : -1;
+    uint8_t *buffer = NULL;
+    if (property->forkCtx.msgFd >= 0) {
+        buffer = MapAppSpawnMsgMemfd(property->forkCtx.msgFd, &size);
+    } else {
+        buffer = (uint8_t *)GetMapMem(property->client.id, argv[PARAM_VALUE_INDEX], size, true, content->content.mode);
+    }
     if (buffer == NULL) {
         APPSPAWN_LOGE("Failed to map errno %{public}d %{public}s", property->client.id, argv[PARAM_VALUE_INDEX]);
         NotifyResToParent(&content->content, &property->client, APPSPAWN_SYSTEM_ERROR);
@@ -1843,12 +2287,17 @@ static AppSpawningCtx *GetAppSpawningCtxFromArg(AppSpawnMgr *content, int argc,
     int ret = GetAppSpawnMsgFromBuffer(buffer, ((AppSpawnMsg *)buffer)->msgLen, &message, &msgRecvLen, &remainLen);
     // release map
     munmap((char *)buffer, size);
-    //unlink
-    char path[PATH_MAX] = {0};
-    int len = sprintf_s(path, sizeof(path), APPSPAWN_MSG_DIR "%s/%s_%u",
-        GetSpawnNameByRunMode(content->content.mode), argv[PARAM_VALUE_INDEX], property->client.id);
-    if (len > 0) {
-        unlink(path);
+    if (property->forkCtx.msgFd >= 0) {
+        close(property->forkCtx.msgFd);
+        property->forkCtx.msgFd = -1;
+    } else {
+        //unlink
+        char path[PATH_MAX] = {0};
+        int len = sprintf_s(path, sizeof(path), APPSPAWN_MSG_DIR "%s/%s_%u",
+            GetSpawnNameByRunMode(content->content.mode), argv[PARAM_VALUE_INDEX], property->client.id);
+        if (len > 0) {
+            unlink(path);
+        }
     }
 
     if (ret == 0 && DecodeAppSpawnMsg(message) == 0 && CheckAppSpawnMsg(message) == 0) {
@@ -1966,6 +2415,7 @@ AppSpawnContent *AppSpawnCreateContent(const char *socketName, char *longProcNam
             return NULL, "Failed to create server");
     }
     appSpawnContent->content.enablePerfork = IsEnablePrefork();
+    InitPreforkPool(appSpawnContent);
     return &appSpawnContent->content;
 }
 
@@ -2351,13 +2801,9 @@ static void ProcessRecvMsg(AppSpawnConnection *connection, AppSpawnMsgNode *mess
 
     int ret;
     switch (msg->msgType) {
-        case MSG_GET_RENDER_TERMINATION_STATUS: {  // get status
-            AppSpawnResult result = {0};
-            ret = ProcessTerminationStatusMsg(message, &result);
-            SendResponse(connection, msg, ret == 0 ? result.result : ret, result.pid);
-            DeleteAppSpawnMsg(&message);
+        case MSG_GET_RENDER_TERMINATION_STATUS:  // get status
+            ProcessTerminationStatusReq(connection, message);
             break;
-        }
         case MSG_SPAWN_NATIVE_PROCESS:  // spawn msg
         case MSG_APP_SPAWN: {
             ProcessSpawnReqMsg(connection, message);
@@ -2435,6 +2881,11 @@ static void ReforkPreforkIfNeeded(AppSpawnContent *content)
     if (!content->enablePerfork) {
         return;
     }
+    AppSpawnMgr *mgr = (AppSpawnMgr *)content;
+    if (PromotePreforkStandby(mgr)) {
+        SchedulePreforkPoolRefill(mgr);
+        return;
+    }
     AppSpawningCtx *newProperty = CreateAppSpawningCtx();
     if (newProperty != NULL) {
         ProcessPreFork(content, newProperty);
@@ -2474,6 +2925,7 @@ static int TryLevel1PreforkUnlock(AppSpawnContent *content, int uid, AppSpawning
         UnregisterSpawningFdsByPid(mgr, content->reservedPid, TYPE_PARENT_CHILD);
         UnregisterSpawningFdsByPid(mgr, content->reservedPid, TYPE_CHILD_PARENT);
         content->reservedPid = 0;
+        mgr->preforkPool.takenCount++;
         return 0;
     } while (0);
 
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "appspawn_manager.h"
+#include "appspawn_msg.h"
+#include "appspawn_utils.h"
+#include "securec.h"
+
+namespace {
+constexpr uint32_t MSG_BUFFER_LEN = 16 * 1024;  // 16K enough for 30 ext tlv
+constexpr uint32_t EXT_TLV_COUNT = 30;
+
+// ext tlv names carried by a typical hap spawn request, padded with extra names up to EXT_TLV_COUNT
+const char *g_extNames[] = {
+    MSG_EXT_NAME_RENDER_CMD, MSG_EXT_NAME_HSP_LIST, MSG_EXT_NAME_OVERLAY, MSG_EXT_NAME_DATA_GROUP,
+    MSG_EXT_NAME_APP_ENV, MSG_EXT_NAME_APP_EXTENSION, MSG_EXT_NAME_ACCOUNT_ID, MSG_EXT_NAME_PROVISION_TYPE,
+    MSG_EXT_NAME_PROCESS_TYPE, MSG_EXT_NAME_MAX_CHILD_PROCCESS_MAX, MSG_EXT_NAME_JIT_PERMISSIONS,
+    MSG_EXT_NAME_USERID, MSG_EXT_NAME_EXTENSION_TYPE, MSG_EXT_NAME_API_TARGET_VERSION, MSG_EXT_NAME_PARENT_UID,
+    MSG_EXT_NAME_XPM_ID_TYPE, MSG_EXT_NAME_APP_SIGN_TYPE, MSG_EXT_NAME_APP_DISTRIBUTION_TYPE,
+};
+
+// names looked up by hooks on every spawn
+const char *g_hookNames[] = {
+    MSG_EXT_NAME_PROCESS_TYPE, MSG_EXT_NAME_PROVISION_TYPE, MSG_EXT_NAME_HSP_LIST, MSG_EXT_NAME_DATA_GROUP,
+    MSG_EXT_NAME_OVERLAY, MSG_EXT_NAME_APP_EXTENSION, MSG_EXT_NAME_ACCOUNT_ID, MSG_EXT_NAME_XPM_ID_TYPE,
+};
+const AppSpawnExtTlvId g_hookIds[] = {
+    EXT_TLV_ID_PROCESS_TYPE, EXT_TLV_ID_PROVISION_TYPE, EXT_TLV_ID_HSP_LIST, EXT_TLV_ID_DATA_GROUP,
+    EXT_TLV_ID_OVERLAY, EXT_TLV_ID_APP_EXTENSION, EXT_TLV_ID_ACCOUNT_ID, EXT_TLV_ID_XPM_ID_TYPE,
+};
+constexpr uint32_t HOOK_NAME_COUNT = sizeof(g_hookNames) / sizeof(g_hookNames[0]);
+
+uint32_t AppendExtTlv(std::vector<uint8_t> &buffer, uint32_t offset, const char *name, const std::string &data)
+{
+    AppSpawnTlvExt tlv = {};
+    tlv.tlvType = TLV_MAX;
+    (void)strcpy_s(tlv.tlvName, sizeof(tlv.tlvName), name);
+    tlv.dataLen = data.size() + 1;
+    tlv.tlvLen = sizeof(AppSpawnTlvExt) + APPSPAWN_ALIGN(tlv.dataLen);
+    (void)memcpy_s(buffer.data() + offset, buffer.size() - offset, &tlv, sizeof(tlv));
+    (void)memcpy_s(buffer.data() + offset + sizeof(tlv), buffer.size() - offset - sizeof(tlv),
+        data.c_str(), tlv.dataLen);
+    return offset + tlv.tlvLen;
+}
+
+std::vector<uint8_t> CreateBenchmarkBuffer()
+{
+    std::vector<uint8_t> buffer(MSG_BUFFER_LEN);
+    AppSpawnMsg *msg = reinterpret_cast<AppSpawnMsg *>(buffer.data());
+    msg->magic = APPSPAWN_MSG_MAGIC;
+    msg->msgType = MSG_APP_SPAWN;
+    msg->msgId = 1;
+    (void)strcpy_s(msg->processName, sizeof(msg->processName), "com.example.bench");
+    uint32_t offset = sizeof(AppSpawnMsg);
+    const uint32_t knownCount = sizeof(g_extNames) / sizeof(g_extNames[0]);
+    for (uint32_t i = 0; i < EXT_TLV_COUNT; i++) {
+        std::string name = i < knownCount ? g_extNames[i] : "bench-ext-" + std::to_string(i);
+        offset = AppendExtTlv(buffer, offset, name.c_str(), std::string(64, 'a'));  // 64 typical value length
+    }
+    msg->msgLen = offset;
+    msg->tlvCount = EXT_TLV_COUNT;
+    return buffer;
+}
+
+AppSpawnMsgNode *CreateBenchmarkMsg(const std::vector<uint8_t> &buffer)
+{
+    AppSpawnMsgNode *message = nullptr;
+    uint32_t msgRecvLen = 0;
+    uint32_t remainLen = 0;
+    const AppSpawnMsg *msg = reinterpret_cast<const AppSpawnMsg *>(buffer.data());
+    if (GetAppSpawnMsgFromBuffer(buffer.data(), msg->msgLen, &message, &msgRecvLen, &remainLen) != 0 ||
+        DecodeAppSpawnMsg(message) != 0) {
+        DeleteAppSpawnMsg(&message);
+        return nullptr;
+    }
+    return message;
+}
+
+void BM_ExtTlvLookupScan(benchmark::State &state)
+{
+    std::vector<uint8_t> buffer = CreateBenchmarkBuffer();
+    AppSpawnMsgNode *message = CreateBenchmarkMsg(buffer);
+    if (message == nullptr) {
+        state.SkipWithError("create msg failed");
+        return;
+    }
+    AppSpawnExtTlvSlot *extSlots = message->extSlots;
+    message->extSlots = nullptr;  // sequential strcmp lookup
+    uint32_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GetAppSpawnMsgExtInfo(message, g_hookNames[index++ % HOOK_NAME_COUNT], nullptr));
+    }
+    message->extSlots = extSlots;
+    DeleteAppSpawnMsg(&message);
+}
+
+void BM_ExtTlvLookupIndex(benchmark::State &state)
+{
+    std::vector<uint8_t> buffer = CreateBenchmarkBuffer();
+    AppSpawnMsgNode *message = CreateBenchmarkMsg(buffer);
+    if (message == nullptr) {
+        state.SkipWithError("create msg failed");
+        return;
+    }
+    uint32_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GetAppSpawnMsgExtInfo(message, g_hookNames[index++ % HOOK_NAME_COUNT], nullptr));
+    }
+    DeleteAppSpawnMsg(&message);
+}
+
+void BM_ExtTlvLookupKnownId(benchmark::State &state)
+{
+    std::vector<uint8_t> buffer = CreateBenchmarkBuffer();
+    AppSpawnMsgNode *message = CreateBenchmarkMsg(buffer);
+    if (message == nullptr) {
+        state.SkipWithError("create msg failed");
+        return;
+    }
+    uint32_t index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(GetAppSpawnMsgKnownExtInfo(message, g_hookIds[index++ % HOOK_NAME_COUNT], nullptr));
+    }
+    DeleteAppSpawnMsg(&message);
+}
+
+// one time cost of building the index, paid once per message
+void BM_ExtTlvDecode(benchmark::State &state)
+{
+    std::vector<uint8_t> buffer = CreateBenchmarkBuffer();
+    for (auto _ : state) {
+        AppSpawnMsgNode *message = CreateBenchmarkMsg(buffer);
+        if (message == nullptr) {
+            state.SkipWithError("create msg failed");
+            break;
+        }
+        DeleteAppSpawnMsg(&message);
+    }
+}
+}  // namespace
+
+BENCHMARK(BM_ExtTlvLookupScan);
+BENCHMARK(BM_ExtTlvLookupIndex);
+BENCHMARK(BM_ExtTlvLookupKnownId);
+BENCHMARK(BM_ExtTlvDecode);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "appspawn_manager.h"
+#include "appspawn_msg.h"
+#include "appspawn_utils.h"
+#include "securec.h"
+
+namespace {
+constexpr uint32_t MSG_BLOCK_LEN = 4096;  // same alignment as the prefork/cold run file mapping
+const char *g_msgFile = APPSPAWN_MSG_DIR "appspawn/benchmark_1";
+
+AppSpawnMsgNode *CreateBenchmarkMsg(uint32_t bodyLen)
+{
+    AppSpawnMsgNode *message = CreateAppSpawnMsg();
+    if (message == nullptr) {
+        return nullptr;
+    }
+    message->msgHeader.magic = APPSPAWN_MSG_MAGIC;
+    message->msgHeader.msgType = MSG_APP_SPAWN;
+    message->msgHeader.msgLen = sizeof(AppSpawnMsg) + bodyLen;
+    message->msgHeader.msgId = 1;
+    message->msgHeader.tlvCount = 0;
+    (void)strcpy_s(message->msgHeader.processName, sizeof(message->msgHeader.processName), "com.example.bench");
+    message->buffer = static_cast<uint8_t *>(calloc(1, bodyLen));
+    if (message->buffer == nullptr) {
+        DeleteAppSpawnMsg(&message);
+        return nullptr;
+    }
+    (void)memset_s(message->buffer, bodyLen, 'a', bodyLen);
+    return message;
+}
+
+// Receiver side shared by both paths: rebuild the message node from the mapped buffer
+bool ParseMappedMsg(const uint8_t *buffer)
+{
+    uint32_t msgRecvLen = 0;
+    uint32_t remainLen = 0;
+    AppSpawnMsgNode *message = nullptr;
+    int ret = GetAppSpawnMsgFromBuffer(buffer, reinterpret_cast<const AppSpawnMsg *>(buffer)->msgLen,
+        &message, &msgRecvLen, &remainLen);
+    DeleteAppSpawnMsg(&message);
+    return ret == 0;
+}
+
+// Mirrors GetMapMem + WritePreforkMsg on the sender and GetMapMem(readOnly) + unlink on the receiver
+bool FileHandoff(const AppSpawnMsgNode *message)
+{
+    const uint32_t memSize = (message->msgHeader.msgLen / MSG_BLOCK_LEN + 1) * MSG_BLOCK_LEN;
+    int fd = open(g_msgFile, O_CREAT | O_RDWR | O_TRUNC, S_IRWXU);
+    if (fd < 0) {
+        return false;
+    }
+    if (fallocate(fd, 0, 0, memSize) != 0) {
+        close(fd);
+        return false;
+    }
+    void *addr = mmap(nullptr, memSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+    uint8_t *buffer = static_cast<uint8_t *>(addr);
+    (void)memcpy_s(buffer, memSize, &message->msgHeader, sizeof(AppSpawnMsg));
+    (void)memcpy_s(buffer + sizeof(AppSpawnMsg), memSize - sizeof(AppSpawnMsg),
+        message->buffer, message->msgHeader.msgLen - sizeof(AppSpawnMsg));
+    munmap(addr, memSize);
+
+    fd = open(g_msgFile, O_RDONLY, S_IRWXU);
+    if (fd < 0) {
+        return false;
+    }
+    addr = mmap(nullptr, memSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+    bool ok = ParseMappedMsg(static_cast<uint8_t *>(addr));
+    munmap(addr, memSize);
+    unlink(g_msgFile);
+    return ok;
+}
+
+bool MemfdHandoff(const AppSpawnMsgNode *message)
+{
+    int fd = CreateAppSpawnMsgMemfd(message, "benchmark", false);
+    if (fd < 0) {
+        return false;
+    }
+    uint32_t mapSize = 0;
+    uint8_t *buffer = MapAppSpawnMsgMemfd(fd, &mapSize);
+    if (buffer == nullptr) {
+        close(fd);
+        return false;
+    }
+    bool ok = ParseMappedMsg(buffer);
+    munmap(buffer, mapSize);
+    close(fd);
+    return ok;
+}
+
+void BM_MsgHandoffFile(benchmark::State &state)
+{
+    (void)MakeDirRec(APPSPAWN_MSG_DIR "appspawn", 0711, 1);  // 0711 default mask
+    AppSpawnMsgNode *message = CreateBenchmarkMsg(static_cast<uint32_t>(state.range(0)));
+    if (message == nullptr) {
+        state.SkipWithError("create msg failed");
+        return;
+    }
+    for (auto _ : state) {
+        if (!FileHandoff(message)) {
+            state.SkipWithError("file handoff failed");
+            break;
+        }
+    }
+    DeleteAppSpawnMsg(&message);
+}
+
+void BM_MsgHandoffMemfd(benchmark::State &state)
+{
+    AppSpawnMsgNode *message = CreateBenchmarkMsg(static_cast<uint32_t>(state.range(0)));
+    if (message == nullptr) {
+        state.SkipWithError("create msg failed");
+        return;
+    }
+    for (auto _ : state) {
+        if (!MemfdHandoff(message)) {
+            state.SkipWithError("memfd handoff failed");
+            break;
+        }
+    }
+    DeleteAppSpawnMsg(&message);
+}
+}  // namespace
+
+// typical spawn messages are a few KB, 60KB is close to MAX_MSG_TOTAL_LENGTH
+BENCHMARK(BM_MsgHandoffFile)->Arg(1024)->Arg(8 * 1024)->Arg(60 * 1024);
+BENCHMARK(BM_MsgHandoffMemfd)->Arg(1024)->Arg(8 * 1024)->Arg(60 * 1024);
+
+BENCHMARK_MAIN();
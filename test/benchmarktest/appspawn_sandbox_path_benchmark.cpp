@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "appspawn_manager.h"
+#include "appspawn_msg.h"
+#include "appspawn_sandbox.h"
+#include "appspawn_utils.h"
+#include "json_utils.h"
+#include "securec.h"
+
+namespace {
+constexpr uint32_t MSG_BUFFER_LEN = 4 * 1024;
+constexpr uint32_t PATH_BUFFER_LEN = 4 * 1024;
+constexpr uint32_t BENCH_UID = 20010029;  // user 100
+const char *g_sandboxConfig = "/system/etc/sandbox/appdata-sandbox.json";
+const char *g_bundleName = "com.example.bench";
+const char *g_rootPath = "/mnt/sandbox/100/com.example.bench";
+
+struct MountPath {
+    std::string source;
+    std::string target;
+    SandboxPathTemplate *sourceTpl;
+    SandboxPathTemplate *targetTpl;
+};
+
+uint32_t AppendTlv(std::vector<uint8_t> &buffer, uint32_t offset, uint16_t type, const void *data, uint32_t len)
+{
+    AppSpawnTlv tlv = {};
+    tlv.tlvType = type;
+    tlv.tlvLen = sizeof(AppSpawnTlv) + APPSPAWN_ALIGN(len);
+    (void)memcpy_s(buffer.data() + offset, buffer.size() - offset, &tlv, sizeof(tlv));
+    (void)memcpy_s(buffer.data() + offset + sizeof(tlv), buffer.size() - offset - sizeof(tlv), data, len);
+    return offset + tlv.tlvLen;
+}
+
+AppSpawnMsgNode *CreateBenchmarkMsg()
+{
+    std::vector<uint8_t> buffer(MSG_BUFFER_LEN);
+    AppSpawnMsg *msg = reinterpret_cast<AppSpawnMsg *>(buffer.data());
+    msg->magic = APPSPAWN_MSG_MAGIC;
+    msg->msgType = MSG_APP_SPAWN;
+    msg->msgId = 1;
+    (void)strcpy_s(msg->processName, sizeof(msg->processName), g_bundleName);
+    uint32_t offset = sizeof(AppSpawnMsg);
+
+    std::vector<uint8_t> bundleInfo(sizeof(AppSpawnMsgBundleInfo) + strlen(g_bundleName) + 1);
+    (void)strcpy_s(reinterpret_cast<AppSpawnMsgBundleInfo *>(bundleInfo.data())->bundleName,
+        strlen(g_bundleName) + 1, g_bundleName);
+    offset = AppendTlv(buffer, offset, TLV_BUNDLE_INFO, bundleInfo.data(), bundleInfo.size());
+    uint32_t flags[] = {1, 0};  // count 1, no flags set
+    offset = AppendTlv(buffer, offset, TLV_MSG_FLAGS, flags, sizeof(flags));
+    AppSpawnMsgDacInfo dacInfo = {};
+    dacInfo.uid = BENCH_UID;
+    dacInfo.gid = BENCH_UID;
+    offset = AppendTlv(buffer, offset, TLV_DAC_INFO, &dacInfo, sizeof(dacInfo));
+    msg->msgLen = offset;
+    msg->tlvCount = 3;  // 3 bundle, flags, dac
+
+    AppSpawnMsgNode *message = nullptr;
+    uint32_t msgRecvLen = 0;
+    uint32_t remainLen = 0;
+    if (GetAppSpawnMsgFromBuffer(buffer.data(), msg->msgLen, &message, &msgRecvLen, &remainLen) != 0 ||
+        DecodeAppSpawnMsg(message) != 0) {
+        DeleteAppSpawnMsg(&message);
+        return nullptr;
+    }
+    return message;
+}
+
+void CollectMountPaths(const cJSON *config, std::vector<MountPath> &paths)
+{
+    if (cJSON_IsObject(config)) {
+        char *source = GetStringFromJsonObj(config, "src-path");
+        char *target = GetStringFromJsonObj(config, "sandbox-path");
+        if (source != nullptr && target != nullptr) {
+            paths.push_back({source, target, nullptr, nullptr});
+        }
+    }
+    const cJSON *child = nullptr;
+    cJSON_ArrayForEach(child, config) {
+        CollectMountPaths(child, paths);
+    }
+}
+
+void FreeTemplates(std::vector<MountPath> &paths)
+{
+    for (auto &path : paths) {
+        free(path.sourceTpl);
+        free(path.targetTpl);
+        path.sourceTpl = nullptr;
+        path.targetTpl = nullptr;
+    }
+}
+
+// mount-path entries of the app sandbox config, deps and unknown variables only expand inside a name group
+std::vector<MountPath> LoadMountPaths()
+{
+    std::vector<MountPath> paths;
+    cJSON *root = GetJsonObjFromFile(g_sandboxConfig);
+    if (root == nullptr) {
+        return paths;
+    }
+    CollectMountPaths(root, paths);
+    cJSON_Delete(root);
+    std::vector<MountPath> result;
+    for (auto &path : paths) {
+        path.sourceTpl = CompileSandboxPathTemplate(path.source.c_str());
+        path.targetTpl = CompileSandboxPathTemplate(path.target.c_str());
+        if (path.sourceTpl == nullptr || path.targetTpl == nullptr ||
+            ((path.sourceTpl->flags | path.targetTpl->flags) & SANDBOX_PATH_TPL_DEP_VAR) != 0) {
+            free(path.sourceTpl);
+            free(path.targetTpl);
+            continue;
+        }
+        result.push_back(path);
+    }
+    return result;
+}
+
+class SandboxPathBench {
+public:
+    SandboxPathBench()
+    {
+        AddDefaultVariable();
+        paths_ = LoadMountPaths();
+        message_ = CreateBenchmarkMsg();
+        (void)memset_s(&context_, sizeof(context_), 0, sizeof(context_));
+        for (uint32_t i = 0; i < MAX_BUFFER; i++) {
+            buffers_[i].resize(PATH_BUFFER_LEN);
+            context_.buffer[i].buffer = buffers_[i].data();
+            context_.buffer[i].bufferLen = PATH_BUFFER_LEN;
+        }
+        context_.bundleName = g_bundleName;
+        context_.message = message_;
+    }
+
+    ~SandboxPathBench()
+    {
+        FreeTemplates(paths_);
+        DeleteAppSpawnMsg(&message_);
+    }
+
+    bool IsValid() const
+    {
+        return message_ != nullptr && !paths_.empty();
+    }
+
+    std::vector<MountPath> paths_;
+    AppSpawnMsgNode *message_ = nullptr;
+    SandboxContext context_;
+    std::vector<char> buffers_[MAX_BUFFER];
+};
+
+// spawn time expansion of every mount source and target by scanning the config string
+void BM_SandboxPathExpandString(benchmark::State &state)
+{
+    SandboxPathBench bench;
+    if (!bench.IsValid()) {
+        state.SkipWithError("load sandbox config failed");
+        return;
+    }
+    for (auto _ : state) {
+        for (const auto &path : bench.paths_) {
+            benchmark::DoNotOptimize(GetSandboxRealVar(&bench.context_,
+                BUFFER_FOR_SOURCE, path.source.c_str(), nullptr, nullptr));
+            benchmark::DoNotOptimize(GetSandboxRealVar(&bench.context_,
+                BUFFER_FOR_TARGET, path.target.c_str(), g_rootPath, nullptr));
+        }
+    }
+    state.counters["paths"] = bench.paths_.size();
+}
+
+// same expansion through the templates compiled at config load
+void BM_SandboxPathExpandTemplate(benchmark::State &state)
+{
+    SandboxPathBench bench;
+    if (!bench.IsValid()) {
+        state.SkipWithError("load sandbox config failed");
+        return;
+    }
+    for (auto _ : state) {
+        for (const auto &path : bench.paths_) {
+            benchmark::DoNotOptimize(GetSandboxRealPath(&bench.context_,
+                BUFFER_FOR_SOURCE, path.sourceTpl, path.source.c_str(), nullptr, nullptr));
+            benchmark::DoNotOptimize(GetSandboxRealPath(&bench.context_,
+                BUFFER_FOR_TARGET, path.targetTpl, path.target.c_str(), g_rootPath, nullptr));
+        }
+    }
+    state.counters["paths"] = bench.paths_.size();
+}
+
+// one time cost of compiling the templates, paid once per config load
+void BM_SandboxPathCompile(benchmark::State &state)
+{
+    SandboxPathBench bench;
+    if (!bench.IsValid()) {
+        state.SkipWithError("load sandbox config failed");
+        return;
+    }
+    for (auto _ : state) {
+        for (const auto &path : bench.paths_) {
+            SandboxPathTemplate *tpl = CompileSandboxPathTemplate(path.source.c_str());
+            benchmark::DoNotOptimize(tpl);
+            free(tpl);
+            tpl = CompileSandboxPathTemplate(path.target.c_str());
+            benchmark::DoNotOptimize(tpl);
+            free(tpl);
+        }
+    }
+}
+}  // namespace
+
+BENCHMARK(BM_SandboxPathExpandString);
+BENCHMARK(BM_SandboxPathExpandTemplate);
+BENCHMARK(BM_SandboxPathCompile);
+
+BENCHMARK_MAIN();
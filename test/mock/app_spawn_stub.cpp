@@ -265,6 +265,51 @@ int GetParameter(const char *key, const char *def, char *value, uint32_t len)
     return -1;
 }
 
+// route cached parameters through the GetParameter stub above, a read re-evaluates the stub every time
+typedef struct {
+    const char *name;
+    const char *defValue;
+    char value[64];  // 64 max
+} StubCachedParameter;
+
+static const char *ReadStubCachedParameter(StubCachedParameter *param, int *changed)
+{
+    char value[sizeof(param->value)] = {0};
+    int ret = GetParameter(param->name, param->defValue, value, sizeof(value));
+    const char *current = ret > 0 ? value : param->defValue;
+    if (changed != nullptr) {
+        *changed = strcmp(current, param->value) != 0;
+    }
+    (void)strcpy_s(param->value, sizeof(param->value), current);
+    return param->value;
+}
+
+CachedHandle CachedParameterCreate(const char *name, const char *defValue)
+{
+    StubCachedParameter *param = reinterpret_cast<StubCachedParameter *>(calloc(1, sizeof(StubCachedParameter)));
+    if (param == nullptr) {
+        return nullptr;
+    }
+    param->name = name;
+    param->defValue = defValue;
+    return reinterpret_cast<CachedHandle>(param);
+}
+
+const char *CachedParameterGet(CachedHandle handle)
+{
+    return ReadStubCachedParameter(reinterpret_cast<StubCachedParameter *>(handle), nullptr);
+}
+
+const char *CachedParameterGetChanged(CachedHandle handle, int *changed)
+{
+    return ReadStubCachedParameter(reinterpret_cast<StubCachedParameter *>(handle), changed);
+}
+
+void CachedParameterDestroy(CachedHandle handle)
+{
+    free(handle);
+}
+
 int InUpdaterMode(void)
 {
     return 0;
@@ -16,8 +16,11 @@
 #include "appmgr_test_helper.h"
 
 #include <cstring>
+#include <string>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <unistd.h>
 #include <vector>
 
@@ -27,6 +30,7 @@
 #include "appspawn.h"
 #include "appspawn_hook.h"
 #include "appspawn_manager.h"
+#include "appspawn_param_cache.h"
 #include "appspawn_modulemgr.h"
 #include "appspawn_utils.h"
 
@@ -239,6 +243,45 @@ HWTEST_F(AppSpawnAppMgrTest, App_Spawn_AppSpawnedProcess_003, TestSize.Level0)
     DeleteAppSpawnMgr(mgr);
 }
 
+static void TestAppOrderTraversal(const AppSpawnMgr *mgr, AppSpawnedProcess *appInfo, void *data)
+{
+    pid_t *lastPid = reinterpret_cast<pid_t *>(data);
+    EXPECT_GE(appInfo->pid, *lastPid);
+    *lastPid = appInfo->pid;
+}
+
+HWTEST_F(AppSpawnAppMgrTest, App_Spawn_AppSpawnedProcess_004, TestSize.Level0)
+{
+    AppSpawnMgr *mgr = CreateAppSpawnMgr(MODE_FOR_APP_SPAWN);
+    ASSERT_NE(mgr, nullptr);
+    const pid_t pidCount = 500;  // 500 more than the initial index capacity
+    for (pid_t i = 0; i < pidCount; i++) {
+        pid_t pid = (i * 7) % pidCount + 1;  // 7 out of order, 1 ~ 500
+        std::string name = "app_" + std::to_string(pid);
+        EXPECT_NE(AddSpawnedProcess(pid, name.c_str(), 0, false, 0), nullptr);
+    }
+    EXPECT_EQ(mgr->pidIndex.count, pidCount);
+    EXPECT_EQ(mgr->nameIndex.count, pidCount);
+
+    // remove odd pids, the index must stay consistent after backward shift deletion
+    for (pid_t pid = 1; pid <= pidCount; pid += 2) {  // 2 odd pids
+        TerminateSpawnedProcess(GetSpawnedProcess(pid));
+    }
+    for (pid_t pid = 1; pid <= pidCount; pid++) {
+        std::string name = "app_" + std::to_string(pid);
+        AppSpawnedProcess *app = GetSpawnedProcess(pid);
+        EXPECT_EQ(app != nullptr, pid % 2 == 0);  // 2 even pids left
+        EXPECT_EQ(GetSpawnedProcessByName(name.c_str()), app);
+    }
+    EXPECT_EQ(GetSpawnedProcess(pidCount + 1), nullptr);
+    EXPECT_EQ(OH_ListGetCnt(&mgr->appQueue), pidCount / 2);  // 2 half left
+
+    pid_t lastPid = 0;
+    TraversalSpawnedProcess(TestAppOrderTraversal, &lastPid);
+    EXPECT_EQ(lastPid, pidCount);
+    DeleteAppSpawnMgr(mgr);
+}
+
 /**
  * @brief AppSpawningCtx
  *
@@ -757,6 +800,122 @@ HWTEST_F(AppSpawnAppMgrTest, App_Spawn_AppSpawnMsg_002, TestSize.Level0)
     DeleteAppSpawnMgr(mgr);
 }
 
+HWTEST_F(AppSpawnAppMgrTest, App_Spawn_AppSpawnMsg_ExtIndex, TestSize.Level0)
+{
+    AppMgrTestHelper testHelper;
+    std::vector<uint8_t> buffer(1024 * 4);  // 1024 * 4  max buffer
+    uint32_t msgLen = 0;
+    int ret = testHelper.AppMgrTestCreateSendMsg(buffer, MSG_APP_SPAWN, msgLen, {
+        [&](uint8_t *buffer, uint32_t bufferLen, uint32_t &realLen, uint32_t &tlvCount) -> int {
+            return testHelper.AppMgrTestAddBaseTlv(buffer, bufferLen, realLen, tlvCount);
+        },
+        [&](uint8_t *buffer, uint32_t bufferLen, uint32_t &realLen, uint32_t &tlvCount) -> int {
+            for (int i = 0; i < 20; i++) {  // 20 ext tlv
+                std::string name = "ext-" + std::to_string(i);
+                APPSPAWN_CHECK_ONLY_EXPER(testHelper.AppMgrTestAppendExtTlv(buffer, bufferLen, realLen, tlvCount,
+                    name.c_str(), name.c_str()) == 0, return -1);
+            }
+            APPSPAWN_CHECK_ONLY_EXPER(testHelper.AppMgrTestAppendExtTlv(buffer, bufferLen, realLen, tlvCount,
+                "dup", "first") == 0, return -1);
+            APPSPAWN_CHECK_ONLY_EXPER(testHelper.AppMgrTestAppendExtTlv(buffer, bufferLen, realLen, tlvCount,
+                "dup", "second") == 0, return -1);
+            APPSPAWN_CHECK_ONLY_EXPER(testHelper.AppMgrTestAppendExtTlv(buffer, bufferLen, realLen, tlvCount,
+                MSG_EXT_NAME_PROCESS_TYPE, "render") == 0, return -1);
+            return testHelper.AppMgrTestAppendExtTlv(buffer, bufferLen, realLen, tlvCount,
+                MSG_EXT_NAME_RENDER_CMD, "--type=render");
+        }
+    });
+    ASSERT_EQ(0, ret);
+
+    AppSpawnMsgNode *outMsg = nullptr;
+    uint32_t msgRecvLen = 0;
+    uint32_t reminder = 0;
+    ret = GetAppSpawnMsgFromBuffer(buffer.data(), msgLen, &outMsg, &msgRecvLen, &reminder);
+    ASSERT_EQ(0, ret);
+    ret = DecodeAppSpawnMsg(outMsg);
+    EXPECT_EQ(0, ret);
+    ASSERT_NE(outMsg->extSlots, nullptr);
+    EXPECT_GE(outMsg->extSlotCount, outMsg->tlvCount * 2);  // 2 load factor <= 1/2
+
+    for (int i = 0; i < 20; i++) {  // 20 ext tlv
+        std::string name = "ext-" + std::to_string(i);
+        uint32_t len = 0;
+        const char *info = reinterpret_cast<const char *>(GetAppSpawnMsgExtInfo(outMsg, name.c_str(), &len));
+        ASSERT_NE(info, nullptr);
+        EXPECT_STREQ(info, name.c_str());
+        EXPECT_EQ(len, name.size() + 1);
+    }
+    EXPECT_STREQ(reinterpret_cast<const char *>(GetAppSpawnMsgExtInfo(outMsg, "dup", nullptr)), "first");
+    EXPECT_EQ(GetAppSpawnMsgExtInfo(outMsg, "ext-20", nullptr), nullptr);
+    EXPECT_STREQ(reinterpret_cast<const char *>(GetAppSpawnMsgKnownExtInfo(outMsg, EXT_TLV_ID_PROCESS_TYPE, nullptr)),
+        "render");
+    EXPECT_STREQ(reinterpret_cast<const char *>(GetAppSpawnMsgKnownExtInfo(outMsg, EXT_TLV_ID_RENDER_CMD, nullptr)),
+        "--type=render");
+    EXPECT_EQ(GetAppSpawnMsgKnownExtInfo(outMsg, EXT_TLV_ID_HSP_LIST, nullptr), nullptr);
+    EXPECT_EQ(GetAppSpawnMsgKnownExtInfo(outMsg, EXT_TLV_ID_MAX, nullptr), nullptr);
+
+    // without index, same result from sequential lookup
+    outMsg->extSlots = nullptr;
+    outMsg->knownExtOffset = nullptr;
+    EXPECT_STREQ(reinterpret_cast<const char *>(GetAppSpawnMsgExtInfo(outMsg, "dup", nullptr)), "first");
+    EXPECT_STREQ(reinterpret_cast<const char *>(GetAppSpawnMsgKnownExtInfo(outMsg, EXT_TLV_ID_PROCESS_TYPE, nullptr)),
+        "render");
+    DeleteAppSpawnMsg(&outMsg);
+}
+
+HWTEST_F(AppSpawnAppMgrTest, App_Spawn_AppSpawnMsg_Arena, TestSize.Level0)
+{
+    AppSpawnMgr *mgr = CreateAppSpawnMgr(MODE_FOR_APP_SPAWN);
+    ASSERT_NE(mgr, nullptr);
+    AppMgrTestHelper testHelper;
+    std::vector<uint8_t> buffer(1024);  // 1024  max buffer
+    uint32_t msgLen = 0;
+    int ret = testHelper.AppMgrTestCreateSendMsg(buffer, MSG_APP_SPAWN, msgLen, {
+        [&](uint8_t *buffer, uint32_t bufferLen, uint32_t &realLen, uint32_t &tlvCount) -> int {
+            return testHelper.AppMgrTestAddBaseTlv(buffer, bufferLen, realLen, tlvCount);
+        }
+    });
+    ASSERT_EQ(0, ret);
+
+    // node, buffer, tlvOffset and ext index are in one block
+    AppSpawnMsgNode *outMsg = nullptr;
+    uint32_t msgRecvLen = 0;
+    uint32_t reminder = 0;
+    ret = GetAppSpawnMsgFromBuffer(buffer.data(), msgLen, &outMsg, &msgRecvLen, &reminder);
+    ASSERT_EQ(0, ret);
+    EXPECT_EQ(0, DecodeAppSpawnMsg(outMsg));
+    EXPECT_EQ(outMsg->arenaSize, static_cast<uint32_t>(MSG_ARENA_BLOCK_SIZE));
+    uint8_t *start = reinterpret_cast<uint8_t *>(outMsg);
+    uint8_t *end = start + outMsg->arenaSize;
+    EXPECT_TRUE(outMsg->buffer > start && outMsg->buffer < end);
+    EXPECT_TRUE(reinterpret_cast<uint8_t *>(outMsg->extSlots + outMsg->extSlotCount) <= end);
+    EXPECT_NE(GetAppSpawnMsgInfo(outMsg, TLV_MSG_FLAGS), nullptr);
+
+    // the block is recycled for the next message
+    AppSpawnMsgNode *oldMsg = outMsg;
+    DeleteAppSpawnMsg(&outMsg);
+    EXPECT_EQ(mgr->idleMsgArenaCount, 1u);
+    msgRecvLen = 0;
+    ret = GetAppSpawnMsgFromBuffer(buffer.data(), msgLen, &outMsg, &msgRecvLen, &reminder);
+    ASSERT_EQ(0, ret);
+    EXPECT_EQ(outMsg, oldMsg);
+    EXPECT_EQ(mgr->idleMsgArenaCount, 0u);
+    EXPECT_EQ(0, DecodeAppSpawnMsg(outMsg));
+    DeleteAppSpawnMsg(&outMsg);
+
+    // spawning ctx is recycled too
+    AppSpawningCtx *property = CreateAppSpawningCtx();
+    ASSERT_NE(property, nullptr);
+    AppSpawningCtx *oldProperty = property;
+    DeleteAppSpawningCtx(property);
+    EXPECT_EQ(mgr->idleSpawningCtxCount, 1u);
+    property = CreateAppSpawningCtx();
+    EXPECT_EQ(property, oldProperty);
+    EXPECT_EQ(property->message, nullptr);
+    DeleteAppSpawningCtx(property);
+    DeleteAppSpawnMgr(mgr);
+}
+
 HWTEST_F(AppSpawnAppMgrTest, App_Spawn_AppSpawnMsg_003, TestSize.Level0)
 {
     AppSpawnMgr *mgr = CreateAppSpawnMgr(MODE_FOR_NWEB_SPAWN);
@@ -1159,6 +1318,202 @@ HWTEST_F(AppSpawnAppMgrTest, App_Spawn_AppSpawningCtx_Msg_007, TestSize.Level0)
     DeleteAppSpawningCtx(appCtx);
 }
 
+/**
+ * @brief 通过密封memfd传递消息：写入、密封、只读映射后可还原完整消息，且无法再写入
+ *
+ */
+HWTEST_F(AppSpawnAppMgrTest, App_Spawn_AppSpawnMsg_Memfd_001, TestSize.Level0)
+{
+    AppMgrTestHelper testHelper;
+    std::vector<uint8_t> buffer(1024);  // 1024  max buffer
+    uint32_t msgLen = 0;
+    int ret = testHelper.AppMgrTestCreateSendMsg(buffer, MSG_APP_SPAWN, msgLen, {
+        [&](uint8_t *buffer, uint32_t bufferLen, uint32_t &realLen, uint32_t &tlvCount) -> int {
+            return testHelper.AppMgrTestAddBaseTlv(buffer, bufferLen, realLen, tlvCount);
+        }
+    });
+    EXPECT_EQ(0, ret);
+    AppSpawnMsgNode *inMsg = nullptr;
+    uint32_t msgRecvLen = 0;
+    uint32_t reminder = 0;
+    ret = GetAppSpawnMsgFromBuffer(buffer.data(), msgLen, &inMsg, &msgRecvLen, &reminder);
+    EXPECT_EQ(0, ret);
+
+    int fd = CreateAppSpawnMsgMemfd(inMsg, "prefork", false);
+    EXPECT_GE(fd, 0);
+    EXPECT_EQ(write(fd, buffer.data(), 1), -1);  // sealed
+    uint32_t mapSize = 0;
+    uint8_t *mapped = MapAppSpawnMsgMemfd(fd, &mapSize);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(mapSize, msgLen);
+    EXPECT_EQ(memcmp(buffer.data(), mapped, msgLen), 0);
+
+    AppSpawnMsgNode *outMsg = nullptr;
+    msgRecvLen = 0;
+    ret = GetAppSpawnMsgFromBuffer(mapped, mapSize, &outMsg, &msgRecvLen, &reminder);
+    EXPECT_EQ(0, ret);
+    EXPECT_EQ(0, DecodeAppSpawnMsg(outMsg));
+    munmap(mapped, mapSize);
+    close(fd);
+    DeleteAppSpawnMsg(&outMsg);
+    DeleteAppSpawnMsg(&inMsg);
+}
+
+/**
+ * @brief 未密封的memfd或普通文件不能作为消息来源
+ *
+ */
+HWTEST_F(AppSpawnAppMgrTest, App_Spawn_AppSpawnMsg_Memfd_002, TestSize.Level0)
+{
+    EXPECT_EQ(CreateAppSpawnMsgMemfd(nullptr, "prefork", false), -1);
+    uint32_t mapSize = 0;
+    EXPECT_EQ(MapAppSpawnMsgMemfd(-1, &mapSize), nullptr);
+
+    int fd = memfd_create("unsealed", MFD_CLOEXEC);
+    EXPECT_GE(fd, 0);
+    std::vector<uint8_t> buffer(sizeof(AppSpawnMsg) + 16);  // 16 tlv body
+    EXPECT_EQ(write(fd, buffer.data(), buffer.size()), static_cast<ssize_t>(buffer.size()));
+    EXPECT_EQ(MapAppSpawnMsgMemfd(fd, &mapSize), nullptr);
+    close(fd);
+}
+
+/**
+ * @brief 子进程阶段耗时汇总：按阶段与 stage + prio 聚合，未执行的阶段不计数
+ *
+ */
+HWTEST_F(AppSpawnAppMgrTest, App_Spawn_ChildTimingStat_001, TestSize.Level0)
+{
+    AppSpawnMgr *mgr = CreateAppSpawnMgr(MODE_FOR_APP_SPAWN);
+    ASSERT_NE(mgr, nullptr);
+    AppSpawnChildTiming timing = {};
+    timing.stageCostUs[STAGE_CHILD_EXECUTE - CHILD_TIMING_STAGE_BEGIN] = 300;  // 300 us
+    timing.hookCount = 2;  // 2 hooks
+    timing.hooks[0] = { STAGE_CHILD_EXECUTE, HOOK_PRIO_SANDBOX, 200, 0 };  // 200 us
+    timing.hooks[1] = { STAGE_CHILD_EXECUTE, HOOK_PRIO_PROPERTY, 100, 0 };  // 100 us
+    AddChildTimingStat(mgr, &timing);
+    timing.stageCostUs[STAGE_CHILD_EXECUTE - CHILD_TIMING_STAGE_BEGIN] = 500;  // 500 us
+    timing.hooks[0].costUs = 400;  // 400 us
+    AddChildTimingStat(mgr, &timing);
+    AddChildTimingStat(mgr, nullptr);
+
+    const ChildTimingStat *stat = &mgr->childTimingStat;
+    EXPECT_EQ(stat->stage[STAGE_CHILD_PRE_COLDBOOT - CHILD_TIMING_STAGE_BEGIN].count, 0);
+    EXPECT_EQ(stat->stage[STAGE_CHILD_EXECUTE - CHILD_TIMING_STAGE_BEGIN].count, 2);
+    EXPECT_EQ(stat->stage[STAGE_CHILD_EXECUTE - CHILD_TIMING_STAGE_BEGIN].maxUs, 500);
+    EXPECT_EQ(stat->stage[STAGE_CHILD_EXECUTE - CHILD_TIMING_STAGE_BEGIN].totalUs, 800);
+    EXPECT_EQ(stat->hookCount, 2);
+    EXPECT_EQ(stat->hooks[0].prio, HOOK_PRIO_SANDBOX);
+    EXPECT_EQ(stat->hooks[0].cost.count, 2);
+    EXPECT_EQ(stat->hooks[0].cost.maxUs, 400);
+    EXPECT_EQ(stat->hooks[1].cost.totalUs, 200);
+
+    AppSpawnMsgNode *message = CreateAppSpawnMsg();
+    ASSERT_NE(message, nullptr);
+    ProcessAppSpawnDumpMsg(message);
+    DeleteAppSpawnMsg(&message);
+    DeleteAppSpawnMgr(mgr);
+}
+
+/**
+ * @brief 沙盒挂载统计汇总：按 section、挂载类别和系统调用累加，未构建沙盒的孵化不计数
+ *
+ */
+HWTEST_F(AppSpawnAppMgrTest, App_Spawn_ChildTimingStat_002, TestSize.Level0)
+{
+    AppSpawnMgr *mgr = CreateAppSpawnMgr(MODE_FOR_APP_SPAWN);
+    ASSERT_NE(mgr, nullptr);
+    AppSpawnChildTiming timing = {};
+    AddChildTimingStat(mgr, &timing);  // no sandbox
+    EXPECT_EQ(mgr->childTimingStat.sandboxCount, 0);
+
+    timing.sandbox.section[SANDBOX_STAT_SECTION_PERMISSION] = { 3, 2, 1, 4 };  // 3 attempted, 2 ok, 1 fail, 4 skip
+    timing.sandbox.category[1] = { 3, 2, 1, 4 };  // category 1 rdonly
+    timing.sandbox.opCount[SANDBOX_STAT_OP_MOUNT] = 3;  // 3 mounts
+    timing.sandbox.opCostNs[SANDBOX_STAT_OP_MOUNT] = 9000;  // 9000 ns
+    AddChildTimingStat(mgr, &timing);
+    AddChildTimingStat(mgr, &timing);
+
+    const ChildTimingStat *stat = &mgr->childTimingStat;
+    EXPECT_EQ(stat->sandboxCount, 2);
+    EXPECT_EQ(stat->sandbox.section[SANDBOX_STAT_SECTION_PERMISSION].attempted, 6);
+    EXPECT_EQ(stat->sandbox.section[SANDBOX_STAT_SECTION_PERMISSION].failed, 2);
+    EXPECT_EQ(stat->sandbox.section[SANDBOX_STAT_SECTION_PERMISSION].skipped, 8);
+    EXPECT_EQ(stat->sandbox.section[SANDBOX_STAT_SECTION_APP_VARIABLE].attempted, 0);
+    EXPECT_EQ(stat->sandbox.category[1].succeeded, 4);
+    EXPECT_EQ(stat->sandbox.opCount[SANDBOX_STAT_OP_MOUNT], 6);
+    EXPECT_EQ(stat->sandbox.opCostNs[SANDBOX_STAT_OP_MOUNT], 18000);
+
+    AppSpawnMsgNode *message = CreateAppSpawnMsg();
+    ASSERT_NE(message, nullptr);
+    ProcessAppSpawnDumpMsg(message);
+    DeleteAppSpawnMsg(&message);
+    DeleteAppSpawnMgr(mgr);
+}
+
+HWTEST_F(AppSpawnAppMgrTest, App_Spawn_SpawnLatency_001, TestSize.Level0)
+{
+    EXPECT_EQ(GetSpawnLatencyBucket(3), 3);  // 3 us, exact bucket
+    EXPECT_EQ(GetSpawnLatencyBucket(8), GetSpawnLatencyBucket(9));  // 8 ~ 9 us share one bucket
+    EXPECT_EQ(GetSpawnLatencyBucketMax(GetSpawnLatencyBucket(1000)), 1023);  // 1000 us in [896, 1023]
+    EXPECT_EQ(GetSpawnLatencyBucket(UINT32_MAX), SPAWN_HIST_BUCKET_COUNT - 1);
+
+    AppSpawnMgr *mgr = CreateAppSpawnMgr(MODE_FOR_APP_SPAWN);
+    ASSERT_NE(mgr, nullptr);
+    for (uint32_t i = 1; i <= 100; i++) {  // 100 samples, 1000 ~ 100000 us
+        AddSpawnLatency(mgr, SPAWN_LATENCY_PREFORK, true, MSG_APP_SPAWN, i * 1000);  // 1000 us step
+    }
+    AddSpawnLatency(mgr, SPAWN_LATENCY_COLD_RUN, false, MAX_TYPE_INVALID, 5000);  // 5000 us
+    AddSpawnLatency(mgr, SPAWN_LATENCY_MODE_MAX, false, MSG_APP_SPAWN, 5000);  // invalid mode, 5000 us
+
+    const SpawnLatencyStat *stat = &mgr->latencyStat;
+    EXPECT_EQ(stat->mode[SPAWN_LATENCY_FORK].count, 0);
+    EXPECT_EQ(stat->mode[SPAWN_LATENCY_PREFORK].count, 100);
+    EXPECT_EQ(stat->mode[SPAWN_LATENCY_PREFORK].maxUs, 100000);
+    EXPECT_EQ(stat->mode[SPAWN_LATENCY_COLD_RUN].count, 1);
+    EXPECT_EQ(stat->phase[0].count, 1);
+    EXPECT_EQ(stat->phase[1].count, 100);
+    EXPECT_EQ(stat->msgType[MSG_APP_SPAWN].count, 100);
+    // percentiles are bucket upper bounds, within 25% of the real value
+    uint32_t p50 = GetSpawnLatencyPercentile(&stat->mode[SPAWN_LATENCY_PREFORK], 500);  // 500: p50
+    EXPECT_GE(p50, 50000);
+    EXPECT_LE(p50, 62500);
+    uint32_t p99 = GetSpawnLatencyPercentile(&stat->mode[SPAWN_LATENCY_PREFORK], 990);  // 990: p99
+    EXPECT_GE(p99, 99000);
+    EXPECT_LE(p99, 100000);
+    EXPECT_EQ(GetSpawnLatencyPercentile(&stat->mode[SPAWN_LATENCY_FORK], 500), 0);  // 500: p50
+
+    AppSpawnMsgNode *message = CreateAppSpawnMsg();
+    ASSERT_NE(message, nullptr);
+    ProcessAppSpawnDumpMsg(message);
+    DeleteAppSpawnMsg(&message);
+    DeleteAppSpawnMgr(mgr);
+}
+
+HWTEST_F(AppSpawnAppMgrTest, App_Spawn_ParamCache_001, TestSize.Level0)
+{
+    DestroyParamCache();
+    EXPECT_EQ(GetCachedParameter(APPSPAWN_PARAM_MAX), nullptr);
+    const char *value = GetCachedParameter(APPSPAWN_PARAM_BOOT_COMPLETED);
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(IsCachedParameterTrue(APPSPAWN_PARAM_BOOT_COMPLETED), strcmp(value, "true") == 0);
+    const AppSpawnParamCacheStat *stat = GetParamCacheStat();
+    EXPECT_EQ(stat->lookups, 1);
+    EXPECT_EQ(stat->cacheHits, 1);
+
+    AddParamCacheSpawnCount();
+    EXPECT_EQ(stat->spawnCount, 1);
+    EXPECT_GE(GetCachedSpawnTimeout(5, false), 5);  // 5 default timeout
+    EXPECT_GE(GetCachedSpawnTimeout(5, true), 5);  // 5 default timeout
+    EXPECT_EQ(stat->lookups, 3);  // 3 first read of three parameters
+
+    EXPECT_EQ(ParseSpawnTimeout(nullptr, 5), 5);  // 5 default timeout
+    EXPECT_EQ(ParseSpawnTimeout("0", 5), 5);  // 5 default timeout
+    EXPECT_EQ(ParseSpawnTimeout("3", 5), 5);  // 3 less than default 5
+    EXPECT_EQ(ParseSpawnTimeout("8", 5), 8);  // 8 larger than default 5
+    DestroyParamCache();
+    EXPECT_EQ(stat->spawnCount, 0);
+}
+
 HWTEST_F(AppSpawnAppMgrTest, App_Spawn_RebuildAppSpawnMsgNode, TestSize.Level0)
 {
     AppSpawnMsgNode *msgNode = CreateAppSpawnMsg();
@@ -1194,4 +1549,42 @@ HWTEST_F(AppSpawnAppMgrTest, App_Spawn_KillAndWaitStatus, TestSize.Level0)
     ret = KillAndWaitStatus(pid, sig, &exitStatus);
     EXPECT_EQ(-1, ret);
 }
+
+HWTEST_F(AppSpawnAppMgrTest, App_Spawn_ReapTerminatedProcess, TestSize.Level0)
+{
+    AppSpawnMgr *mgr = CreateAppSpawnMgr(MODE_FOR_NWEB_SPAWN);
+    ASSERT_NE(mgr, nullptr);
+    int exitStatus = 0;
+    EXPECT_EQ(ReapTerminatedProcess(9999999, &exitStatus), -1);  // 9999999 not a child
+    EXPECT_EQ(exitStatus, -1);
+    EXPECT_EQ(ReapTerminatedProcess(9999999, nullptr), -1);  // 9999999 not a child
+
+    // reaped by SIGCHLD first, status from died queue
+    AppSpawnedProcess *app = AddSpawnedProcess(9999998, "render1", 0, false, 0);  // 9999998 test pid
+    ASSERT_NE(app, nullptr);
+    app->exitStatus = 9;  // 9 test status
+    TerminateSpawnedProcess(app);
+    EXPECT_EQ(ReapTerminatedProcess(9999998, &exitStatus), 0);  // 9999998 test pid
+    EXPECT_EQ(exitStatus, 9);  // 9 test status
+    EXPECT_EQ(mgr->diedAppCount, 0);
+
+    // reaped by the pid fd watcher
+    pid_t pid = fork();
+    if (pid == 0) {
+        _exit(3);  // 3 test exit code
+    }
+    ASSERT_GT(pid, 0);
+    app = AddSpawnedProcess(pid, "render2", 0, false, 0);
+    ASSERT_NE(app, nullptr);
+    int ret = -1;
+    for (int i = 0; i < 1000 && ret != 0; i++) {  // 1000 retry
+        ret = ReapTerminatedProcess(pid, &exitStatus);
+        APPSPAWN_ONLY_EXPER(ret != 0, usleep(1000));  // 1000 1ms
+    }
+    EXPECT_EQ(ret, 0);
+    EXPECT_TRUE(WIFEXITED(exitStatus));
+    EXPECT_EQ(WEXITSTATUS(exitStatus), 3);  // 3 test exit code
+    EXPECT_EQ(GetSpawnedProcess(pid), nullptr);
+    DeleteAppSpawnMgr(mgr);
+}
 }  // namespace OHOS
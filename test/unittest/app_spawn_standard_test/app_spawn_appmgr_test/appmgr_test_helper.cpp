@@ -147,6 +147,26 @@ int AppMgrTestHelper::AppMgrTestAddExtTlv(uint8_t *buffer, uint32_t bufferLen, u
     return 0;
 }
 
+int AppMgrTestHelper::AppMgrTestAppendExtTlv(uint8_t *buffer, uint32_t bufferLen, uint32_t &realLen,
+    uint32_t &tlvCount, const char *name, const char *data)
+{
+    AppSpawnTlvExt tlv = {};
+    tlv.tlvType = TLV_MAX;
+    int ret = strcpy_s(tlv.tlvName, sizeof(tlv.tlvName), name);
+    APPSPAWN_CHECK(ret == 0, return -1, "Failed to strcpy");
+    tlv.dataLen = strlen(data) + 1;
+    tlv.tlvLen = sizeof(AppSpawnTlvExt) + APPSPAWN_ALIGN(tlv.dataLen);
+    APPSPAWN_CHECK(realLen + tlv.tlvLen <= bufferLen, return -1, "No space for tlv %{public}s", name);
+
+    ret = memcpy_s(buffer + realLen, bufferLen - realLen, &tlv, sizeof(tlv));
+    APPSPAWN_CHECK(ret == 0, return -1, "Failed to memcpy_s bufferSize");
+    ret = memcpy_s(buffer + realLen + sizeof(tlv), bufferLen - realLen - sizeof(tlv), data, tlv.dataLen);
+    APPSPAWN_CHECK(ret == 0, return -1, "Failed to memcpy_s bufferSize");
+    realLen += tlv.tlvLen;
+    tlvCount++;
+    return 0;
+}
+
 void AppMgrTestHelper::AppMgrTestSetDefaultData()
 {
     processName_ = std::string("com.example.myapplication");
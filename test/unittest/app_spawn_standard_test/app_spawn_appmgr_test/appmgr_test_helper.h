@@ -43,6 +43,9 @@ public:
     int AppMgrTestAddBaseTlv(uint8_t *buffer, uint32_t bufferLen, uint32_t &realLen, uint32_t &tlvCount);
     int AppMgrTestAddRenderTerminationTlv(uint8_t *buffer, uint32_t bufferLen, uint32_t &realLen, uint32_t &tlvCount);
     int AppMgrTestAddExtTlv(uint8_t *buffer, uint32_t bufferLen, uint32_t &realLen, uint32_t &tlvCount);
+    // append one ext tlv at buffer + realLen
+    int AppMgrTestAppendExtTlv(uint8_t *buffer, uint32_t bufferLen, uint32_t &realLen, uint32_t &tlvCount,
+        const char *name, const char *data);
     static void SignalHandle(int sig);
 
 private:
@@ -285,15 +285,13 @@ HWTEST_F(AppSpawnCGroupTest, App_Spawn_CGroup_006, TestSize.Level0)
         ret = WriteToFile(path, 0, pids, 3);
         APPSPAWN_CHECK_ONLY_EXPER(ret == 0, break);
 
-        AppSpawnedProcess *appInfo2 = CreateTestAppInfo(name);
+        AppSpawnedProcess *appInfo2 = AddSpawnedProcess(102, name, 0, false, 0);  // 102 pid in same cgroup
         APPSPAWN_CHECK(appInfo2 != nullptr, break, "Failed to create appInfo");
-        OH_ListAddTail(&GetAppSpawnMgr()->appQueue, &appInfo2->node);
-        appInfo2->pid = 102;
+        appInfo2->uid = appInfo->uid;
         ProcessMgrHookExecute(STAGE_SERVER_APP_ADD, content, appInfo2);
         // died
         ProcessMgrHookExecute(STAGE_SERVER_APP_DIED, content, appInfo);
-        OH_ListRemove(&appInfo2->node);
-        free(appInfo2);
+        TerminateSpawnedProcess(appInfo2);
     } while (0);
     if (appInfo) {
         free(appInfo);
@@ -674,6 +674,74 @@ HWTEST_F(AppSpawnSandboxTest, App_Spawn_Variable_009, TestSize.Level0)
     DeleteAppSpawningCtx(spawningCtx);
 }
 
+/**
+ * @brief 测试deps变量优先取本次孵化展开的路径
+ *
+ */
+HWTEST_F(AppSpawnSandboxTest, App_Spawn_Variable_011, TestSize.Level0)
+{
+    AppSpawningCtx *spawningCtx = TestCreateAppSpawningCtx();
+    SandboxContext *context = TestGetSandboxContext(spawningCtx, 0);
+    ASSERT_EQ(context != nullptr, 1);
+
+    PathMountNode pathNode;
+    pathNode.source = const_cast<char *>("/data/app/el2/<currentUserId>/base");
+    pathNode.target = const_cast<char *>("/data/storage/el2");
+    pathNode.category = MOUNT_TMP_SHRED;
+    SandboxDepPath depPath = {};
+    depPath.source = const_cast<char *>("/data/app/el2/100/base");
+    depPath.target = const_cast<char *>("/data/storage/el2");
+    VarExtraData *extraData = TestGetVarExtraData(context, SANDBOX_TAG_NAME_GROUP, &pathNode);
+    extraData->depPath = &depPath;
+    const char *value = GetSandboxRealVar(context, 0, "<deps-src-path>/base", nullptr, extraData);
+    ASSERT_EQ(value != nullptr, 1);
+    EXPECT_STREQ(value, "/data/app/el2/100/base/base");
+    value = GetSandboxRealVar(context, 0, "<deps-sandbox-path>/base", nullptr, extraData);
+    ASSERT_EQ(value != nullptr, 1);
+    EXPECT_STREQ(value, "/data/storage/el2/base");
+    DeleteSandboxContext(&context);
+    DeleteAppSpawningCtx(spawningCtx);
+}
+
+/**
+ * @brief 测试路径预编译模板，展开结果与字符串替换一致
+ *
+ */
+HWTEST_F(AppSpawnSandboxTest, App_Spawn_Variable_010, TestSize.Level0)
+{
+    AddDefaultVariable();
+    AppSpawningCtx *spawningCtx = TestCreateAppSpawningCtx();
+    SandboxContext *context = TestGetSandboxContext(spawningCtx, 0);
+    ASSERT_EQ(context != nullptr, 1);
+
+    const char *paths[] = {
+        "/data/app/el2/<currentUserId>/log/<PackageName_index>",
+        "/system/<lib>/module",
+        "/system/<param:test.variable.001>/test001",
+        "/data/storage/<variablePackageName>",
+        "<deps-test-path>/base",
+        "/data/storage/el1/bundle",
+    };
+    for (size_t i = 0; i < ARRAY_LENGTH(paths); i++) {
+        SandboxPathTemplate *tpl = CompileSandboxPathTemplate(paths[i]);
+        ASSERT_EQ(tpl != nullptr, 1);
+        const char *real = GetSandboxRealVar(context, 0, paths[i], "/mnt/sandbox/100/", nullptr);
+        ASSERT_EQ(real != nullptr, 1);
+        std::string realPath = real;
+        const char *value = GetSandboxRealPath(context, 0, tpl, paths[i], "/mnt/sandbox/100/", nullptr);
+        APPSPAWN_LOGV("value %{public}s real %{public}s", value, realPath.c_str());
+        ASSERT_EQ(value != nullptr, 1);
+        EXPECT_EQ(realPath, value);
+        bool hasPackageName = strstr(paths[i], "<variablePackageName>") != nullptr;
+        EXPECT_EQ((tpl->flags & SANDBOX_PATH_TPL_PACKAGE_NAME) != 0, hasPackageName);
+        free(tpl);
+    }
+    // 未闭合的变量不编译，回退到字符串替换
+    ASSERT_EQ(CompileSandboxPathTemplate("/system/<lib/module") == nullptr, 1);
+    DeleteSandboxContext(&context);
+    DeleteAppSpawningCtx(spawningCtx);
+}
+
 HWTEST_F(AppSpawnSandboxTest, App_Spawn_Permission_01, TestSize.Level0)
 {
     AppSpawnSandboxCfg *sandbox = nullptr;
@@ -1138,6 +1206,41 @@ HWTEST_F(AppSpawnSandboxTest, App_Spawn_Sandbox_cfg_006, TestSize.Level0)
         DeleteAppSpawnSandbox(sandbox);
     }
 }
+/**
+ * @brief name group依赖挂载在context中展开，不修改配置节点
+ *
+ */
+HWTEST_F(AppSpawnSandboxTest, App_Spawn_Sandbox_cfg_007, TestSize.Level0)
+{
+    AppSpawnSandboxCfg *sandbox = CreateAppSpawnSandbox(EXT_DATA_APP_SANDBOX);
+    ASSERT_NE(sandbox, nullptr);
+    TestParseAppSandboxConfig(sandbox, g_commonConfig.c_str());
+    SandboxNameGroupNode *groupNode = reinterpret_cast<SandboxNameGroupNode *>(
+        GetSandboxSection(&sandbox->nameGroupsQueue, "test-always"));
+    ASSERT_NE(groupNode, nullptr);
+    ASSERT_NE(groupNode->depNode, nullptr);
+    EXPECT_EQ(groupNode->depStatic, 0);
+
+    AppSpawningCtx *spawningCtx = TestCreateAppSpawningCtx();
+    SandboxContext *context = TestGetSandboxContext(spawningCtx, 0);
+    ASSERT_NE(context, nullptr);
+    (void)StagedMountPreUnShare(context, sandbox);
+    EXPECT_STREQ(groupNode->depNode->source, "/data/app/e20/<currentUserId>/base");
+    const SandboxDepPath *depPath = nullptr;
+    for (uint32_t i = 0; i < context->depPathCount; i++) {
+        if (context->depPaths[i].groupNode == groupNode) {
+            depPath = &context->depPaths[i];
+        }
+    }
+    ASSERT_NE(depPath, nullptr);
+    EXPECT_STREQ(depPath->source, "/data/app/e20/100/base");
+    EXPECT_EQ(depPath->mounted, 1);
+
+    DeleteSandboxContext(&context);
+    DeleteAppSpawningCtx(spawningCtx);
+    DeleteAppSpawnSandbox(sandbox);
+}
+
 /**
  * @brief 沙盒执行，能执行到对应的检查项，并且检查通过
  *
@@ -1243,6 +1346,227 @@ HWTEST_F(AppSpawnSandboxTest, App_Spawn_Sandbox_mount_002, TestSize.Level0)
     ASSERT_EQ(ret, 0);
 }
 
+/**
+ * @brief 挂载计划缓存。相同请求复用计划，子进程按计划挂载，清理后计划失效
+ *
+ */
+HWTEST_F(AppSpawnSandboxTest, App_Spawn_Sandbox_MountPlan_001, TestSize.Level0)
+{
+    AppSpawnSandboxCfg *sandbox = nullptr;
+    AppSpawnClientHandle clientHandle = nullptr;
+    AppSpawnReqMsgHandle reqHandle = 0;
+    AppSpawningCtx *property = nullptr;
+    int ret = -1;
+    do {
+        ret = AppSpawnClientInit(APPSPAWN_SERVER_NAME, &clientHandle);
+        APPSPAWN_CHECK(ret == 0, break, "Failed to create reqMgr %{public}s", APPSPAWN_SERVER_NAME);
+        reqHandle = g_testHelper.CreateMsg(clientHandle, MSG_APP_SPAWN, 1);
+        APPSPAWN_CHECK(reqHandle != INVALID_REQ_HANDLE, break, "Failed to create req %{public}s", APPSPAWN_SERVER_NAME);
+
+        ret = APPSPAWN_ARG_INVALID;
+        property = g_testHelper.GetAppProperty(clientHandle, reqHandle);
+        APPSPAWN_CHECK_ONLY_EXPER(property != nullptr, break);
+
+        sandbox = CreateAppSpawnSandbox(EXT_DATA_APP_SANDBOX);
+        APPSPAWN_CHECK_ONLY_EXPER(sandbox != nullptr, break);
+        ret = TestParseAppSandboxConfig(sandbox, g_commonConfig.c_str());
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, break);
+
+        PrepareSandboxMountPlan(sandbox, property, 0);
+        const SandboxMountPlan *plan = sandbox->spawnPlan;
+        ASSERT_NE(plan, nullptr);
+        ASSERT_EQ(sandbox->mountPlanCount, 1);
+        PrepareSandboxMountPlan(sandbox, property, 0);
+        ASSERT_EQ(sandbox->spawnPlan, plan);
+        ASSERT_EQ(sandbox->mountPlanCount, 1);
+        ret = MountSandboxConfigs(sandbox, property, 0);
+
+        ClearSandboxMountPlans(sandbox);
+        ASSERT_EQ(sandbox->spawnPlan, nullptr);
+        ASSERT_EQ(sandbox->mountPlanCount, 0);
+    } while (0);
+    if (sandbox) {
+        DeleteAppSpawnSandbox(sandbox);
+    }
+    DeleteAppSpawningCtx(property);
+    AppSpawnClientDestroy(clientHandle);
+    ASSERT_EQ(ret, 0);
+}
+
+static uint32_t CountAplMountPlanItems(const SandboxMountPlan *plan, uint32_t type)
+{
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < plan->itemCount; i++) {
+        const SandboxMountPlanItem *item = &plan->items[i];
+        if (item->type != type || item->node == nullptr ||
+            (item->node->type != SANDBOX_TAG_MOUNT_PATH && item->node->type != SANDBOX_TAG_MOUNT_FILE)) {
+            continue;
+        }
+        count += (reinterpret_cast<const PathMountNode *>(item->node)->appAplName != nullptr) ? 1 : 0;
+    }
+    return count;
+}
+
+/**
+ * @brief 挂载计划缓存。相同bundle不同apl生成不同计划，被app-apl-name排除的节点不会按缓存计划挂载
+ *
+ */
+HWTEST_F(AppSpawnSandboxTest, App_Spawn_Sandbox_MountPlan_002, TestSize.Level0)
+{
+    AppSpawnSandboxCfg *sandbox = nullptr;
+    AppSpawnClientHandle clientHandle = nullptr;
+    AppSpawningCtx *property = nullptr;
+    AppSpawningCtx *aplProperty = nullptr;
+    int ret = -1;
+    do {
+        ret = AppSpawnClientInit(APPSPAWN_SERVER_NAME, &clientHandle);
+        APPSPAWN_CHECK(ret == 0, break, "Failed to create reqMgr %{public}s", APPSPAWN_SERVER_NAME);
+        AppSpawnReqMsgHandle reqHandle = g_testHelper.CreateMsg(clientHandle, MSG_APP_SPAWN, 1);
+        APPSPAWN_CHECK(reqHandle != INVALID_REQ_HANDLE, break, "Failed to create req %{public}s", APPSPAWN_SERVER_NAME);
+        ret = APPSPAWN_ARG_INVALID;
+        property = g_testHelper.GetAppProperty(clientHandle, reqHandle);
+        APPSPAWN_CHECK_ONLY_EXPER(property != nullptr, break);
+        // 配置中app-apl-name为system的节点对system应用不挂载
+        g_testHelper.SetTestApl("system");
+        reqHandle = g_testHelper.CreateMsg(clientHandle, MSG_APP_SPAWN, 1);
+        g_testHelper.SetTestApl("system_core");
+        APPSPAWN_CHECK(reqHandle != INVALID_REQ_HANDLE, break, "Failed to create req %{public}s", APPSPAWN_SERVER_NAME);
+        aplProperty = g_testHelper.GetAppProperty(clientHandle, reqHandle);
+        APPSPAWN_CHECK_ONLY_EXPER(aplProperty != nullptr, break);
+
+        sandbox = CreateAppSpawnSandbox(EXT_DATA_APP_SANDBOX);
+        APPSPAWN_CHECK_ONLY_EXPER(sandbox != nullptr, break);
+        ret = TestParseAppSandboxConfig(sandbox, g_commonConfig.c_str());
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, break);
+
+        PrepareSandboxMountPlan(sandbox, property, 0);
+        const SandboxMountPlan *plan = sandbox->spawnPlan;
+        ASSERT_NE(plan, nullptr);
+        ASSERT_NE(CountAplMountPlanItems(plan, SANDBOX_PLAN_ITEM_MOUNT), 0u);
+        ret = MountSandboxConfigs(sandbox, property, 0);
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, break);
+
+        PrepareSandboxMountPlan(sandbox, aplProperty, 0);
+        const SandboxMountPlan *aplPlan = sandbox->spawnPlan;
+        ASSERT_NE(aplPlan, nullptr);
+        ASSERT_NE(aplPlan, plan);
+        ASSERT_EQ(sandbox->mountPlanCount, 2);
+        ASSERT_EQ(CountAplMountPlanItems(aplPlan, SANDBOX_PLAN_ITEM_MOUNT), 0u);
+        ASSERT_EQ(CountAplMountPlanItems(aplPlan, SANDBOX_PLAN_ITEM_NODE), CountAplMountPlanItems(plan,
+            SANDBOX_PLAN_ITEM_MOUNT) + CountAplMountPlanItems(plan, SANDBOX_PLAN_ITEM_NODE));
+        ret = MountSandboxConfigs(sandbox, aplProperty, 0);
+    } while (0);
+    if (sandbox) {
+        DeleteAppSpawnSandbox(sandbox);
+    }
+    DeleteAppSpawningCtx(aplProperty);
+    DeleteAppSpawningCtx(property);
+    AppSpawnClientDestroy(clientHandle);
+    ASSERT_EQ(ret, 0);
+}
+
+/**
+ * @brief 沙盒目录缓存。目的路径相对根目录创建，不在根目录下的路径交给调用者
+ *
+ */
+HWTEST_F(AppSpawnSandboxTest, App_Spawn_Sandbox_DirCache_001, TestSize.Level0)
+{
+    const char *rootPath = "/data/local/tmp/appspawn_dir_cache";
+    SandboxContext *context = GetSandboxContext();
+    ASSERT_NE(context, nullptr);
+    CreateSandboxDir(rootPath, FILE_MODE);
+    context->rootPath = strdup(rootPath);
+    ASSERT_NE(context->rootPath, nullptr);
+    int ret = OpenSandboxDirCache(context);
+    ASSERT_EQ(ret, 0);
+
+    struct stat st = {};
+    std::string dirPath = std::string(rootPath) + "/data/storage/el2/base";
+    ASSERT_EQ(CreateSandboxTargetPath(context, dirPath.c_str(), false), true);
+    ASSERT_EQ(stat(dirPath.c_str(), &st), 0);
+    ASSERT_EQ(S_ISDIR(st.st_mode), true);
+    std::string filePath = std::string(rootPath) + "/data/storage/el2/hosts";
+    ASSERT_EQ(CreateSandboxTargetPath(context, filePath.c_str(), true), true);
+    ASSERT_EQ(stat(filePath.c_str(), &st), 0);
+    ASSERT_EQ(S_ISREG(st.st_mode), true);
+
+    // 覆盖挂载后缓存失效，目录按实际情况重新创建
+    (void)rmdir(dirPath.c_str());
+    InvalidateSandboxDirCache(context, (std::string(rootPath) + "/data/storage").c_str());
+    ASSERT_EQ(CreateSandboxTargetPath(context, dirPath.c_str(), false), true);
+    ASSERT_EQ(stat(dirPath.c_str(), &st), 0);
+
+    ASSERT_EQ(CreateSandboxTargetPath(context, "/data/local/tmp/appspawn_dir_cache_other", false), false);
+    DeleteSandboxContext(&context);
+
+    (void)remove(filePath.c_str());
+    const char *dirs[] = {"/data/storage/el2/base", "/data/storage/el2", "/data/storage", "/data", ""};
+    for (const char *dir : dirs) {
+        (void)rmdir((std::string(rootPath) + dir).c_str());
+    }
+}
+
+static int CountSandboxSection(SandboxSection *section, void *data)
+{
+    (*reinterpret_cast<uint32_t *>(data))++;
+    return 0;
+}
+
+/**
+ * @brief 按置位分发section。索引表与遍历队列的结果一致
+ *
+ */
+HWTEST_F(AppSpawnSandboxTest, App_Spawn_Sandbox_SectionTable_001, TestSize.Level0)
+{
+    uint32_t buffer[3] = {2, 0x80000001, 0x4};  // count 2, bit 0 31 34
+    const AppSpawnMsgFlags *msgFlags = reinterpret_cast<const AppSpawnMsgFlags *>(buffer);
+    ASSERT_EQ(GetNextMsgFlagIndex(msgFlags, 0, 64), 0);
+    ASSERT_EQ(GetNextMsgFlagIndex(msgFlags, 1, 64), 31);
+    ASSERT_EQ(GetNextMsgFlagIndex(msgFlags, 32, 64), 34);
+    ASSERT_EQ(GetNextMsgFlagIndex(msgFlags, 35, 64), 64);
+    ASSERT_EQ(GetNextMsgFlagIndex(msgFlags, 1, 20), 20);
+
+    AppSpawnSandboxCfg *sandbox = nullptr;
+    AppSpawnClientHandle clientHandle = nullptr;
+    AppSpawnReqMsgHandle reqHandle = 0;
+    AppSpawningCtx *property = nullptr;
+    int ret = -1;
+    do {
+        ret = AppSpawnClientInit(APPSPAWN_SERVER_NAME, &clientHandle);
+        APPSPAWN_CHECK(ret == 0, break, "Failed to create reqMgr %{public}s", APPSPAWN_SERVER_NAME);
+        reqHandle = g_testHelper.CreateMsg(clientHandle, MSG_APP_SPAWN, 1);
+        APPSPAWN_CHECK(reqHandle != INVALID_REQ_HANDLE, break, "Failed to create req %{public}s", APPSPAWN_SERVER_NAME);
+
+        ret = APPSPAWN_ARG_INVALID;
+        property = g_testHelper.GetAppProperty(clientHandle, reqHandle);
+        APPSPAWN_CHECK_ONLY_EXPER(property != nullptr, break);
+
+        sandbox = CreateAppSpawnSandbox(EXT_DATA_APP_SANDBOX);
+        APPSPAWN_CHECK_ONLY_EXPER(sandbox != nullptr, break);
+        ret = TestParseAppSandboxConfig(sandbox, g_commonConfig.c_str());
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, break);
+        sandbox->maxPermissionIndex = PermissionRenumber(&sandbox->permissionQueue);
+
+        uint32_t queueCount[2] = {0, 0};
+        uint32_t tableCount[2] = {0, 0};
+        ret = ForEachSandboxSectionSet(sandbox, property->message, TLV_PERMISSION, CountSandboxSection, &queueCount[0]);
+        ret |= ForEachSandboxSectionSet(sandbox, property->message, TLV_MSG_FLAGS, CountSandboxSection, &queueCount[1]);
+        ret |= BuildSandboxSectionTables(sandbox);
+        APPSPAWN_CHECK_ONLY_EXPER(ret == 0, break);
+        ASSERT_EQ(sandbox->permissionTable.indexCount, static_cast<uint32_t>(sandbox->maxPermissionIndex));
+        ret = ForEachSandboxSectionSet(sandbox, property->message, TLV_PERMISSION, CountSandboxSection, &tableCount[0]);
+        ret |= ForEachSandboxSectionSet(sandbox, property->message, TLV_MSG_FLAGS, CountSandboxSection, &tableCount[1]);
+        ASSERT_EQ(queueCount[0], tableCount[0]);
+        ASSERT_EQ(queueCount[1], tableCount[1]);
+    } while (0);
+    if (sandbox) {
+        DeleteAppSpawnSandbox(sandbox);
+    }
+    DeleteAppSpawningCtx(property);
+    AppSpawnClientDestroy(clientHandle);
+    ASSERT_EQ(ret, 0);
+}
+
 /**
  * @brief app-variable部分执行。让mount执行失败，失败返回错误结果
  *
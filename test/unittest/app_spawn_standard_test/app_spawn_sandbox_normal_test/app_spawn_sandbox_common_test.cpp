@@ -1278,4 +1278,46 @@ HWTEST_F(AppSpawnSandboxCommonTest, App_Spawn_SandboxCommon_GetDecReadOnlyPath_0
     EXPECT_EQ(result.size(), 0);
 }
 
+/**
+ * @tc.name: App_Spawn_SandboxCommon_CompileSectionIR_01
+ * @tc.desc: Test mount flags, dest mode and symlinks are pre-parsed into section IR
+ * @tc.type: FUNC
+ */
+HWTEST_F(AppSpawnSandboxCommonTest, App_Spawn_SandboxCommon_CompileSectionIR_01, TestSize.Level0)
+{
+    const char *config = "{ \"flags\": \"DLP_MANAGER_READ_ONLY\", \"mount-paths\": [{"
+        "\"src-path\": \"/data/app/el1/<currentUserId>/base/<PackageName>\","
+        "\"sandbox-path\": \"/data/storage/el1/base\","
+        "\"sandbox-flags\": [\"bind\", \"rec\"], \"dest-mode\": \"S_IRUSR|S_IWUSR\","
+        "\"check-action-status\": \"true\", \"dec-paths\": [\"/storage\", 1]"
+        "}], \"symbol-links\": [{ \"target-name\": \"/system/bin\", \"link-name\": \"/bin\" }] }";
+    cJSON *appConfig = cJSON_Parse(config);
+    ASSERT_NE(appConfig, nullptr);
+
+    AppSpawn::SandboxSectionIR section;
+    AppSpawn::SandboxCommon::CompileSectionIR(appConfig, section);
+    EXPECT_STREQ(section.flagsName, "DLP_MANAGER_READ_ONLY");
+    EXPECT_EQ(section.flags, APP_FLAGS_DLP_MANAGER_READ_ONLY);
+    ASSERT_EQ(section.mountPoints.size(), 1);
+    const AppSpawn::SandboxMountPointIR &mountPoint = section.mountPoints[0];
+    EXPECT_EQ(mountPoint.mountFlags, MS_BIND | MS_REC);
+    EXPECT_TRUE(mountPoint.hasDestMode);
+    EXPECT_EQ(mountPoint.destMode, S_IRUSR | S_IWUSR);
+    EXPECT_TRUE(mountPoint.checkStatus);
+    EXPECT_TRUE(mountPoint.hasFlags);
+    EXPECT_TRUE(mountPoint.wpsSkip);
+    EXPECT_EQ(mountPoint.mountSharedFlag, MS_SLAVE);
+    EXPECT_TRUE(mountPoint.decPaths.empty());  // 含非字符串项时整体忽略
+    ASSERT_EQ(section.symlinks.size(), 1);
+    EXPECT_STREQ(section.symlinks[0].linkName, "/bin");
+    EXPECT_FALSE(section.symlinks[0].hasDestMode);
+
+    // 未预编译的节点在使用时临时编译
+    AppSpawn::SandboxSectionIR tmpSection;
+    const AppSpawn::SandboxSectionIR &result = AppSpawn::SandboxCommon::GetSectionIR(appConfig, tmpSection);
+    EXPECT_EQ(&result, &tmpSection);
+    EXPECT_EQ(result.mountPoints.size(), 1);
+    cJSON_Delete(appConfig);
+}
+
 }  // namespace OHOS
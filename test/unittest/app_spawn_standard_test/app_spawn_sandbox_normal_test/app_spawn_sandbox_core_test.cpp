@@ -246,13 +246,52 @@ HWTEST_F(AppSpawnSandboxCoreTest, CheckMountFlag_01, TestSize.Level0)
     cJSON *appConfig = cJSON_Parse(appConfigStr);
     ASSERT_EQ(appConfig != nullptr, 1);
 
-    bool ret = AppSpawn::SandboxCore::CheckMountFlag(appProperty, bundleName, appConfig);
+    SandboxSectionIR section;
+    AppSpawn::SandboxCommon::CompileSectionIR(appConfig, section);
+    bool ret = AppSpawn::SandboxCore::CheckMountFlag(appProperty, bundleName, section);
     EXPECT_EQ(ret, false);
 
     cJSON_Delete(appConfig);
     DeleteAppSpawningCtx(appProperty);
 }
 
+/**
+ * @tc.name: CheckMountFlag_02
+ * @tc.desc: Test mount flag checking for flags configuration of wps bundle
+ * @tc.type: FUNC
+ * @tc.require: issueI5NTX6
+ */
+HWTEST_F(AppSpawnSandboxCoreTest, CheckMountFlag_02, TestSize.Level0)
+{
+    const char *bundleName = "com.ohos.wps.test";
+    const char *appConfigStr = R"({
+        "flags": "DLP_MANAGER_FULL_CONTROL",
+        "mount-paths": []
+    })";
+
+    g_testHelperCore.SetProcessName(bundleName);
+    g_testHelperCore.SetTestApl("normal");
+
+    AppSpawningCtx *appProperty = GetTestAppPropertyCore();
+    ASSERT_NE(appProperty, nullptr);
+
+    cJSON *appConfig = cJSON_Parse(appConfigStr);
+    ASSERT_EQ(appConfig != nullptr, 1);
+
+    SandboxSectionIR section;
+    AppSpawn::SandboxCommon::CompileSectionIR(appConfig, section);
+    EXPECT_EQ(section.flags, APP_FLAGS_DLP_MANAGER_FULL_CONTROL);
+    EXPECT_EQ(AppSpawn::SandboxCore::CheckMountFlag(appProperty, bundleName, section), false);
+
+    int ret = SetAppSpawnMsgFlag(appProperty->message, TLV_MSG_FLAGS, APP_FLAGS_DLP_MANAGER_FULL_CONTROL);
+    EXPECT_EQ(ret, 0);
+    EXPECT_EQ(AppSpawn::SandboxCore::CheckMountFlag(appProperty, bundleName, section), true);
+    EXPECT_EQ(AppSpawn::SandboxCore::CheckMountFlag(appProperty, "com.ohos.test.app", section), false);
+
+    cJSON_Delete(appConfig);
+    DeleteAppSpawningCtx(appProperty);
+}
+
 /**
  * @tc.name: UpdateMsgFlagsWithPermission_01
  * @tc.desc: Test updating message flags with permissions
@@ -841,4 +841,64 @@ HWTEST_F(HnpJsonTest, DoRebuildHnpInfoCfgTest_003, TestSize.Level0)
     (void)snprintf_s(cfgPath, PATH_MAX, PATH_MAX, HNP_PACKAGE_INFO_JSON_FILE_PATH, uid);
     (void)remove(cfgPath);
 }
+
+/**
+ * @tc.name: HnpPackageInfoTransTest_001
+ * @tc.desc: Test hnp info changes in a transaction are visible to queries and written once at the end
+ * @tc.type: FUNC
+ */
+HWTEST_F(HnpJsonTest, HnpPackageInfoTransTest_001, TestSize.Level0)
+{
+    HnpCfgInfo hnpCfg;
+    (void)memset_s(&hnpCfg, sizeof(HnpCfgInfo), 0, sizeof(HnpCfgInfo));
+    hnpCfg.uid = 10019;
+    hnpCfg.isInstall = true;
+    char cfgPath[PATH_MAX] = {0};
+    (void)snprintf_s(cfgPath, PATH_MAX, PATH_MAX, HNP_PACKAGE_INFO_JSON_FILE_PATH, hnpCfg.uid);
+    EnsurePathExists(cfgPath);
+    (void)remove(cfgPath);
+
+    EXPECT_EQ(HnpPackageInfoTransBegin(hnpCfg.uid), 0);
+    strcpy_s(hnpCfg.name, MAX_FILE_PATH_LEN, "test_hnp_b");
+    strcpy_s(hnpCfg.version, HNP_VERSION_LEN, "2.0");
+    EXPECT_EQ(HnpInstallInfoJsonWrite("com.test.hap", &hnpCfg), 0);
+    strcpy_s(hnpCfg.name, MAX_FILE_PATH_LEN, "test_hnp_a");
+    strcpy_s(hnpCfg.version, HNP_VERSION_LEN, "1.0");
+    EXPECT_EQ(HnpInstallInfoJsonWrite("com.test.hap", &hnpCfg), 0);
+    EXPECT_NE(access(cfgPath, F_OK), 0);
+
+    char *version = HnpCurrentVersionGet("test_hnp_b", hnpCfg.uid);
+    ASSERT_NE(version, nullptr);
+    EXPECT_STREQ(version, "2.0");
+    free(version);
+    EXPECT_TRUE(CanRecovery("com.test.hap", &hnpCfg));
+    EXPECT_FALSE(CanRecovery("com.other.hap", &hnpCfg));
+    EXPECT_EQ(HnpPackageInfoHnpDelete("com.test.hap", "test_hnp_b", "2.0", hnpCfg.uid), 0);
+    EXPECT_EQ(HnpCurrentVersionGet("test_hnp_b", hnpCfg.uid), nullptr);
+
+    EXPECT_EQ(HnpPackageInfoTransEnd(hnpCfg.uid), 0);
+    EXPECT_EQ(access(cfgPath, F_OK), 0);
+    version = HnpCurrentVersionUninstallCheck("test_hnp_a", hnpCfg.uid);
+    ASSERT_NE(version, nullptr);
+    EXPECT_STREQ(version, "1.0");
+    free(version);
+    EXPECT_EQ(HnpCurrentVersionGet("test_hnp_b", hnpCfg.uid), nullptr);
+
+    (void)remove(cfgPath);
+}
+
+/**
+ * @tc.name: HnpPackageInfoTransTest_002
+ * @tc.desc: Test hnp info transaction nesting, another uid and unmatched end
+ * @tc.type: FUNC
+ */
+HWTEST_F(HnpJsonTest, HnpPackageInfoTransTest_002, TestSize.Level0)
+{
+    EXPECT_EQ(HnpPackageInfoTransEnd(10020), 0);
+    EXPECT_EQ(HnpPackageInfoTransBegin(10020), 0);
+    EXPECT_EQ(HnpPackageInfoTransBegin(10020), 0);
+    EXPECT_EQ(HnpPackageInfoTransBegin(10021), HNP_ERRNO_BASE_PARAMS_INVALID);
+    EXPECT_EQ(HnpPackageInfoTransEnd(10020), 0);
+    EXPECT_EQ(HnpPackageInfoTransEnd(10020), 0);
+}
 }
\ No newline at end of file
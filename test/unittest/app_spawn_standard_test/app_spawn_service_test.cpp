@@ -18,6 +18,8 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 #include <unistd.h>
 
 #include <gtest/gtest.h>
@@ -138,6 +140,47 @@ HWTEST_F(AppSpawnServiceTest, App_Spawn_MSG_APP_SPAWN_002, TestSize.Level0)
     ASSERT_EQ(ret, 0);
 }
 
+/**
+ * @brief 通过异步接口在一个连接上同时发送多个MSG_APP_SPAWN消息
+ * @note 预期结果：响应按 msgId 匹配到各自的请求，每个回调执行一次
+ *
+ */
+HWTEST_F(AppSpawnServiceTest, App_Spawn_MSG_APP_SPAWN_Async_001, TestSize.Level0)
+{
+    const int reqCount = 4;  // 4 requests in flight
+    std::vector<AppSpawnResult> results(reqCount);
+    std::vector<int> callCount(reqCount, 0);
+    AppSpawnClientHandle clientHandle = nullptr;
+    int ret = AppSpawnClientInit(APPSPAWN_SERVER_NAME, &clientHandle);
+    ASSERT_EQ(ret, 0);
+    EXPECT_EQ(AppSpawnClientGetEventFd(clientHandle), -1);
+
+    auto callback = [](const AppSpawnResult *result, void *context) {
+        auto *item = reinterpret_cast<std::pair<AppSpawnResult *, int *> *>(context);
+        *item->first = *result;
+        (*item->second)++;
+    };
+    std::vector<std::pair<AppSpawnResult *, int *>> contexts;
+    for (int i = 0; i < reqCount; i++) {
+        contexts.emplace_back(&results[i], &callCount[i]);
+    }
+    for (int i = 0; i < reqCount; i++) {
+        AppSpawnReqMsgHandle reqHandle = testServer->CreateMsg(clientHandle, MSG_APP_SPAWN, 0);
+        ret = AppSpawnClientSubmitMsg(clientHandle, reqHandle, callback, &contexts[i]);
+        EXPECT_EQ(ret, 0);
+    }
+    EXPECT_GE(AppSpawnClientGetEventFd(clientHandle), 0);
+    while (AppSpawnClientProcessEvents(clientHandle, -1) > 0) {
+    }
+    for (int i = 0; i < reqCount; i++) {
+        EXPECT_EQ(callCount[i], 1);
+        EXPECT_EQ(results[i].result, 0);
+        EXPECT_GT(results[i].pid, 0);
+        APPSPAWN_ONLY_EXPER(results[i].pid > 0, kill(results[i].pid, SIGKILL));
+    }
+    AppSpawnClientDestroy(clientHandle);
+}
+
 /**
  * @brief appspawn孵化的应用进程退出后，向appspawn发送MSG_GET_RENDER_TERMINATION_STATUS类型的消息
  * @note 预期结果：appspawn不支持处理该类型消息，不会根据消息中传入的pid去查询进程的退出状态
@@ -45,7 +45,8 @@ protected:
         GTEST_LOG_(INFO) << info->test_suite_name() << "." << info->name() << " end";
         APPSPAWN_LOGI("%{public}s.%{public}s end", info->test_suite_name(), info->name());
 
-        // 清理测试队列中的节点
+        // 清理测试队列中的节点，opcode 表引用这些节点，先清除
+        ClearPermissionOpcodeTable();
         ListNode *node = testQueue.front.next;
         while (node != &testQueue.front) {
             ListNode *next = node->next;
@@ -362,3 +363,70 @@ HWTEST_F(AppSpawnSpmPermissionTest, App_Spawn_Spm_GetSpawnFlagIndexesFromPermiss
     // 验证返回值：应该返回 -1
     EXPECT_EQ(ret, -1);
 }
+
+// ============================================================================
+// BuildPermissionOpcodeTable 测试用例
+// ============================================================================
+
+/**
+ * @brief 建表后按 opcode 查询和位图转换结果与遍历队列一致
+ */
+HWTEST_F(AppSpawnSpmPermissionTest, App_Spawn_Spm_BuildPermissionOpcodeTable_001, TestSize.Level1)
+{
+    SandboxPermissionNode *node1 = CreateTestPermissionNode("perm0", 0, 10);
+    SandboxPermissionNode *node2 = CreateTestPermissionNode("perm5", 5, 40);
+    SandboxPermissionNode *node3 = CreateTestPermissionNode("perm33", 33, 30);
+    SandboxPermissionNode *node4 = CreateTestPermissionNode("permInvalid", 2, OPCODE_INVALID);
+    ASSERT_NE(node1, nullptr);
+    ASSERT_NE(node2, nullptr);
+    ASSERT_NE(node3, nullptr);
+    ASSERT_NE(node4, nullptr);
+    AddPermissionToQueue(node1);
+    AddPermissionToQueue(node2);
+    AddPermissionToQueue(node3);
+    AddPermissionToQueue(node4);
+
+    EXPECT_EQ(BuildPermissionOpcodeTable(&testQueue), 0);
+    EXPECT_EQ(GetPermissionNodeByOpcode(&testQueue, 40), node2);
+    EXPECT_EQ(GetPermissionNodeByOpcode(&testQueue, 20), nullptr);
+    EXPECT_EQ(GetPermissionNodeByOpcode(&testQueue, 100), nullptr);
+    EXPECT_STREQ(GetPermissionNameByOpcode(&testQueue, 30), "perm33");
+
+    // 授权 opcode=10、30、40 以及未配置的 opcode=11、63
+    uint32_t perms[MAX_PERM_BIT_MAP_SIZE] = {0};
+    perms[0] = (1U << 10) | (1U << 11) | (1U << 30);
+    perms[1] = (1U << 8) | (1U << 31);
+    uint32_t flagIndexes[2] = {0};
+    EXPECT_EQ(GetSpawnFlagIndexesFromPermissionBitmap(&testQueue, perms, flagIndexes, 2), 0);
+    EXPECT_EQ(flagIndexes[0], (1U << 0) | (1U << 5));
+    EXPECT_EQ(flagIndexes[1], (1U << 1));
+
+    ClearPermissionOpcodeTable();
+    uint32_t scanIndexes[2] = {0};
+    EXPECT_EQ(GetSpawnFlagIndexesFromPermissionBitmap(&testQueue, perms, scanIndexes, 2), 0);
+    EXPECT_EQ(scanIndexes[0], flagIndexes[0]);
+    EXPECT_EQ(scanIndexes[1], flagIndexes[1]);
+}
+
+/**
+ * @brief opcode 重复时建表失败，查询退回遍历队列
+ */
+HWTEST_F(AppSpawnSpmPermissionTest, App_Spawn_Spm_BuildPermissionOpcodeTable_002, TestSize.Level2)
+{
+    SandboxPermissionNode *node1 = CreateTestPermissionNode("perm0", 0, 10);
+    SandboxPermissionNode *node2 = CreateTestPermissionNode("perm1", 1, 10);
+    ASSERT_NE(node1, nullptr);
+    ASSERT_NE(node2, nullptr);
+    AddPermissionToQueue(node1);
+    AddPermissionToQueue(node2);
+
+    EXPECT_NE(BuildPermissionOpcodeTable(&testQueue), 0);
+    EXPECT_NE(BuildPermissionOpcodeTable(nullptr), 0);
+    EXPECT_EQ(GetPermissionNodeByOpcode(&testQueue, 10), node1);
+
+    uint32_t perms[MAX_PERM_BIT_MAP_SIZE] = {0};
+    perms[0] = (1U << 10);
+    uint32_t flagIndexes[1] = {0};
+    EXPECT_EQ(GetSpawnFlagIndexesFromPermissionBitmap(&testQueue, perms, flagIndexes, 1), 0);
+    EXPECT_EQ(flagIndexes[0], (1U << 0) | (1U << 1));
+}
@@ -152,4 +152,16 @@ int CheckAppSpawnMsgFlag(const AppSpawnMsgNode *message, uint32_t type, uint32_t
     return 0;
 }
 
+// messages built by TestDataFactory are not arena backed, free them part by part
+void DeleteAppSpawnMsg(AppSpawnMsgNode **msgNode)
+{
+    if (msgNode == nullptr || *msgNode == nullptr) {
+        return;
+    }
+    free((*msgNode)->buffer);
+    free((*msgNode)->tlvOffset);
+    free(*msgNode);
+    *msgNode = nullptr;
+}
+
 } // extern "C"
@@ -58,8 +58,10 @@ HWTEST_F(AppSpawnUnlockMountHisyseventTest, UnlockMount_Hisysevent_ReportUnlockM
     int32_t successCount = 8;
     int32_t failCount = 2;
     int64_t duration = 1500;
+    int64_t scanDuration = 20;
+    int64_t runningDuration = 300;
 
-    ReportUnlockMountResult(uid, totalCount, successCount, failCount, duration);
+    ReportUnlockMountResult(uid, totalCount, successCount, failCount, duration, scanDuration, runningDuration);
 
     // Verify HiSysEventWrite was called exactly once
     EXPECT_EQ(state.callCount, 1);
@@ -91,7 +93,7 @@ HWTEST_F(AppSpawnUnlockMountHisyseventTest, UnlockMount_Hisysevent_ReportUnlockM
     int64_t duration = 0;
 
     // Should not crash even when HiSysEventWrite fails
-    ReportUnlockMountResult(uid, totalCount, successCount, failCount, duration);
+    ReportUnlockMountResult(uid, totalCount, successCount, failCount, duration, 0, 0);
 
     // Verify the call was still made and the failure was handled
     EXPECT_EQ(state.callCount, 1);
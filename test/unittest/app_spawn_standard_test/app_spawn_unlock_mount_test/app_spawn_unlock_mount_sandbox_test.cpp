@@ -24,7 +24,6 @@
 #include <map>
 #include <atomic>
 #include <thread>
-#include <queue>
 #include <mutex>
 #include <functional>
 
@@ -66,18 +65,12 @@ std::string ReplacePlaceholders(const std::string &templateStr, const std::strin
                                 const std::string &bundleName);
 }
 MountEntryResult MountSingleConfigEntry(const UnlockMountEntry &config, const LockBundleInfo &bundle);
+bool GetNextMountBatch(MountQueueContext &ctx, unsigned int workerId, size_t &bundleIndex);
+void MountQueueWorkerThread(MountQueueContext &ctx, unsigned int workerId);
+std::unique_ptr<MountQueueContext> CreateMountContext(int uid);
 
 namespace OHOS {
 
-// Forward declarations for test helper functions
-struct MountWorkerContext {
-    std::vector<LockBundleInfo> *bundles;
-    std::atomic<int> *successCount;
-    std::atomic<int> *failCount;
-    std::atomic<int> *skipCount;
-};
-void MountWorkerThread(unsigned int index, unsigned int mod, const MountWorkerContext &ctx);
-
 AppSpawnTestHelper g_testHelperUnlockMountSandbox;
 
 // Mock control variables for opendir/readdir
@@ -968,96 +961,133 @@ HWTEST_F(AppSpawnUnlockMountSandboxTest, DoSharedMountForApp_009, TestSize.Level
     EXPECT_EQ(skipCount.load(), 12);  // All configs skipped
 }
 
-// ==================== Batch-3: MountWorkerThread Tests ====================
+// ==================== Batch-3: MountQueueWorkerThread Tests ====================
+
+// /dev/null存在、源路径不存在：挂载失败；目的路径不存在：跳过
+static const UnlockMountEntry g_testMountConfig[] = {
+    {"/nonexistent_unlock_mount_src/<bundleName>", "/null"},
+    {"/data/app/el2/<userId>/base/<bundleName>", "/nonexistent_unlock_mount_dest"},
+};
+static constexpr size_t TEST_MOUNT_CONFIG_SIZE = sizeof(g_testMountConfig) / sizeof(g_testMountConfig[0]);
+
+static void InitTestMountContext(MountQueueContext &ctx, unsigned int threadCount, size_t bundleCount)
+{
+    ctx.queues = std::vector<MountWorkerQueue>(threadCount);
+    ctx.mountConfig = g_testMountConfig;
+    ctx.configSize = TEST_MOUNT_CONFIG_SIZE;
+    for (size_t i = 0; i < bundleCount; i++) {
+        std::string bundleName = "com.example.app" + std::to_string(i);
+        ctx.bundles.push_back({1, static_cast<uint32_t>(100 * UID_BASE + i), "/dev", bundleName});
+    }
+    ctx.runningCount = 0;
+    ctx.threadCount = threadCount;
+}
 
 /**
- * @tc.name: MountWorkerThread_001
- * @tc.desc: Test MountWorkerThread with single task and single thread (mod=1)
+ * @tc.name: MountQueueWorkerThread_001
+ * @tc.desc: Test worker takes its own batches from the front and steals from the back of other queues
  * @tc.type: FUNC
  * @tc.require: issueI
  */
-HWTEST_F(AppSpawnUnlockMountSandboxTest, MountWorkerThread_001, TestSize.Level1)
+HWTEST_F(AppSpawnUnlockMountSandboxTest, MountQueueWorkerThread_001, TestSize.Level1)
 {
-    // Arrange
-    std::vector<LockBundleInfo> tasks;
-    LockBundleInfo b1 = {1, 200100, "/mnt/sandbox/100", "chipset"};
-    tasks.push_back(b1);
-    std::atomic<int> successCount{0};
-    std::atomic<int> failCount{0};
-    std::atomic<int> skipCount{0};
-    MountWorkerContext ctx = { &tasks, &successCount, &failCount, &skipCount };
+    MountQueueContext ctx;
+    InitTestMountContext(ctx, 2, 4);  // 2 workers, 4 bundles
+    ctx.queues[0].batches = {0, 1, 2, 3};
 
-    // Act
-    MountWorkerThread(0, 1, ctx);
+    // worker 1的队列为空，从worker 0的队列尾部窃取
+    size_t bundleIndex = 0;
+    ASSERT_TRUE(GetNextMountBatch(ctx, 1, bundleIndex));
+    EXPECT_EQ(bundleIndex, 3u);
+    ASSERT_TRUE(GetNextMountBatch(ctx, 0, bundleIndex));
+    EXPECT_EQ(bundleIndex, 0u);
 
-    // Assert
-    // 覆盖: MountWorkerThread single thread (sandbox_shared_mount.cpp:721)
-    // Note: On device, all configs skipped due to access() failure (paths don't exist)
-    EXPECT_EQ(successCount.load(), 0);
-    EXPECT_EQ(failCount.load(), 0);
-    EXPECT_EQ(skipCount.load(), 12);  // All 12 config entries skipped
+    // worker 1窃取完剩余的应用，worker 0无任务可取
+    MountQueueWorkerThread(ctx, 1);
+    EXPECT_TRUE(ctx.queues[0].batches.empty());
+    EXPECT_TRUE(ctx.queues[1].batches.empty());
+    EXPECT_FALSE(GetNextMountBatch(ctx, 0, bundleIndex));
+    EXPECT_EQ(ctx.successCount.load(), 0);
+    EXPECT_EQ(ctx.failCount.load(), 2);  // bundles 1, 2
+    EXPECT_EQ(ctx.skipCount.load(), 2);
 }
 
 /**
- * @tc.name: MountWorkerThread_002
- * @tc.desc: Test MountWorkerThread with index beyond task list size (no-op)
+ * @tc.name: MountQueueWorkerThread_002
+ * @tc.desc: Test success/fail/skip totals when several workers drain unbalanced queues concurrently
  * @tc.type: FUNC
  * @tc.require: issueI
  */
-HWTEST_F(AppSpawnUnlockMountSandboxTest, MountWorkerThread_002, TestSize.Level1)
-{
-    // Arrange
-    std::vector<LockBundleInfo> tasks;
-    LockBundleInfo b2 = {1, 200100, "/mnt/sandbox/100", "com.example.app1"};
-    tasks.push_back(b2);
-    std::atomic<int> successCount{0};
-    std::atomic<int> failCount{0};
-    std::atomic<int> skipCount{0};
-    MountWorkerContext ctx = { &tasks, &successCount, &failCount, &skipCount };
+HWTEST_F(AppSpawnUnlockMountSandboxTest, MountQueueWorkerThread_002, TestSize.Level1)
+{
+    const unsigned int threadCount = 3;
+    const size_t bundleCount = 9;
+    MountQueueContext ctx;
+    InitTestMountContext(ctx, threadCount, bundleCount);
+    for (size_t i = 0; i < bundleCount; i++) {
+        ctx.queues[i < bundleCount - 1 ? 0 : 2].batches.push_back(i);  // worker 1无任务，只能窃取
+    }
+    ctx.runningCount = 2;  // 前2个应用视为已运行
+    ctx.runningPending.store(ctx.runningCount);
+    ctx.mountStart = std::chrono::steady_clock::now();
 
-    // Act - index=5, mod=1, but only 1 task -> loop never executes
-    MountWorkerThread(5, 1, ctx);
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < threadCount; i++) {
+        workers.emplace_back(MountQueueWorkerThread, std::ref(ctx), i);
+    }
+    MountQueueWorkerThread(ctx, 0);
+    for (auto &worker : workers) {
+        worker.join();
+    }
 
-    // Assert
-    // 覆盖: MountWorkerThread index >= size (sandbox_shared_mount.cpp:721)
-    // Note: On device, when loop doesn't execute, all configs skipped
-    EXPECT_EQ(successCount.load(), 0);
-    EXPECT_EQ(failCount.load(), 0);
-    EXPECT_EQ(skipCount.load(), 7);  // Mount point configs 5,7,9,11 (7 out of 12)
+    for (unsigned int i = 0; i < threadCount; i++) {
+        EXPECT_TRUE(ctx.queues[i].batches.empty());
+    }
+    EXPECT_EQ(ctx.successCount.load(), 0);
+    EXPECT_EQ(ctx.failCount.load(), static_cast<int>(bundleCount));
+    EXPECT_EQ(ctx.skipCount.load(), static_cast<int>(bundleCount));
+    EXPECT_EQ(ctx.runningPending.load(), 0u);
 }
 
 /**
- * @tc.name: MountWorkerThread_003
- * @tc.desc: Test MountWorkerThread with mod=2 (processes every other task)
+ * @tc.name: CreateMountContext_001
+ * @tc.desc: Test running apps are ordered first and placed at the head of the worker queues
  * @tc.type: FUNC
  * @tc.require: issueI
  */
-HWTEST_F(AppSpawnUnlockMountSandboxTest, MountWorkerThread_003, TestSize.Level1)
-{
-    // Arrange
-    std::vector<LockBundleInfo> tasks;
-    LockBundleInfo b1 = {1, 200100, "/mnt/sandbox/100", "chipset"};
-    tasks.push_back(b1);
-    LockBundleInfo b2 = {1, 200100, "/mnt/sandbox/100", "com.example.app1"};
-    tasks.push_back(b2);
-    LockBundleInfo b3 = {1, 200100, "/mnt/sandbox/100", "system"};
-    tasks.push_back(b3);
-    std::atomic<int> successCount{0};
-    std::atomic<int> failCount{0};
-    std::atomic<int> skipCount{0};
-    MountWorkerContext ctx = { &tasks, &successCount, &failCount, &skipCount };
-    g_accessShouldFail = false;
-
-    // Act - mod=2, index=1 -> processes tasks[1] only
-    MountWorkerThread(1, 2, ctx);
-
-    // Assert
-    // 覆盖: MountWorkerThread mod=2 stride (sandbox_shared_mount.cpp:721)
-    // Note: On device, all configs skipped due to access() failure (paths don't exist)
-    // mod=2, index=1 processes mount points 1,3,5,7,9,11 (6 points), each processes 3 tasks = 18 total
-    EXPECT_EQ(successCount.load(), 0);
-    EXPECT_EQ(failCount.load(), 0);
-    EXPECT_EQ(skipCount.load(), 18);  // 6 mount points × 3 tasks = 18 skipped
+HWTEST_F(AppSpawnUnlockMountSandboxTest, CreateMountContext_001, TestSize.Level1)
+{
+    AddLockBundleRef(100 * UID_BASE + 1, testBundle1, "/mnt/sandbox/100/com.example.app1_preunlock");
+    AddLockBundleRef(100 * UID_BASE + 2, testBundle2, "/mnt/sandbox/100/com.example.app2_preunlock");
+    AddLockBundleRef(100 * UID_BASE + 3, testBundle3, "/mnt/sandbox/100/com.example.app3_preunlock");
+    AddLockBundleRef(200 * UID_BASE + 3, testBundle3, "/mnt/sandbox/200/com.example.app3_preunlock");
+
+    AppSpawnMgr *mgr = CreateAppSpawnMgr(MODE_FOR_APP_SPAWN);
+    ASSERT_NE(mgr, nullptr);
+    AppSpawnedProcess *app = AddSpawnedProcess(1001, testBundle3, 0, false, 0);  // 1001 pid
+    ASSERT_NE(app, nullptr);
+    app->uid = 100 * UID_BASE + 3;
+
+    std::unique_ptr<MountQueueContext> ctx = CreateMountContext(testUid);
+    TerminateSpawnedProcess(app);
+    DeleteAppSpawnMgr(mgr);
+    ASSERT_NE(ctx, nullptr);
+
+    // 已运行的app3排在最前，其余应用保持原有顺序，其他用户的应用被过滤
+    ASSERT_EQ(ctx->bundles.size(), 3u);
+    EXPECT_EQ(ctx->runningCount, 1u);
+    EXPECT_EQ(ctx->runningPending.load(), 1u);
+    EXPECT_EQ(ctx->bundles[0].bundleName, testBundle3);
+    EXPECT_EQ(ctx->bundles[1].bundleName, testBundle1);
+    EXPECT_EQ(ctx->bundles[2].bundleName, testBundle2);
+    ASSERT_GT(ctx->threadCount, 0u);
+    EXPECT_EQ(ctx->queues.size(), ctx->threadCount);
+    EXPECT_EQ(ctx->queues[0].batches.front(), 0u);
+
+    MountQueueWorkerThread(*ctx, 0);
+    EXPECT_EQ(ctx->runningPending.load(), 0u);
+    EXPECT_EQ(ctx->successCount.load() + ctx->failCount.load() + ctx->skipCount.load(),
+        static_cast<int>(ctx->bundles.size() * ctx->configSize));
 }
 
 // ==================== Batch-4: AddLockBundleRef Tests ====================
@@ -1692,144 +1722,4 @@ HWTEST_F(AppSpawnUnlockMountSandboxTest, MountDirToShared_002, TestSize.Level1)
     EXPECT_EQ(g_lockBundleMap.size(), originalMapSize);
 }
 
-// ==================== MountWorkerThread and DoSharedMountForUser Implementation ====================
-// These implementations are moved from sandbox_unlock_mount.cpp to test file
-// to make tests more independent
-
-// Single mount task
-struct MountTask {
-    size_t configIndex;    // Mount point config index
-    size_t bundleIndex;    // App index
-};
-
-// Task queue context
-struct MountQueueContext {
-    std::queue<MountTask> taskQueue;
-    std::mutex queueMutex;
-    const UnlockMountEntry *mountConfig;
-    std::vector<LockBundleInfo> bundles;
-    std::atomic<int> successCount{0};
-    std::atomic<int> failCount{0};
-    std::atomic<int> skipCount{0};
-};
-
-// Work queue core logic
-static void MountQueueWorkerThread(MountQueueContext &ctx, unsigned int workerId)
-{
-    size_t processedTasks = 0;
-    MountTask task;
-
-    while (true) {
-        // Get task from queue (with lock)
-        {
-            std::lock_guard<std::mutex> lock(ctx.queueMutex);
-            if (ctx.taskQueue.empty()) {
-                break;
-            }
-            task = ctx.taskQueue.front();
-            ctx.taskQueue.pop();
-        }
-
-        // Execute mount task (without lock)
-        const LockBundleInfo &bundle = ctx.bundles[task.bundleIndex];
-        auto r = MountSingleConfigEntry(ctx.mountConfig[task.configIndex], bundle);
-        ctx.successCount += r.success;
-        ctx.failCount += r.fail;
-        ctx.skipCount += r.skip;
-
-        processedTasks++;
-    }
-}
-
-// MountWorkerThread implementation (compatibility interface for testing)
-void MountWorkerThread(unsigned int index, unsigned int mod, const MountWorkerContext &oldCtx)
-{
-    // Get mount configuration
-    size_t configSize = 0;
-    const UnlockMountEntry* mountConfig = GetUnlockMountEntry(&configSize);
-
-    // Build task queue for this thread (sharded by index, mod)
-    std::queue<MountTask> taskQueue;
-    for (size_t i = index; i < configSize; i += mod) {
-        for (size_t j = 0; j < oldCtx.bundles->size(); j++) {
-            taskQueue.push({i, j});
-        }
-    }
-
-    // Convert to queue context (value-based)
-    MountQueueContext newCtx;
-    newCtx.taskQueue = std::move(taskQueue);
-    newCtx.mountConfig = mountConfig;
-    newCtx.bundles = std::move(*const_cast<std::vector<LockBundleInfo>*>(oldCtx.bundles));
-
-    // Call work queue core logic
-    MountQueueWorkerThread(newCtx, index);
-
-    // Copy results back to old context
-    *oldCtx.successCount += newCtx.successCount.load();
-    *oldCtx.failCount += newCtx.failCount.load();
-    *oldCtx.skipCount += newCtx.skipCount.load();
-}
-
-// DoSharedMountForUser implementation (work queue mode)
-int DoSharedMountForUser(int uid)
-{
-    // Get mount bundle list from g_lockBundleMap
-    std::vector<LockBundleInfo> bundles;
-    for (const auto &[lockPath, info] : g_lockBundleMap) {
-        bundles.push_back(info);
-    }
-
-    // Filter bundles by userId
-    std::vector<LockBundleInfo> filteredBundles;
-    for (const auto &bundle : bundles) {
-        if ((bundle.uid / UID_BASE) == static_cast<uint32_t>(uid)) {
-            filteredBundles.push_back(bundle);
-        }
-    }
-
-    if (filteredBundles.empty()) {
-        return 0;
-    }
-
-    // Get mount configuration
-    size_t configSize = 0;
-    const UnlockMountEntry* mountConfig = GetUnlockMountEntry(&configSize);
-
-    // Calculate thread count
-    const unsigned int threadCount = std::min(
-        static_cast<unsigned int>(filteredBundles.size()),
-        std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 4
-    );
-
-    // Build task queue: all (configIndex, bundleIndex) combinations
-    std::queue<MountTask> taskQueue;
-    for (size_t i = 0; i < configSize; i++) {
-        for (size_t j = 0; j < filteredBundles.size(); j++) {
-            taskQueue.push({i, j});
-        }
-    }
-
-    // Create queue context
-    MountQueueContext queueCtx;
-    queueCtx.taskQueue = std::move(taskQueue);
-    queueCtx.mountConfig = mountConfig;
-    queueCtx.bundles = std::move(filteredBundles);
-
-    // Create worker threads
-    std::vector<std::thread> workers;
-    for (unsigned int i = 0; i < threadCount; i++) {
-        workers.emplace_back(MountQueueWorkerThread, std::ref(queueCtx), i);
-    }
-
-    // Wait for all threads to complete
-    for (auto &worker : workers) {
-        if (worker.joinable()) {
-            worker.join();
-        }
-    }
-
-    return 0;
-}
-
 }  // namespace OHOS
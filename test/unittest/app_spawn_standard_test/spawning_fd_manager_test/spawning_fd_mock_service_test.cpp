@@ -56,7 +56,7 @@ APPSPAWN_STATIC char *GetMapMem(uint32_t clientId, const char *processName,
 APPSPAWN_STATIC int WritePreforkMsg(AppSpawningCtx *property, uint32_t memSize);
 APPSPAWN_STATIC pid_t ForkAndRegisterFds(AppSpawnMgr *mgr, AppSpawningCtx *property,
     int preforkFd[PIPE_FD_LENGTH], int parentToChildFd[PIPE_FD_LENGTH]);
-APPSPAWN_STATIC int SendPipeMsgToChild(AppSpawnMgr *mgr, pid_t childPid, AppSpawnPipeMsg *pipeMsg);
+APPSPAWN_STATIC int SendPipeMsgToChild(AppSpawnMgr *mgr, pid_t childPid, AppSpawnPipeMsg *pipeMsg, int msgFd);
 APPSPAWN_STATIC int TransferPreforkFdToForkCtx(AppSpawnMgr *mgr, pid_t childPid, AppSpawningCtx *property);
 APPSPAWN_STATIC void CleanupPreforkChild(AppSpawnMgr *mgr, pid_t childPid);
 
@@ -803,7 +803,7 @@ HWTEST_F(SpawningFdForkMockTest, SpawningFd_SendPipeMsg_004, TestSize.Level0)
     AppSpawnPipeMsg pipeMsg = {};
     pipeMsg.type = MSG_APP_SPAWN;
 
-    int ret = SendPipeMsgToChild(mgr_, pid, &pipeMsg);
+    int ret = SendPipeMsgToChild(mgr_, pid, &pipeMsg, -1);
     EXPECT_NE(ret, 0);
 
     // On failure, Unregister is NOT called, node should still be in queue
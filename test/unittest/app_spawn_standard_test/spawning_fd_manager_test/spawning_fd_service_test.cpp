@@ -18,6 +18,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <cstring>
+#include <vector>
 #include <sys/resource.h>
 #include <sys/wait.h>
 
@@ -37,9 +38,12 @@ extern "C" {
 APPSPAWN_STATIC void ClearPipeFd(int pipe[], int length);
 APPSPAWN_STATIC pid_t ForkAndRegisterFds(AppSpawnMgr *mgr, AppSpawningCtx *property,
     int preforkFd[PIPE_FD_LENGTH], int parentToChildFd[PIPE_FD_LENGTH]);
-APPSPAWN_STATIC int SendPipeMsgToChild(AppSpawnMgr *mgr, pid_t childPid, AppSpawnPipeMsg *pipeMsg);
+APPSPAWN_STATIC int SendPipeMsgToChild(AppSpawnMgr *mgr, pid_t childPid, AppSpawnPipeMsg *pipeMsg, int msgFd);
 APPSPAWN_STATIC int TransferPreforkFdToForkCtx(AppSpawnMgr *mgr, pid_t childPid, AppSpawningCtx *property);
 APPSPAWN_STATIC void CleanupPreforkChild(AppSpawnMgr *mgr, pid_t childPid);
+APPSPAWN_STATIC void HandleDiedPid(pid_t pid, uid_t uid, int status);
+APPSPAWN_STATIC bool PromotePreforkStandby(AppSpawnMgr *mgr);
+APPSPAWN_STATIC bool RemovePreforkStandby(AppSpawnMgr *mgr, pid_t pid);
 }
 
 namespace OHOS {
@@ -91,6 +95,29 @@ protected:
         childPids_.clear();
     }
 
+    // Helper: register a pair of prefork pipes for a fake prefork child
+    void RegisterFakePreforkPipes(pid_t pid)
+    {
+        int childToParentFd[PIPE_FD_LENGTH] = {-1, -1};
+        int parentToChildFd[PIPE_FD_LENGTH] = {-1, -1};
+        ASSERT_EQ(pipe(childToParentFd), 0);
+        ASSERT_EQ(pipe(parentToChildFd), 0);
+        SpawningFdRegInfo cpInfo = { TYPE_CHILD_PARENT, PIPE_FD_LENGTH, childToParentFd, pid };
+        ASSERT_NE(RegisterSpawningFds(mgr_, &cpInfo), nullptr);
+        SpawningFdRegInfo pcInfo = { TYPE_PARENT_CHILD, PIPE_FD_LENGTH, parentToChildFd, pid };
+        ASSERT_NE(RegisterSpawningFds(mgr_, &pcInfo), nullptr);
+    }
+
+    // Helper: put fake prefork children into the standby slots of the pool
+    void AddFakeStandby(const std::vector<pid_t> &pids)
+    {
+        mgr_->preforkPool.size = PREFORK_POOL_MAX_SIZE;
+        for (pid_t pid : pids) {
+            RegisterFakePreforkPipes(pid);
+            mgr_->preforkPool.standby[mgr_->preforkPool.standbyCount++] = pid;
+        }
+    }
+
     // Helper: create a minimal AppSpawningCtx with client.id set
     AppSpawningCtx *CreateMinimalCtx(uint32_t clientId)
     {
@@ -236,7 +263,7 @@ HWTEST_F(SpawningFdServiceTest, SpawningFd_SendPipeMsg_001, TestSize.Level0)
     pipeMsg->msg.preforkMsg.msgLen = sizeof(AppSpawnMsg);
 
     // SendPipeMsgToChild should succeed
-    int ret = SendPipeMsgToChild(mgr_, pid, pipeMsg);
+    int ret = SendPipeMsgToChild(mgr_, pid, pipeMsg, -1);
     EXPECT_EQ(ret, 0);
 
     // After SendPipeMsgToChild, parent-child fds should be unregistered
@@ -263,11 +290,11 @@ HWTEST_F(SpawningFdServiceTest, SpawningFd_SendPipeMsg_002, TestSize.Level0)
     pipeMsg.type = MSG_APP_SPAWN;
 
     // Non-existent pid
-    int ret = SendPipeMsgToChild(mgr_, 99999, &pipeMsg);
+    int ret = SendPipeMsgToChild(mgr_, 99999, &pipeMsg, -1);
     EXPECT_NE(ret, 0);
 
     // NULL mgr
-    ret = SendPipeMsgToChild(nullptr, 99999, &pipeMsg);
+    ret = SendPipeMsgToChild(nullptr, 99999, &pipeMsg, -1);
     EXPECT_NE(ret, 0);
 }
 
@@ -398,7 +425,7 @@ HWTEST_F(SpawningFdServiceTest, SpawningFd_SendPipeMsg_003, TestSize.Level0)
     AppSpawnPipeMsg pipeMsg = {};
     pipeMsg.type = MSG_APP_SPAWN;
 
-    int ret = SendPipeMsgToChild(mgr_, pid, &pipeMsg);
+    int ret = SendPipeMsgToChild(mgr_, pid, &pipeMsg, -1);
     EXPECT_NE(ret, 0);
 
     // On write failure, Unregister is NOT called, node should still be in queue
@@ -482,4 +509,118 @@ HWTEST_F(SpawningFdServiceTest, SpawningFd_ForkAndRegister_004, TestSize.Level0)
 
     DeleteAppSpawningCtx(property);
 }
+
+/**
+ * @tc.name: SpawningFd_PreforkPool_001
+ * @tc.desc: PromotePreforkStandby将standby槽位提升为reservedPid；reservedPid有效时不改变；
+ *           standby为空时返回false
+ * @tc.type: FUNC
+ * @tc.level: Level0
+ * @tc.require: Spawning Fd Manager
+ */
+HWTEST_F(SpawningFdServiceTest, SpawningFd_PreforkPool_001, TestSize.Level0)
+{
+    AddFakeStandby({ 64001, 64002 });
+    mgr_->content.reservedPid = 0;
+
+    EXPECT_TRUE(PromotePreforkStandby(mgr_));
+    EXPECT_EQ(mgr_->content.reservedPid, 64002);
+    EXPECT_EQ(mgr_->preforkPool.standbyCount, 1u);
+
+    // reservedPid still valid: nothing to promote
+    EXPECT_TRUE(PromotePreforkStandby(mgr_));
+    EXPECT_EQ(mgr_->content.reservedPid, 64002);
+    EXPECT_EQ(mgr_->preforkPool.standbyCount, 1u);
+
+    mgr_->content.reservedPid = 0;
+    EXPECT_TRUE(PromotePreforkStandby(mgr_));
+    EXPECT_EQ(mgr_->content.reservedPid, 64001);
+    EXPECT_EQ(mgr_->preforkPool.standbyCount, 0u);
+
+    mgr_->content.reservedPid = 0;
+    EXPECT_FALSE(PromotePreforkStandby(mgr_));
+    EXPECT_EQ(mgr_->content.reservedPid, 0);
+
+    CleanupSpawningFdsByPid(mgr_, 64001);
+    CleanupSpawningFdsByPid(mgr_, 64002);
+}
+
+/**
+ * @tc.name: SpawningFd_PreforkPool_002
+ * @tc.desc: RemovePreforkStandby移除指定pid的槽位，其余槽位保持；未知pid返回false
+ * @tc.type: FUNC
+ * @tc.level: Level0
+ * @tc.require: Spawning Fd Manager
+ */
+HWTEST_F(SpawningFdServiceTest, SpawningFd_PreforkPool_002, TestSize.Level0)
+{
+    AddFakeStandby({ 64011, 64012, 64013 });
+
+    EXPECT_TRUE(RemovePreforkStandby(mgr_, 64011));
+    EXPECT_EQ(mgr_->preforkPool.standbyCount, 2u);
+    EXPECT_FALSE(RemovePreforkStandby(mgr_, 64011));
+    EXPECT_FALSE(RemovePreforkStandby(mgr_, 99999));
+
+    bool found12 = false;
+    bool found13 = false;
+    for (uint32_t i = 0; i < mgr_->preforkPool.standbyCount; i++) {
+        found12 = found12 || mgr_->preforkPool.standby[i] == 64012;
+        found13 = found13 || mgr_->preforkPool.standby[i] == 64013;
+    }
+    EXPECT_TRUE(found12);
+    EXPECT_TRUE(found13);
+
+    CleanupSpawningFdsByPid(mgr_, 64011);
+    CleanupSpawningFdsByPid(mgr_, 64012);
+    CleanupSpawningFdsByPid(mgr_, 64013);
+}
+
+/**
+ * @tc.name: SpawningFd_PreforkPool_003
+ * @tc.desc: HandleDiedPid处理standby子进程退出：槽位移除且其pipe fd被清理，reservedPid不变
+ * @tc.type: FUNC
+ * @tc.level: Level0
+ * @tc.require: Spawning Fd Manager
+ */
+HWTEST_F(SpawningFdServiceTest, SpawningFd_PreforkPool_003, TestSize.Level0)
+{
+    mgr_->content.reservedPid = 64020;
+    RegisterFakePreforkPipes(64020);
+    AddFakeStandby({ 64021 });
+
+    HandleDiedPid(64021, 0, 0);
+
+    EXPECT_EQ(mgr_->preforkPool.standbyCount, 0u);
+    EXPECT_EQ(mgr_->content.reservedPid, 64020);
+    EXPECT_EQ(FindSpawningFdsByPid(mgr_, 64021, TYPE_CHILD_PARENT), nullptr);
+    EXPECT_EQ(FindSpawningFdsByPid(mgr_, 64021, TYPE_PARENT_CHILD), nullptr);
+    EXPECT_NE(FindSpawningFdsByPid(mgr_, 64020, TYPE_PARENT_CHILD), nullptr);
+
+    CleanupSpawningFdsByPid(mgr_, 64020);
+    mgr_->content.reservedPid = 0;
+}
+
+/**
+ * @tc.name: SpawningFd_PreforkPool_004
+ * @tc.desc: HandleDiedPid处理reservedPid退出：清理其fd后立即提升standby子进程为reservedPid
+ * @tc.type: FUNC
+ * @tc.level: Level0
+ * @tc.require: Spawning Fd Manager
+ */
+HWTEST_F(SpawningFdServiceTest, SpawningFd_PreforkPool_004, TestSize.Level0)
+{
+    mgr_->content.reservedPid = 64030;
+    RegisterFakePreforkPipes(64030);
+    AddFakeStandby({ 64031 });
+
+    HandleDiedPid(64030, 0, 0);
+
+    EXPECT_EQ(mgr_->content.reservedPid, 64031);
+    EXPECT_EQ(mgr_->preforkPool.standbyCount, 0u);
+    EXPECT_EQ(FindSpawningFdsByPid(mgr_, 64030, TYPE_PARENT_CHILD), nullptr);
+    EXPECT_NE(FindSpawningFdsByPid(mgr_, 64031, TYPE_PARENT_CHILD), nullptr);
+
+    CleanupSpawningFdsByPid(mgr_, 64031);
+    mgr_->content.reservedPid = 0;
+}
 }  // namespace OHOS
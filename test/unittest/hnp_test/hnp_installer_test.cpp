@@ -19,6 +19,7 @@
 #include <climits>
 #include <cstdlib>
 #include <cstring>
+#include <elf.h>
 #include <memory>
 #include <string>
 #include <sys/stat.h>
@@ -47,6 +48,10 @@ using namespace testing::ext;
     extern "C" {
 #endif
 
+int HapPackageCollect(const char *dstPath, HapInstallInfo *installInfo, HnpInstallJobList *list);
+int HnpInstallWorkerCountGet(const HnpInstallJobList *list);
+int HnpInstallJobListRun(HnpInstallJobList *list, int *count);
+void HnpInstallJobListClear(HnpInstallJobList *list);
 
 #ifdef __cplusplus
     }
@@ -1573,4 +1578,272 @@ HWTEST_F(HnpInstallerTest, Hnp_ReplaceSubstring_003, TestSize.Level0)
     GTEST_LOG_(INFO) << "Hnp_ReplaceSubstring_003 end";
 }
 
+/* 生成包含elfCount个ELF文件和一个普通文件的hnp包，普通文件不填充验签信息，使预留个数多于实际填充个数 */
+static void HnpPackWithElf(const char *name, const char *version, const char *outDir, int elfCount)
+{
+    char srcDir[MAX_FILE_PATH_LEN];
+    char binDir[MAX_FILE_PATH_LEN];
+    char file[MAX_FILE_PATH_LEN];
+    EXPECT_GT(sprintf_s(srcDir, MAX_FILE_PATH_LEN, "./hnp_sample_%s", name), 0);
+    EXPECT_GT(sprintf_s(binDir, MAX_FILE_PATH_LEN, "%s/bin", srcDir), 0);
+    EXPECT_EQ(HnpCreateFolder(binDir), 0);
+    EXPECT_EQ(HnpCreateFolder(outDir), 0);
+
+    Elf64_Ehdr ehdr = {};
+    EXPECT_EQ(memcpy_s(ehdr.e_ident, EI_NIDENT, ELFMAG, SELFMAG), EOK);
+    ehdr.e_ident[EI_CLASS] = ELFCLASS64;
+    ehdr.e_type = ET_EXEC;
+    for (int i = 0; i <= elfCount; i++) {
+        if (i < elfCount) {
+            EXPECT_GT(sprintf_s(file, MAX_FILE_PATH_LEN, "%s/%s_%d", binDir, name, i), 0);
+        } else {
+            EXPECT_GT(sprintf_s(file, MAX_FILE_PATH_LEN, "%s/%s_txt", binDir, name), 0);
+        }
+        FILE *fp = fopen(file, "wb");
+        ASSERT_NE(fp, nullptr);
+        if (i < elfCount) {
+            EXPECT_EQ(fwrite(&ehdr, sizeof(ehdr), 1, fp), 1u);
+        } else {
+            EXPECT_EQ(fwrite(name, strlen(name), 1, fp), 1u);
+        }
+        (void)fclose(fp);
+        EXPECT_EQ(chmod(file, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH), 0);
+    }
+
+    char arg1[] = "hnpcli";
+    char arg2[] = "pack";
+    char arg3[] = "-i";
+    char arg5[] = "-o";
+    char arg7[] = "-n";
+    char arg9[] = "-v";
+    char *argv[] = {arg1, arg2, arg3, srcDir, arg5, const_cast<char *>(outDir), arg7, const_cast<char *>(name),
+        arg9, const_cast<char *>(version)};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    EXPECT_EQ(HnpCmdPack(argc, argv), 0);
+    EXPECT_EQ(HnpDeleteFolder(srcDir), 0);
+}
+
+static void HnpJobListCollect(HapInstallInfo *installInfo, HnpInstallJobList *list, bool isForce)
+{
+    installInfo->uid = TEST_HNP_UID;
+    installInfo->hapPackageName = const_cast<char *>("sample");
+    installInfo->hnpRootPath = const_cast<char *>("./hnp_out");
+    installInfo->abi = const_cast<char *>("system64");
+    installInfo->isForce = isForce;
+    EXPECT_EQ(HapPackageCollect(HNP_BASE_PATH, installInfo, list), 0);
+    if (list->signTotal > 0) {
+        list->hnpSignMapInfos = (HnpSignMapInfo *)malloc(sizeof(HnpSignMapInfo) * list->signTotal);
+        EXPECT_NE(list->hnpSignMapInfos, nullptr);
+    }
+}
+
+static int HnpJobListRun(HnpInstallJobList *list, int *count)
+{
+    EXPECT_EQ(HnpPackageInfoTransBegin(TEST_HNP_UID), 0);
+    int ret = HnpInstallJobListRun(list, count);
+    EXPECT_EQ(HnpPackageInfoTransEnd(TEST_HNP_UID), 0);
+    return ret;
+}
+
+static void HnpJobListDelete(HnpInstallJobList *list)
+{
+    HnpInstallJobListClear(list);
+    free(list->hnpSignMapInfos);
+    list->hnpSignMapInfos = nullptr;
+    HnpDeleteFolder(HNP_BASE_PATH);
+    HnpDeleteFolder("hnp_out");
+    RemoveUidCfg(TEST_HNP_UID);
+}
+
+static std::string HnpJobLinkPath(const HnpInstallJob *job, const char *file)
+{
+    return std::string(HNP_BASE_PATH"/hnppublic/bin/") + job->hnpCfg.name + file;
+}
+
+static std::string HnpJobLinkTarget(const HnpInstallJob *job, const char *file)
+{
+    return std::string("../") + job->hnpCfg.name + ".org/" + job->hnpCfg.name + "_" + job->hnpCfg.version +
+        "/bin/" + job->hnpCfg.name + file;
+}
+
+/* 清理环境后生成count个公有hnp包 */
+static void HnpPackWithElfPrepare(int count)
+{
+    HnpDeleteFolder("hnp_out");
+    HnpDeleteFolder(HNP_BASE_PATH);
+    RemoveUidCfg(TEST_HNP_UID);
+    EXPECT_EQ(mkdir(HNP_BASE_PATH, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH), 0);
+    for (int i = 0; i < count; i++) {
+        std::string name = "sample_" + std::to_string(i);
+        HnpPackWithElf(name.c_str(), "1.1", "./hnp_out/public", 1);
+    }
+}
+
+/**
+* @tc.name: Hnp_Install_Parallel_001
+* @tc.desc:  Verify sign map infos are compacted in job order when jobs have different file counts.
+* @tc.type: FUNC
+* @tc.require: issueI9BU5F
+* @tc.author:
+*/
+HWTEST_F(HnpInstallerTest, Hnp_Install_Parallel_001, TestSize.Level0)
+{
+    GTEST_LOG_(INFO) << "Hnp_Install_Parallel_001 start";
+
+    HnpPackWithElfPrepare(0);
+    HnpPackWithElf("sample_a", "1.1", "./hnp_out/public", 1);
+    HnpPackWithElf("sample_b", "1.1", "./hnp_out/public", 3);
+    HnpPackWithElf("sample_c", "1.1", "./hnp_out/private", 2);
+
+    HapInstallInfo installInfo = {};
+    HnpInstallJobList list = {};
+    HnpJobListCollect(&installInfo, &list, true);
+    EXPECT_EQ(list.count, 3);
+
+    int count = 0;
+    EXPECT_EQ(HnpJobListRun(&list, &count), 0);
+    EXPECT_EQ(count, 6);
+    EXPECT_GT(list.signTotal, count);
+
+    // 各任务的验签信息按任务顺序连续排列，且都属于该任务
+    int sum = 0;
+    for (int i = 0; i < list.count; i++) {
+        HnpInstallJob *job = &list.jobs[i];
+        int elfCount = (strcmp(job->hnpCfg.name, "sample_a") == 0) ? 1 :
+            ((strcmp(job->hnpCfg.name, "sample_b") == 0) ? 3 : 2);
+        EXPECT_EQ(job->signCount, elfCount);
+        std::string prefix = std::string(job->hnpInfo.hnpSignKeyPrefix) + "!/";
+        for (int j = sum; (j < sum + job->signCount) && (j < count); j++) {
+            EXPECT_EQ(strncmp(list.hnpSignMapInfos[j].key, prefix.c_str(), prefix.size()), 0);
+            EXPECT_NE(strstr(list.hnpSignMapInfos[j].value, job->hnpInfo.hnpVersionPath), nullptr);
+        }
+        sum += job->signCount;
+    }
+    EXPECT_EQ(sum, count);
+
+    HnpJobListDelete(&list);
+
+    GTEST_LOG_(INFO) << "Hnp_Install_Parallel_001 end";
+}
+
+/**
+* @tc.name: Hnp_Install_Parallel_002
+* @tc.desc:  Verify jobs after the first failed job are not installed and its error is returned.
+* @tc.type: FUNC
+* @tc.require: issueI9BU5F
+* @tc.author:
+*/
+HWTEST_F(HnpInstallerTest, Hnp_Install_Parallel_002, TestSize.Level0)
+{
+    GTEST_LOG_(INFO) << "Hnp_Install_Parallel_002 start";
+
+    HnpPackWithElfPrepare(4);
+    HapInstallInfo installInfo = {};
+    HnpInstallJobList list = {};
+    HnpJobListCollect(&installInfo, &list, false);
+    ASSERT_EQ(list.count, 4);
+
+    // 任务1的安装目录已存在，非强制安装失败；任务2的软链被普通文件占用，提交时也会失败
+    EXPECT_EQ(HnpCreateFolder(list.jobs[1].hnpInfo.hnpSoftwarePath), 0);
+    EXPECT_EQ(HnpCreateFolder(HNP_BASE_PATH"/hnppublic/bin"), 0);
+    FILE *fp = fopen(HnpJobLinkPath(&list.jobs[2], "_0").c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    (void)fclose(fp);
+
+    int count = 0;
+    EXPECT_EQ(HnpJobListRun(&list, &count), HNP_ERRNO_INSTALLER_PATH_IS_EXIST);
+
+    // 失败任务之前的已安装，之后的未安装且并发阶段解压的内容已删除
+    EXPECT_EQ(access(list.jobs[0].hnpInfo.hnpVersionPath, F_OK), 0);
+    EXPECT_EQ(HnpSymlinkCheck(HnpJobLinkPath(&list.jobs[0], "_0").c_str(),
+        HnpJobLinkTarget(&list.jobs[0], "_0").c_str()), true);
+    EXPECT_EQ(access(list.jobs[1].hnpInfo.hnpVersionPath, F_OK), -1);
+    EXPECT_EQ(access(list.jobs[2].hnpInfo.hnpSoftwarePath, F_OK), -1);
+    EXPECT_EQ(access(list.jobs[3].hnpInfo.hnpSoftwarePath, F_OK), -1);
+    struct stat st;
+    EXPECT_EQ(lstat(HnpJobLinkPath(&list.jobs[3], "_0").c_str(), &st), -1);
+
+    HnpJobListDelete(&list);
+
+    GTEST_LOG_(INFO) << "Hnp_Install_Parallel_002 end";
+}
+
+/**
+* @tc.name: Hnp_Install_Parallel_003
+* @tc.desc:  Verify the lowest-index failed job's error is returned when a later job also fails.
+* @tc.type: FUNC
+* @tc.require: issueI9BU5F
+* @tc.author:
+*/
+HWTEST_F(HnpInstallerTest, Hnp_Install_Parallel_003, TestSize.Level0)
+{
+    GTEST_LOG_(INFO) << "Hnp_Install_Parallel_003 start";
+
+    HnpPackWithElfPrepare(4);
+    HapInstallInfo installInfo = {};
+    HnpInstallJobList list = {};
+    HnpJobListCollect(&installInfo, &list, false);
+    ASSERT_EQ(list.count, 4);
+
+    // 任务1的软链被普通文件占用，提交时失败；任务2的安装目录已存在，非强制安装也会失败
+    EXPECT_EQ(HnpCreateFolder(HNP_BASE_PATH"/hnppublic/bin"), 0);
+    FILE *fp = fopen(HnpJobLinkPath(&list.jobs[1], "_0").c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    (void)fclose(fp);
+    EXPECT_EQ(HnpCreateFolder(list.jobs[2].hnpInfo.hnpSoftwarePath), 0);
+
+    int count = 0;
+    EXPECT_EQ(HnpJobListRun(&list, &count), HNP_ERRNO_SYMLINK_CHECK_FAILED);
+
+    EXPECT_EQ(access(list.jobs[0].hnpInfo.hnpVersionPath, F_OK), 0);
+    EXPECT_EQ(access(list.jobs[2].hnpInfo.hnpSoftwarePath, F_OK), 0);
+    EXPECT_EQ(access(list.jobs[2].hnpInfo.hnpVersionPath, F_OK), -1);
+    EXPECT_EQ(access(list.jobs[3].hnpInfo.hnpSoftwarePath, F_OK), -1);
+
+    HnpJobListDelete(&list);
+
+    GTEST_LOG_(INFO) << "Hnp_Install_Parallel_003 end";
+}
+
+/**
+* @tc.name: Hnp_Install_Parallel_004
+* @tc.desc:  Verify hnp installed more than once is installed serially in job order.
+* @tc.type: FUNC
+* @tc.require: issueI9BU5F
+* @tc.author:
+*/
+HWTEST_F(HnpInstallerTest, Hnp_Install_Parallel_004, TestSize.Level0)
+{
+    GTEST_LOG_(INFO) << "Hnp_Install_Parallel_004 start";
+
+    HnpPackWithElfPrepare(1);
+    HnpPackWithElf("sample_dup", "1", "./hnp_out/public", 1);
+    HnpPackWithElf("sample_dup", "2", "./hnp_out/public/sub", 1);
+    HapInstallInfo installInfo = {};
+    HnpInstallJobList list = {};
+    HnpJobListCollect(&installInfo, &list, true);
+    ASSERT_EQ(list.count, 3);
+    EXPECT_EQ(HnpInstallWorkerCountGet(&list), 1);
+
+    int count = 0;
+    EXPECT_EQ(HnpJobListRun(&list, &count), 0);
+
+    // 后安装的版本生效
+    int last = -1;
+    for (int i = 0; i < list.count; i++) {
+        if (strcmp(list.jobs[i].hnpCfg.name, "sample_dup") == 0) {
+            last = i;
+        }
+    }
+    ASSERT_GE(last, 0);
+    EXPECT_EQ(access(list.jobs[last].hnpInfo.hnpVersionPath, F_OK), 0);
+    EXPECT_EQ(HnpSymlinkCheck(HnpJobLinkPath(&list.jobs[last], "_0").c_str(),
+        HnpJobLinkTarget(&list.jobs[last], "_0").c_str()), true);
+
+    HnpJobListDelete(&list);
+
+    GTEST_LOG_(INFO) << "Hnp_Install_Parallel_004 end";
+}
+
 }
\ No newline at end of file
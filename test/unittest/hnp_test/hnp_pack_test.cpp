@@ -20,6 +20,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <set>
 #include <string>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -36,6 +37,7 @@ using namespace testing::ext;
     extern "C" {
 #endif
 
+extern int g_hnpZipMaxWorkers;
 
 #ifdef __cplusplus
     }
@@ -402,5 +404,125 @@ HWTEST_F(HnpPackTest, Hnp_Pack_006, TestSize.Level0)
     GTEST_LOG_(INFO) << "Hnp_Pack_006 end";
 }
 
+#define HNP_PACK_LARGE_FILE_SIZE (600 * 1024 + 17)   // 大于打包读缓冲256K，覆盖流式压缩
+
+static void HnpPackTreeFileWrite(const char *path, const char *data, size_t len)
+{
+    FILE *fp = fopen(path, "wb");
+    ASSERT_NE(fp, nullptr);
+    if (len > 0) {
+        EXPECT_EQ(fwrite(data, sizeof(char), len, fp), len);
+    }
+    (void)fclose(fp);
+}
+
+/* 固定内容的目录：hnp.json、空文件、小文件、大于读缓冲的大文件及子目录 */
+static void HnpPackTreeCreate(void)
+{
+    EXPECT_EQ(mkdir("hnp_sample", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH), 0);
+    EXPECT_EQ(mkdir("hnp_sample/bin", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH), 0);
+    EXPECT_EQ(mkdir("hnp_sample/lib", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH), 0);
+    EXPECT_EQ(mkdir("hnp_out", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH), 0);
+
+    char cfg[] = "{\"type\":\"hnp-config\",\"name\":\"sample\",\"version\":\"1.1\",\"install\":"
+        "{\"links\":[{\"source\":\"bin/small\",\"target\":\"small\"}]}}";
+    HnpPackTreeFileWrite("hnp_sample/hnp.json", cfg, strlen(cfg) + 1);
+    HnpPackTreeFileWrite("hnp_sample/bin/empty", nullptr, 0);
+    std::string small;
+    for (int i = 0; i < 64; i++) {
+        small += "hnp pack digest test\n";
+    }
+    HnpPackTreeFileWrite("hnp_sample/bin/small", small.c_str(), small.size());
+    std::string large(HNP_PACK_LARGE_FILE_SIZE, '\0');
+    for (unsigned int i = 0; i < large.size(); i++) {
+        large[i] = static_cast<char>((i * 7 + (i >> 12)) % 251);
+    }
+    HnpPackTreeFileWrite("hnp_sample/bin/large", large.c_str(), large.size());
+    HnpPackTreeFileWrite("hnp_sample/lib/data", "lib data\n", strlen("lib data\n"));
+}
+
+/* 校验父目录条目先于子条目写入，返回条目数 */
+static int HnpPackEntryOrderCheck(const char *hnpFile)
+{
+    unzFile uf = unzOpen(hnpFile);
+    EXPECT_NE(uf, nullptr);
+    if (uf == nullptr) {
+        return 0;
+    }
+    std::set<std::string> entries;
+    char name[MAX_FILE_PATH_LEN];
+    for (int ret = unzGoToFirstFile(uf); ret == UNZ_OK; ret = unzGoToNextFile(uf)) {
+        unz_file_info info;
+        EXPECT_EQ(unzGetCurrentFileInfo(uf, &info, name, sizeof(name), nullptr, 0, nullptr, 0), UNZ_OK);
+        std::string entry(name);
+        std::string::size_type pos = entry.find_last_of('/', entry.size() - 2);
+        if (pos != std::string::npos) {
+            EXPECT_EQ(entries.count(entry.substr(0, pos + 1)), 1u) << entry;
+        }
+        entries.insert(entry);
+    }
+    unzClose(uf);
+    return static_cast<int>(entries.size());
+}
+
+static std::string HnpPackFileRead(const char *path)
+{
+    std::string content;
+    FILE *fp = fopen(path, "rb");
+    EXPECT_NE(fp, nullptr);
+    if (fp == nullptr) {
+        return content;
+    }
+    char buf[4096];
+    size_t len;
+    while ((len = fread(buf, sizeof(char), sizeof(buf), fp)) > 0) {
+        content.append(buf, len);
+    }
+    (void)fclose(fp);
+    return content;
+}
+
+/**
+* @tc.name: Hnp_Pack_007
+* @tc.desc:  Verify HnpCmdPack output of a fixed tree is the same with serial and parallel compression.
+* @tc.type: FUNC
+* @tc.require:issueI98PSE
+* @tc.author:
+*/
+HWTEST_F(HnpPackTest, Hnp_Pack_007, TestSize.Level0)
+{
+    GTEST_LOG_(INFO) << "Hnp_Pack_007 start";
+
+    // clear resource before test
+    HnpDeleteFolder("hnp_sample");
+    HnpDeleteFolder("hnp_out");
+    HnpPackTreeCreate();
+
+    char arg1[] = "hnp", arg2[] = "pack";
+    char arg3[] = "-i", arg4[] = "./hnp_sample", arg5[] = "-o", arg6[] = "./hnp_out";
+    char *argv[] = {arg1, arg2, arg3, arg4, arg5, arg6};
+    int argc = sizeof(argv) / sizeof(argv[0]);
+
+    // 不启动压缩线程，由写入线程串行压缩
+    int maxWorkers = g_hnpZipMaxWorkers;
+    g_hnpZipMaxWorkers = 0;
+    EXPECT_EQ(HnpCmdPack(argc, argv), 0);
+    g_hnpZipMaxWorkers = maxWorkers;
+    std::string serial = HnpPackFileRead("./hnp_out/sample.hnp");
+    EXPECT_EQ(remove("./hnp_out/sample.hnp"), 0);
+
+    EXPECT_EQ(HnpCmdPack(argc, argv), 0);
+    std::string parallel = HnpPackFileRead("./hnp_out/sample.hnp");
+    EXPECT_EQ(HnpPackEntryOrderCheck("./hnp_out/sample.hnp"), 8);  // 3个目录及5个文件
+
+    ASSERT_FALSE(serial.empty());
+    ASSERT_EQ(serial.size(), parallel.size());
+    EXPECT_EQ(memcmp(serial.data(), parallel.data(), serial.size()), 0);
+
+    EXPECT_EQ(HnpDeleteFolder("hnp_sample"), 0);
+    EXPECT_EQ(HnpDeleteFolder("hnp_out"), 0);
+
+    GTEST_LOG_(INFO) << "Hnp_Pack_007 end";
+}
 
 } // namespace OHOS
@@ -24,7 +24,7 @@ extern "C" {
 #endif
 #endif
 
-bool HnpELFFileCheck(const char *path, HnpSignMapInfo *signInfo);
+bool HnpELFHeaderCheck(const char *head, size_t headLen, const char *path, HnpSignMapInfo *signInfo);
 
 #ifdef __cplusplus
 #if __cplusplus
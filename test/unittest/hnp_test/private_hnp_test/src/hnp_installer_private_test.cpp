@@ -47,52 +47,13 @@ using namespace testing::ext;
     extern "C" {
 #endif
 
-static void CreateTestFileWrite32(const char *fileName)
+static void ElfHeadInit(unsigned char *ident, unsigned char elfClass)
 {
-    FILE *tmpFile = fopen(fileName, "wb");
-    if (tmpFile != nullptr) {
-        Elf32_Ehdr ehdr = {};
-        ehdr.e_ident[EI_MAG0] = '\177';
-        ehdr.e_ident[EI_MAG1] = 'E';
-        ehdr.e_ident[EI_MAG2] = 'L';
-        ehdr.e_ident[EI_MAG3] = 'F';
-        ehdr.e_ident[EI_CLASS] = ELFCLASS32;
-        fwrite(&ehdr, sizeof(Elf32_Ehdr), 1, tmpFile);
-        (void)fflush(tmpFile);
-        fclose(tmpFile);
-    }
-}
-
-static void CreateTestFileWrite64(const char *fileName)
-{
-    FILE *tmpFile = fopen(fileName, "wb");
-    if (tmpFile != nullptr) {
-        Elf64_Ehdr ehdr = {};
-        ehdr.e_ident[EI_MAG0] = '\177';
-        ehdr.e_ident[EI_MAG1] = 'E';
-        ehdr.e_ident[EI_MAG2] = 'L';
-        ehdr.e_ident[EI_MAG3] = 'F';
-        ehdr.e_ident[EI_CLASS] = ELFCLASS64;
-        fwrite(&ehdr, sizeof(Elf64_Ehdr), 1, tmpFile);
-        (void)fflush(tmpFile);
-        fclose(tmpFile);
-    }
-}
-
-static void CreateTestFileWriteOther(const char *fileName)
-{
-    FILE *tmpFile = fopen(fileName, "wb");
-    if (tmpFile != nullptr) {
-        Elf64_Ehdr ehdr = {};
-        ehdr.e_ident[EI_MAG0] = '\177';
-        ehdr.e_ident[EI_MAG1] = 'E';
-        ehdr.e_ident[EI_MAG2] = 'L';
-        ehdr.e_ident[EI_MAG3] = 'F';
-        ehdr.e_ident[EI_CLASS] = ELFCLASSNONE;
-        fwrite(&ehdr, sizeof(Elf64_Ehdr), 1, tmpFile);
-        (void)fflush(tmpFile);
-        fclose(tmpFile);
-    }
+    ident[EI_MAG0] = '\177';
+    ident[EI_MAG1] = 'E';
+    ident[EI_MAG2] = 'L';
+    ident[EI_MAG3] = 'F';
+    ident[EI_CLASS] = elfClass;
 }
 
 #ifdef __cplusplus
@@ -139,46 +100,56 @@ HWTEST_F(HnpPrivatTest, HnpGetRet_001, TestSize.Level0)
     UpdateReadFunc(NULL);
 }
 
-HWTEST_F(HnpPrivatTest, HnpELFFileCheckTest_001, TestSize.Level0)
+HWTEST_F(HnpPrivatTest, HnpELFHeaderCheckTest_001, TestSize.Level0)
 {
-    char testFile[PATH_MAX] = {0};
-    size_t bytes = snprintf_s(testFile, PATH_MAX, PATH_MAX - 1, APPSPAWN_BASE_DIR "/hnptestelf32");
-    EXPECT_NE(bytes, 0);
-
-    CreateTestFileWrite32(testFile);
+    Elf32_Ehdr ehdr = {};
+    ElfHeadInit(ehdr.e_ident, ELFCLASS32);
+    ehdr.e_type = ET_EXEC;
 
     HnpSignMapInfo temp = {};
-    bool ret = HnpELFFileCheck(testFile, &temp);
+    bool ret = HnpELFHeaderCheck(reinterpret_cast<const char *>(&ehdr), sizeof(ehdr), "elf32", &temp);
     EXPECT_TRUE(ret);
-    remove(testFile);
+    EXPECT_TRUE(temp.isExec);
 }
 
-HWTEST_F(HnpPrivatTest, HnpELFFileCheckTest_002, TestSize.Level0)
+HWTEST_F(HnpPrivatTest, HnpELFHeaderCheckTest_002, TestSize.Level0)
 {
-    char testFile[PATH_MAX] = {0};
-    size_t bytes = snprintf_s(testFile, PATH_MAX, PATH_MAX - 1, APPSPAWN_BASE_DIR "/hnptestelf64");
-    EXPECT_NE(bytes, 0);
-
-    CreateTestFileWrite64(testFile);
+    Elf64_Ehdr ehdr = {};
+    ElfHeadInit(ehdr.e_ident, ELFCLASS64);
+    ehdr.e_type = ET_DYN;
 
     HnpSignMapInfo temp = {};
-    bool ret = HnpELFFileCheck(testFile, &temp);
+    bool ret = HnpELFHeaderCheck(reinterpret_cast<const char *>(&ehdr), sizeof(ehdr), "elf64", &temp);
     EXPECT_TRUE(ret);
-    remove(testFile);
+    EXPECT_FALSE(temp.isExec);
 }
 
-HWTEST_F(HnpPrivatTest, HnpELFFileCheckTest_003, TestSize.Level0)
+HWTEST_F(HnpPrivatTest, HnpELFHeaderCheckTest_003, TestSize.Level0)
 {
-    char testFile[PATH_MAX] = {0};
-    size_t bytes = snprintf_s(testFile, PATH_MAX, PATH_MAX - 1, APPSPAWN_BASE_DIR "/hnptestelfother");
-    EXPECT_NE(bytes, 0);
-
-    CreateTestFileWriteOther(testFile);
+    Elf64_Ehdr ehdr = {};
+    ElfHeadInit(ehdr.e_ident, ELFCLASSNONE);
 
     HnpSignMapInfo temp = {};
-    bool ret = HnpELFFileCheck(testFile, &temp);
+    bool ret = HnpELFHeaderCheck(reinterpret_cast<const char *>(&ehdr), sizeof(ehdr), "elfother", &temp);
     EXPECT_TRUE(ret);
-    remove(testFile);
+}
+
+HWTEST_F(HnpPrivatTest, HnpELFHeaderCheckTest_004, TestSize.Level0)
+{
+    Elf64_Ehdr ehdr = {};
+    ElfHeadInit(ehdr.e_ident, ELFCLASS64);
+    ehdr.e_type = ET_EXEC;
+    HnpSignMapInfo temp = {};
+
+    // 文件头不足EI_NIDENT或魔数不匹配时不是elf文件
+    EXPECT_FALSE(HnpELFHeaderCheck(reinterpret_cast<const char *>(&ehdr), EI_NIDENT - 1, "short", &temp));
+    ehdr.e_ident[EI_MAG1] = 'X';
+    EXPECT_FALSE(HnpELFHeaderCheck(reinterpret_cast<const char *>(&ehdr), sizeof(ehdr), "text", &temp));
+
+    // 已识别为elf但文件头被截断时不判定为可执行文件
+    ehdr.e_ident[EI_MAG1] = 'E';
+    EXPECT_TRUE(HnpELFHeaderCheck(reinterpret_cast<const char *>(&ehdr), EI_NIDENT, "truncated", &temp));
+    EXPECT_FALSE(temp.isExec);
 }
 
 HWTEST_F(HnpPrivatTest, HapInstallInfoDestory_001, TestSize.Level0)
@@ -57,6 +57,8 @@ extern "C" {
 #define IFF_LOOPBACK_SIZE 2
 
 #define APPSPAWN_CHECK_EXIT "AppSpawnCheckUnexpectedExitCall"
+#define SPAWN_TIMEOUT_PARAM "persist.appspawn.reqMgr.timeout"
+#define COLD_SPAWN_TIMEOUT_PARAM "const.appspawn.reqMgr.asanTimeout"
 #define UNUSED(x) (void)(x)
 
 #define APP_COLD_START 0x01
@@ -158,6 +160,7 @@ void SetDumpToStream(FILE *stream);
 typedef int (*SplitStringHandle)(const char *str, void *context);
 int32_t StringSplit(const char *str, const char *separator, void *context, SplitStringHandle handle);
 char *GetLastStr(const char *str, const char *dst);
+uint32_t ParseSpawnTimeout(const char *data, uint32_t def);
 uint32_t GetSpawnTimeout(uint32_t def, bool isColdRun);
 void DumpCurrentDir(char *buffer, uint32_t bufferLen, const char *dirPath);
 int CheckEnabled(const char *param, const char *value);
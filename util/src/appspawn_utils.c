@@ -414,18 +414,20 @@ int IsDeveloperModeOpen()
 #    pragma warning(pop)
 #endif
 
+uint32_t ParseSpawnTimeout(const char *data, uint32_t def)
+{
+    APPSPAWN_CHECK_ONLY_EXPER(data != NULL && data[0] != '\0' && strcmp(data, "0") != 0, return def);
+    errno = 0;
+    uint32_t value = (uint32_t)atoi(data);
+    return (errno != 0) ? def : ((value < def) ? def : value);
+}
+
 uint32_t GetSpawnTimeout(uint32_t def, bool isColdRun)
 {
-    uint32_t value = def;
     char data[32] = {};  // 32 length
-    char *key = (isColdRun ? "const.appspawn.reqMgr.asanTimeout" : "persist.appspawn.reqMgr.timeout");
+    const char *key = (isColdRun ? COLD_SPAWN_TIMEOUT_PARAM : SPAWN_TIMEOUT_PARAM);
     int ret = GetParameter(key, "0", data, sizeof(data));
-    if (ret > 0 && strcmp(data, "0") != 0) {
-        errno = 0;
-        value = (uint32_t)atoi(data);
-        return (errno != 0) ? def : ((value < def) ? def : value);
-    }
-    return value;
+    return ret > 0 ? ParseSpawnTimeout(data, def) : def;
 }
 
 int EnableNewNetNamespace(void)